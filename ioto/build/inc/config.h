@@ -0,0 +1,13 @@
+#define SERVICES_AI 1
+#define SERVICES_DATABASE 1
+#define SERVICES_KEYS 0
+#define SERVICES_LOGS 0
+#define SERVICES_MQTT 1
+#define SERVICES_PROVISION 1
+#define SERVICES_REGISTER 1
+#define SERVICES_SERIALIZE "auto"
+#define SERVICES_SHADOW 0
+#define SERVICES_SYNC 1
+#define SERVICES_UPDATE 1
+#define SERVICES_URL 1
+#define SERVICES_WEB 1
@@ -169,6 +169,58 @@
     #define ME_FIBER_STACK_RESET_LIMIT ((size_t) (64 * 1024))
 #endif
 
+//  Tune the stack committed for each fiber entry proc from sampled stack high-water marks
+#ifndef ME_FIBER_STACK_TUNE
+    #define ME_FIBER_STACK_TUNE ME_FIBER_GROWABLE_STACK
+#endif
+
+#ifndef ME_FIBER_STACK_CLASSES
+    #define ME_FIBER_STACK_CLASSES 32           // Distinct fiber entry procs profiled
+#endif
+
+#ifndef ME_FIBER_STACK_SAMPLE
+    #define ME_FIBER_STACK_SAMPLE  64           // Measure one in N fiber runs once a proc is profiled
+#endif
+
+#ifndef ME_FIBER_TUNED_MIN_STACK
+    #define ME_FIBER_TUNED_MIN_STACK ((size_t) (16 * 1024))
+#endif
+
+//  Release the unused stack of fibers parked for longer than this period (msec)
+#ifndef ME_FIBER_TRIM_INTERVAL
+    #define ME_FIBER_TRIM_INTERVAL (5 * 1000)
+#endif
+
+//  Structured trace spans (rSpanBegin/rSpanEnd). Set to zero to compile out all span instrumentation.
+#ifndef ME_R_SPAN
+    #define ME_R_SPAN R_USE_FIBER
+#endif
+
+//  Per-subsystem memory accounting (rSetMemTag). Adds a 16 byte header to each rAlloc block.
+#ifndef ME_R_MEM_TAGS
+    #define ME_R_MEM_TAGS ME_DEBUG
+#endif
+
+//  Size-classed pools for small fixed-size objects. Set to zero to use malloc directly (e.g. for heap debuggers).
+#ifndef ME_MEM_POOL
+    #define ME_MEM_POOL        1
+#endif
+
+//  Largest object size served from pool slabs. Larger objects use malloc.
+#ifndef ME_MEM_POOL_MAX
+    #define ME_MEM_POOL_MAX    512
+#endif
+
+//  Size of each pool slab
+#ifndef ME_MEM_POOL_SLAB
+    #define ME_MEM_POOL_SLAB   ((size_t) (16 * 1024))
+#endif
+
+//  Default block size for arenas
+#ifndef ME_ARENA_BLOCK
+    #define ME_ARENA_BLOCK     ((size_t) (4 * 1024))
+#endif
+
 //  Memory protection flags for rProtectPages
 #define R_PROT_NONE                    0
 #define R_PROT_READ                    1
@@ -570,6 +622,18 @@ PUBLIC void rFreePages(void *ptr, size_t size);
  */
 PUBLIC int rProtectPages(void *addr, size_t size, int prot);
 
+/**
+    Discard the contents of a region of pages.
+    @description Releases the physical memory backing the region and sets its protection. If the region
+        remains accessible, pages read as zero when next touched.
+    @param addr Start address of the region (must be page-aligned).
+    @param size Size of the region in bytes (must be page-aligned).
+    @param prot Protection flags: R_PROT_NONE, R_PROT_READ, R_PROT_WRITE, R_PROT_EXEC.
+    @return Zero on success, negative on error.
+    @stability Evolving
+ */
+PUBLIC int rDiscardPages(void *addr, size_t size, int prot);
+
 /**
     Get system page size.
     @description Returns the system memory page size. Result is cached for efficiency.
@@ -624,6 +688,271 @@ PUBLIC void *rMemdup(cvoid *ptr, size_t size);
  */
 PUBLIC void rSetMemHandler(RMemProc handler);
 
+/**
+    Object pool size class granularity in bytes
+ */
+#define R_POOL_ALIGN   16
+
+/**
+    Number of pool size classes
+ */
+#define R_POOL_CLASSES (ME_MEM_POOL_MAX / R_POOL_ALIGN)
+
+/**
+    Object pool for small fixed-size objects
+    @description Pools carve objects from slabs and recycle them via per-size-class free lists. This avoids
+        malloc lock time and heap fragmentation for objects that are frequently allocated and freed.
+        Pools are shared by all object types of the same size class and are never freed.
+    @stability Evolving
+ */
+typedef struct RPool RPool;
+
+/**
+    Pool statistics for one size class
+    @stability Evolving
+ */
+typedef struct RPoolStats {
+    size_t size;                /**< Object size for this class */
+    int64 objects;              /**< Total objects owned by the pool */
+    int64 inUse;                /**< Objects currently allocated */
+    int64 allocs;               /**< Total allocations */
+    int slabs;                  /**< Number of slabs */
+} RPoolStats;
+
+/**
+    Memory statistics
+    @stability Evolving
+ */
+typedef struct RMemStats {
+    size_t heap;                /**< Bytes obtained from the system by malloc. Zero if not supported. */
+    size_t heapFree;            /**< Free bytes held by malloc. Zero if not supported. */
+    size_t poolBytes;           /**< Bytes reserved in pool slabs */
+    size_t poolUsed;            /**< Bytes of pool objects in use */
+    int pools;                  /**< Number of active size classes in the stats array */
+    RPoolStats stats[R_POOL_CLASSES]; /**< Per size class statistics */
+} RMemStats;
+
+/**
+    Get the object pool for a given object size
+    @description Return the pool for the size class containing the given size, creating it if required.
+        Call from the main thread, typically when initializing a module, and cache the result.
+        Objects larger than ME_MEM_POOL_MAX are allocated via malloc.
+    @param size Object size in bytes
+    @return The pool object.
+    @stability Evolving
+ */
+PUBLIC RPool *rAllocPool(size_t size);
+
+/**
+    Allocate an object from a pool
+    @description Allocate a zeroed object from the pool. When called from a foreign thread, the object is
+        allocated via malloc and joins the pool when freed, unless the pool free list already holds as many objects
+        as the pool slabs provide, in which case it is released to the heap.
+    @param pool Pool returned from rAllocPool
+    @return Pointer to the zeroed object. If memory is not available the memory allocation handler will be invoked.
+    @stability Evolving
+ */
+PUBLIC void *rAllocFromPool(RPool *pool);
+
+/**
+    Return an object to a pool
+    @description The object must have been allocated via rAllocFromPool on the same pool. Do not free pool
+        objects with rFree. This routine is THREAD SAFE.
+    @param pool Pool returned from rAllocPool
+    @param ptr Object to free. If NULL, the call is skipped.
+    @stability Evolving
+ */
+PUBLIC void rFreeToPool(RPool *pool, void *ptr);
+
+/**
+    Get memory statistics
+    @description Return heap and object pool statistics. Compare heapFree to heap over time to monitor heap
+        fragmentation.
+    @param stats Statistics structure to fill
+    @stability Evolving
+ */
+PUBLIC void rGetMemStats(RMemStats *stats);
+
+/*
+    Memory accounting tags
+ */
+#define R_MEM_OTHER 0               /**< Untagged allocations and allocations from foreign threads */
+#define R_MEM_POOL  1               /**< Object pool slabs */
+#define R_MEM_WEB   2               /**< Web server */
+#define R_MEM_DB    3               /**< Database */
+#define R_MEM_JSON  4               /**< JSON trees */
+#define R_MEM_MQTT  5               /**< MQTT client */
+#define R_MEM_URL   6               /**< URL client */
+#define R_MEM_APP   7               /**< First tag available for applications */
+#define R_MEM_TAGS  16              /**< Maximum number of tags */
+
+/**
+    Memory accounting for one tag
+    @stability Evolving
+ */
+typedef struct RMemTagStats {
+    cchar *name;                /**< Tag name. NULL if the tag is not named. */
+    int64 bytes;                /**< Live bytes */
+    int64 blocks;               /**< Live blocks */
+    int64 allocs;               /**< Total allocations */
+    int64 peak;                 /**< Peak live bytes */
+} RMemTagStats;
+
+/**
+    Memory accounting snapshot
+    @stability Evolving
+ */
+typedef struct RMemSnapshot {
+    Ticks when;                 /**< Time of the snapshot */
+    RMemTagStats tags[R_MEM_TAGS]; /**< Per tag accounting */
+} RMemSnapshot;
+
+/**
+    Set the memory accounting tag
+    @description Subsequent rAlloc allocations by the current fiber are charged to the given tag. Each fiber
+        has its own tag which is inherited from the creating fiber. Resized blocks keep their original tag.
+        Allocations from foreign threads are charged to R_MEM_OTHER. Use the result to restore the prior tag:
+            prior = rSetMemTag(R_MEM_DB);
+            ...
+            rSetMemTag(prior);
+        Memory accounting requires ME_R_MEM_TAGS (the default for debug builds).
+    @param tag Tag from R_MEM_OTHER to R_MEM_TAGS - 1. Invalid tags are ignored.
+    @return The prior tag.
+    @stability Evolving
+ */
+PUBLIC int rSetMemTag(int tag);
+
+/**
+    Get the memory accounting tag of the current fiber
+    @return The current tag.
+    @stability Evolving
+ */
+PUBLIC int rGetMemTag(void);
+
+/**
+    Name a memory accounting tag
+    @description Set the name used for the tag in snapshots and reports. Call from the main thread when
+        initializing. The standard tags are named by default.
+    @param tag Tag from R_MEM_OTHER to R_MEM_TAGS - 1.
+    @param name Static name string. The name is not copied.
+    @return Zero if successful, otherwise a negative R_ERR_ code.
+    @stability Evolving
+ */
+PUBLIC int rSetMemTagName(int tag, cchar *name);
+
+/**
+    Capture the memory accounting for all tags
+    @param snapshot Snapshot to fill. Zeroed if ME_R_MEM_TAGS is disabled.
+    @stability Evolving
+ */
+PUBLIC void rGetMemSnapshot(RMemSnapshot *snapshot);
+
+/**
+    Compute the change in memory accounting between two snapshots
+    @description The bytes, blocks and allocs of the diff are the change from before to after. The peak is
+        that of the after snapshot. Use to assert that an operation does not leak memory per tag.
+    @param diff Snapshot to receive the difference. May be the same as before or after.
+    @param before Earlier snapshot
+    @param after Later snapshot
+    @stability Evolving
+ */
+PUBLIC void rDiffMemSnapshot(RMemSnapshot *diff, const RMemSnapshot *before, const RMemSnapshot *after);
+
+/**
+    Report memory accounting
+    @description Emit the live bytes, blocks, allocations and peak for each active tag via rMetrics.
+    @stability Evolving
+ */
+PUBLIC void rReportMem(void);
+
+/**
+    Report memory accounting periodically
+    @param period Report period in milliseconds. Set to zero to stop reporting.
+    @stability Evolving
+ */
+PUBLIC void rSetMemReport(Ticks period);
+
+/**
+    Bump-pointer memory arena
+    @description Arenas serve many short-lived allocations that share a lifetime. Allocation advances a pointer
+        in the current block and all allocations are released together via rResetArena or rFreeArena.
+        Individual arena allocations must not be freed via rFree. Arenas are not thread safe.
+    @stability Evolving
+ */
+typedef struct RArena RArena;
+
+/**
+    Allocate an arena
+    @param blockSize Size of arena blocks. Set to zero for the ME_ARENA_BLOCK default. The first block is
+        allocated immediately and retained until the arena is freed.
+    @return The arena object. Returns NULL if memory cannot be allocated.
+    @stability Evolving
+ */
+PUBLIC RArena *rAllocArena(size_t blockSize);
+
+/**
+    Free an arena and all its allocations
+    @param arena Arena to free. If NULL, the call is skipped.
+    @stability Evolving
+ */
+PUBLIC void rFreeArena(RArena *arena);
+
+/**
+    Release all arena allocations
+    @description Allocations made since the arena was allocated or last reset become invalid. Overflow blocks
+        are freed and the first block is reused.
+    @param arena Arena to reset
+    @stability Evolving
+ */
+PUBLIC void rResetArena(RArena *arena);
+
+/**
+    Allocate memory from an arena
+    @description The memory is not zeroed and is aligned for any type.
+    @param arena Arena to allocate from
+    @param size Size of memory to allocate
+    @return Pointer to the memory block. If memory is not available the memory allocation handler will be invoked.
+    @stability Evolving
+ */
+PUBLIC void *rArenaAlloc(RArena *arena, size_t size);
+
+/**
+    Clone a string into an arena
+    @param arena Arena to allocate from
+    @param str String to clone. If NULL, an empty string is returned.
+    @return Cloned string allocated in the arena.
+    @stability Evolving
+ */
+PUBLIC char *rArenaClone(RArena *arena, cchar *str);
+
+/**
+    Format a string into an arena
+    @param arena Arena to allocate from
+    @param fmt Printf style format string
+    @param ... Variable arguments to format
+    @return Formatted string allocated in the arena.
+    @stability Evolving
+ */
+PUBLIC char *rArenaFmt(RArena *arena, cchar *fmt, ...) PRINTF_ATTRIBUTE(2, 3);
+
+/**
+    Format a string into an arena
+    @param arena Arena to allocate from
+    @param fmt Printf style format string
+    @param args Varargs argument list
+    @return Formatted string allocated in the arena.
+    @stability Evolving
+ */
+PUBLIC char *rArenaFmtv(RArena *arena, cchar *fmt, va_list args);
+
+/**
+    Get the bytes allocated from an arena since it was last reset
+    @param arena Arena to examine
+    @return Count of bytes including alignment padding.
+    @stability Evolving
+ */
+PUBLIC size_t rGetArenaUsed(RArena *arena);
+
 /************************************ Fiber ************************************/
 
 /**
@@ -706,7 +1035,33 @@ typedef struct RFiberStack {
     size_t initialSize;   // Initial committed size (for pool reset)
     size_t maxSize;       // Maximum growth allowed
     bool guarded;         // Using guard pages (vs pattern)
+#if ME_FIBER_STACK_TUNE
+    void *parked;         // Stack pointer when last parked (NULL if running or trimmed)
+    void *clean;          // Stack below this address was zeroed before a sampled run
+    size_t used;          // High-water mark measured before trimming a sampled run
+    uint parkGen;         // Trim generation when parked
+    uint grows;           // Growth faults during the current run
+#endif
 } RFiberStack;
+
+#if ME_FIBER_STACK_TUNE
+/**
+    Stack profile for a fiber entry proc
+    @description Fibers are profiled by the entry proc given to rAllocFiber. The high-water mark of sampled
+        runs determines the stack committed when the proc next starts a fiber.
+    @stability Evolving
+    @ingroup RFiber
+ */
+typedef struct RFiberStackClass {
+    void *proc;           // Fiber entry proc
+    uint64 runs;          // Fibers started with the proc
+    uint64 samples;       // Runs with a measured high-water mark
+    uint64 grows;         // Stack growth faults
+    size_t peak;          // Largest measured high-water mark
+    size_t window;        // Largest high-water mark in the current sample window
+    size_t size;          // Tuned stack commit (zero until sampled)
+} RFiberStackClass;
+#endif
 #endif
 
 /**
@@ -730,6 +1085,13 @@ typedef struct RFiber {
     bool pooled;         // Fiber is pooled, waiting for reuse
     int exception;       // Exception that caused the fiber to crash
     int done;
+#if ME_R_SPAN
+    uint64 span;         // Current trace span
+    int spanTrack;       // Trace track for this fiber
+#endif
+#if ME_R_MEM_TAGS
+    int memTag;          // Memory accounting tag
+#endif
 #if FIBER_WITH_VALGRIND
     uint stackId;
 #endif
@@ -739,6 +1101,11 @@ typedef struct RFiber {
 #endif
 #if ME_FIBER_GROWABLE_STACK
     RFiberStack stackInfo; // Guard page stack metadata
+#if ME_FIBER_STACK_TUNE
+    struct RFiberStackClass *stackClass; // Stack profile for the entry proc
+    struct RFiber *nextActive;           // Active fiber list for idle stack trimming
+    struct RFiber *prevActive;
+#endif
 #elif ME_FIBER_VM_STACK
     uchar *stack;          // Pointer to VM-allocated stack
 #else
@@ -971,6 +1338,43 @@ PUBLIC int rSetFiberStackLimits(size_t initialSize, size_t maxSize, size_t growS
  */
 PUBLIC void rGetFiberStackLimits(size_t *initialSize, size_t *maxSize, size_t *growSize, size_t *resetLimit);
 
+/**
+    Enable or disable fiber stack tuning
+    @description When enabled, the runtime samples the stack high-water mark of fibers for each entry proc
+        (web requests, MQTT messages, event procs) and commits a matching stack when the proc next starts a fiber.
+        Sizes are the sampled peak plus 25% headroom and shrink if a proc's usage falls. Stacks can still grow
+        on demand up to the maximum stack size. The unused stack below fibers that stay parked, such as idle
+        connections, is periodically released. Tuning requires growable stacks and is enabled by default.
+    @param enable Set to true to enable tuning.
+    @return The previous setting.
+    @stability Evolving
+    @see rGetFiberStackAdvice, rGetFiberStackProfile
+ */
+PUBLIC bool rSetFiberStackTuning(bool enable);
+
+/**
+    Get recommended fiber stack limits
+    @description Computes recommended limits from the sampled stack high-water marks. The initial size
+        covers 90% of fiber runs. The maximum size is twice the largest sampled high-water mark, but not less
+        than ME_FIBER_DEFAULT_STACK. If no fibers have been sampled, the current limits are returned.
+    @param initialSize Pointer to receive the recommended initial stack size (may be NULL).
+    @param maxSize Pointer to receive the recommended maximum stack size (may be NULL).
+    @stability Evolving
+    @see rSetFiberStackLimits
+ */
+PUBLIC void rGetFiberStackAdvice(size_t *initialSize, size_t *maxSize);
+
+#if ME_FIBER_STACK_TUNE
+/**
+    Get the stack profile for fiber entry procs
+    @param classes Array to receive the profiles.
+    @param max Number of elements in the classes array.
+    @return The number of profiles copied to the classes array.
+    @stability Evolving
+ */
+PUBLIC int rGetFiberStackProfile(RFiberStackClass *classes, int max);
+#endif
+
 /**
     Allocate a fiber coroutine object
     @description This allocates a new fiber coroutine. Use rStartFiber to launch.
@@ -1022,8 +1426,172 @@ PUBLIC int rEnter(bool *access, Ticks deadline);
     @stability Evolving
  */
 PUBLIC void rLeave(bool *access);
+
+/*
+    Sampling profiler. Backtraces require glibc or MacOS.
+ */
+#ifndef ME_R_PROFILE
+    #if (LINUX && defined(__GLIBC__)) || MACOSX
+        #define ME_R_PROFILE 1              /**< Build the SIGPROF sampling profiler */
+    #else
+        #define ME_R_PROFILE 0
+    #endif
+#endif
+
+#if ME_R_PROFILE
+#ifndef ME_R_PROFILE_SAMPLES
+    #define ME_R_PROFILE_SAMPLES 8192       /**< Default sample buffer size */
+#endif
+#ifndef ME_R_PROFILE_HZ
+    #define ME_R_PROFILE_HZ      99         /**< Default sampling frequency */
+#endif
+#define R_PROFILE_DEPTH          24         /**< Maximum frames per sample */
+#define R_PROFILE_RAW            0x1        /**< Report all frames as module+offset */
+
+/**
+    Start the sampling profiler
+    @description Samples the runtime thread on SIGPROF at the given frequency of consumed CPU time. Each sample
+        records the current fiber, its entry proc and a backtrace in a buffer allocated when profiling starts.
+        Sampling stops recording when the buffer is full. Samples taken on other threads are ignored.
+        Starting the profiler discards prior samples.
+    @param frequency Samples per second of CPU time. Set to zero for ME_R_PROFILE_HZ.
+    @param maxSamples Maximum number of samples to record. Set to zero for ME_R_PROFILE_SAMPLES.
+    @return Zero if successful, R_ERR_BAD_STATE if already running or R_ERR_CANT_INITIALIZE if the timer
+        cannot be started.
+    @stability Evolving
+    @see rGetProfile, rStopProfile, rWriteProfile
+ */
+PUBLIC int rStartProfile(int frequency, int maxSamples);
+
+/**
+    Stop the sampling profiler
+    @description Recorded samples are retained until the profiler is restarted or the runtime terminates.
+    @stability Evolving
+ */
+PUBLIC void rStopProfile(void);
+
+/**
+    Get the recorded profile as folded stacks
+    @description Returns one line per unique stack of the form "fiber;caller;...;leaf count" suitable for
+        flamegraph.pl, speedscope or inferno. The root frame is "main" for the main fiber or
+        "fiber:PROC" for other fibers, where PROC is the fiber entry proc.
+        Frames are named by the nearest exported symbol, so executables should be linked with -rdynamic.
+        Static functions are attributed to the preceding exported symbol. Unnamed frames and frames
+        when using R_PROFILE_RAW are reported as module+offset for offline symbolization (addr2line).
+    @param flags Set to R_PROFILE_RAW to report all frames as module+offset.
+    @return An allocated string. Caller must free.
+    @stability Evolving
+ */
+PUBLIC char *rGetProfile(int flags);
+
+/**
+    Get profiler sample counts
+    @param samples Pointer to receive the number of recorded samples (may be NULL).
+    @param dropped Pointer to receive the number of samples dropped because the buffer was full (may be NULL).
+    @stability Evolving
+ */
+PUBLIC void rGetProfileStats(int64 *samples, int64 *dropped);
+
+/**
+    Write the recorded profile as folded stacks to a file
+    @param path File name
+    @param flags Set to R_PROFILE_RAW to report all frames as module+offset.
+    @return Zero if successful, otherwise a negative error code.
+    @stability Evolving
+    @see rGetProfile
+ */
+PUBLIC int rWriteProfile(cchar *path, int flags);
+
+/**
+    Stop the profiler and free the sample buffer
+    @description Called by rTerm. When restarting (R_RESTART), rTerm retains the profiler and its samples and
+        sampling is paused until the runtime is reinitialized.
+    @stability Internal
+ */
+PUBLIC void rTermProfile(void);
+#endif /* ME_R_PROFILE */
 #endif
 
+/************************************ Spans ***********************************/
+/*
+    Structured trace spans exported in the Chrome trace-event format
+ */
+#if ME_R_SPAN
+#ifndef ME_R_SPAN_MAX
+    #define ME_R_SPAN_MAX 4096              /**< Default span ring size */
+#endif
+
+/**
+    Start recording trace spans
+    @description Spans are recorded into a ring buffer of the given size that overwrites the oldest spans when
+        full. Spans are only recorded on the runtime thread. Restarting discards prior spans.
+        If a path is provided, it is the default path used by rWriteSpans.
+    @param maxSpans Ring buffer size. Set to zero for ME_R_SPAN_MAX.
+    @param path Optional default file to receive the spans via rWriteSpans. May be NULL.
+    @return Zero if successful, otherwise R_ERR_MEMORY.
+    @stability Evolving
+    @see rGetSpans, rSpanBegin, rSpanEnd, rStopSpans, rWriteSpans
+ */
+PUBLIC int rStartSpans(int maxSpans, cchar *path);
+
+/**
+    Stop recording trace spans
+    @description Recorded spans are retained until recording is restarted or the runtime terminates.
+        Spans that are open when recording stops are still completed by rSpanEnd.
+    @stability Evolving
+ */
+PUBLIC void rStopSpans(void);
+
+/**
+    Begin a trace span
+    @description The span becomes the current span of the calling fiber and is the parent of spans begun
+        before it ends. This is a fast no-op when span recording is not started.
+    @param category Span category such as "web" or "db". Must be a static string.
+    @param name Span name such as "request". Must be a static string.
+    @return Span ID to pass to rSpanEnd. Returns zero if spans are not being recorded.
+    @stability Evolving
+ */
+PUBLIC uint64 rSpanBegin(cchar *category, cchar *name);
+
+/**
+    End a trace span
+    @description Records the span duration and restores the parent span as the current span of the fiber.
+    @param span Span ID returned by rSpanBegin. Zero is ignored.
+    @stability Evolving
+ */
+PUBLIC void rSpanEnd(uint64 span);
+
+/**
+    Get the recorded spans as Chrome trace-event JSON
+    @description Returns a JSON document with one complete ("X") event per ended span, suitable for
+        chrome://tracing, ui.perfetto.dev or speedscope. Each fiber is a separate track (tid) and each event
+        records its span ID and parent ID in its args.
+    @return An allocated string. Caller must free.
+    @stability Evolving
+ */
+PUBLIC char *rGetSpans(void);
+
+/**
+    Write the recorded spans as Chrome trace-event JSON to a file
+    @param path File name. If NULL, the path given to rStartSpans is used.
+    @return Zero if successful, otherwise a negative error code.
+    @stability Evolving
+    @see rGetSpans
+ */
+PUBLIC int rWriteSpans(cchar *path);
+
+/**
+    Stop recording and free the span ring
+    @description Called by rTerm. When restarting (R_RESTART), rTerm retains the span ring and recording continues
+        after the runtime is reinitialized.
+    @stability Internal
+ */
+PUBLIC void rTermSpans(void);
+#else
+    #define rSpanBegin(category, name) ((uint64) 0)
+    #define rSpanEnd(span)             ((void) (span))
+#endif /* ME_R_SPAN */
+
 /************************************ Time *************************************/
 #if R_USE_TIME
 
@@ -1293,6 +1861,7 @@ typedef int64 REvent;
 #define R_EVENT_KQUEUE            3       /**< BSD kqueue */
 #define R_EVENT_SELECT            4       /**< traditional select() */
 #define R_EVENT_WSAPOLL           5       /**< Windows WSAPOLL */
+#define R_EVENT_URING             6       /**< Linux io_uring with epoll fallback. Select via ME_EVENT_NOTIFIER */
 
 #ifndef ME_EVENT_NOTIFIER
     #if MACOSX || SOLARIS
@@ -1368,6 +1937,20 @@ PUBLIC REvent rAllocEvent(RFiber *fiber, REventProc proc, void *data, Ticks dela
  */
 PUBLIC REvent rStartEvent(REventProc proc, void *data, Ticks delay);
 
+/**
+    Start a fast callback event
+    @description
+    This schedules a fast event to run once. Fast events run directly off the main service fiber and must not
+    block or yield. This routine is THREAD SAFE.
+    This API is a wrapper for rAllocEvent with the R_EVENT_FAST flag.
+    @param proc Callback procedure function. Signature is: void (*fn)(void *data, int id)
+    @param data Data reference to pass to the callback
+    @param delay Delay in milliseconds in which to run the callback
+    @return A positive integer event ID
+    @stability Evolving
+ */
+PUBLIC REvent rStartFastEvent(REventProc proc, void *data, Ticks delay);
+
 /**
     Stop an event
     @param id Event id allocated by rStartEvent
@@ -1406,6 +1989,99 @@ PUBLIC Ticks rRunEvents(void);
  */
 PUBLIC Time rGetNextDueEvent(void);
 
+#ifndef ME_R_EVENT_STATS
+    #define ME_R_EVENT_STATS 1              /**< Build event loop health statistics */
+#endif
+
+#define R_EVENT_BUCKETS 20                  /**< Event latency histogram buckets */
+
+/**
+    Event latency histogram
+    @description Samples are in microseconds. Bucket zero counts samples under one microsecond.
+        Bucket N counts samples from 2^(N-1) up to (but not including) 2^N microseconds.
+        The last bucket also counts all larger samples.
+    @stability Evolving
+ */
+typedef struct REventHistogram {
+    uint64 count;                           /**< Number of samples */
+    uint64 total;                           /**< Sum of samples (usec) */
+    uint64 max;                             /**< Largest sample (usec) */
+    uint64 buckets[R_EVENT_BUCKETS];        /**< Sample counts by power of two */
+} REventHistogram;
+
+/**
+    Event loop health statistics
+    @see rGetEventStats, rSetEventStats
+    @stability Evolving
+ */
+typedef struct REventStats {
+    REventHistogram loop;                   /**< Time to dispatch all due events per loop iteration */
+    REventHistogram lag;                    /**< How late events were dispatched after their due time */
+    REventHistogram slice;                  /**< Time a fiber or fast event ran before yielding to the loop */
+    uint64 iterations;                      /**< Event loop iterations */
+    uint64 dispatched;                      /**< Events dispatched */
+    uint64 slow;                            /**< Slices exceeding the slow handler threshold */
+    Ticks slowThreshold;                    /**< Slow handler threshold (msec) */
+    int queued;                             /**< Events currently scheduled */
+    int maxDue;                             /**< Most events due in a single loop iteration */
+    bool enabled;                           /**< Statistics are being collected */
+} REventStats;
+
+/*
+    Set when event statistics are enabled. Internal.
+ */
+PUBLIC_DATA bool rEventStatsEnabled;
+
+/**
+    Enable or disable event loop health statistics
+    @description When enabled, the event loop records the time to dispatch due events per iteration, how late
+        events run compared with their scheduled time and how long each fiber or fast event runs before yielding.
+        Slices that run longer than the slow threshold are counted and logged with the address of the
+        offending procedure. Enabling statistics resets prior statistics. When disabled, the overhead is
+        a single test per loop iteration and fiber switch.
+    @param enable Set to true to enable collecting statistics.
+    @param slow Slow handler threshold in milliseconds. Set to zero to disable slow handler detection.
+    @stability Evolving
+ */
+PUBLIC void rSetEventStats(bool enable, Ticks slow);
+
+/**
+    Get the event loop health statistics
+    @param stats Structure to receive a copy of the statistics.
+    @stability Evolving
+ */
+PUBLIC void rGetEventStats(REventStats *stats);
+
+/**
+    Reset the event loop health statistics
+    @stability Evolving
+ */
+PUBLIC void rResetEventStats(void);
+
+/**
+    Estimate a percentile from an event histogram
+    @param hist Histogram to examine.
+    @param percent Percentile to estimate (0-100).
+    @return The upper bound in microseconds of the bucket containing the percentile.
+    @stability Evolving
+ */
+PUBLIC uint64 rGetEventPercentile(const REventHistogram *hist, double percent);
+
+/**
+    Record the run time of a fiber slice. Internal.
+    @param start Start time from rGetEventClock.
+    @param proc Procedure that ran.
+    @stability Internal
+ */
+PUBLIC void rAddEventSlice(uint64 start, void *proc);
+
+/**
+    Get a monotonic clock in microseconds for event statistics and trace spans
+    @return Time in microseconds.
+    @stability Internal
+ */
+PUBLIC uint64 rGetEventClock(void);
+
 /**
     Service events.
     @description This call blocks and continually services events on the event loop until the app is instructed to exit
@@ -1553,6 +2229,16 @@ PUBLIC void rSetWaitMask(RWait *wp, int64 mask, Ticks deadline);
  */
 PUBLIC int rGetWaitFd(void);
 
+/**
+    Re-create the I/O wait notifier
+    @description This is called in a child process after fork. The epoll and io_uring instances are shared with
+        the parent after fork and kqueue instances are not inherited. This call creates a new notifier for the
+        process and re-registers all current wait masks.
+    @return Zero if successful.
+    @stability Evolving
+ */
+PUBLIC int rResetWait(void);
+
 /**
     Wait for an I/O event
     @description This is typically called by $rServiceEvents to wait for I/O events.
@@ -1721,6 +2407,19 @@ PUBLIC char *sitosx(int64 value, int radix);
  */
 PUBLIC char *sitosbuf(char *buf, size_t size, int64 value, int radix);
 
+/**
+    Convert a floating point number to a string buffer.
+    @description This call converts the supplied double to the shortest string that reads back as the same
+        double. Numbers from 0.0001 to 1000000 are formatted in fixed notation and other numbers use an exponent.
+        This is the same output as the "%g" format without a precision.
+    @param buf Pointer to the buffer that will hold the string.
+    @param size Size of the buffer. A buffer of 32 characters is large enough for any number.
+    @param value Number to convert
+    @return Returns a reference to the string or NULL if the buffer is too small.
+    @stability Evolving
+ */
+PUBLIC char *sftosbuf(char *buf, size_t size, double value);
+
 /**
     Compare strings ignoring case. This is a r replacement for strcasecmp. It can handle NULL args.
     @description Compare two strings ignoring case differences. This call operates similarly to strcmp.
@@ -2690,6 +3389,17 @@ PUBLIC ssize rPutToBuf(RBuf *buf, cchar *fmt, ...) PRINTF_ATTRIBUTE(2, 3);
  */
 PUBLIC ssize rPutIntToBuf(RBuf *buf, int64 i);
 
+/**
+    Put a floating point number to the buffer.
+    @description Append the shortest decimal representation of the number that reads back as the same double.
+        This is the same output as the "%g" format without a precision, but does not parse a format string.
+    @param buf Buffer created via rAllocBuf
+    @param value Number to append to the buffer
+    @returns Number of characters added to the buffer, otherwise a negative error code
+    @stability Evolving
+ */
+PUBLIC ssize rPutDoubleToBuf(RBuf *buf, double value);
+
 /**
     Put a string to the buffer.
     @description Append a null terminated string to the buffer at the end position and increment the end pointer.
@@ -3007,6 +3717,17 @@ PUBLIC void *rPopItem(RList *list);
     #define ME_MAX_LOG_LINE 512             /* Max size of a log line */
 #endif
 
+#ifndef ME_R_LOG_RING
+    #define ME_R_LOG_RING   (256 * 1024)    /* Size of the async log ring buffer (power of two) */
+#endif
+
+/*
+    Async log overflow policies
+ */
+#define R_LOG_DROP          0               /**< Drop messages when the async log buffer is full */
+#define R_LOG_BLOCK         1               /**< Block the caller until the log writer makes room */
+#define R_LOG_COUNT         2               /**< Drop messages and log a count of dropped messages */
+
 #define R_LOG_FORMAT        "%A: %M"
 #define R_LOG_SYSLOG        "%D %H %A[%P] %T %F %M"
 
@@ -3040,6 +3761,8 @@ typedef void (*RLogHandler)(cchar *type, cchar *source, cchar *msg);
     @description This convenience routine calls rSetLogPath, rSetLogFilter and rSetLogFormat.
     @param spec The spec is of the form:  "destination:filter". The destination may be a filename, "stdout", "stderr" or
        "none". The log filter portion is of the form: "types:sources" and is passed to rSetLogFilter.
+       The destination may be followed by ":async" or ":async=POLICY" to write the log from a background thread.
+       See rSetLogAsync for the POLICY values "drop", "block" and "count". The default policy is "count".
     @param format The log pattern to use to format the message. The format can use %Letter tokens that are expanded at
        runtime. The tokens supported are: 'A' for the application name, 'C' for clock ticks, 'D' for the local datetime,
         'H' for the system hostname, 'P' for the process ID , 'S' for the message source, and 'T' for the log message
@@ -3118,10 +3841,43 @@ PUBLIC void rDefaultLogHandler(cchar *type, cchar *source, cchar *msg);
         with the extension trimmed and "-COUNT.EXT" appended where COUNT is the backup number
         and EXT is the original file extension. This call will keep up to ME_R_LOG_COUNT backups
         (defaults to 5). After backing up the log file, a new (empty) file will be opened.
+        In async mode, the backup is performed by the log writer thread.
     @stability Evolving
  */
 PUBLIC void rBackupLog(void);
 
+/**
+    Enable or disable asynchronous logging
+    @description In async mode, log messages are formatted by the caller and queued in a ring buffer of
+        ME_R_LOG_RING bytes. A background thread writes queued messages in batches and performs log backups
+        requested via rBackupLog, so disk stalls do not block the event loop. Queued messages are written
+        before exit, when the log path changes, when logging is terminated and after "fatal" messages.
+        Async logging is only supported on systems with pthreads. The log should only be written from the
+        runtime thread.
+    @param enable Set to true to enable async logging. Set to false to flush the queue and write synchronously.
+    @param policy Overflow policy when the ring buffer is full. Set to R_LOG_DROP to discard messages,
+        R_LOG_BLOCK to wait for space or R_LOG_COUNT to discard messages and then log the number dropped.
+        Set to -1 to retain the current policy.
+    @return Zero if successful, otherwise a negative R error code.
+    @stability Evolving
+ */
+PUBLIC int rSetLogAsync(bool enable, int policy);
+
+/**
+    Flush queued async log messages
+    @description Wait until all queued log messages have been written. Does nothing if async logging is
+        not enabled.
+    @stability Evolving
+ */
+PUBLIC void rFlushLog(void);
+
+/**
+    Get the number of async log messages dropped because the ring buffer was full
+    @return The count of dropped messages.
+    @stability Evolving
+ */
+PUBLIC uint64 rGetLogDropped(void);
+
 /**
     Format a log message into a buffer
     @description This formats the log message according to the current log format string.
@@ -3213,6 +3969,49 @@ PUBLIC void rAssert(cchar *loc, cchar *msg);
  */
 PUBLIC void rLogv(cchar *type, cchar *source, cchar *fmt, va_list args);
 
+/*
+    Log filter generation. Incremented by two whenever the log filter changes. Call sites cache their filter
+    decision as "generation | enabled".
+ */
+PUBLIC_DATA uint rLogFilterGen;
+
+/**
+    Test if a log call site should emit messages and cache the result
+    @description This is used by the rDebug, rError, rInfo and rTrace macros so that filtered log statements
+        do not repeat the type and source lookups performed by rEmitLog. The cached result is valid until the
+        log filter is changed via rSetLogFilter.
+    @param site Call site cache. Set to NULL if the source is not constant so the result is not cached.
+    @param type Log message type string.
+    @param source Log message source.
+    @return True if the message should be logged.
+    @stability Internal
+ */
+PUBLIC bool rEmitLogSite(uint *site, cchar *type, cchar *source);
+
+/*
+    Only call sites with a constant source can cache the filter decision
+ */
+#if __GNUC__
+    #define R_LOG_CONSTANT(source) __builtin_constant_p(source)
+#else
+    #define R_LOG_CONSTANT(source) 0
+#endif
+
+/*
+    Test a call site. A disabled call site with a current cache costs a single comparison.
+ */
+#define R_LOG_SITE(site, type, source) \
+        ((site) != rLogFilterGen && ((site) == (rLogFilterGen | 1) || \
+                                     rEmitLogSite(R_LOG_CONSTANT(source) ? &(site) : NULL, type, source)))
+
+#define R_LOG_CALL(type, source, ...) \
+        do { \
+            static uint _rLogSite = 0; \
+            if (R_LOG_SITE(_rLogSite, type, source)) { \
+                rLog(type, source, __VA_ARGS__); \
+            } \
+        } while (0)
+
 #if DOXYGEN
 /**
     Emit a debug message to the log
@@ -3257,15 +4056,15 @@ PUBLIC void rLog(cchar *source, cchar *fmt, ...);
 
 #else
     #if ME_R_DEBUG_LOGGING
-        #define rDebug(source, ...) rLog("debug", source, __VA_ARGS__)
+        #define rDebug(source, ...) R_LOG_CALL("debug", source, __VA_ARGS__)
     #else
         #define rDebug(source, ...) if (1); else {}
     #endif
     #if R_USE_LOG
-        #define rError(source, ...) rLog("error", source, __VA_ARGS__)
+        #define rError(source, ...) R_LOG_CALL("error", source, __VA_ARGS__)
         #define rFatal(source, ...) if (1) { rLog("error", source, __VA_ARGS__); exit(1); } else
-        #define rInfo(source, ...)  rLog("info", source, __VA_ARGS__)
-        #define rTrace(source, ...) rLog("trace", source, __VA_ARGS__)
+        #define rInfo(source, ...)  R_LOG_CALL("info", source, __VA_ARGS__)
+        #define rTrace(source, ...) R_LOG_CALL("trace", source, __VA_ARGS__)
     #else
         #define rError(source, ...) if (1); else {}
         #define rFatal(source, ...) exit(1)
@@ -3277,11 +4076,15 @@ PUBLIC void rLog(cchar *source, cchar *fmt, ...);
 /**
     Emit an AWS CloudWatch EMF metrics message
     @description It is generally preferable to use CustomMetrics instead of AWS CloudWatch metrics.
-    @param message Prefix message string
+        The message line is followed by a single line EMF JSON document. The values are supplied as
+        (key, type, value) triples terminated by a NULL key. Types "int", "int64" and "double" define metrics.
+        Types "boolean" and "string" define properties, which include the values of the dimensions.
+            rMetrics("Memory", "Ioto", "Tag", NULL, "Tag", "string", "web", "Bytes", "int64", bytes, NULL);
+    @param message Prefix message string. May be NULL.
     @param space Metric namespace
-    @param dimensions Metric dimensions
-    @param values Format string of values
-    @param ... Arguments for values format string
+    @param dimensions Comma separated list of dimension names
+    @param values Reserved. Set to NULL.
+    @param ... Metric and property (key, type, value) triples terminated by a NULL key.
     @stability Evolving
  */
 PUBLIC void rMetrics(cchar *message, cchar *space, cchar *dimensions, cchar *values, ...);
@@ -3346,6 +4149,7 @@ PUBLIC void dump(cchar *msg, uchar *block, size_t len);
                                           WARNING: the name must be persistent for the lifetime of the hash/list. */
 #define R_TEMPORAL_NAME  0x20        /**< Temporal name provided, hash will clone and free */
 #define R_HASH_CASELESS  0x40        /**< Ignore case in comparisons */
+#define R_HASH_INCREMENTAL 0x80      /**< Resize incrementally to avoid latency spikes for large hashes */
 #define R_NAME_MASK      0x38
 #define R_VALUE_MASK     0x7
 #endif
@@ -3363,18 +4167,25 @@ typedef uint (*RHashProc)(cvoid *name, size_t len);
 /**
     Hash table structure.
     @description The hash structure supports growable hash tables collision resistant hashes.
+        Names are stored in a dense array and indexed by an open-addressing table of control bytes and slots.
     @see RName RHashProc RHash rAddName rAddNameFmt rCreateHash
         rGetFirstName rGetHashLength rGetNextName rLookupName rLookupNameEntry
          rRemoveName
     @stability Evolving
  */
 typedef struct RHash {
-    uint numBuckets : 24;            /**< Number of buckets in the first-level hash */
     uint flags : 8;                  /**< Hash control flags */
     uint size;                       /**< Size of allocated names */
     uint length;                     /**< Number of names in the hash */
+    uint capacity;                   /**< Number of table slots (power of two) */
+    uint deleted;                    /**< Number of deleted table slots (tombstones) */
     int free;                        /**< Free list of names */
-    int *buckets;                    /**< Hash collision bucket table */
+    uchar *ctrl;                     /**< Table control bytes. Empty, deleted or 7 bits of the name hash */
+    int *slots;                      /**< Table slots holding indexes into names */
+    uchar *oldCtrl;                  /**< Old table control bytes during an incremental resize */
+    int *oldSlots;                   /**< Old table slots during an incremental resize */
+    uint oldCapacity;                /**< Number of old table slots */
+    uint migrate;                    /**< Next old table slot to migrate */
     struct RName *names;             /**< Hash items */
     RHashProc fn;                    /**< Hash function */
 } RHash;
@@ -3386,9 +4197,10 @@ typedef struct RHash {
 typedef struct RName {
     char *name;                         /**< Hash name */
     void *value;                        /**< Pointer to data */
-    int next : 24;                      /**< Next name in hash chain or next free if on free list */
+    int next : 24;                      /**< Next free name if on free list */
     uint flags : 6;                     /**< Name was allocated */
     uint custom : 2;                    /**< Custom data bits */
+    uint hash;                          /**< Full hash of the name */
 } RName;
 
 /*
@@ -3409,7 +4221,9 @@ typedef struct RName {
         allocated values. Set to R_DYNAMIC_VALUE when providing allocated values that the hash may use, own
         and ultimately free when the hash is free. Set to R_TEMPORAL_VALUE when providing a string value that
         the hash must clone and free. Set to R_HASH_CASELESS for case insensitive matching for names.
-        The default flags is: R_STATIC_NAME | R_STATIC_VALUE.
+        Set R_HASH_INCREMENTAL for large hashes on latency sensitive paths. When the table grows, entries are
+        migrated a few at a time by subsequent operations rather than all at once.
+        The default name and value flags are: R_STATIC_NAME | R_STATIC_VALUE.
     @return Returns a pointer to the allocated hash table.
     @stability Evolving
  */
@@ -3441,7 +4255,8 @@ PUBLIC RHash *rCloneHash(RHash *master);
         use, own and ultimately free when the hash is free. Set flags to R_STATIC_VALUE if providing statically
         allocated values. Set to R_DYNAMIC_VALUE when providing allocated values that the hash may use, own
         and ultimately free when the hash is free. If flags are zero, the flags provided to rAllocHash are used.
-    @return Added RName reference.
+    @return Added RName reference. Returns NULL if the table has reached its maximum size (ME_R_MAX_HASH) or
+        memory cannot be allocated.
     @stability Evolving
  */
 PUBLIC RName *rAddName(RHash *table, cchar *name, void *ptr, int flags);
@@ -3457,7 +4272,8 @@ PUBLIC RName *rAddName(RHash *table, cchar *name, void *ptr, int flags);
         use, own and ultimately free when the hash is free. Set flags to R_STATIC_VALUE if providing statically
         allocated values. Set to R_DYNAMIC_VALUE when providing allocated values that the hash may use, own
         and ultimately free when the hash is free. If flags are zero, the flags provided to rAllocHash are used.
-    @return Added RName reference.
+    @return Added RName reference. Returns NULL if the table has reached its maximum size (ME_R_MAX_HASH) or
+        memory cannot be allocated.
     @stability Evolving
  */
 PUBLIC RName *rAddDuplicateName(RHash *hash, cchar *name, void *ptr, int flags);
@@ -3590,6 +4406,56 @@ PUBLIC RBuf *rHashToJsonBuf(RHash *hash, RBuf *buf, int pretty);
     @stability Evolving
  */
 PUBLIC char *rHashToJson(RHash *hash, int pretty);
+
+/**
+    Intern a string
+    @description Interned strings (atoms) are stored once in a global table and persist until rTerm. Interning
+        the same string again returns the same pointer, so atoms can be compared by pointer equality and
+        may be used as static hash names. Strings longer than ME_R_INTERN_LEN are not interned, nor are
+        strings once the table holds ME_R_INTERN_MAX atoms. Callers should fall back to cloning if NULL
+        is returned.
+    @param str String to intern.
+    @return The interned string or NULL if the string cannot be interned. Caller must not free or modify.
+    @stability Evolving
+ */
+PUBLIC cchar *rIntern(cchar *str);
+
+/**
+    Intern a block of characters
+    @description Same as rIntern but the block does not need to be null terminated.
+    @param str Characters to intern.
+    @param len Length of the block in bytes.
+    @return The interned string or NULL if the block cannot be interned. Caller must not free or modify.
+    @stability Evolving
+ */
+PUBLIC cchar *rInternBlock(cchar *str, size_t len);
+
+/**
+    Lookup an interned string
+    @description Return the atom for a string if it has already been interned. The string is not added
+        to the table.
+    @param str String to lookup.
+    @return The interned string or NULL if not interned.
+    @stability Evolving
+ */
+PUBLIC cchar *rLookupIntern(cchar *str);
+
+/**
+    Get the hash code of an interned string
+    @description The hash is computed once when the string is interned. It is the value returned by
+        shash for the string.
+    @param atom Interned string returned by rIntern, rInternBlock or rLookupIntern.
+    @return The string hash code.
+    @stability Evolving
+ */
+PUBLIC uint rGetInternHash(cchar *atom);
+
+/**
+    Free the interned string table
+    @description Called by rTerm. Atoms must not be used after this call.
+    @stability Internal
+ */
+PUBLIC void rTermIntern(void);
 #endif /* R_USE_HASH */
 
 /************************************ File *************************************/
@@ -3905,6 +4771,16 @@ PUBLIC void rTermOs(void);
  */
 PUBLIC int rDaemonize(void);
 
+/**
+    Fork a worker process
+    @description Fork the current process and prepare the child to run its own event loop. The child re-creates the
+        I/O wait notifier via rResetWait so it does not share kernel wait state with the parent. On Linux, the
+        child receives SIGTERM if the parent exits.
+    @return The child process ID in the parent, zero in the child, or a negative error code.
+    @stability Evolving
+ */
+PUBLIC int rForkWorker(void);
+
 /**
     Get the application name defined via rSetAppName
     @returns the one-word lower case application name defined via rSetAppName
@@ -4078,6 +4954,7 @@ PUBLIC void rTermEvents(void);
 #define R_SOCKET_SERVER          0x8      /**< Socket is on the server-side */
 #define R_SOCKET_FAST_CONNECT    0x10     /**< Fast connect mode */
 #define R_SOCKET_FAST_CLOSE      0x20     /**< Fast close mode */
+#define R_SOCKET_REUSE_PORT      0x40     /**< Listener shares its port with other processes (SO_REUSEPORT) */
 
 #ifndef ME_R_SSL_CACHE
     #define ME_R_SSL_CACHE       512
@@ -4124,6 +5001,24 @@ typedef void (*RSocketCustom)(struct RSocket *sp, int cmd, void *arg, int flags)
  */
 #define R_SOCKET_CONFIG_TLS 1               /**< Custom callback to configure TLS */
 
+/**
+    I/O vector for gathered socket writes
+    @description Describes one block of data for rWriteSocketv. On Unix systems this is the native struct iovec.
+    @stability Evolving
+ */
+#if ME_UNIX_LIKE
+typedef struct iovec RIOVec;
+#else
+typedef struct RIOVec {
+    void *iov_base;                         /**< Start of the block */
+    size_t iov_len;                         /**< Length of the block */
+} RIOVec;
+#endif
+
+#ifndef ME_R_IOV_MAX
+    #define ME_R_IOV_MAX 16                 /**< Maximum number of vectors for rWriteSocketv */
+#endif
+
 typedef struct RSocket {
     Socket fd;                              /**< Actual socket file handle */
     struct Rtls *tls;
@@ -4131,6 +5026,7 @@ typedef struct RSocket {
     uint mask : 4;
     uint hasCert : 1;                       /**< TLS certificate defined */
     int linger;                             /**< Linger timeout in seconds. -1 means no linger. */
+    int shards;                             /**< Reuse-port group size for client address affinity */
     RSocketProc handler;
     void *arg;
     char *error;
@@ -4437,6 +5333,20 @@ PUBLIC void rSetSocketLinger(RSocket *sp, int linger);
  */
 PUBLIC void rSetSocketNoDelay(RSocket *sp, int enable);
 
+/**
+    Share a listening port with other processes
+    @description Set SO_REUSEPORT on a listening socket so that several worker processes may each bind the same
+        endpoint. The kernel then distributes new connections across the listeners. If shards is greater than one
+        (Linux only), the listeners use client address affinity so that a given client IP address is always
+        accepted by the same listener. This keeps per-process state such as sessions consistent for the client.
+        Otherwise, connections are distributed by the kernel connection hash.
+        This API must be called before calling rListenSocket.
+    @param sp Socket object returned from rAllocSocket
+    @param shards Number of listeners in the group for client affinity. Set to zero for connection distribution.
+    @stability Evolving
+ */
+PUBLIC void rSetSocketReusePort(RSocket *sp, int shards);
+
 /**
     Set the socket TLS verification parameters
     @description This call is a wrapper over rSetTlsCerts.
@@ -4500,6 +5410,22 @@ PUBLIC ssize rWriteSocket(RSocket *sp, cvoid *buf, size_t bufsize, Ticks deadlin
  */
 PUBLIC ssize rWriteSocketSync(RSocket *sp, cvoid *buf, size_t len);
 
+/**
+    Write a set of blocks to a socket until a deadline is reached
+    @description Gather-write several blocks with as few system calls as possible. On Unix systems the blocks are
+        written with a single sendmsg where the socket can absorb the data. On TLS connections, small leading
+        blocks are coalesced into a single TLS record. This call will yield the current fiber and resume the
+        main fiber while waiting for the socket to drain.
+    @pre Must be called from a fiber.
+    @param sp Socket object returned from rAllocSocket
+    @param iov Array of blocks to write. Blocks of zero length are skipped. The array is not modified.
+    @param count Number of blocks in iov. Must not exceed ME_R_IOV_MAX.
+    @param deadline System time in ticks to wait until. Set to zero for no deadline.
+    @return The total count of bytes written. Return a negative error code on errors.
+    @stability Evolving
+ */
+PUBLIC ssize rWriteSocketv(RSocket *sp, const RIOVec *iov, int count, Ticks deadline);
+
 #if ME_HAS_SENDFILE
 /**
     Send a file over a socket using zero-copy sendfile.
@@ -4607,6 +5533,52 @@ PUBLIC bool rTryLock(RLock *lock);
  */
 PUBLIC void rMemoryBarrier(void);
 
+/**
+    Atomic compare and swap of a pointer.
+    @description If the value at \a target is equal to \a expected, set it to \a value. This is a full memory barrier.
+    This routine is THREAD SAFE.
+    @param target Address of the pointer to update
+    @param expected Value the pointer is expected to hold
+    @param value New value to store
+    @return True if the pointer held the expected value and was updated.
+    @stability Evolving.
+ */
+PUBLIC bool rAtomicCas(void *volatile *target, void *expected, cvoid *value);
+
+/**
+    Atomic exchange of a pointer.
+    @description Store \a value at \a target and return the prior value. This is a full memory barrier.
+    This routine is THREAD SAFE.
+    @param target Address of the pointer to update
+    @param value New value to store
+    @return The prior value of the pointer.
+    @stability Evolving.
+ */
+PUBLIC void *rAtomicExchange(void *volatile *target, cvoid *value);
+
+/**
+    Atomic add to a 64-bit integer.
+    @description Add \a value to the integer at \a target. This is a full memory barrier.
+    This routine is THREAD SAFE.
+    @param target Address of the integer to update
+    @param value Value to add. May be negative.
+    @return The value of the integer before the add.
+    @stability Evolving.
+ */
+PUBLIC int64 rAtomicAdd64(volatile int64 *target, int64 value);
+
+/**
+    Atomic compare and swap of a 64-bit integer.
+    @description If the integer at \a target is equal to \a expected, set it to \a value. This is a full memory barrier.
+    This routine is THREAD SAFE.
+    @param target Address of the integer to update
+    @param expected Value the integer is expected to hold
+    @param value New value to store
+    @return True if the integer held the expected value and was updated.
+    @stability Evolving.
+ */
+PUBLIC bool rAtomicCas64(volatile int64 *target, int64 expected, int64 value);
+
 /*
     For maximum performance, use the lock/unlock routines macros
  */
@@ -69,6 +69,9 @@ extern "C" {
 #ifndef ME_WEB_UPLOAD
     #define ME_WEB_UPLOAD           1               /**< Enable file upload functionality */
 #endif
+#ifndef ME_WEB_ARCHIVE
+    #define ME_WEB_ARCHIVE          1               /**< Enable serving documents from a packed zip archive */
+#endif
 #ifndef ME_COM_WEBSOCK
     #define ME_COM_WEBSOCK          1               /**< Enable WebSocket protocol support */
 #endif
@@ -92,6 +95,7 @@ extern "C" {
 #define WEB_MAX_SIG         160         /**< Maximum size of controller.method URL portion in API signatures */
 #define WEB_MAX_COOKIE_SIZE 8192        /**< Maximum size of cookie header (security limit) */
 #define WEB_MAX_SIG_DEPTH   16          /**< Maximum recursion depth for signature validation */
+#define WEB_MAX_WORKERS     64          /**< Maximum number of worker processes (web.workers) */
 
 /*
     Dependencies
@@ -104,6 +108,9 @@ extern "C" {
 #ifndef ME_WEB_CONFIG
     #define ME_WEB_CONFIG      "web.json5"     /**< Default configuration file name */
 #endif
+#ifndef ME_WEB_ARENA
+    #define ME_WEB_ARENA       ((size_t) (2 * 1024)) /**< Per-request arena block size */
+#endif
 #ifndef WEB_SESSION_COOKIE
     #define WEB_SESSION_COOKIE "-web-session-" /**< Default session cookie name */
 #endif
@@ -163,6 +170,7 @@ struct Web;
 struct WebAction;
 struct WebHost;
 struct WebRoute;
+struct WebRouteNode;
 struct WebSession;
 struct WebUpload;
 struct WebUser;
@@ -230,6 +238,21 @@ typedef struct WebAction {
     WebProc fn;                         /**< Function to invoke */
 } WebAction;
 
+/**
+    @name Route Method Bits
+    @description Bitmask values for the standard HTTP methods in WebRoute.methodMask and Web.methodMask.
+        Other methods are checked against the WebRoute.methods hash.
+    @{
+ */
+#define WEB_METHOD_DELETE  0x1          /**< DELETE method */
+#define WEB_METHOD_GET     0x2          /**< GET method */
+#define WEB_METHOD_HEAD    0x4          /**< HEAD method */
+#define WEB_METHOD_OPTIONS 0x8          /**< OPTIONS method */
+#define WEB_METHOD_POST    0x10         /**< POST method */
+#define WEB_METHOD_PUT     0x20         /**< PUT method */
+#define WEB_METHOD_TRACE   0x40         /**< TRACE method */
+/** @} */
+
 /**
     Routing object to match a request against a path prefix
     @description Route configuration that defines how incoming HTTP requests are processed.
@@ -244,6 +267,7 @@ typedef struct WebRoute {
     bool validate : 1;                  /**< Validate request */
     bool xsrf : 1;                      /**< Use XSRF tokens */
     RHash *methods;                     /**< HTTP methods verbs */
+    uint methodMask;                    /**< Standard methods in "methods" as WEB_METHOD_* bits */
     cchar *handler;                     /**< Request handler (file, action) */
     cchar *role;                        /**< Required user role or ability */
 #if ME_WEB_HTTP_AUTH
@@ -345,6 +369,11 @@ typedef struct WebHost {
     RHash *mimeTypes;           /**< MIME type mappings indexed by file extension */
     RList *actions;             /**< Ordered list of WebAction objects for URL-to-function bindings */
     RList *routes;              /**< Ordered list of WebRoute objects for request routing */
+    struct WebRouteNode *routeTree; /**< Radix tree of route match patterns compiled from routes */
+    struct WebFileCache *fileCache; /**< Cache of static file metadata and content (web.fileCache) */
+#if ME_WEB_ARCHIVE
+    struct WebArchive *archive; /**< Packed document archive served before the documents directory */
+#endif
     RList *redirects;           /**< Ordered list of WebRedirect objects for URL redirections */
     REvent sessionEvent;        /**< Session timer event */
     int roles;                  /**< Base ID of roles in config */
@@ -365,6 +394,12 @@ typedef struct WebHost {
     int connections;            /**< Current count of active client connections */
     int64 connSequence;         /**< Connection sequence number for per-host connection tracking */
 
+    //  Worker processes sharing the listening endpoints via SO_REUSEPORT
+    int workers;                /**< Number of serving processes including the parent (web.workers) */
+    int *workerPids;            /**< Process IDs of forked workers (parent only) */
+    bool worker : 1;            /**< True if this process is a forked worker */
+    bool clientAffinity : 1;    /**< Route each client address to the same worker (web.workerAffinity) */
+
 #if ME_WEB_HTTP_AUTH
     //  HTTP authentication configuration (Basic/Digest protocols)
     cchar *realm;               /**< Authentication realm (default: host name) */
@@ -424,6 +459,31 @@ typedef struct WebHost {
  */
 PUBLIC void webAddAction(WebHost *host, cchar *prefix, WebProc fn, cchar *role);
 
+/**
+    Action to report event loop health statistics
+    @description This action responds with the event loop statistics collected via rSetEventStats as JSON.
+        This includes loop iteration time, event dispatch lag and fiber run slice histograms in microseconds,
+        the run queue depth and the count of slow handlers. Install with webAddAction and protect with a role.
+        The web command and agent install this action at the "web.stats" URL with the "web.statsRole" role
+        which defaults to "admin".
+    @param web Web request object
+    @stability Evolving
+ */
+PUBLIC void webEventStatsAction(struct Web *web);
+
+#if ME_R_SPAN
+/**
+    Action to report the recorded trace spans
+    @description This action responds with the spans recorded via rStartSpans as Chrome trace-event JSON.
+        Use this to retrieve spans from a running process. Install with webAddAction and protect with a role.
+        The web command and agent install this action at the "web.spans" URL with the "web.spansRole" role
+        which defaults to "admin".
+    @param web Web request object
+    @stability Evolving
+ */
+PUBLIC void webSpansAction(struct Web *web);
+#endif
+
 /**
  * @name Debug Tracing Flags
  * @description Flags for webAllocHost() to control debug tracing output.
@@ -460,6 +520,37 @@ PUBLIC WebHost *webAllocHost(Json *config, int flags);
  */
 PUBLIC void webFreeHost(WebHost *host);
 
+/**
+    Flush the static file cache for a host
+    @description Discard all cached file metadata and content so that subsequent requests read the files from disk.
+        The cache is enabled via the web.fileCache.enable property in the host configuration. Cached files are
+        checked for changes every web.fileCache.lifespan and files modified via PUT or DELETE requests are
+        discarded immediately. Call this after updating the documents directory by other means.
+    @param host Web host object
+    @stability Evolving
+ */
+PUBLIC void webFlushFileCache(WebHost *host);
+
+#if ME_WEB_ARCHIVE
+/**
+    Mount a packed document archive for a host
+    @description Serve documents from a zip archive without extracting it. The archive is memory mapped and its
+        central directory is indexed when mounted so requests are served directly from the mapping without
+        accessing the file system. Archive documents are served before the documents directory which continues
+        to serve requests for documents not in the archive. Pre-compressed variants stored in the archive with
+        ".br" and ".gz" extensions are served to clients that accept them on routes with "compressed" enabled.
+        Entries must be stored without compression (zip -0). Compressed entries are ignored.
+        Any previously mounted archive is unmounted. The archive is mounted when the host is allocated if the
+        web.archive.path property is defined in the host configuration.
+    @param host Web host object
+    @param path Zip archive file path
+    @param root Archive directory to serve as the document root. Set to NULL or "" to serve the entire archive.
+    @return Zero if successful, otherwise a negative error code.
+    @stability Evolving
+ */
+PUBLIC int webMountArchive(WebHost *host, cchar *path, cchar *root);
+#endif
+
 /**
     Get the web documents directory for a host
     @description Retrieve the document root directory path where static files are served from.
@@ -471,6 +562,19 @@ PUBLIC void webFreeHost(WebHost *host);
 
 PUBLIC cchar *webGetDocs(WebHost *host);
 
+/**
+    Find the route for a request path
+    @description Routes are matched in configuration order and the first matching route is selected. Routes with a
+        trailing "/" (or an empty match) match any path that starts with the route pattern. Other routes must
+        match the path exactly. Routes are compiled into a radix tree so the cost of matching depends on the
+        length of the path and not the number of routes. The request method is not considered.
+    @param host Web host object
+    @param path Request URL path
+    @return The matching route or NULL if no route matches
+    @stability Evolving
+ */
+PUBLIC WebRoute *webMatchRoute(WebHost *host, cchar *path);
+
 /**
     Set the default IP address for the host
     @description Configure the default IP address to use in redirects and URL generation
@@ -486,6 +590,14 @@ PUBLIC void webSetHostDefaultIP(WebHost *host, cchar *ip);
     @description Begin accepting HTTP connections on all configured listening endpoints.
         This creates socket listeners based on the host configuration and starts the request
         processing loop. The function will block until webStopHost() is called.
+        If "web.workers" is set to a count greater than one (or "auto" for one per CPU core), the host forks
+        worker processes before listening. Each process runs its own event loop and binds the listening
+        endpoints with SO_REUSEPORT so the kernel spreads connections across the processes. Routes, users and
+        configuration are read-only copies in each worker. Sessions are held per worker, so by default
+        "web.workerAffinity" is "client" and each client address is served by the same worker (Linux). Set it to
+        "connection" to distribute every connection independently. Workers are supported on Unix-like systems
+        and are intended for dedicated web servers such as the standalone "web" command. The Ioto agent rejects
+        "web.workers" as forking would duplicate its database, MQTT and timer services.
     @pre Must only be called from a fiber
     @param host Web host object to start
     @return Zero if successful, otherwise a negative error code
@@ -550,6 +662,40 @@ PUBLIC int webProcessUpload(struct Web *web);
 #define WEB_HOOK_END        10 /**< End of request processing */
 /** @} */
 
+/**
+ * @name Well-Known Request Headers
+ * @description Header identifiers for webGetHeaderId. These headers are indexed when the request headers
+ *     are parsed so they can be retrieved without scanning the headers.
+ * @{
+ */
+#define WEB_HDR_ACCEPT                 0  /**< Accept */
+#define WEB_HDR_ACCEPT_ENCODING        1  /**< Accept-Encoding */
+#define WEB_HDR_AUTHORIZATION          2  /**< Authorization */
+#define WEB_HDR_CONNECTION             3  /**< Connection */
+#define WEB_HDR_CONTENT_DISPOSITION    4  /**< Content-Disposition */
+#define WEB_HDR_CONTENT_LENGTH         5  /**< Content-Length */
+#define WEB_HDR_CONTENT_TYPE           6  /**< Content-Type */
+#define WEB_HDR_COOKIE                 7  /**< Cookie */
+#define WEB_HDR_HOST                   8  /**< Host */
+#define WEB_HDR_IF_MATCH               9  /**< If-Match */
+#define WEB_HDR_IF_MODIFIED_SINCE      10 /**< If-Modified-Since */
+#define WEB_HDR_IF_NONE_MATCH          11 /**< If-None-Match */
+#define WEB_HDR_IF_RANGE               12 /**< If-Range */
+#define WEB_HDR_IF_UNMODIFIED_SINCE    13 /**< If-Unmodified-Since */
+#define WEB_HDR_LAST_EVENT_ID          14 /**< Last-Event-ID */
+#define WEB_HDR_ORIGIN                 15 /**< Origin */
+#define WEB_HDR_RANGE                  16 /**< Range */
+#define WEB_HDR_REFERER                17 /**< Referer */
+#define WEB_HDR_SEC_WEBSOCKET_KEY      18 /**< Sec-WebSocket-Key */
+#define WEB_HDR_SEC_WEBSOCKET_PROTOCOL 19 /**< Sec-WebSocket-Protocol */
+#define WEB_HDR_SEC_WEBSOCKET_VERSION  20 /**< Sec-WebSocket-Version */
+#define WEB_HDR_TRANSFER_ENCODING      21 /**< Transfer-Encoding */
+#define WEB_HDR_UPGRADE                22 /**< Upgrade */
+#define WEB_HDR_USER_AGENT             23 /**< User-Agent */
+#define WEB_HDR_XSRF_TOKEN             24 /**< X-XSRF-TOKEN */
+#define WEB_HDR_MAX                    25 /**< Count of well-known headers */
+/** @} */
+
 typedef struct WebListen {
     RSocket *sock;             /**< Socket */
     char *endpoint;            /**< Endpoint definition */
@@ -590,6 +736,7 @@ typedef struct Web {
     uint authenticated : 1;     /**< User authenticated and roleId defined */
     uint authChecked : 1;       /**< Authentication has been checked */
     uint close : 1;             /**< Should the connection be closed after the request completes */
+    uint eventStream : 1;       /**< Is the response a Server-Sent Events (SSE) stream */
     uint exists : 1;            /**< Does the requested resource exist */
     uint finalized : 1;         /**< The response has been finalized */
     uint formBody : 1;          /**< Is the current request a POSTed form */
@@ -608,6 +755,7 @@ typedef struct Web {
     uint post : 1;              /**< Is the current request a POST request */
     uint put : 1;               /**< Is the current request a PUT request */
     uint trace : 1;             /**< Is the current request a TRACE request */
+    uint methodMask : 7;        /**< Request method as a WEB_METHOD_* bit. Zero for other methods */
 
     uint ifModified:1;          /**< If-Modified-Since header was present */
     uint ifUnmodified:1;        /**< If-Unmodified-Since header was present */
@@ -630,7 +778,10 @@ typedef struct Web {
     Ticks deadline;             /**< Timeout deadline for when the next I/O must complete */
 
     RBuf *rxHeaders;            /**< Request received headers */
+    cchar *rxHeaderIndex[WEB_HDR_MAX]; /**< Values of the well-known request headers indexed by WEB_HDR_* */
+    RHash *rxHeaderHash;        /**< Other request headers. Created on the first lookup of such a header */
     RHash *txHeaders;           /**< Output headers */
+    RArena *arena;              /**< Request-scoped memory arena. Reset when the request completes */
 
     //  Parsed request
     cchar *contentType;         /**< Receive content type header value */
@@ -753,6 +904,18 @@ PUBLIC void webAddHeaderDynamicString(Web *web, cchar *key, char *value);
  */
 PUBLIC void webAddAccessControlHeader(Web *web);
 
+/**
+    Allocate request-scoped memory
+    @description Allocate memory from the request arena. The memory is released automatically when the
+        request completes, including between keep-alive requests on the same connection. Do not free it via rFree
+        and do not retain references beyond the request.
+    @param web Web request object
+    @param size Size of memory to allocate
+    @return Pointer to the memory block. The memory is not zeroed.
+    @stability Evolving
+ */
+PUBLIC void *webAllocMem(Web *web, size_t size);
+
 /**
     Buffer the response body
     @description Enable response buffering to improve performance and allow automatic
@@ -779,6 +942,17 @@ PUBLIC void webBuffer(Web *web, size_t size);
  */
 PUBLIC ssize webBufferUntil(Web *web, cchar *until, size_t limit);
 
+/**
+    Clone a string into request-scoped memory
+    @description The string is allocated from the request arena and released automatically when the request
+        completes. Do not free it via rFree.
+    @param web Web request object
+    @param str String to clone. If NULL, an empty string is returned.
+    @return Cloned string
+    @stability Evolving
+ */
+PUBLIC char *webClone(Web *web, cchar *str);
+
 /**
     Respond to the request with an error
     @description Generate a complete HTTP error response with the specified status code and message.
@@ -818,6 +992,18 @@ PUBLIC void webExtendTimeout(Web *web, Ticks timeout);
  */
 PUBLIC ssize webFinalize(Web *web);
 
+/**
+    Format a string into request-scoped memory
+    @description The string is allocated from the request arena and released automatically when the request
+        completes. Do not free it via rFree.
+    @param web Web request object
+    @param fmt Printf-style format string
+    @param ... Arguments for the format string
+    @return Formatted string
+    @stability Evolving
+ */
+PUBLIC char *webFmt(Web *web, cchar *fmt, ...) PRINTF_ATTRIBUTE(2, 3);
+
 /**
     Get a request cookie value
     @description Extract a specific cookie value from the request Cookie header.
@@ -832,7 +1018,8 @@ PUBLIC char *webGetCookie(Web *web, cchar *name);
 /**
     Get a request header value
     @description Retrieve the value of a specific HTTP request header. Header name
-        matching is case-insensitive per HTTP standards.
+        matching is case-insensitive per HTTP standards. If a header is repeated, the first value is returned.
+        Internal callers should use webGetHeaderId for the well-known headers.
     @param web Web request object
     @param key HTTP header name (case-insensitive)
     @return Header value string, or NULL if header not found
@@ -840,6 +1027,18 @@ PUBLIC char *webGetCookie(Web *web, cchar *name);
  */
 PUBLIC cchar *webGetHeader(Web *web, cchar *key);
 
+/**
+    Get a well-known request header value
+    @description Retrieve the value of a request header by its WEB_HDR_* identifier. The well-known headers
+        are indexed when the request headers are parsed so this does not search the headers.
+        If a header is repeated, the first value is returned.
+    @param web Web request object
+    @param id Header identifier. Set to a WEB_HDR_* value. For example: WEB_HDR_RANGE.
+    @return Header value string, or NULL if header not found
+    @stability Evolving
+ */
+PUBLIC cchar *webGetHeaderId(Web *web, int id);
+
 /**
     Get the next request header in sequence
     @description Iterate through all HTTP request headers. Call repeatedly to enumerate
@@ -1259,7 +1458,12 @@ PUBLIC bool webCheckSignature(Web *web, Json *json, int nid, JsonNode *signature
 PUBLIC int webConsumeInput(Web *web);
 PUBLIC int webFileHandler(Web *web);
 PUBLIC void webFree(Web *web);
+#if ME_WEB_ARCHIVE
+PUBLIC void webFreeArchive(WebHost *host);
+#endif
+PUBLIC void webFreeFileCache(WebHost *host);
 PUBLIC void webFreeRanges(Web *web);
+PUBLIC void webInitFileCache(WebHost *host);
 PUBLIC void webClose(Web *web);
 PUBLIC void webParseForm(Web *web);
 PUBLIC void webParseQuery(Web *web);
@@ -1607,6 +1811,17 @@ PUBLIC int webUpgradeSocket(Web *web);
  */
 PUBLIC char *webHttpDate(time_t when);
 
+/**
+    Format a time as an HTTP date string into a buffer
+    @description Non-allocating form of webHttpDate.
+    @param buf Buffer to hold the date. Should be at least 32 bytes.
+    @param bufsize Size of the buffer
+    @param when Unix timestamp to convert
+    @return The buffer or NULL if the time cannot be formatted.
+    @stability Evolving
+ */
+PUBLIC char *webFormatHttpDate(char *buf, size_t bufsize, time_t when);
+
 /**
     Check if currentEtag matches any ETag in If-Match or If-None-Match list
     @description Compares the current resource ETag against the list of ETags
@@ -71,11 +71,14 @@ typedef struct DbChange {
 
 #define USER_ALLOC 0x1        /* User allocated json */
 
+static RPool *itemPool;         /* Pool for DbItem objects */
+
 /************************************ Forwards *********************************/
 
 static void addContext(Db *db, Json *props);
 static DbChange *allocChange(Db *db, DbModel *model, DbItem *item, DbParams *params, cchar *cmd,
                              Ticks due);
+static void addField(DbModel *model, cchar *name, DbField *field);
 static DbField *allocField(Db *db, cchar *name, Json *json, int fid);
 static DbItem *allocItem(cchar *name, Json *json, char *value);
 static DbModel *allocModel(Db *db, cchar *name, cchar *sync, Time delay);
@@ -91,6 +94,7 @@ static void freeChange(Db *db, DbChange *change);
 static void freeField(DbField *field);
 static void freeModel(DbModel *model);
 static void freeItem(Db *db, DbItem *node);
+static RbNode *insertItem(RbTree *index, DbItem *item);
 static int flushJournal(Db *db);
 static RbTree *getIndex(Db *db, DbParams *params);
 static cchar *getIndexName(Db *db, DbParams *params);
@@ -104,6 +108,7 @@ static int loadData(Db *db, cchar *path);
 static int loadIndexes(Db *db);
 static int loadModels(Db *db, Json *json);
 static int loadSchema(Db *db, cchar *schema);
+static Db *openDb(cchar *path, cchar *schema, int flags);
 static cchar *readBlock(Db *db, FILE *fp, RBuf *buf);
 static size_t readSize(FILE *fp);
 static int readItem(FILE *fp, DbItem **item);
@@ -116,6 +121,7 @@ static void setTimestamps(DbModel *model, Json *props, cchar *cmd);
 static Json *toJson(DbItem *item);
 static int writeBlock(Db *db, cchar *buf);
 static int writeChangeToJournal(Db *db, DbModel *model, DbItem *item, cchar *cmd);
+static int writeDatabase(Db *db, cchar *path);
 static int writeItem(FILE *fp, DbItem *item);
 static int writeSize(Db *db, uint32_t len);
 
@@ -125,6 +131,17 @@ static int writeSize(Db *db, uint32_t len);
     Schema defines the data model
  */
 PUBLIC Db *dbOpen(cchar *path, cchar *schema, int flags)
+{
+    Db  *db;
+    int tag;
+
+    tag = rSetMemTag(R_MEM_DB);
+    db = openDb(path, schema, flags);
+    rSetMemTag(tag);
+    return db;
+}
+
+static Db *openDb(cchar *path, cchar *schema, int flags)
 {
     Db  *db;
     int count;
@@ -365,7 +382,7 @@ static int loadModels(Db *db, Json *json)
             if (!model->expiresField) {
                 model->expiresField = field->ttl ? field->name : NULL;
             }
-            rAddName(model->fields, fp->name, field, R_TEMPORAL_NAME | R_STATIC_VALUE);
+            addField(model, fp->name, field);
         }
         if (model->sync) {
             if (!rLookupName(model->fields, "updated")) {
@@ -421,7 +438,7 @@ static int loadData(Db *db, cchar *path)
             if (!item) {
                 break;
             }
-            rbInsert(db->primary, item);
+            insertItem(db->primary, item);
         }
         fclose(fp);
     }
@@ -432,6 +449,17 @@ static int loadData(Db *db, cchar *path)
     Save the database to persistent store in binary (non-portable) form.
  */
 PUBLIC int dbSave(Db *db, cchar *path)
+{
+    uint64 span;
+    int    rc;
+
+    span = rSpanBegin("db", "save");
+    rc = writeDatabase(db, path);
+    rSpanEnd(span);
+    return rc;
+}
+
+static int writeDatabase(Db *db, cchar *path)
 {
     RbTree *rbt;
     RbNode *rp;
@@ -686,7 +714,7 @@ PUBLIC const DbItem *dbCreate(Db *db, cchar *modelName, Json *props, DbParams *p
     item = allocItem(env.search.key, env.props, 0);
     env.props = 0;
 
-    rbInsert(env.index, item);
+    insertItem(env.index, item);
     change(db, env.model, item, params, env.params->upsert ? "upsert" : "create");
 
     if (env.params->log) {
@@ -1046,7 +1074,7 @@ PUBLIC const DbItem *dbSetField(Db *db, cchar *modelName, cchar *fieldName, ccha
         if (env.params->upsert) {
             setTimestamps(env.model, env.props, "update");
             item = allocItem(env.search.key, env.props, 0);
-            rbInsert(env.index, item);
+            insertItem(env.index, item);
         } else {
             dberror(db, R_ERR_NOT_READY, "Cannot set field, item does not exist");
             freeEnv(&env);
@@ -1112,6 +1140,7 @@ PUBLIC const DbItem *dbUpdate(Db *db, cchar *modelName, Json *props, DbParams *p
     Env    env;
     RbNode *rp;
     DbItem *item;
+    uint64 span;
 
     if (!db) {
         return NULL;
@@ -1120,7 +1149,9 @@ PUBLIC const DbItem *dbUpdate(Db *db, cchar *modelName, Json *props, DbParams *p
         dberror(db, R_ERR_BAD_ARGS, "Cannot update, bad properties");
         return 0;
     }
+    span = rSpanBegin("db", "update");
     if (SETUP(db, modelName, props, params, "update", &env) < 0) {
+        rSpanEnd(span);
         return 0;
     }
     item = 0;
@@ -1147,14 +1178,16 @@ PUBLIC const DbItem *dbUpdate(Db *db, cchar *modelName, Json *props, DbParams *p
         if (!env.params->upsert) {
             dberror(db, R_ERR_CANT_FIND, "Cannot update, item does not exist");
             freeEnv(&env);
+            rSpanEnd(span);
             return 0;
         }
         if ((item = allocItem(env.search.key, env.props, 0)) != 0) {
-            rbInsert(env.index, item);
+            insertItem(env.index, item);
         }
     }
     change(db, env.model, item, params, env.params->upsert ? "upsert" : "update");
     freeEnv(&env);
+    rSpanEnd(span);
     return item;
 }
 
@@ -1592,7 +1625,7 @@ static DbModel *allocModel(Db *db, cchar *name, cchar *sync, Time delay)
     field = rAllocType(DbField);
     field->name = sclone(name);
     field->hidden = 1;
-    rAddName(model->fields, db->type, field, R_TEMPORAL_NAME | R_STATIC_VALUE);
+    addField(model, db->type, field);
 
     rAddName(db->models, model->name, model, 0);
     return model;
@@ -1660,6 +1693,20 @@ static DbField *allocField(Db *db, cchar *name, Json *json, int fid)
     return field;
 }
 
+/*
+    Add a field to the model. Field names are interned so properties with interned names match by pointer.
+ */
+static void addField(DbModel *model, cchar *name, DbField *field)
+{
+    cchar *atom;
+
+    if ((atom = rIntern(name)) != 0) {
+        rAddName(model->fields, atom, field, R_STATIC_NAME | R_STATIC_VALUE);
+    } else {
+        rAddName(model->fields, name, field, R_TEMPORAL_NAME | R_STATIC_VALUE);
+    }
+}
+
 static void freeField(DbField *field)
 {
     if (field) {
@@ -1677,10 +1724,15 @@ static void freeField(DbField *field)
 static DbItem *allocItem(cchar *key, Json *json, char *value)
 {
     DbItem *item;
+    int    tag;
 
-    if ((item = rAllocType(DbItem)) == 0) {
+    if (!itemPool) {
+        itemPool = rAllocPool(sizeof(DbItem));
+    }
+    if ((item = rAllocFromPool(itemPool)) == 0) {
         return 0;
     }
+    tag = rSetMemTag(R_MEM_DB);
     if (json) {
         if (json->userFlags & USER_ALLOC) {
             //  Cleanup before insertion into the RB tree
@@ -1699,9 +1751,24 @@ static DbItem *allocItem(cchar *key, Json *json, char *value)
     }
     item->key = sclone(key);
     item->allocatedName = 1;
+    rSetMemTag(tag);
     return item;
 }
 
+/*
+    Insert an item into an index. The tree node is charged to the database memory tag.
+ */
+static RbNode *insertItem(RbTree *index, DbItem *item)
+{
+    RbNode *node;
+    int    tag;
+
+    tag = rSetMemTag(R_MEM_DB);
+    node = rbInsert(index, item);
+    rSetMemTag(tag);
+    return node;
+}
+
 static void freeItem(Db *db, DbItem *item)
 {
     if (!item) return;
@@ -1711,7 +1778,7 @@ static void freeItem(Db *db, DbItem *item)
         item->key = 0;
     }
     clearItem(item);
-    rFree(item);
+    rFreeToPool(itemPool, item);
 }
 
 static void clearItem(DbItem *item)
@@ -1988,12 +2055,15 @@ static void commitChange(Db *db)
  */
 static int writeChangeToJournal(Db *db, DbModel *model, DbItem *item, cchar *cmd)
 {
-    char *value;
-    int  bufsize;
+    char   *value;
+    uint64 flushSpan, span;
+    int    bufsize, rc;
 
     //  Journal will be unset when booting and applying prior journal
     if (!db->journal) return 0;
 
+    span = rSpanBegin("db", "journal");
+
     /*
         Compute the size of the change record as three null terminated strings.
         The string lengths are not read into the buffer.
@@ -2011,11 +2081,15 @@ static int writeChangeToJournal(Db *db, DbModel *model, DbItem *item, cchar *cmd
     if (value != item->value) {
         rFree(value);
     }
+    flushSpan = rSpanBegin("db", "flush");
     if (fflush(db->journal) < 0 || rFlushFile(fileno(db->journal)) < 0) {
         dberror(db, R_ERR_CANT_WRITE, "Cannot flush journal: %d", errno);
         db->journalError = 1;
     }
-    return flushJournal(db);
+    rSpanEnd(flushSpan);
+    rc = flushJournal(db);
+    rSpanEnd(span);
+    return rc;
 }
 
 static int flushJournal(Db *db)
@@ -2425,8 +2499,11 @@ static DbChange *allocChange(Db *db, DbModel *model, DbItem *item, DbParams *par
                              Ticks due)
 {
     DbChange *change;
+    int      tag;
 
+    tag = rSetMemTag(R_MEM_DB);
     if ((change = rAllocType(DbChange)) == 0) {
+        rSetMemTag(tag);
         return 0;
     }
     change->db = db;
@@ -2436,6 +2513,7 @@ static DbChange *allocChange(Db *db, DbModel *model, DbItem *item, DbParams *par
     change->due = due;
     change->key = sclone(item->key);
     rAddName(db->changes, item->key, change, 0);
+    rSetMemTag(tag);
     return change;
 }
 
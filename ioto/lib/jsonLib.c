@@ -66,11 +66,13 @@ static int indentLevel = JSON_DEFAULT_INDENT;  // Indentation spaces per level
 
 static JsonNode *allocNode(Json *json, int type, cchar *name, cchar *value);
 static int blendRecurse(Json *dest, int did, cchar *dkey, const Json *csrc, int sid, cchar *skey, int flags, int depth);
+static cchar *cloneName(cchar *name, int *allocated);
 static void compactProperties(RBuf *buf, char *sol, int indent);
 static char *copyProperty(Json *json, cchar *key);
 static int expandValue(const Json *json, RBuf *buf, cchar *key, int indent, int flags);
 static void freeNode(JsonNode *node);
 static bool isfnumber(cchar *s, size_t len);
+static char *jclone(cchar *str);
 static int jerror(Json *json, cchar *fmt, ...);
 static int jquery(Json *json, int nid, cchar *key, cchar *value, int type);
 static int nodeToString(const Json *json, int nid, int indent, int flags, RBuf *buf);
@@ -84,15 +86,32 @@ static void spaces(RBuf *buf, int count);
 PUBLIC Json *jsonAlloc(void)
 {
     Json *json;
+    int  tag;
 
+    tag = rSetMemTag(R_MEM_JSON);
     json = rAllocType(Json);
     json->lineNumber = 1;
     json->lock = 0;
     json->size = ME_JSON_INC;
     json->nodes = rAlloc(sizeof(JsonNode) * (size_t) json->size);
+    rSetMemTag(tag);
     return json;
 }
 
+/*
+    Clone a string charged to the JSON memory tag. Resized node arrays keep the tag of the initial allocation.
+ */
+static char *jclone(cchar *str)
+{
+    char *result;
+    int  tag;
+
+    tag = rSetMemTag(R_MEM_JSON);
+    result = sclone(str);
+    rSetMemTag(tag);
+    return result;
+}
+
 PUBLIC void jsonFree(Json *json)
 {
     JsonNode *node;
@@ -184,6 +203,22 @@ static void initNode(Json *json, int nid)
 #endif
 }
 
+/*
+    Copy a property name. Names are interned where possible so repeated names share one copy.
+    Sets *allocated if the name was cloned and must be freed.
+ */
+static cchar *cloneName(cchar *name, int *allocated)
+{
+    cchar *atom;
+
+    if ((atom = rIntern(name)) != 0) {
+        *allocated = 0;
+        return atom;
+    }
+    *allocated = 1;
+    return jclone(name);
+}
+
 /*
     Set the name and value of a node.
  */
@@ -206,10 +241,10 @@ static void setNode(Json *json, int nid, int type, cchar *name, int allocatedNam
         node->name = 0;
 
         if (name) {
-            node->allocatedName = (uint) allocatedName;
             if (allocatedName) {
-                name = sclone(name);
+                name = cloneName(name, &allocatedName);
             }
+            node->allocatedName = (uint) allocatedName;
             node->name = (char*) name;
         }
     }
@@ -229,7 +264,7 @@ static void setNode(Json *json, int nid, int type, cchar *name, int allocatedNam
         if (value) {
             node->allocatedValue = (uint) allocatedValue;
             if (allocatedValue) {
-                value = sclone(value);
+                value = jclone(value);
             }
             node->value = (char*) value;
         }
@@ -257,7 +292,7 @@ static JsonNode *allocNode(Json *json, int type, cchar *name, cchar *value)
 static void copyNodes(Json *dest, int did, Json *src, int sid, int slen)
 {
     JsonNode *dp, *sp;
-    int      i;
+    int      allocated, i;
 
     if (!dest || !src || did < 0 || did >= dest->count || sid < 0 || sid >= src->count) {
         return;
@@ -273,10 +308,12 @@ static void copyNodes(Json *dest, int did, Json *src, int sid, int slen)
             rFree(dp->value);
         }
         *dp = *sp;
-        if ((dp->name = sclone(sp->name)) != 0) {
-            dp->allocatedName = 1;
+        dp->allocatedName = 0;
+        if (sp->name) {
+            dp->name = (char*) cloneName(sp->name, &allocated);
+            dp->allocatedName = (uint) allocated;
         }
-        if ((dp->value = sclone(sp->value)) != 0) {
+        if ((dp->value = jclone(sp->value)) != 0) {
             dp->allocatedValue = 1;
         }
         dp->last = did + sp->last - sid;
@@ -381,7 +418,7 @@ PUBLIC Json *jsonParse(cchar *ctext, int flags)
     char *text;
 
     json = jsonAlloc();
-    text = sclone(ctext);
+    text = jclone(ctext);
     if (jsonParseText(json, text, flags) < 0) {
         jsonFree(json);
         return 0;
@@ -478,7 +515,7 @@ PUBLIC Json *jsonParseString(cchar *atext, char **error, int flags)
         *error = 0;
     }
     json = jsonAlloc();
-    text = sclone(atext);
+    text = jclone(atext);
 
     if (jsonParseText(json, text, flags) < 0) {
         if (error) {
@@ -514,7 +551,7 @@ PUBLIC Json *jsonParseFile(cchar *path, char **error, int flags)
     }
     json = jsonAlloc();
     if (path) {
-        json->path = sclone(path);
+        json->path = jclone(path);
     }
     if (jsonParseText(json, text, flags) < 0) {
         if (error) {
@@ -1524,7 +1561,7 @@ PUBLIC void jsonSetNodeValue(JsonNode *node, cchar *value, int type, int flags)
     if (flags & JSON_PASS_VALUE) {
         node->value = (char*) value;
     } else {
-        node->value = sclone(value);
+        node->value = jclone(value);
     }
     node->allocatedValue = 1;
     node->type = (uint) type;
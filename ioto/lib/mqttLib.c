@@ -70,6 +70,9 @@ static cchar *packetTypes[] = {
 
 #define MQTT_BITFIELD_RULE_VIOLOATION(bitfield, rule_value, rule_mask) ((bitfield ^ rule_value)&rule_mask)
 
+static RPool *msgPool;          /* Pool for MqttMsg objects */
+static RPool *recvPool;         /* Pool for MqttRecv argument blocks */
+
 struct {
     cuchar typeIsValid[16];
     cuchar requiredFlags[16];
@@ -137,6 +140,7 @@ struct {
 /*********************************** Forwards *********************************/
 
 static MqttMsg *allocMsg(Mqtt *mq, uint type, int id, size_t size);
+static Mqtt *allocMqtt(cchar *clientId, MqttEventProc proc);
 static MqttTopic *allocTopic(Mqtt *mq, MqttCallback callback, cchar *topic, MqttWaitFlags wait);
 static void dequeueMsg(Mqtt *mq, MqttMsg *msg);
 static MqttMsg *findMsg(Mqtt *mq, MqttPacketType type, int id);
@@ -185,6 +189,17 @@ static int waitUntil(Mqtt *mq, MqttMsg *msg, MqttWaitFlags state);
 /************************************* Code ***********************************/
 
 PUBLIC Mqtt *mqttAlloc(cchar *clientId, MqttEventProc proc)
+{
+    Mqtt *mq;
+    int  tag;
+
+    tag = rSetMemTag(R_MEM_MQTT);
+    mq = allocMqtt(clientId, proc);
+    rSetMemTag(tag);
+    return mq;
+}
+
+static Mqtt *allocMqtt(cchar *clientId, MqttEventProc proc)
 {
     Mqtt *mq;
 
@@ -582,6 +597,8 @@ PUBLIC int mqttPublish(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, MqttWaitFl
     va_list ap;
     char    topicBuf[MQTT_MAX_TOPIC_SIZE];
     ssize   len;
+    uint64  span;
+    int     rc;
 
     if (mq == 0) {
         rTrace("mqtt", "Publish on bad Mqtt object");
@@ -606,7 +623,10 @@ PUBLIC int mqttPublish(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, MqttWaitFl
         rTrace("mqtt", "Bad topic");
         return R_ERR_BAD_ARGS;
     }
-    return publish(mq, buf, bufsize, qos, wait, 0, topicBuf);
+    span = rSpanBegin("mqtt", "publish");
+    rc = publish(mq, buf, bufsize, qos, wait, 0, topicBuf);
+    rSpanEnd(span);
+    return rc;
 }
 
 PUBLIC int mqttPublishRetained(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, MqttWaitFlags wait, cchar *topic, ...)
@@ -614,6 +634,8 @@ PUBLIC int mqttPublishRetained(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, Mq
     va_list ap;
     char    topicBuf[MQTT_MAX_TOPIC_SIZE];
     ssize   len;
+    uint64  span;
+    int     rc;
 
     if (mq == 0) {
         rTrace("mqtt", "Publish on bad Mqtt object");
@@ -634,7 +656,10 @@ PUBLIC int mqttPublishRetained(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, Mq
         rTrace("mqtt", "Topic is too big");
         return R_ERR_BAD_ARGS;
     }
-    return publish(mq, buf, bufsize, qos, wait, MQTT_RETAIN, topicBuf);
+    span = rSpanBegin("mqtt", "publish");
+    rc = publish(mq, buf, bufsize, qos, wait, MQTT_RETAIN, topicBuf);
+    rSpanEnd(span);
+    return rc;
 }
 
 static int publish(Mqtt *mq, cvoid *buf, size_t bufsize, int qos, MqttWaitFlags wait, int retain, cchar *topic)
@@ -1194,6 +1219,7 @@ static int recvMsgs(Mqtt *mq)
     RBuf     *buf;
     ssize    bytes;
     size_t   space;
+    uint64   span;
     int      consumed;
 
     if (!mq) {
@@ -1238,7 +1264,9 @@ static int recvMsgs(Mqtt *mq)
         //  Add a null helps debugging. Not required as dataSize determines data length.
         rAddNullToBuf(buf);
 
+        span = rSpanBegin("mqtt", "receive");
         processRecvMsg(mq, &recv);
+        rSpanEnd(span);
     }
     return mq->error;
 }
@@ -1328,14 +1356,17 @@ static int processRecvMsg(Mqtt *mq, MqttRecv *rp)
                     to the fiber/callback. Allocate the topic here as it is not null terminated in the header
                     incomingMsg will free it.
                  */
-                arg = rAllocType(MqttRecv);
+                if (!recvPool) {
+                    recvPool = rAllocPool(sizeof(MqttRecv));
+                }
+                arg = rAllocFromPool(recvPool);
                 memcpy(arg, rp, sizeof(MqttRecv));
                 arg->topic = rAlloc(rp->topicSize + 1);
                 sncopy(arg->topic, rp->topicSize + 1, (char*) rp->topic, rp->topicSize);
                 if (rp->dataSize > 0) {
                     if ((arg->data = rAlloc(rp->dataSize + 1)) == 0) {
                         rFree(arg->topic);
-                        rFree(arg);
+                        rFreeToPool(recvPool, arg);
                         break;
                     }
                     memcpy(arg->data, rp->data, rp->dataSize);
@@ -1477,7 +1508,7 @@ static void incomingMsg(MqttRecv *rp)
     //  This was allocated in processRecvMsg
     rFree(rp->topic);
     rFree(rp->data);
-    rFree(rp);
+    rFreeToPool(recvPool, rp);
     mq->fiberCount--;
 }
 
@@ -1731,6 +1762,7 @@ static int packHdr(Mqtt *mq, uchar *start, MqttHdr *hdr)
 static MqttMsg *allocMsg(Mqtt *mq, uint type, int id, size_t size)
 {
     MqttMsg *msg;
+    int     tag;
 
     // Reject negative and oversized sizes before adding header slack
     if (size < 0) {
@@ -1740,7 +1772,10 @@ static MqttMsg *allocMsg(Mqtt *mq, uint type, int id, size_t size)
         // Message too big (would overflow when adding header slack)
         return NULL;
     }
-    if ((msg = rAllocType(MqttMsg)) == NULL) {
+    if (!msgPool) {
+        msgPool = rAllocPool(sizeof(MqttMsg));
+    }
+    if ((msg = rAllocFromPool(msgPool)) == NULL) {
         return NULL;
     }
     //  Fixed header is 5 bytes. So reserve 7 bytes for safety
@@ -1748,7 +1783,9 @@ static MqttMsg *allocMsg(Mqtt *mq, uint type, int id, size_t size)
     if (size <= MQTT_INLINE_BUF_SIZE) {
         msg->buf = msg->inlineBuf;
     } else {
+        tag = rSetMemTag(R_MEM_MQTT);
         msg->buf = rAlloc(size);
+        rSetMemTag(tag);
     }
     msg->end = msg->start = msg->buf;
     msg->endbuf = &msg->buf[size];
@@ -1764,7 +1801,7 @@ static void freeMsg(MqttMsg *msg)
         if (msg->buf != msg->inlineBuf) {
             rFree(msg->buf);
         }
-        rFree(msg);
+        rFreeToPool(msgPool, msg);
     }
 }
 
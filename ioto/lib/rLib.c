@@ -73,6 +73,17 @@ PUBLIC int rInit(RFiberProc fn, cvoid *arg)
 
 PUBLIC void rTerm(void)
 {
+    //  Profile samples and spans are retained across a restart so they cover the life of the process
+#if ME_R_PROFILE
+    if (rState != R_RESTART) {
+        rTermProfile();
+    }
+#endif
+#if ME_R_SPAN
+    if (rState != R_RESTART) {
+        rTermSpans();
+    }
+#endif
 #if ME_COM_SSL && R_USE_TLS
     rTermTls();
 #endif
@@ -85,6 +96,9 @@ PUBLIC void rTerm(void)
 #if R_USE_FILE
     rTermFile();
 #endif
+#if R_USE_HASH
+    rTermIntern();
+#endif
 #if R_USE_FIBER
     rTermFibers();
 #endif
@@ -144,6 +158,27 @@ PUBLIC int rDaemonize(void)
     exit(0);
 }
 
+PUBLIC int rForkWorker(void)
+{
+    pid_t pid;
+
+    if ((pid = fork()) < 0) {
+        rError("run", "Fork failed for worker process");
+        return R_ERR_CANT_CREATE;
+
+    } else if (pid == 0) {
+#if LINUX
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+        if (rResetWait() < 0) {
+            rError("run", "Cannot create wait notifier for worker process");
+            _exit(1);
+        }
+        return 0;
+    }
+    return (int) pid;
+}
+
 PUBLIC int rWritePid(void)
 {
 #if ME_UNIX_LIKE
@@ -636,11 +671,37 @@ PUBLIC ssize rPutToBuf(RBuf *bp, cchar *fmt, ...)
     Add a number to the buffer (always null terminated).
  */
 PUBLIC ssize rPutIntToBuf(RBuf *bp, int64 i)
+{
+    ssize  rc;
+    uint64 uval;
+    char   num[32], *cp, *end;
+
+    //  Format from the end of the buffer without parsing a format or measuring the result
+    cp = end = &num[sizeof(num)];
+    uval = (i < 0) ? (uint64) - (i + 1) + 1 : (uint64) i;
+    do {
+        *--cp = (char) ('0' + uval % 10);
+        uval /= 10;
+    } while (uval != 0);
+    if (i < 0) {
+        *--cp = '-';
+    }
+    rc = rPutBlockToBuf(bp, cp, (size_t) (end - cp));
+    if (bp->end < bp->endbuf) {
+        *((char*) bp->end) = (char) '\0';
+    }
+    return rc;
+}
+
+/*
+    Add the shortest round-trip representation of a double to the buffer (always null terminated).
+ */
+PUBLIC ssize rPutDoubleToBuf(RBuf *bp, double value)
 {
     ssize rc;
     char  num[32];
 
-    rc = rPutStringToBuf(bp, sitosbuf(num, sizeof(num), i, 10));
+    rc = rPutStringToBuf(bp, sftosbuf(num, sizeof(num), value));
     if (bp->end < bp->endbuf) {
         *((char*) bp->end) = (char) '\0';
     }
@@ -981,20 +1042,60 @@ void freeEspDummy(void)
 #if R_USE_EVENT
 /*********************************** Locals ***********************************/
 
+/*
+    Initial size of the event queue heap and the event ID index
+ */
+#define EVENT_QUEUE_MIN 64
+
+/*
+    Arity of the event queue heap. A 4-ary heap halves the tree depth of a binary heap and keeps
+    sibling comparisons within one or two cache lines.
+ */
+#define EVENT_HEAP_ARITY 4
+
 typedef struct Event {
     RFiber *fiber;
     REventProc proc;
     void *arg;
-    struct Event *next;
+    struct Event *next;         /* Due list link */
+    struct Event *link;         /* Event ID index chain */
     Ticks when;
     REvent id;
+    uint64 seq;                 /* Scheduling sequence to preserve FIFO order for events due at the same time */
+    int index;                  /* Slot in the event queue heap. Set to -1 when not queued */
     int fast;
+    int stopped;                /* Stopped while still in the inbox. Freed when the inbox is drained */
 } Event;
 
 /*
-    Event queue. Note: events are not stored in list order
+    Event queue. This is a 4-ary min-heap ordered by (when, seq) so the next due event is always at events[0].
+ */
+static Event  **events = 0;
+static int    eventCount = 0;
+static int    eventMax = 0;
+static uint64 eventSeq = 0;
+
+/*
+    Event ID index. Chained hash keyed by event ID for O(1) lookup by rStopEvent, rRunEvent and rLookupEvent.
+    The bucket count is a power of two and event IDs are sequential, so the low bits spread evenly.
+ */
+static Event **eventIndex = 0;
+static uint  eventIndexSize = 0;
+
+/*
+    Event inbox for events allocated by foreign threads. This is a lock-free multi-producer, single-consumer stack.
+    Foreign threads push without taking the eventLock and the main thread drains the entire inbox in one batch.
+    The inboxSignaled flag coalesces wakeups so that one rWakeup covers a burst of posts until the next drain.
+ */
+static void *volatile eventInbox = 0;
+static void *volatile inboxSignaled = 0;
+
+/*
+    Next event ID. Updated atomically so foreign threads can allocate IDs without the eventLock.
+    Once the IDs have wrapped, new IDs must be checked for collisions with pending events under the eventLock.
  */
-static Event *events = 0;
+static volatile int64 nextEventID = 1;
+static volatile int   eventIDWrapped = 0;
 
 /*
     Event lock so rStartEvent can be thread safe
@@ -1010,19 +1111,52 @@ typedef struct Watch {
 } Watch;
 
 static RHash *watches;
+static RPool *eventPool;
+
+#if ME_R_EVENT_STATS
+/*
+    Event loop health statistics. Only collected when rEventStatsEnabled is set.
+ */
+PUBLIC bool rEventStatsEnabled = 0;
+
+static REventStats eventStats;
+static uint64      slowUsec;            /* Slow handler threshold (usec) */
+#endif
 
 /********************************** Forwards **********************************/
 
+static REvent allocEventID(void);
+static void drainInbox(void);
+static Event *findInboxEvent(REvent id);
 static void freeEvent(Event *ep);
 static REvent getNextID(void);
-static void linkEvent(Event *ep);
-static Event *lookupEvent(REvent id, Event **priorp);
+static int growEventIndex(void);
+static void indexEvent(Event *ep);
+static int linkEvent(Event *ep);
+static Event *lookupEvent(REvent id);
+static Event *popEvent(void);
+static void postEvent(Event *ep);
+static void siftEventDown(int index);
+static void siftEventUp(int index);
+static void unindexEvent(Event *ep);
+static void unlinkEvent(Event *ep);
+
+#if ME_R_EVENT_STATS
+static void addSample(REventHistogram *hist, uint64 usec);
+#endif
 
 /************************************ Code ************************************/
 
 PUBLIC int rInitEvents(void)
 {
     events = 0;
+    eventCount = eventMax = 0;
+    eventSeq = 0;
+    eventIndex = 0;
+    eventIndexSize = 0;
+    eventInbox = 0;
+    inboxSignaled = 0;
+    eventPool = rAllocPool(sizeof(Event));
     watches = rAllocHash(0, R_TEMPORAL_NAME | R_STATIC_VALUE);
     if (!watches) {
         return R_ERR_MEMORY;
@@ -1038,11 +1172,17 @@ PUBLIC void rTermEvents(void)
     RList *list;
     RName *name;
     uint  next;
+    int   i;
 
-    for (ep = events; ep; ep = np) {
+    for (ep = rAtomicExchange(&eventInbox, NULL); ep; ep = np) {
         np = ep->next;
         freeEvent(ep);
     }
+    for (i = 0; i < eventCount; i++) {
+        freeEvent(events[i]);
+    }
+    rFree(events);
+    rFree(eventIndex);
     for (ITERATE_NAME_DATA(watches, name, list)) {
         for (ITERATE_ITEMS(list, watch, next)) {
             rFree(watch);
@@ -1051,8 +1191,14 @@ PUBLIC void rTermEvents(void)
     }
     rFreeHash(watches);
     rTermLock(&eventLock);
+#if ME_R_EVENT_STATS
+    rEventStatsEnabled = 0;
+#endif
     watches = 0;
     events = 0;
+    eventIndex = 0;
+    eventCount = eventMax = 0;
+    eventIndexSize = 0;
 }
 
 /*
@@ -1061,12 +1207,14 @@ PUBLIC void rTermEvents(void)
     to run the proc. This routine is THREAD SAFE and is the only safe way to interact with R
     services from foreign threads. Returns an event ID that may be used with rStopEvent to
     deschedule and event if it has not already run.
+    Foreign threads post the event to the lock-free inbox which is drained by the main thread.
  */
 PUBLIC REvent rAllocEvent(RFiber *fiber, REventProc proc, void *arg, Ticks delay, int flags)
 {
-    Event *ep;
+    Event  *ep;
+    REvent id;
 
-    if ((ep = rAlloc(sizeof(Event))) == 0) {
+    if ((ep = rAllocFromPool(eventPool)) == 0) {
         return 0;
     }
     if (proc) {
@@ -1077,18 +1225,44 @@ PUBLIC REvent rAllocEvent(RFiber *fiber, REventProc proc, void *arg, Ticks delay
         fiber = rGetFiber();
     }
     ep->arg = arg;
+    ep->next = ep->link = 0;
+    ep->index = -1;
     Ticks now = rGetTicks();
     if (delay > 0 && now > MAXINT64 - delay) {
         ep->when = MAXINT64;
     } else {
         ep->when = now + delay;
     }
-    ep->id = getNextID();
     ep->fiber = fiber;
     ep->fast = (!fiber && flags & R_EVENT_FAST) ? 1 : 0;
-    linkEvent(ep);
+    ep->stopped = 0;
+
+    if (rIsForeignThread()) {
+        //  Until IDs wrap, a fresh ID cannot collide with a pending event so the lock is not required
+        if (eventIDWrapped) {
+            rLock(&eventLock);
+            id = getNextID();
+            rUnlock(&eventLock);
+        } else {
+            id = allocEventID();
+        }
+        //  The event may run and be freed as soon as it is posted
+        ep->id = id;
+        postEvent(ep);
+        return id;
+    }
+    rLock(&eventLock);
+    ep->id = id = getNextID();
+    if (linkEvent(ep) < 0) {
+        rUnlock(&eventLock);
+        //  Caller retains ownership of the fiber
+        ep->fiber = 0;
+        freeEvent(ep);
+        return 0;
+    }
+    rUnlock(&eventLock);
     rWakeup();
-    return ep->id;
+    return id;
 }
 
 static void freeEvent(Event *ep)
@@ -1097,7 +1271,7 @@ static void freeEvent(Event *ep)
         rFreeFiber(ep->fiber);
         ep->fiber = 0;
     }
-    rFree(ep);
+    rFreeToPool(eventPool, ep);
 }
 
 PUBLIC REvent rStartEvent(REventProc proc, void *arg, Ticks delay)
@@ -1112,22 +1286,25 @@ PUBLIC REvent rStartFastEvent(REventProc proc, void *arg, Ticks delay)
 
 PUBLIC int rStopEvent(REvent id)
 {
-    Event *ep, *prior;
+    Event *ep;
 
     if (id == 0) {
         return R_ERR_CANT_FIND;
     }
     rLock(&eventLock);
-    if ((ep = lookupEvent(id, &prior)) != 0) {
-        if (ep == events) {
-            events = ep->next;
-        } else if (prior) {
-            prior->next = ep->next;
-        }
+    drainInbox();
+    if ((ep = lookupEvent(id)) != 0) {
+        unlinkEvent(ep);
         rUnlock(&eventLock);
         freeEvent(ep);
         return 0;
     }
+    if ((ep = findInboxEvent(id)) != 0) {
+        //  Foreign threads cannot drain the inbox. The main thread frees the event when it does.
+        ep->stopped = 1;
+        rUnlock(&eventLock);
+        return 0;
+    }
     rUnlock(&eventLock);
     return R_ERR_CANT_FIND;
 }
@@ -1137,7 +1314,19 @@ PUBLIC int rRunEvent(REvent id)
     Event *ep;
 
     rLock(&eventLock);
-    if ((ep = lookupEvent(id, NULL)) != 0) {
+    drainInbox();
+    if ((ep = lookupEvent(id)) != 0) {
+        //  Requeue as the most recently scheduled event due now
+        ep->when = rGetTicks();
+        ep->seq = eventSeq++;
+        siftEventUp(ep->index);
+        siftEventDown(ep->index);
+        rUnlock(&eventLock);
+        rWakeup();
+        return 0;
+    }
+    if ((ep = findInboxEvent(id)) != 0) {
+        //  Scheduled as due when the main thread drains the inbox
         ep->when = rGetTicks();
         rUnlock(&eventLock);
         rWakeup();
@@ -1163,54 +1352,58 @@ PUBLIC bool rLookupEvent(REvent id)
     Event *ep;
 
     rLock(&eventLock);
-    ep = lookupEvent(id, NULL);
+    drainInbox();
+    if ((ep = lookupEvent(id)) == 0) {
+        ep = findInboxEvent(id);
+    }
     rUnlock(&eventLock);
     return ep ? 1 : 0;
 }
 
 PUBLIC Ticks rRunEvents(void)
 {
-    Event      *ep, *next, *prior;
+    Event      *ep, *next;
     Event      *dueList, *dueTail;
     Ticks      now, deadline;
     REventProc proc;
     RFiber     *fiber;
     void       *arg;
+    int        rc;
+#if ME_R_EVENT_STATS
+    uint64     start, sliceStart;
+    int        due;
+
+    start = rEventStatsEnabled ? rGetEventClock() : 0;
+    due = 0;
+#endif
 
     assert(rIsMain());
     now = rGetTicks();
-    deadline = MAXINT64;
 
     /*
-        Build a list of due events while holding the lock
+        Pop due events off the queue while holding the lock. Events scheduled by the due events
+        themselves are run on the next iteration.
      */
     rLock(&eventLock);
+    drainInbox();
     dueList = NULL;
     dueTail = NULL;
-    prior = NULL;
 
-    for (ep = events; ep; ep = next) {
-        next = ep->next;
-        if (ep->when <= now && rState < R_STOPPING) {
-            //  Unlink from main list
-            if (ep == events) {
-                events = ep->next;
-            } else if (prior) {
-                prior->next = ep->next;
-            }
-            //  Add to due list
-            ep->next = NULL;
+    if (rState < R_STOPPING) {
+        while (eventCount > 0 && events[0]->when <= now) {
+            ep = popEvent();
+#if ME_R_EVENT_STATS
+            due++;
+#endif
             if (dueTail) {
                 dueTail->next = ep;
                 dueTail = ep;
             } else {
                 dueList = dueTail = ep;
             }
-        } else {
-            deadline = min(ep->when, deadline);
-            prior = ep;
         }
     }
+    deadline = eventCount > 0 ? events[0]->when : MAXINT64;
     rUnlock(&eventLock);
 
     /*
@@ -1218,12 +1411,26 @@ PUBLIC Ticks rRunEvents(void)
      */
     for (ep = dueList; ep; ep = next) {
         next = ep->next;
+        ep->next = 0;
         arg = ep->arg;
-
+#if ME_R_EVENT_STATS
+        if (start) {
+            eventStats.dispatched++;
+            addSample(&eventStats.lag, (uint64) max(now - ep->when, 0) * 1000);
+        }
+#endif
         if (ep->fast) {
             assert(!ep->fiber);
             proc = ep->proc;
             freeEvent(ep);
+#if ME_R_EVENT_STATS
+            if (start) {
+                sliceStart = rGetEventClock();
+                (proc) (arg);
+                rAddEventSlice(sliceStart, (void*) proc);
+                continue;
+            }
+#endif
             (proc) (arg);
         } else {
             fiber = ep->fiber;
@@ -1232,7 +1439,12 @@ PUBLIC Ticks rRunEvents(void)
                 if (!fiber) {
                     // Put back event until we have a fiber to run it on
                     ep->when = rGetTicks() + 1;
-                    linkEvent(ep);
+                    rLock(&eventLock);
+                    rc = linkEvent(ep);
+                    rUnlock(&eventLock);
+                    if (rc < 0) {
+                        freeEvent(ep);
+                    }
                     continue;
                 }
             }
@@ -1241,207 +1453,529 @@ PUBLIC Ticks rRunEvents(void)
             rResumeFiber(fiber, arg);
         }
     }
-
+#if ME_R_EVENT_STATS
+    if (start) {
+        eventStats.iterations++;
+        if (due > 0) {
+            eventStats.maxDue = max(eventStats.maxDue, due);
+            addSample(&eventStats.loop, rGetEventClock() - start);
+        }
+    }
+#endif
     return deadline;
 }
 
-PUBLIC Time rGetNextDueEvent(void)
+#if ME_R_EVENT_STATS
+PUBLIC void rSetEventStats(bool enable, Ticks slow)
 {
-    Ticks when;
-
-    if (rState >= R_STOPPING) {
-        return 0;
+    if (enable && !rEventStatsEnabled) {
+        rResetEventStats();
     }
+    eventStats.slowThreshold = slow;
+    slowUsec = slow > 0 ? (uint64) slow * 1000 : 0;
+    rEventStatsEnabled = enable;
+}
+
+PUBLIC void rGetEventStats(REventStats *stats)
+{
+    *stats = eventStats;
+    stats->enabled = rEventStatsEnabled;
     rLock(&eventLock);
-    when = events ? events->when : MAXINT64;
+    stats->queued = eventCount;
     rUnlock(&eventLock);
-    return when;
+}
+
+PUBLIC void rResetEventStats(void)
+{
+    Ticks slow;
+
+    slow = eventStats.slowThreshold;
+    memset(&eventStats, 0, sizeof(eventStats));
+    eventStats.slowThreshold = slow;
 }
 
 /*
-    Event IDs are 64 bits and should never wrap in our lifetime, but we do handle wrapping just incase. In that case,
-       events with IDs starting from 1 should have long since run.
-    Regardless, we check for collisions with existing events.
-    Event ID == 0 is invalid.
+    Record the time a fiber or fast event ran before returning to the event loop
  */
-static REvent getNextID(void)
+PUBLIC void rAddEventSlice(uint64 start, void *proc)
 {
-    static REvent nextID = 1;
-    REvent        id;
-    int           attempts = 0;
+    uint64 elapsed;
 
-    rLock(&eventLock);
-    if (nextID >= MAXINT64) {
-        nextID = 1;
-    }
-    //  Will always find an ID on an embedded system, but prevent infinite loop in pathological case
-    while (rLookupEvent(nextID) && attempts++ < 10000) {
-        nextID++;
-        if (nextID >= MAXINT64) {
-            nextID = 1;
-        }
+    elapsed = rGetEventClock() - start;
+    addSample(&eventStats.slice, elapsed);
+    if (slowUsec && elapsed >= slowUsec) {
+        eventStats.slow++;
+        rInfo("event", "Slow handler %p ran for %lld msec", proc, (int64) (elapsed / 1000));
     }
-    id = nextID++;
-    rUnlock(&eventLock);
-    return id;
 }
 
-static Event *lookupEvent(REvent id, Event **priorp)
+PUBLIC uint64 rGetEventPercentile(const REventHistogram *hist, double percent)
 {
-    Event *ep, *prior;
+    uint64 count, target;
+    int    i;
 
-    for (prior = 0, ep = events; ep; ep = ep->next) {
-        if (ep->id == id) {
-            if (priorp) {
-                *priorp = prior;
-            }
-            return ep;
+    if (hist->count == 0) {
+        return 0;
+    }
+    target = (uint64) ((double) hist->count * percent / 100.0);
+    target = max(target, 1);
+    for (count = 0, i = 0; i < R_EVENT_BUCKETS - 1; i++) {
+        count += hist->buckets[i];
+        if (count >= target) {
+            return min((uint64) 1 << i, hist->max);
         }
-        prior = ep;
     }
-    return 0;
+    return hist->max;
 }
 
-/*
-    THREAD SAFE
-    Note: do an in-order insertion. This inserts after the last event of the same time.
- */
-static void linkEvent(Event *event)
+static void addSample(REventHistogram *hist, uint64 usec)
 {
-    Event *ep, *prior;
+    uint64 value;
+    int    bucket;
 
-    rLock(&eventLock);
-    if (events) {
-        prior = 0;
-        for (ep = events; ep; ep = ep->next) {
-            if (ep->when > event->when) {
-                if (ep == events) {
-                    // Insert at the head
-                    event->next = events;
-                    events = event;
-                } else {
-                    event->next = prior->next;
-                    prior->next = event;
-                }
-                break;
-            }
-            prior = ep;
-        }
-        // If loop completed without break, append at end
-        if (ep == NULL) {
-            prior->next = event;
-            event->next = NULL;
-        }
-    } else {
-        // Add to the head
-        event->next = events;
-        events = event;
+    for (bucket = 0, value = usec; value && bucket < R_EVENT_BUCKETS - 1; bucket++) {
+        value >>= 1;
+    }
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->total += usec;
+    if (usec > hist->max) {
+        hist->max = usec;
     }
-    rUnlock(&eventLock);
 }
 
-PUBLIC void rWatch(cchar *name, RWatchProc proc, void *data)
+#else /* !ME_R_EVENT_STATS */
+
+PUBLIC void rSetEventStats(bool enable, Ticks slow)
 {
-    Watch *watch;
-    RList *list;
-    uint  next;
+}
 
-    if ((list = rLookupName(watches, name)) == 0) {
-        list = rAllocList(0, 0);
-        if (!list) {
-            return;
-        }
-        if (!rAddName(watches, name, list, 0)) {
-            rFreeList(list);
-            return;
-        }
-    } else {
-        //  Check for duplicates
-        for (ITERATE_ITEMS(list, watch, next)) {
-            if (watch->proc == proc && watch->data == data) {
-                return;
-            }
-        }
-    }
-#ifndef __clang_analyzer__
-    watch = rAllocType(Watch);
-    watch->proc = proc;
-    watch->data = data;
-    rPushItem(list, watch);
-#endif
+PUBLIC void rGetEventStats(REventStats *stats)
+{
+    memset(stats, 0, sizeof(REventStats));
 }
 
-PUBLIC void rWatchOff(cchar *name, RWatchProc proc, void *data)
+PUBLIC void rResetEventStats(void)
 {
-    RList *list;
-    Watch *watch;
-    int   next;
+}
 
-    if ((list = rLookupName(watches, name)) != 0) {
-        for (ITERATE_ITEMS(list, watch, next)) {
-            if (watch->proc == proc && watch->data == data) {
-                rRemoveItemAt(list, next);
-#ifndef __clang_analyzer__
-                // Clang analyzer incorrectly complains about this
-                rFree(watch);
+PUBLIC uint64 rGetEventPercentile(const REventHistogram *hist, double percent)
+{
+    return 0;
+}
+#endif /* ME_R_EVENT_STATS */
+
+PUBLIC uint64 rGetEventClock(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64) ts.tv_sec * 1000000 + (uint64) ts.tv_nsec / 1000;
+#else
+    return (uint64) rGetTicks() * 1000;
 #endif
-                break;
-            }
-        }
+}
+
+PUBLIC Time rGetNextDueEvent(void)
+{
+    Ticks when;
+
+    if (rState >= R_STOPPING) {
+        return 0;
     }
+    rLock(&eventLock);
+    drainInbox();
+    when = eventCount > 0 ? events[0]->when : MAXINT64;
+    rUnlock(&eventLock);
+    return when;
 }
 
-static void signalFiber(Watch *watch)
+/*
+    Event IDs are 64 bits and should never wrap in our lifetime, but we do handle wrapping just incase. In that case,
+       events with IDs starting from 1 should have long since run.
+    Regardless, after wrapping we check for collisions with queued events and events in the inbox.
+    Event ID == 0 is invalid.
+    Must be called with the eventLock held.
+ */
+static REvent getNextID(void)
 {
-    watch->proc(watch->data, NULL);
+    REvent id;
+    int    attempts = 0;
+
+    //  Will always find an ID on an embedded system, but prevent infinite loop in pathological case
+    do {
+        id = allocEventID();
+    } while (eventIDWrapped && (lookupEvent(id) || findInboxEvent(id)) && attempts++ < 10000);
+    return id;
 }
 
 /*
-    Signal watchers of an event
-    This spawns a fiber for each watcher and is difficult to reliably take an argument that needs freeing.
+    Take the next event ID. The wrap to one is part of the same compare and swap so concurrent callers
+    never observe or overwrite a stale counter. THREAD SAFE.
  */
-PUBLIC void rSignal(cchar *name)
+static REvent allocEventID(void)
 {
-    RList *list;
-    Watch *watch;
-    int   next;
+    int64 id, next;
 
-    if ((list = rLookupName(watches, name)) != 0) {
-        for (ITERATE_ITEMS(list, watch, next)) {
-            rStartEvent((RFiberProc) signalFiber, watch, 0);
+    do {
+        id = nextEventID;
+        if (id >= MAXINT64 - 1) {
+            next = 1;
+        } else {
+            next = id + 1;
         }
+    } while (!rAtomicCas64(&nextEventID, id, next));
+
+    if (next == 1) {
+        eventIDWrapped = 1;
     }
+    return id;
 }
 
 /*
-    Invoke watchers synchronously
+    Find an event that a foreign thread has posted to the inbox but which has not yet been drained.
+    Must be called with the eventLock held. Foreign threads only push onto the head of the inbox and the
+    main thread only takes the inbox with the eventLock held, so the list is stable while walking.
  */
-PUBLIC void rSignalSync(cchar *name, cvoid *arg)
+static Event *findInboxEvent(REvent id)
 {
-    RList *list;
-    Watch *watch;
-    int   next;
+    Event *ep;
 
-    if ((list = rLookupName(watches, name)) != 0) {
-        for (ITERATE_ITEMS(list, watch, next)) {
-            watch->proc(watch->data, arg);
+    for (ep = eventInbox; ep; ep = ep->next) {
+        if (ep->id == id && !ep->stopped) {
+            return ep;
         }
     }
+    return 0;
 }
 
-#endif /* R_USE_EVENT */
 /*
-    Copyright (c) Michael O'Brien. All Rights Reserved.
-    This is proprietary software and requires a commercial license from the author.
+    Push an event onto the inbox. Called by foreign threads. THREAD SAFE.
+    Only the first post after a drain calls rWakeup.
  */
+static void postEvent(Event *ep)
+{
+    void *head;
 
+    do {
+        head = eventInbox;
+        ep->next = head;
+    } while (!rAtomicCas(&eventInbox, head, ep));
 
-/********* Start of file src/fiber.c ************/
-
-/**
-    fiber.c - Fiber coroutines
+    if (rAtomicExchange(&inboxSignaled, (void*) 1) == 0) {
+        rWakeup();
+    }
+}
 
-    Copyright (c) All Rights Reserved. See details at the end of the file.
+/*
+    Move all events in the inbox to the event queue. Must be called by the main thread with the eventLock held.
+    Clear the signaled flag before taking the inbox so a post that races with the drain issues a fresh wakeup.
+ */
+static void drainInbox(void)
+{
+    Event *ep, *next, *list;
+
+    if (eventInbox == 0 || rIsForeignThread()) {
+        return;
+    }
+    rAtomicExchange(&inboxSignaled, NULL);
+    list = rAtomicExchange(&eventInbox, NULL);
+
+    //  The inbox is LIFO, so reverse to preserve the order of posting
+    for (ep = list, list = 0; ep; ep = next) {
+        next = ep->next;
+        ep->next = list;
+        list = ep;
+    }
+    for (ep = list; ep; ep = next) {
+        next = ep->next;
+        if (ep->stopped || linkEvent(ep) < 0) {
+            freeEvent(ep);
+        }
+    }
+}
+
+/*
+    Return true if event "a" should run before event "b"
+ */
+static bool runsBefore(Event *a, Event *b)
+{
+    return a->when < b->when || (a->when == b->when && a->seq < b->seq);
+}
+
+static void siftEventUp(int index)
+{
+    Event *ep;
+    int   parent;
+
+    ep = events[index];
+    while (index > 0) {
+        parent = (index - 1) / EVENT_HEAP_ARITY;
+        if (!runsBefore(ep, events[parent])) {
+            break;
+        }
+        events[index] = events[parent];
+        events[index]->index = index;
+        index = parent;
+    }
+    events[index] = ep;
+    ep->index = index;
+}
+
+static void siftEventDown(int index)
+{
+    Event *ep;
+    int   child, best, last, i;
+
+    ep = events[index];
+    while (1) {
+        child = index * EVENT_HEAP_ARITY + 1;
+        if (child >= eventCount) {
+            break;
+        }
+        best = child;
+        last = min(child + EVENT_HEAP_ARITY, eventCount);
+        for (i = child + 1; i < last; i++) {
+            if (runsBefore(events[i], events[best])) {
+                best = i;
+            }
+        }
+        if (!runsBefore(events[best], ep)) {
+            break;
+        }
+        events[index] = events[best];
+        events[index]->index = index;
+        index = best;
+    }
+    events[index] = ep;
+    ep->index = index;
+}
+
+/*
+    Remove and return the next due event. Must be called with the eventLock held and a non-empty queue.
+ */
+static Event *popEvent(void)
+{
+    Event *ep;
+
+    ep = events[0];
+    unlinkEvent(ep);
+    return ep;
+}
+
+/*
+    Insert an event into the queue and ID index. Events due at the same time are run in order of insertion.
+    Must be called with the eventLock held.
+ */
+static int linkEvent(Event *ep)
+{
+    Event **heap;
+    int   size;
+
+    if (eventCount >= eventMax) {
+        size = eventMax ? eventMax * 2 : EVENT_QUEUE_MIN;
+        if ((heap = rRealloc(events, (size_t) size * sizeof(Event*))) == 0) {
+            return R_ERR_MEMORY;
+        }
+        events = heap;
+        eventMax = size;
+    }
+    if ((uint) eventCount >= eventIndexSize && growEventIndex() < 0) {
+        return R_ERR_MEMORY;
+    }
+    ep->seq = eventSeq++;
+    ep->next = 0;
+    events[eventCount] = ep;
+    siftEventUp(eventCount++);
+    indexEvent(ep);
+    return 0;
+}
+
+/*
+    Remove an event from the queue and ID index. Must be called with the eventLock held.
+ */
+static void unlinkEvent(Event *ep)
+{
+    Event *last;
+    int   index;
+
+    index = ep->index;
+    assert(index >= 0 && index < eventCount && events[index] == ep);
+
+    last = events[--eventCount];
+    if (last != ep) {
+        events[index] = last;
+        last->index = index;
+        siftEventUp(index);
+        siftEventDown(last->index);
+    }
+    ep->index = -1;
+    unindexEvent(ep);
+}
+
+static Event *lookupEvent(REvent id)
+{
+    Event *ep;
+
+    if (eventIndexSize == 0) {
+        return 0;
+    }
+    for (ep = eventIndex[(uint64) id & (eventIndexSize - 1)]; ep; ep = ep->link) {
+        if (ep->id == id) {
+            return ep;
+        }
+    }
+    return 0;
+}
+
+static void indexEvent(Event *ep)
+{
+    uint bucket;
+
+    bucket = (uint) ((uint64) ep->id & (eventIndexSize - 1));
+    ep->link = eventIndex[bucket];
+    eventIndex[bucket] = ep;
+}
+
+static void unindexEvent(Event *ep)
+{
+    Event **pp;
+
+    for (pp = &eventIndex[(uint64) ep->id & (eventIndexSize - 1)]; *pp; pp = &(*pp)->link) {
+        if (*pp == ep) {
+            *pp = ep->link;
+            break;
+        }
+    }
+    ep->link = 0;
+}
+
+/*
+    Double the size of the event ID index and rehash the queued events
+ */
+static int growEventIndex(void)
+{
+    Event **index;
+    uint  size;
+    int   i;
+
+    size = eventIndexSize ? eventIndexSize * 2 : EVENT_QUEUE_MIN;
+    if ((index = rAlloc(size * sizeof(Event*))) == 0) {
+        return R_ERR_MEMORY;
+    }
+    memset(index, 0, size * sizeof(Event*));
+    rFree(eventIndex);
+    eventIndex = index;
+    eventIndexSize = size;
+    for (i = 0; i < eventCount; i++) {
+        indexEvent(events[i]);
+    }
+    return 0;
+}
+
+PUBLIC void rWatch(cchar *name, RWatchProc proc, void *data)
+{
+    Watch *watch;
+    RList *list;
+    uint  next;
+
+    if ((list = rLookupName(watches, name)) == 0) {
+        list = rAllocList(0, 0);
+        if (!list) {
+            return;
+        }
+        if (!rAddName(watches, name, list, 0)) {
+            rFreeList(list);
+            return;
+        }
+    } else {
+        //  Check for duplicates
+        for (ITERATE_ITEMS(list, watch, next)) {
+            if (watch->proc == proc && watch->data == data) {
+                return;
+            }
+        }
+    }
+#ifndef __clang_analyzer__
+    watch = rAllocType(Watch);
+    watch->proc = proc;
+    watch->data = data;
+    rPushItem(list, watch);
+#endif
+}
+
+PUBLIC void rWatchOff(cchar *name, RWatchProc proc, void *data)
+{
+    RList *list;
+    Watch *watch;
+    int   next;
+
+    if ((list = rLookupName(watches, name)) != 0) {
+        for (ITERATE_ITEMS(list, watch, next)) {
+            if (watch->proc == proc && watch->data == data) {
+                rRemoveItemAt(list, next);
+#ifndef __clang_analyzer__
+                // Clang analyzer incorrectly complains about this
+                rFree(watch);
+#endif
+                break;
+            }
+        }
+    }
+}
+
+static void signalFiber(Watch *watch)
+{
+    watch->proc(watch->data, NULL);
+}
+
+/*
+    Signal watchers of an event
+    This spawns a fiber for each watcher and is difficult to reliably take an argument that needs freeing.
+ */
+PUBLIC void rSignal(cchar *name)
+{
+    RList *list;
+    Watch *watch;
+    int   next;
+
+    if ((list = rLookupName(watches, name)) != 0) {
+        for (ITERATE_ITEMS(list, watch, next)) {
+            rStartEvent((RFiberProc) signalFiber, watch, 0);
+        }
+    }
+}
+
+/*
+    Invoke watchers synchronously
+ */
+PUBLIC void rSignalSync(cchar *name, cvoid *arg)
+{
+    RList *list;
+    Watch *watch;
+    int   next;
+
+    if ((list = rLookupName(watches, name)) != 0) {
+        for (ITERATE_ITEMS(list, watch, next)) {
+            watch->proc(watch->data, arg);
+        }
+    }
+}
+
+#endif /* R_USE_EVENT */
+/*
+    Copyright (c) Michael O'Brien. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
+
+
+/********* Start of file src/fiber.c ************/
+
+/**
+    fiber.c - Fiber coroutines
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
  */
 
 /********************************** Includes **********************************/
@@ -1483,10 +2017,27 @@ typedef struct FiberPool {
 
 static FiberPool fiberPool = { 0 };
 
+#if ME_FIBER_STACK_TUNE
+/*
+    Stack profiles are kept per fiber entry proc in a small open-addressed table keyed by the proc.
+    Active fibers are listed so the stack below parked fibers can be trimmed.
+ */
+static RFiberStackClass stackClasses[ME_FIBER_STACK_CLASSES];
+static RFiber *activeFibers;
+static REvent trimEvent;
+static uint   trimGen = 1;
+static bool   stackTuning = 1;
+static size_t adviceInitial, adviceMax;
+
+#define FIBER_STACK_WARMUP 16           // Sample every run until a proc has run this many fibers
+#define FIBER_STACK_WINDOW 16           // Samples before a tuned size can shrink
+#define FIBER_PARK_PAD     2048         // Stack below the parked stack pointer used to switch context
+#endif
+
 /*********************************** Forwards *********************************/
 
 static RFiber *acquireFromPool(void);
-static RFiber *allocNewFiber(void);
+static RFiber *allocNewFiber(size_t stackSize);
 static int initFiberContext(RFiber *fiber, RFiberProc function, cvoid *data);
 static bool releaseToPool(RFiber *fiber);
 static void freeFiberMemory(RFiber *fiber);
@@ -1497,9 +2048,20 @@ static void setupFiberSignalHandlers(void);
 static int allocGuardedStack(RFiberStack *info, size_t initialSize, size_t maxSize);
 static void freeGuardedStack(RFiberStack *info);
 static void resetGuardedStack(RFiberStack *info);
+static void resizeGuardedStack(RFiberStack *info, size_t size);
 static int growFiberStack(RFiber *fiber);
 #endif
 
+#if ME_FIBER_STACK_TUNE
+static RFiberStackClass *getStackClass(void *proc);
+static void linkFiber(RFiber *fiber);
+static void logStackAdvice(void);
+static void recordStack(RFiber *fiber);
+static void trimFibers(void *data);
+static void tuneStack(RFiber *fiber, RFiberStackClass *cp);
+static void unlinkFiber(RFiber *fiber);
+#endif
+
 /************************************ Code ************************************/
 
 PUBLIC int rInitFibers(void)
@@ -1514,6 +2076,9 @@ PUBLIC int rInitFibers(void)
     fiberPool.poolMin = ME_FIBER_POOL_MIN;
     fiberPool.poolMax = ME_FIBER_POOL_LIMIT;
     fiberPool.pruneEvent = rStartEvent(pruneFibers, NULL, ME_FIBER_PRUNE_INTERVAL);
+#if ME_FIBER_STACK_TUNE
+    trimEvent = rStartEvent(trimFibers, NULL, ME_FIBER_TRIM_INTERVAL);
+#endif
 
     if (uctx_init(NULL) < 0) {
         rError("runtime", "Cannot initialize UCTX subsystem");
@@ -1540,6 +2105,13 @@ PUBLIC void rTermFibers(void)
         rStopEvent(fiberPool.pruneEvent);
         fiberPool.pruneEvent = 0;
     }
+#if ME_FIBER_STACK_TUNE
+    if (trimEvent) {
+        rStopEvent(trimEvent);
+        trimEvent = 0;
+    }
+    activeFibers = NULL;
+#endif
     for (fiber = fiberPool.free; fiber; fiber = next) {
         next = fiber->next;
 #if FIBER_WITH_VALGRIND
@@ -1591,6 +2163,10 @@ static void fiberEntry(RFiber *fiber)
 PUBLIC RFiber *rAllocFiber(cchar *name, RFiberProc function, cvoid *data)
 {
     RFiber *fiber;
+    size_t stackSize;
+#if ME_FIBER_STACK_TUNE
+    RFiberStackClass *cp;
+#endif
 
     // Check fiber limit
     if (fiberPool.max && fiberPool.active >= fiberPool.max) {
@@ -1605,19 +2181,36 @@ PUBLIC RFiber *rAllocFiber(cchar *name, RFiberProc function, cvoid *data)
         rDebug("fiber", "Peak fibers %d", fiberPool.active);
         fiberPool.peak = fiberPool.active;
     }
+    stackSize = fiberInitialStack;
+#if ME_FIBER_STACK_TUNE
+    cp = stackTuning ? getStackClass((void*) function) : NULL;
+    if (cp && cp->size) {
+        stackSize = cp->size;
+    }
+#endif
     fiber = acquireFromPool();
     if (!fiber) {
-        fiber = allocNewFiber();
+        fiber = allocNewFiber(stackSize);
         if (!fiber) {
             fiberPool.active--;
             return NULL;
         }
     }
+#if ME_FIBER_STACK_TUNE
+    tuneStack(fiber, cp);
+#endif
     if (initFiberContext(fiber, function, data) < 0) {
         freeFiberMemory(fiber);
         fiberPool.active--;
         return NULL;
     }
+#if ME_R_SPAN
+    //  Pooled fibers keep their trace track but not an unended span
+    fiber->span = 0;
+#endif
+#if ME_FIBER_STACK_TUNE
+    linkFiber(fiber);
+#endif
     return fiber;
 }
 
@@ -1625,6 +2218,9 @@ void rFreeFiber(RFiber *fiber)
 {
     assert(fiber);
     fiberPool.active--;
+#if ME_FIBER_STACK_TUNE
+    unlinkFiber(fiber);
+#endif
 
     if (!releaseToPool(fiber)) {
         freeFiberMemory(fiber);
@@ -1632,9 +2228,9 @@ void rFreeFiber(RFiber *fiber)
 }
 
 /*
-    Allocate a new fiber from the heap
+    Allocate a new fiber from the heap. The stackSize is the initial commit for growable stacks.
  */
-static RFiber *allocNewFiber(void)
+static RFiber *allocNewFiber(size_t stackSize)
 {
     RFiber *fiber;
     size_t size;
@@ -1651,9 +2247,9 @@ static RFiber *allocNewFiber(void)
     memset(fiber, 0, size);
     if (uctx_needstack()) {
         // Allocate guarded stack using runtime-configurable limits
-        if (allocGuardedStack(&fiber->stackInfo, fiberInitialStack, fiberMaxStack) < 0) {
+        if (allocGuardedStack(&fiber->stackInfo, stackSize, fiberMaxStack) < 0) {
             rFree(fiber);
-            rAllocException(R_MEM_STACK, fiberInitialStack);
+            rAllocException(R_MEM_STACK, stackSize);
             return NULL;
         }
     }
@@ -1716,6 +2312,9 @@ static RFiber *allocNewFiber(void)
 static int initFiberContext(RFiber *fiber, RFiberProc function, cvoid *data)
 {
     uctx_t *context;
+#if ME_FIBER_GROWABLE_STACK
+    size_t size;
+#endif
 
     fiber->result = NULL;
     fiber->block = 0;
@@ -1723,12 +2322,21 @@ static int initFiberContext(RFiber *fiber, RFiberProc function, cvoid *data)
     fiber->done = 0;
     fiber->func = function;
     fiber->data = (void*) data;
+#if ME_R_MEM_TAGS
+    //  Fibers inherit the memory accounting tag of their creator
+    fiber->memTag = rGetMemTag();
+#endif
 
     if (!fiber->pooled) {
         //  New fiber - full context initialization
         context = &fiber->context;
 #if ME_FIBER_GROWABLE_STACK
-        uctx_setstack(context, uctx_needstack() ? fiber->stackInfo.usable : NULL, fiber->stackInfo.committed);
+        /*
+            Tuned stacks may commit less than the uctx minimum stack size. The stack grows on demand
+            into the reserved region, so the context bounds need only cover the minimum.
+         */
+        size = max(fiber->stackInfo.committed, ME_FIBER_MIN_STACK);
+        uctx_setstack(context, uctx_needstack() ? (char*) fiber->stackInfo.top - size : NULL, size);
 #else
         uctx_setstack(context, uctx_needstack() ? fiber->stack : NULL, fiberInitialStack);
 #endif
@@ -1770,6 +2378,22 @@ static void freeFiberMemory(RFiber *fiber)
  */
 static void *swapContext(RFiber *f1, RFiber *f2, void *result)
 {
+#if ME_R_EVENT_STATS && R_USE_EVENT
+    uint64 start;
+
+    //  Measure the time the fiber runs before yielding back to the main fiber
+    start = (rEventStatsEnabled && f1 == mainFiber) ? rGetEventClock() : 0;
+#endif
+#if ME_FIBER_STACK_TUNE
+    if (f1 != mainFiber) {
+        //  Everything below this point on the parked stack is unused until the fiber resumes
+        f1->stackInfo.parked = (void*) &result;
+        f1->stackInfo.parkGen = trimGen;
+    }
+#endif
+#if ME_R_MEM_TAGS
+    f1->memTag = rSetMemTag(f2->memTag);
+#endif
     f2->result = result;
     currentFiber = f2;
     if (uctx_swapcontext(&f1->context, &f2->context) < 0) {
@@ -1778,12 +2402,23 @@ static void *swapContext(RFiber *f1, RFiber *f2, void *result)
     }
     // On return, the currentFiber is f1
     result = f1->result;
+#if ME_R_EVENT_STATS && R_USE_EVENT
+    if (start) {
+        rAddEventSlice(start, (void*) f2->func);
+    }
+#endif
     if (f2->done) {
         //  Fiber crashed or has unrecoverable error - free completely, skip pool
+#if ME_FIBER_STACK_TUNE
+        unlinkFiber(f2);
+#endif
         freeFiberMemory(f2);
         fiberPool.active--;
     } else if (f2->pooled) {
         //  Fiber completed normally - return to pool (context stays alive)
+#if ME_FIBER_STACK_TUNE
+        recordStack(f2);
+#endif
         rFreeFiber(f2);
     }
     return result;
@@ -2098,25 +2733,105 @@ PUBLIC void rGetFiberStackLimits(size_t *initialSize, size_t *maxSize, size_t *g
 #endif
 }
 
-#if ME_FIBER_GROWABLE_STACK
-/*
-    Allocate a guarded stack with reserved virtual address space.
-    Reserves maxSize VA space, commits initialSize at the top (stack grows down).
-    The region from base to usable is PROT_NONE and acts as the guard.
- */
-static int allocGuardedStack(RFiberStack *info, size_t initialSize, size_t maxSize)
+PUBLIC bool rSetFiberStackTuning(bool enable)
 {
-    size_t pageSize, reserveSize, commitSize;
-    void   *base, *usable;
+#if ME_FIBER_STACK_TUNE
+    bool prior;
 
-    pageSize = rGetPageSize();
-    reserveSize = R_ALLOC_ALIGN(maxSize, pageSize);
-    commitSize = R_ALLOC_ALIGN(initialSize, pageSize);
+    prior = stackTuning;
+    stackTuning = enable;
+    return prior;
+#else
+    return 0;
+#endif
+}
 
-    // Reserve entire virtual address range (PROT_NONE)
-    base = rAllocPages(reserveSize);
-    if (!base) {
-        return -1;
+PUBLIC void rGetFiberStackAdvice(size_t *initialSize, size_t *maxSize)
+{
+    size_t initial, limit;
+#if ME_FIBER_STACK_TUNE
+    RFiberStackClass *cp, *sorted[ME_FIBER_STACK_CLASSES];
+    uint64           runs, total;
+    size_t           peak;
+    int              count, i, j;
+
+    count = 0;
+    total = 0;
+    peak = 0;
+    for (i = 0; i < ME_FIBER_STACK_CLASSES; i++) {
+        cp = &stackClasses[i];
+        if (cp->samples) {
+            //  Insertion sort by tuned size
+            for (j = count++; j > 0 && sorted[j - 1]->size > cp->size; j--) {
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = cp;
+            total += cp->runs;
+            peak = max(peak, cp->peak);
+        }
+    }
+    initial = fiberInitialStack;
+    limit = fiberMaxStack;
+    if (count > 0) {
+        //  Smallest tuned size covering 90% of runs
+        for (runs = 0, i = 0; i < count - 1; i++) {
+            runs += sorted[i]->runs;
+            if (runs * 10 >= total * 9) {
+                break;
+            }
+        }
+        initial = sorted[i]->size;
+        limit = max(R_ALLOC_ALIGN(peak * 2, rGetPageSize()), ME_FIBER_DEFAULT_STACK);
+        limit = max(limit, initial);
+    }
+#elif ME_FIBER_GROWABLE_STACK
+    initial = fiberInitialStack;
+    limit = fiberMaxStack;
+#else
+    initial = limit = fiberInitialStack;
+#endif
+    if (initialSize) {
+        *initialSize = initial;
+    }
+    if (maxSize) {
+        *maxSize = limit;
+    }
+}
+
+#if ME_FIBER_STACK_TUNE
+PUBLIC int rGetFiberStackProfile(RFiberStackClass *classes, int max)
+{
+    int i, count;
+
+    count = 0;
+    for (i = 0; i < ME_FIBER_STACK_CLASSES && count < max; i++) {
+        if (stackClasses[i].proc) {
+            classes[count++] = stackClasses[i];
+        }
+    }
+    return count;
+}
+#endif
+
+#if ME_FIBER_GROWABLE_STACK
+/*
+    Allocate a guarded stack with reserved virtual address space.
+    Reserves maxSize VA space, commits initialSize at the top (stack grows down).
+    The region from base to usable is PROT_NONE and acts as the guard.
+ */
+static int allocGuardedStack(RFiberStack *info, size_t initialSize, size_t maxSize)
+{
+    size_t pageSize, reserveSize, commitSize;
+    void   *base, *usable;
+
+    pageSize = rGetPageSize();
+    reserveSize = R_ALLOC_ALIGN(maxSize, pageSize);
+    commitSize = R_ALLOC_ALIGN(initialSize, pageSize);
+
+    // Reserve entire virtual address range (PROT_NONE)
+    base = rAllocPages(reserveSize);
+    if (!base) {
+        return -1;
     }
     // Commit usable portion at top of range (stack grows down)
     usable = (char*) base + reserveSize - commitSize;
@@ -2154,9 +2869,6 @@ static void freeGuardedStack(RFiberStack *info)
  */
 static void resetGuardedStack(RFiberStack *info)
 {
-    size_t decommitSize;
-    void   *newUsable, *oldUsable;
-
     if (!info || !info->guarded) {
         return;
     }
@@ -2164,17 +2876,34 @@ static void resetGuardedStack(RFiberStack *info)
     if (info->committed <= fiberStackResetLimit) {
         return;
     }
-    // Decommit grown pages back to initial size (make them PROT_NONE again)
-    newUsable = (char*) info->top - info->initialSize;
+    resizeGuardedStack(info, info->initialSize);
+}
+
+/*
+    Resize the committed region of a parked guarded stack.
+    Shrinking releases the decommitted pages. Growing commits the pages now rather than via guard page faults.
+ */
+static void resizeGuardedStack(RFiberStack *info, size_t size)
+{
+    char *usable, *oldUsable;
+
+    if (size > info->maxSize) {
+        size = info->maxSize;
+    }
+    usable = (char*) info->top - size;
     oldUsable = info->usable;
-    decommitSize = (size_t) ((char*) newUsable - (char*) oldUsable);
 
-    if (decommitSize > 0) {
-        rProtectPages(oldUsable, decommitSize, R_PROT_NONE);
+    if (usable > oldUsable) {
+        if (rDiscardPages(oldUsable, (size_t) (usable - oldUsable), R_PROT_NONE) < 0) {
+            return;
+        }
+    } else if (usable < oldUsable) {
+        if (rProtectPages(usable, (size_t) (oldUsable - usable), R_PROT_READ | R_PROT_WRITE) < 0) {
+            return;
+        }
     }
-    // Update stack info
-    info->usable = newUsable;
-    info->committed = info->initialSize;
+    info->usable = usable;
+    info->committed = size;
 }
 
 /*
@@ -2213,10 +2942,244 @@ static int growFiberStack(RFiber *fiber)
     }
     stack->usable = newUsable;
     stack->committed = newCommitted;
+#if ME_FIBER_STACK_TUNE
+    stack->grows++;
+#endif
     return 0;
 }
 #endif /* ME_FIBER_GROWABLE_STACK */
 
+#if ME_FIBER_STACK_TUNE
+/*
+    Find or create the stack profile for a fiber entry proc. Returns NULL if the table is full.
+ */
+static RFiberStackClass *getStackClass(void *proc)
+{
+    RFiberStackClass *cp;
+    uint             i, index;
+
+    index = (uint) (((size_t) proc >> 4) % ME_FIBER_STACK_CLASSES);
+    for (i = 0; i < ME_FIBER_STACK_CLASSES; i++) {
+        cp = &stackClasses[(index + i) % ME_FIBER_STACK_CLASSES];
+        if (cp->proc == proc) {
+            return cp;
+        }
+        if (cp->proc == NULL) {
+            cp->proc = proc;
+            return cp;
+        }
+    }
+    return NULL;
+}
+
+/*
+    Stack size for a high-water mark with 25% headroom
+ */
+static size_t getTunedSize(size_t used)
+{
+    size_t size;
+
+    size = R_ALLOC_ALIGN(used + used / 4, rGetPageSize());
+    size = max(size, ME_FIBER_TUNED_MIN_STACK);
+    return min(size, fiberMaxStack);
+}
+
+/*
+    Lowest address of the stack that is unused while the fiber is parked
+ */
+static char *getParkedLimit(RFiberStack *info)
+{
+    size_t limit;
+
+    if (!info->parked) {
+        return info->usable;
+    }
+    limit = (size_t) ((char*) info->parked - FIBER_PARK_PAD);
+    return (char*) (limit & ~(rGetPageSize() - 1));
+}
+
+/*
+    Measure the high-water mark of a sampled run. The stack below info->clean was zero when the run started,
+    so the lowest non-zero word is the deepest point written.
+ */
+static size_t scanStack(RFiberStack *info)
+{
+    size_t *sp, *end;
+
+    end = (size_t*) info->clean;
+    for (sp = (size_t*) info->usable; sp < end && *sp == 0; sp++) {
+    }
+    return (size_t) ((char*) info->top - (char*) sp);
+}
+
+/*
+    Size a fiber stack for its entry proc before it runs. Selected runs are sampled by zeroing the
+    unused stack so the high-water mark can be measured when the fiber completes.
+ */
+static void tuneStack(RFiber *fiber, RFiberStackClass *cp)
+{
+    RFiberStack *info;
+    char        *clean;
+
+    info = &fiber->stackInfo;
+    fiber->stackClass = cp;
+    info->clean = NULL;
+    info->used = 0;
+    info->grows = 0;
+
+    if (!info->guarded) {
+        return;
+    }
+    if (!cp) {
+        resetGuardedStack(info);
+        return;
+    }
+    cp->runs++;
+    if (fiber->pooled) {
+        resizeGuardedStack(info, cp->size ? cp->size : fiberInitialStack);
+    }
+    if (cp->runs > FIBER_STACK_WARMUP && (cp->runs % ME_FIBER_STACK_SAMPLE) != 0) {
+        return;
+    }
+    if (fiber->pooled) {
+        clean = getParkedLimit(info);
+        if (clean <= (char*) info->usable ||
+            rDiscardPages(info->usable, (size_t) (clean - (char*) info->usable), R_PROT_READ | R_PROT_WRITE) < 0) {
+            return;
+        }
+        info->clean = clean;
+    } else {
+        //  New stacks are zero filled
+        info->clean = info->top;
+    }
+}
+
+/*
+    Record the stack use of a completed fiber against its entry proc.
+    Tuned sizes grow immediately and shrink to the largest high-water mark of each window of samples.
+ */
+static void recordStack(RFiber *fiber)
+{
+    RFiberStackClass *cp;
+    RFiberStack      *info;
+    size_t           used, size;
+
+    if ((cp = fiber->stackClass) == NULL) {
+        return;
+    }
+    info = &fiber->stackInfo;
+    cp->grows += info->grows;
+    if (!info->clean) {
+        return;
+    }
+    used = max(scanStack(info), info->used);
+    info->clean = NULL;
+
+    cp->samples++;
+    cp->peak = max(cp->peak, used);
+    cp->window = max(cp->window, used);
+    size = getTunedSize(used);
+    if (size > cp->size) {
+        cp->size = size;
+    }
+    if ((cp->samples % FIBER_STACK_WINDOW) == 0) {
+        cp->size = getTunedSize(cp->window);
+        cp->window = 0;
+    }
+}
+
+/*
+    Release the unused stack below a fiber parked since before the last trim pass.
+    Returns true if the stack was trimmed.
+ */
+static bool trimStack(RFiber *fiber)
+{
+    RFiberStack *info;
+    char        *limit;
+
+    info = &fiber->stackInfo;
+    if (!info->guarded || !info->parked || info->parkGen == 0 || info->parkGen == trimGen) {
+        return 0;
+    }
+    info->parkGen = 0;
+    limit = getParkedLimit(info);
+    if (limit <= (char*) info->usable) {
+        return 0;
+    }
+    if (info->clean) {
+        //  Keep the high-water mark of a sampled run before its stack is zeroed
+        info->used = max(info->used, scanStack(info));
+    }
+    return rDiscardPages(info->usable, (size_t) (limit - (char*) info->usable), R_PROT_READ | R_PROT_WRITE) == 0;
+}
+
+/*
+    Periodically release the unused stack of idle connections and pooled fibers. Fibers parked for
+    a full trim interval keep only the stack they occupy.
+ */
+static void trimFibers(void *data)
+{
+    RFiber *fiber;
+    int    count;
+
+    count = 0;
+    if (stackTuning) {
+        for (fiber = activeFibers; fiber; fiber = fiber->nextActive) {
+            count += trimStack(fiber);
+        }
+        for (fiber = fiberPool.free; fiber; fiber = fiber->next) {
+            count += trimStack(fiber);
+        }
+    }
+    if (++trimGen == 0) {
+        trimGen = 1;
+    }
+    if (count) {
+        rTrace("fiber", "Trimmed %d idle fiber stacks", count);
+    }
+    trimEvent = rStartEvent(trimFibers, NULL, ME_FIBER_TRIM_INTERVAL);
+}
+
+static void linkFiber(RFiber *fiber)
+{
+    fiber->prevActive = NULL;
+    fiber->nextActive = activeFibers;
+    if (activeFibers) {
+        activeFibers->prevActive = fiber;
+    }
+    activeFibers = fiber;
+}
+
+static void unlinkFiber(RFiber *fiber)
+{
+    if (fiber->prevActive) {
+        fiber->prevActive->nextActive = fiber->nextActive;
+    } else if (activeFibers == fiber) {
+        activeFibers = fiber->nextActive;
+    }
+    if (fiber->nextActive) {
+        fiber->nextActive->prevActive = fiber->prevActive;
+    }
+    fiber->nextActive = fiber->prevActive = NULL;
+}
+
+/*
+    Log the recommended stack limits when they change
+ */
+static void logStackAdvice(void)
+{
+    size_t initial, limit;
+
+    rGetFiberStackAdvice(&initial, &limit);
+    if (initial != adviceInitial || limit != adviceMax) {
+        adviceInitial = initial;
+        adviceMax = limit;
+        rDebug("fiber", "Recommended fiber stack limits: fiberStack %zuk, fiberStackMax %zuk",
+               initial / 1024, limit / 1024);
+    }
+}
+#endif /* ME_FIBER_STACK_TUNE */
+
 /*
     Prune excess fibers from the pool down to poolMin
     Only prunes fibers that have been idle longer than ME_FIBER_IDLE_TIMEOUT
@@ -2278,6 +3241,9 @@ static void pruneFibers(void *data)
 #endif
     rDebug("pruneFibers: pruned %d, active %d, peak %d, pooled %d, poolMin: %d, poolMax: %d",
            count, fiberPool.active, fiberPool.peak, fiberPool.pooled, fiberPool.poolMin, fiberPool.poolMax);
+#endif
+#if ME_FIBER_STACK_TUNE
+    logStackAdvice();
 #endif
     //  Reschedule if pool is still active
     if (fiberPool.poolMax > 0) {
@@ -2299,8 +3265,8 @@ static RFiber *acquireFromPool(void)
     fiberPool.free = fiber->next;
     fiberPool.pooled--;
     fiberPool.poolHits++;
-#if ME_FIBER_GROWABLE_STACK
-    // Reset grown stacks above resetLimit back to initial size
+#if ME_FIBER_GROWABLE_STACK && !ME_FIBER_STACK_TUNE
+    // Reset grown stacks above resetLimit back to initial size. Tuned stacks are sized by tuneStack.
     resetGuardedStack(&fiber->stackInfo);
 #endif
     //  Context is alive and parked at yield point - no cleanup needed
@@ -2340,6 +3306,9 @@ PUBLIC void rEndFiberBlock(void)
     sigaddset(&set, SIGBUS);
     sigaddset(&set, SIGFPE);
     sigaddset(&set, SIGILL);
+#if ME_R_PROFILE
+    sigaddset(&set, SIGPROF);
+#endif
     sigprocmask(SIG_UNBLOCK, &set, NULL);
 #endif
 }
@@ -2505,13 +3474,17 @@ static void setupFiberSignalHandlers(void)
     ss.ss_flags = 0;
     sigaltstack(&ss, NULL);
 
-    // Memory access signals - may be stack growth requests
+    // Memory access signals - may be stack growth requests. Profiler samples are deferred while growing.
     sa.sa_sigaction = guardPageHandler;
     sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+#if ME_R_PROFILE
+    sigaddset(&sa.sa_mask, SIGPROF);
+#endif
     sigaction(SIGSEGV, &sa, NULL);
     sigaction(SIGBUS, &sa, NULL);
 
     // Non-memory signals - always errors, use basic handler
+    sigemptyset(&sa.sa_mask);
     sa.sa_handler = fiberSignalHandler;
     sa.sa_flags = 0;
     sigaction(SIGILL, &sa, NULL);
@@ -3652,9 +4625,11 @@ PUBLIC int rFlushFile(int fd)
 /*
     hash.c - Fast hashing hash lookup module
 
-    This hash hash uses a fast name lookup mechanism. Names are C strings. The hash value entries
-    are arbitrary pointers. The names are hashed into a series of buckets which then have a chain of hash entries.
-    The chain is in collating sequence so search time through the chain is on average (N/hashSize)/2.
+    This hash uses a fast name lookup mechanism. Names are C strings. The hash value entries
+    are arbitrary pointers. Entries are stored in a dense names array and indexed by an open-addressing table
+    of control bytes and slots. Each control byte holds 7 bits of the name's hash for a full slot, or marks the
+    slot as empty or deleted. Lookups probe a group of control bytes at a time (using SSE2 where available)
+    and only compare names whose full stored hash matches.
 
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
@@ -3675,13 +4650,85 @@ PUBLIC int rFlushFile(int fd)
 
 #define R_HASH_ALLOC_SIZE 512
 
+/*
+    Control byte values. Full slots store the low 7 bits of the hash (0x00-0x7F).
+ */
+#define CTRL_EMPTY        0x80
+#define CTRL_DELETED      0xFE
+
+/*
+    Group probing. SSE2 matches 16 control bytes per instruction. Otherwise use 8 bytes in a 64-bit word.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HASH_SSE2     1
+    #define HASH_GROUP    16
+    #define HASH_BIT_SHIFT 0
+    typedef uint GroupMask;
+#else
+    #define HASH_SSE2     0
+    #define HASH_GROUP    8
+    #define HASH_BIT_SHIFT 3
+    typedef uint64 GroupMask;
+    #define GROUP_LSB     ((uint64) 0x0101010101010101ULL)
+    #define GROUP_MSB     ((uint64) 0x8080808080808080ULL)
+#endif
+
+/*
+    Maximum load factor of 7/8
+ */
+#define HASH_MAX_LOAD(cap) ((cap) - ((cap) >> 3))
+
+/*
+    Old table slots migrated per operation when resizing incrementally. The table doubles when resized, so
+    migration completes well before the new table fills.
+ */
+#ifndef ME_R_HASH_MIGRATE
+    #define ME_R_HASH_MIGRATE 64
+#endif
+
+/*
+    Interned strings. Atoms are allocated from an arena with their hash and length and are never freed
+    until rTerm. Limits bound the table when interning names from untrusted input.
+ */
+#ifndef ME_R_INTERN_LEN
+    #define ME_R_INTERN_LEN 64
+#endif
+#ifndef ME_R_INTERN_MAX
+    #define ME_R_INTERN_MAX 8192
+#endif
+
+typedef struct RAtom {
+    uint hash;
+    uint len;
+    char name[];
+} RAtom;
+
+static RHash  *atoms;
+static RArena *atomArena;
+
 /********************************** Forwards **********************************/
 
-static size_t getBucketSize(size_t size);
-static int growBuckets(RHash *hash, size_t size);
-static int growNames(RHash *hash, size_t size);
-static int lookupHash(RHash *hash, cchar *name, int *index, int *prior);
+static int findSlot(RHash *hash, cchar *name, uint h, bool *old);
+static int findTableSlot(RHash *hash, cuchar *ctrl, cint *slots, uint capacity, cchar *name, uint h);
+static uint finishHash(uint h);
+static void finishMigration(RHash *hash);
 static void freeHashName(RName *np);
+static bool groupHasEmpty(cuchar *ctrl);
+static cchar *intern(cchar *str, size_t len, bool add);
+static GroupMask groupMatch(cuchar *ctrl, uint h2);
+static GroupMask groupMatchFree(cuchar *ctrl);
+static int growNames(RHash *hash, size_t size);
+static uint hashName(RHash *hash, cchar *name);
+static RName *insertName(RHash *hash, cchar *name, uint h);
+static int insertSlot(RHash *hash, uint h, int kindex);
+static int lowestBit(GroupMask mask);
+static void migrateSlots(RHash *hash, uint count);
+static void removeSlot(uchar *ctrl, int *slots, int slot, uint *deleted);
+static int reserveSlot(RHash *hash);
+static int resizeTable(RHash *hash, size_t capacity);
+static RName *setName(RHash *hash, RName *np, cchar *name, void *ptr, int flags);
+static size_t tableCapacity(size_t size);
 
 /*********************************** Code *************************************/
 
@@ -3693,8 +4740,11 @@ PUBLIC RHash *rAllocHash(size_t size, int flags)
         rAllocException(R_MEM_FAIL, size);
         return NULL;
     }
-    if (!flags) {
-        flags = R_STATIC_NAME | R_STATIC_VALUE;
+    if (!(flags & R_NAME_MASK)) {
+        flags |= R_STATIC_NAME;
+    }
+    if (!(flags & R_VALUE_MASK)) {
+        flags |= R_STATIC_VALUE;
     }
     if ((hash = rAllocType(RHash)) == 0) {
         return 0;
@@ -3703,7 +4753,7 @@ PUBLIC RHash *rAllocHash(size_t size, int flags)
     hash->free = -1;
     hash->fn = (RHashProc) ((hash->flags & R_HASH_CASELESS) ? shashlower : shash);
     if (size > 0) {
-        if (growBuckets(hash, size) < 0) {
+        if (resizeTable(hash, tableCapacity(size)) < 0) {
             rFreeHash(hash);
             return 0;
         }
@@ -3729,7 +4779,10 @@ PUBLIC void rFreeHash(RHash *hash)
             freeHashName(np);
         }
         rFree(hash->names);
-        rFree(hash->buckets);
+        rFree(hash->ctrl);
+        rFree(hash->slots);
+        rFree(hash->oldCtrl);
+        rFree(hash->oldSlots);
         rFree(hash);
     }
 }
@@ -3744,6 +4797,24 @@ static void freeHashName(RName *np)
     }
 }
 
+/*
+    Set the name and value of an entry according to the flags
+ */
+static RName *setName(RHash *hash, RName *np, cchar *name, void *ptr, int flags)
+{
+    if (!(flags & R_NAME_MASK)) {
+        flags |= hash->flags & R_NAME_MASK;
+    }
+    np->name = (flags & R_TEMPORAL_NAME) ? sclone(name) : (void*) name;
+
+    if (!(flags & R_VALUE_MASK)) {
+        flags |= hash->flags & R_VALUE_MASK;
+    }
+    np->value = (flags & R_TEMPORAL_VALUE) ? sclone(ptr) : (void*) ptr;
+    np->flags = (uint) flags;
+    return np;
+}
+
 /*
     Insert an entry into the hash hash. If the entry already exists, update its value.
     Order of insertion is not preserved.
@@ -3751,7 +4822,9 @@ static void freeHashName(RName *np)
 PUBLIC RName *rAddName(RHash *hash, cchar *name, void *ptr, int flags)
 {
     RName *np;
-    int   bindex, kindex;
+    uint  h;
+    int   slot;
+    bool  old;
 
     if (hash == 0 || name == 0) {
         assert(hash && name);
@@ -3760,57 +4833,19 @@ PUBLIC RName *rAddName(RHash *hash, cchar *name, void *ptr, int flags)
     if (flags == 0) {
         flags = hash->flags;
     }
-    if (hash->length >= (hash->numBuckets)) {
-        if (growBuckets(hash, hash->length + 1) < 0) {
-            return 0;
-        }
-    }
-    if ((kindex = lookupHash(hash, name, &bindex, 0)) >= 0) {
-        np = &hash->names[kindex];
+    h = hashName(hash, name);
+    if ((slot = findSlot(hash, name, h, &old)) >= 0) {
+        np = &hash->names[old ? hash->oldSlots[slot] : hash->slots[slot]];
         freeHashName(np);
-
-    } else {
-        /*
-            New entry
-         */
-        if (hash->free < 0) {
-            if (growNames(hash, hash->size * 3 / 2) < 0) {
-                return 0;
-            }
-        }
-        kindex = hash->free;
-        if (kindex < 0 || hash->numBuckets == 0) {
-            // No free names available or hash in degraded state
-            return 0;
-        }
-        np = &hash->names[kindex];
-        hash->free = np->next;
-        hash->length++;
-
-        /*
-            Add to bucket chain
-         */
-        np->next = hash->buckets[bindex];
-        hash->buckets[bindex] = kindex;
-        np->custom = 0;
-    }
-    if (!(flags & R_NAME_MASK)) {
-        flags |= hash->flags & R_NAME_MASK;
-    }
-    np->name = (flags & R_TEMPORAL_NAME) ? sclone(name) : (void*) name;
-
-    if (!(flags & R_VALUE_MASK)) {
-        flags |= hash->flags & R_VALUE_MASK;
+    } else if ((np = insertName(hash, name, h)) == 0) {
+        return 0;
     }
-    np->value = (flags & R_TEMPORAL_VALUE) ? sclone(ptr) : (void*) ptr;
-    np->flags = (uint) flags;
-    return np;
+    return setName(hash, np, name, ptr, flags);
 }
 
 PUBLIC RName *rAddDuplicateName(RHash *hash, cchar *name, void *ptr, int flags)
 {
     RName *np;
-    int   bindex, kindex;
 
     if (hash == 0 || name == 0) {
         assert(hash && name);
@@ -3819,13 +4854,24 @@ PUBLIC RName *rAddDuplicateName(RHash *hash, cchar *name, void *ptr, int flags)
     if (flags == 0) {
         flags = hash->flags;
     }
-    if (hash->length >= (hash->numBuckets)) {
-        if (growBuckets(hash, hash->length + 1) < 0) {
-            return 0;
-        }
+    if ((np = insertName(hash, name, hashName(hash, name))) == 0) {
+        return 0;
+    }
+    return setName(hash, np, name, ptr, flags);
+}
+
+/*
+    Allocate a new entry for the name and index it. The caller sets the name and value.
+ */
+static RName *insertName(RHash *hash, cchar *name, uint h)
+{
+    RName *np;
+    int   kindex;
+
+    if (hash->oldCtrl) {
+        migrateSlots(hash, ME_R_HASH_MIGRATE);
     }
-    if (lookupHash(hash, name, &bindex, 0) < 0 && hash->numBuckets == 0) {
-        // Hash table is in degraded state (no buckets)
+    if (reserveSlot(hash) < 0) {
         return 0;
     }
     if (hash->free < 0) {
@@ -3833,32 +4879,18 @@ PUBLIC RName *rAddDuplicateName(RHash *hash, cchar *name, void *ptr, int flags)
             return 0;
         }
     }
-    kindex = hash->free;
-    if (kindex < 0) {
-        // No free names available
+    if ((kindex = hash->free) < 0) {
+        return 0;
+    }
+    if (insertSlot(hash, h, kindex) < 0) {
         return 0;
     }
     np = &hash->names[kindex];
     hash->free = np->next;
+    np->next = -1;
+    np->hash = h;
+    np->custom = 0;
     hash->length++;
-
-    /*
-        Add to bucket chain
-     */
-    np->next = hash->buckets[bindex];
-    hash->buckets[bindex] = kindex;
-    np->custom = 0;
-
-    if (!(flags & R_NAME_MASK)) {
-        flags |= hash->flags & R_NAME_MASK;
-    }
-    np->name = (flags & R_TEMPORAL_NAME) ? sclone(name) : (void*) name;
-
-    if (!(flags & R_VALUE_MASK)) {
-        flags |= hash->flags & R_VALUE_MASK;
-    }
-    np->value = (flags & R_TEMPORAL_VALUE) ? sclone(ptr) : (void*) ptr;
-    np->flags = (uint) flags;
     return np;
 }
 
@@ -3939,15 +4971,16 @@ PUBLIC RHash *rCloneHash(RHash *master)
  */
 PUBLIC RName *rLookupNameEntry(RHash *hash, cchar *name)
 {
-    int kindex;
+    int  slot;
+    bool old;
 
-    if (name == 0 || hash == 0 || hash->buckets == 0) {
+    if (name == 0 || hash == 0 || hash->ctrl == 0) {
         return 0;
     }
-    if ((kindex = lookupHash(hash, name, 0, 0)) < 0) {
+    if ((slot = findSlot(hash, name, hashName(hash, name), &old)) < 0) {
         return 0;
     }
-    return &hash->names[kindex];
+    return &hash->names[old ? hash->oldSlots[slot] : hash->slots[slot]];
 }
 
 /*
@@ -3955,39 +4988,42 @@ PUBLIC RName *rLookupNameEntry(RHash *hash, cchar *name)
  */
 PUBLIC void *rLookupName(RHash *hash, cchar *name)
 {
-    RName *np;
-    int   kindex;
+    int  slot;
+    bool old;
 
-    if (name == 0 || hash == 0 || hash->buckets == 0) {
+    if (name == 0 || hash == 0 || hash->ctrl == 0) {
         return 0;
     }
-    if ((kindex = lookupHash(hash, name, 0, 0)) < 0) {
+    if ((slot = findSlot(hash, name, hashName(hash, name), &old)) < 0) {
         return 0;
     }
-    np = &hash->names[kindex];
-    return (void*) np->value;
+    return (void*) hash->names[old ? hash->oldSlots[slot] : hash->slots[slot]].value;
 }
 
 PUBLIC int rRemoveName(RHash *hash, cchar *name)
 {
     RName *np;
-    int   bindex, kindex, prior;
+    int   kindex, slot;
+    bool  old;
 
     assert(hash);
     assert(name);
 
-    if (name == 0 || hash == 0 || hash->buckets == 0) {
+    if (name == 0 || hash == 0 || hash->ctrl == 0) {
         return 0;
     }
-    if ((kindex = lookupHash(hash, name, &bindex, &prior)) < 0) {
+    if ((slot = findSlot(hash, name, hashName(hash, name), &old)) < 0) {
         return R_ERR_CANT_FIND;
     }
-    np = &hash->names[kindex];
-    if (prior >= 0) {
-        hash->names[prior].next = np->next;
+    if (old) {
+        kindex = hash->oldSlots[slot];
+        //  Tombstones in the old table are discarded when migration completes
+        removeSlot(hash->oldCtrl, hash->oldSlots, slot, NULL);
     } else {
-        hash->buckets[bindex] = np->next;
+        kindex = hash->slots[slot];
+        removeSlot(hash->ctrl, hash->slots, slot, &hash->deleted);
     }
+    np = &hash->names[kindex];
     freeHashName(np);
     np->flags = 0;
     np->next = hash->free;
@@ -3997,136 +5033,371 @@ PUBLIC int rRemoveName(RHash *hash, cchar *name)
 }
 
 /*
-    Exponential primes
+    Clear a table slot. Probes only continue past a group that has no empty slots. If this group still has an
+    empty slot, it has never been full and the slot can be marked empty. Otherwise leave a tombstone and count it
+    in deleted if not NULL.
  */
-static size_t hashSizes[] = {
-    19, 29, 59, 79, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 0
-};
+static void removeSlot(uchar *ctrl, int *slots, int slot, uint *deleted)
+{
+    slots[slot] = -1;
+    if (groupHasEmpty(&ctrl[(size_t) slot & ~((size_t) HASH_GROUP - 1)])) {
+        ctrl[slot] = CTRL_EMPTY;
+    } else {
+        ctrl[slot] = CTRL_DELETED;
+        if (deleted) {
+            (*deleted)++;
+        }
+    }
+}
+
+static uint hashName(RHash *hash, cchar *name)
+{
+    return finishHash(hash->fn(name, slen(name)));
+}
+
+/*
+    Finalize the name hash so all bits depend on every input byte. The low 7 bits are stored in the control
+    byte and the remaining bits select the probe start.
+ */
+static uint finishHash(uint h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
 
-static size_t getBucketSize(size_t numNames)
+/*
+    Return the index of the lowest set bit of a non-zero group mask
+ */
+static int lowestBit(GroupMask mask)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    #if HASH_SSE2
+    return __builtin_ctz(mask);
+    #else
+    return __builtin_ctzll(mask);
+    #endif
+#else
     int i;
 
-    for (i = 0; hashSizes[i]; i++) {
-        if (numNames < hashSizes[i]) {
-            return hashSizes[i];
+    for (i = 0; !(mask & 1); i++) {
+        mask >>= 1;
+    }
+    return i;
+#endif
+}
+
+/*
+    Return a mask of control bytes in the group that match the 7-bit hash.
+    The portable form may report a false positive adjacent to a true match. Callers verify the full hash.
+ */
+static GroupMask groupMatch(cuchar *ctrl, uint h2)
+{
+#if HASH_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*) ctrl);
+    return (GroupMask) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) h2)));
+#else
+    uint64 group, x;
+
+    memcpy(&group, ctrl, sizeof(group));
+    x = group ^ (GROUP_LSB * h2);
+    return (x - GROUP_LSB) & ~x & GROUP_MSB;
+#endif
+}
+
+/*
+    Return a mask of the empty or deleted control bytes in the group
+ */
+static GroupMask groupMatchFree(cuchar *ctrl)
+{
+#if HASH_SSE2
+    return (GroupMask) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) ctrl));
+#else
+    uint64 group;
+
+    memcpy(&group, ctrl, sizeof(group));
+    return group & GROUP_MSB;
+#endif
+}
+
+/*
+    Test if any control byte in the group is empty
+ */
+static bool groupHasEmpty(cuchar *ctrl)
+{
+#if HASH_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*) ctrl);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) CTRL_EMPTY))) != 0;
+#else
+    uint64 group;
+
+    memcpy(&group, ctrl, sizeof(group));
+    return ((group & ~(group << 6)) & GROUP_MSB) != 0;
+#endif
+}
+
+/*
+    Find the table slot holding the name. If an incremental resize is in progress, migrate some old slots
+    and then search the new table followed by the old table. Set *old if the slot is in the old table.
+ */
+static int findSlot(RHash *hash, cchar *name, uint h, bool *old)
+{
+    int slot;
+
+    *old = 0;
+    if (hash->oldCtrl) {
+        migrateSlots(hash, ME_R_HASH_MIGRATE);
+    }
+    if ((slot = findTableSlot(hash, hash->ctrl, hash->slots, hash->capacity, name, h)) >= 0) {
+        return slot;
+    }
+    if (hash->oldCtrl) {
+        if ((slot = findTableSlot(hash, hash->oldCtrl, hash->oldSlots, hash->oldCapacity, name, h)) >= 0) {
+            *old = 1;
+            return slot;
         }
     }
-    return hashSizes[i - 1];
+    return -1;
 }
 
-static int growNames(RHash *hash, size_t size)
+/*
+    Find the slot holding the name in a table. Groups are probed using triangular steps which visit every group
+    when the number of groups is a power of two.
+ */
+static int findTableSlot(RHash *hash, cuchar *ctrl, cint *slots, uint capacity, cchar *name, uint h)
 {
-    RName  *np;
-    size_t i, inc, len;
+    RName     *np;
+    GroupMask mask;
+    size_t    pos, step, groups;
+    uint      h2;
+    int       bit, kindex;
 
-    if (size < ME_R_MIN_HASH) {
-        size = ME_R_MIN_HASH;
+    if (capacity == 0) {
+        return -1;
     }
-    if (hash->size > size) {
-        assert(hash->size < size);
-        size = hash->size + ME_R_MIN_HASH;
+    h2 = h & 0x7F;
+    groups = capacity / HASH_GROUP;
+    pos = ((size_t) (h >> 7) & (groups - 1)) * HASH_GROUP;
+    for (step = 0; step < groups; step++) {
+        mask = groupMatch(&ctrl[pos], h2);
+        while (mask) {
+            bit = lowestBit(mask) >> HASH_BIT_SHIFT;
+            kindex = slots[pos + (size_t) bit];
+            if (kindex >= 0) {
+                np = &hash->names[kindex];
+                if (np->hash == h) {
+                    if (np->name == name) {
+                        //  Interned names match by pointer
+                        return (int) (pos + (size_t) bit);
+
+                    } else if (hash->flags & R_HASH_CASELESS) {
+                        if (scaselesscmp(np->name, name) == 0) {
+                            return (int) (pos + (size_t) bit);
+                        }
+                    } else if (strcmp(np->name, name) == 0) {
+                        return (int) (pos + (size_t) bit);
+                    }
+                }
+            }
+            mask &= mask - 1;
+        }
+        if (groupHasEmpty(&ctrl[pos])) {
+            return -1;
+        }
+        pos = (pos + (step + 1) * HASH_GROUP) & (capacity - 1);
     }
-    if (size > SIZE_MAX / sizeof(RName)) {
-        rAllocException(R_MEM_FAIL, size * sizeof(RName));
-        return R_ERR_MEMORY;
+    return -1;
+}
+
+/*
+    Index a names entry in the first free slot of its probe sequence. Returns R_ERR_WONT_FIT if the table is full.
+ */
+static int insertSlot(RHash *hash, uint h, int kindex)
+{
+    GroupMask mask;
+    size_t    pos, step, groups, slot;
+
+    groups = hash->capacity / HASH_GROUP;
+    pos = ((size_t) (h >> 7) & (groups - 1)) * HASH_GROUP;
+    for (step = 0; step < groups; step++) {
+        if ((mask = groupMatchFree(&hash->ctrl[pos])) != 0) {
+            slot = pos + (size_t) (lowestBit(mask) >> HASH_BIT_SHIFT);
+            if (hash->ctrl[slot] == CTRL_DELETED) {
+                hash->deleted--;
+            }
+            hash->ctrl[slot] = (uchar) (h & 0x7F);
+            hash->slots[slot] = kindex;
+            return 0;
+        }
+        pos = (pos + (step + 1) * HASH_GROUP) & (hash->capacity - 1);
     }
-    len = size * sizeof(RName);
-    if ((hash->names = rRealloc(hash->names, len)) == 0) {
-        return R_ERR_MEMORY;
+    return R_ERR_WONT_FIT;
+}
+
+/*
+    Ensure there is room to index one more name. Grow the table or purge tombstones if required.
+ */
+static int reserveSlot(RHash *hash)
+{
+    size_t capacity;
+
+    if (hash->length + hash->deleted + 1 <= HASH_MAX_LOAD(hash->capacity)) {
+        return 0;
     }
-    inc = size - hash->size;
-    memset(&hash->names[hash->size], 0, inc * sizeof(RName));
+    if (hash->length + 1 > HASH_MAX_LOAD(ME_R_MAX_HASH)) {
+        //  The table is at the maximum size
+        return R_ERR_WONT_FIT;
+    }
+    capacity = tableCapacity(hash->length + 1);
+    if (capacity < hash->capacity) {
+        capacity = hash->capacity;
+    }
+    /*
+        Ensure headroom after purging tombstones so the table is not rebuilt again soon. This also gives an
+        incremental resize time to migrate the old table.
+     */
+    if (HASH_MAX_LOAD(capacity) - hash->length - 1 < capacity / 16 && capacity < ME_R_MAX_HASH) {
+        capacity <<= 1;
+    }
+    return resizeTable(hash, capacity);
+}
 
-    for (i = 0; i < inc; i++) {
-        np = &hash->names[hash->size];
-        np->next = hash->free;
-        hash->free = (int) hash->size++;
+/*
+    Return the power of two table capacity to hold the given number of names
+ */
+static size_t tableCapacity(size_t size)
+{
+    size_t capacity;
+
+    capacity = max(ME_R_MIN_HASH, HASH_GROUP);
+    while (HASH_MAX_LOAD(capacity) < size && capacity < ME_R_MAX_HASH) {
+        capacity <<= 1;
     }
-    return 0;
+    return capacity;
 }
 
-static int growBuckets(RHash *hash, size_t size)
+/*
+    Rebuild the table at the given capacity. Names are reindexed using their stored hash codes.
+    For R_HASH_INCREMENTAL hashes, the current table is retained as the old table and is migrated by subsequent
+    operations.
+ */
+static int resizeTable(RHash *hash, size_t capacity)
 {
+    uchar  *ctrl;
+    int    *slots;
     RName  *np;
-    size_t i, len;
-    uint   bindex;
+    size_t i;
+    bool   incremental;
 
-    if (size < ME_R_MIN_HASH) {
-        size = ME_R_MIN_HASH;
+    if (capacity > SIZE_MAX / sizeof(int)) {
+        rAllocException(R_MEM_FAIL, capacity);
+        return R_ERR_MEMORY;
     }
-    if (hash->numBuckets > size) {
-        return 0;
+    if ((ctrl = rAlloc(capacity)) == 0) {
+        return R_ERR_MEMORY;
     }
-    size = getBucketSize(size);
-    len = sizeof(int) * size;
-    rFree(hash->buckets);
-    if ((hash->buckets = rAlloc(len)) == 0) {
-        hash->numBuckets = 0;
+    if ((slots = rAlloc(capacity * sizeof(int))) == 0) {
+        rFree(ctrl);
         return R_ERR_MEMORY;
     }
-    hash->numBuckets = (uint) size;
-    for (i = 0; i < size; i++) {
-        hash->buckets[i] = -1;
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    incremental = (hash->flags & R_HASH_INCREMENTAL) && hash->length > 0;
+    if (incremental) {
+        //  A prior resize must complete first. Headroom in reserveSlot makes this rare.
+        finishMigration(hash);
+        hash->oldCtrl = hash->ctrl;
+        hash->oldSlots = hash->slots;
+        hash->oldCapacity = hash->capacity;
+        hash->migrate = 0;
+    } else {
+        rFree(hash->ctrl);
+        rFree(hash->slots);
     }
+    hash->ctrl = ctrl;
+    hash->slots = slots;
+    hash->capacity = (uint) capacity;
+    hash->deleted = 0;
 
-    /*
-        Rehash existing names
-     */
+    if (incremental) {
+        return 0;
+    }
     for (i = 0; i < hash->size; i++) {
         np = &hash->names[i];
-        if (!np->flags) continue;
-        bindex = hash->fn(np->name, slen(np->name)) % (uint) size;
-        if (hash->buckets[bindex] >= 0) {
-            np->next = hash->buckets[bindex];
-        } else {
-            np->next = -1;
+        if (np->flags) {
+            insertSlot(hash, np->hash, (int) i);
         }
-        hash->buckets[bindex] = (int) i;
     }
     return 0;
 }
 
-static int lookupHash(RHash *hash, cchar *name, int *bucketIndex, int *priorp)
+/*
+    Move up to count old table slots into the new table. Migrated slots are marked deleted so probes of the
+    old table remain intact. The old table is freed when fully migrated.
+ */
+static void migrateSlots(RHash *hash, uint count)
+{
+    uint i, end;
+    int  kindex;
+
+    end = hash->migrate + min(count, hash->oldCapacity - hash->migrate);
+    for (i = hash->migrate; i < end; i++) {
+        if (hash->oldCtrl[i] < CTRL_EMPTY) {
+            kindex = hash->oldSlots[i];
+            insertSlot(hash, hash->names[kindex].hash, kindex);
+            hash->oldCtrl[i] = CTRL_DELETED;
+        }
+    }
+    hash->migrate = end;
+    if (end >= hash->oldCapacity) {
+        rFree(hash->oldCtrl);
+        rFree(hash->oldSlots);
+        hash->oldCtrl = 0;
+        hash->oldSlots = 0;
+        hash->oldCapacity = 0;
+        hash->migrate = 0;
+    }
+}
+
+static void finishMigration(RHash *hash)
+{
+    if (hash->oldCtrl) {
+        migrateSlots(hash, hash->oldCapacity);
+    }
+}
+
+static int growNames(RHash *hash, size_t size)
 {
     RName  *np;
-    size_t iterations;
-    int    bindex, kindex, prior, rc;
+    size_t i, inc, len;
 
-    if (hash->numBuckets == 0) {
-        return -1;
+    if (size < ME_R_MIN_HASH) {
+        size = ME_R_MIN_HASH;
     }
-    bindex = (int) (hash->fn(name, slen(name)) % hash->numBuckets);
-    if (bucketIndex) {
-        *bucketIndex = (int) bindex;
+    if (hash->size > size) {
+        assert(hash->size < size);
+        size = hash->size + ME_R_MIN_HASH;
     }
-    if ((kindex = hash->buckets[bindex]) < 0) {
-        return -1;
+    if (size > SIZE_MAX / sizeof(RName)) {
+        rAllocException(R_MEM_FAIL, size * sizeof(RName));
+        return R_ERR_MEMORY;
     }
-    prior = -1;
-    iterations = 0;
-    while (kindex >= 0) {
-        if (iterations++ > hash->size) {
-            // Circular chain detected
-            return -1;
-        }
-        np = &hash->names[kindex];
-        if (hash->flags & R_HASH_CASELESS) {
-            rc = scaselesscmp(np->name, name);
-        } else {
-            rc = strcmp(np->name, name);
-        }
-        if (rc == 0) {
-            if (priorp) {
-                *priorp = prior;
-            }
-            return kindex;
-        }
-        prior = kindex;
-        assert(kindex != np->next);
-        kindex = np->next;
+    len = size * sizeof(RName);
+    if ((hash->names = rRealloc(hash->names, len)) == 0) {
+        return R_ERR_MEMORY;
     }
-    return -1;
+    inc = size - hash->size;
+    memset(&hash->names[hash->size], 0, inc * sizeof(RName));
+
+    for (i = 0; i < inc; i++) {
+        np = &hash->names[hash->size];
+        np->next = hash->free;
+        hash->free = (int) hash->size++;
+    }
+    return 0;
 }
 
 PUBLIC int rGetHashLength(RHash *hash)
@@ -4261,6 +5532,107 @@ PUBLIC char *rHashToJson(RHash *hash, int pretty)
     return rBufToStringAndFree(buf);
 }
 
+PUBLIC cchar *rIntern(cchar *str)
+{
+    if (!str) {
+        return NULL;
+    }
+    return intern(str, slen(str), 1);
+}
+
+PUBLIC cchar *rInternBlock(cchar *str, size_t len)
+{
+    char buf[ME_R_INTERN_LEN + 1];
+
+    if (!str || len > ME_R_INTERN_LEN) {
+        return NULL;
+    }
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+    return intern(buf, len, 1);
+}
+
+PUBLIC cchar *rLookupIntern(cchar *str)
+{
+    if (!str) {
+        return NULL;
+    }
+    return intern(str, slen(str), 0);
+}
+
+PUBLIC uint rGetInternHash(cchar *atom)
+{
+    if (!atom) {
+        return 0;
+    }
+    return ((RAtom*) (atom - offsetof(RAtom, name)))->hash;
+}
+
+PUBLIC void rTermIntern(void)
+{
+    rFreeHash(atoms);
+    rFreeArena(atomArena);
+    atoms = 0;
+    atomArena = 0;
+}
+
+/*
+    Lookup and optionally add an atom. The table is only accessed from the main thread. Other threads
+    get NULL and must clone instead.
+ */
+static cchar *intern(cchar *str, size_t len, bool add)
+{
+    RAtom *atom;
+    RName *np;
+    uint  h, key;
+    int   slot;
+    bool  old;
+
+    if (len > ME_R_INTERN_LEN) {
+        return NULL;
+    }
+#if R_USE_THREAD
+    if (rGetCurrentThread() != rGetMainThread()) {
+        return NULL;
+    }
+#endif
+    if (!atoms) {
+        if (!add) {
+            return NULL;
+        }
+        if ((atoms = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE)) == 0) {
+            return NULL;
+        }
+        if ((atomArena = rAllocArena(0)) == 0) {
+            rTermIntern();
+            return NULL;
+        }
+    }
+    /*
+        The atom table uses shash, so the string is hashed once for the lookup, insert and the atom itself
+     */
+    h = shash(str, len);
+    key = finishHash(h);
+    if (atoms->ctrl && (slot = findSlot(atoms, str, key, &old)) >= 0) {
+        return atoms->names[old ? atoms->oldSlots[slot] : atoms->slots[slot]].name;
+    }
+    if (!add || atoms->length >= ME_R_INTERN_MAX) {
+        return NULL;
+    }
+    if ((atom = rArenaAlloc(atomArena, sizeof(RAtom) + len + 1)) == 0) {
+        return NULL;
+    }
+    atom->hash = h;
+    atom->len = (uint) len;
+    memcpy(atom->name, str, len);
+    atom->name[len] = '\0';
+    if ((np = insertName(atoms, atom->name, key)) == 0) {
+        return NULL;
+    }
+    setName(atoms, np, atom->name, atom, 0);
+    return atom->name;
+}
+
 #endif /* R_USE_HASH */
 /*
     Copyright (c) Michael O'Brien. All Rights Reserved.
@@ -4289,6 +5661,46 @@ PUBLIC char *rHashToJson(RHash *hash, int pretty)
 
 #define R_LIST_ALLOC_SIZE      512
 
+/*
+    Sort tuning. Partitions smaller than SORT_INSERTION use insertion sort. Partitions larger than
+    SORT_NINTHER use a median of medians pivot. Lists of at least SORT_RADIX_MIN strings are radix sorted.
+ */
+#define SORT_INSERTION         24
+#define SORT_NINTHER           128
+#define SORT_PARTIAL_LIMIT     8
+#define SORT_RADIX_MIN         64
+#define SORT_RADIX_BUCKET      32
+#define SORT_RADIX_LEVELS      32
+
+typedef struct Sorter {
+    RSortProc cmp;
+    void *ctx;
+    size_t esize;
+    size_t unit;                /* Swap unit in bytes: 8, 4 or 1 depending on element size and alignment */
+} Sorter;
+
+typedef struct Radix {
+    char **tmp;
+    size_t *levels[SORT_RADIX_LEVELS];
+} Radix;
+
+/********************************** Forwards **********************************/
+
+static size_t commonPrefix(char **items, size_t n, size_t depth);
+static void heapSort(Sorter *sp, char *begin, char *end);
+static void insertionSort(Sorter *sp, char *begin, char *end);
+static bool partialInsertionSort(Sorter *sp, char *begin, char *end);
+static char *partitionLeft(Sorter *sp, char *begin, char *end);
+static char *partitionRight(Sorter *sp, char *begin, char *end, bool *partitioned);
+static bool presorted(char **items, size_t n);
+static void radixSort(Radix *rp, char **items, size_t n, size_t depth, int level);
+static void siftDown(Sorter *sp, char *base, size_t root, size_t n);
+static void sort3(Sorter *sp, char *a, char *b, char *c);
+static int sortLog2(size_t n);
+static void sortLoop(Sorter *sp, char *begin, char *end, int badAllowed, bool leftmost);
+static bool sortStrings(char **items, size_t n);
+static void swapElt(Sorter *sp, char *a, char *b);
+
 /************************************ Code ************************************/
 
 PUBLIC RList *rAllocList(int len, int flags)
@@ -4629,69 +6041,474 @@ PUBLIC int rGrowList(RList *lp, int size)
 
 static int defaultSort(char **q1, char **q2, void *ctx)
 {
-    return scmp(*q1, *q2);
+    if (*q1 == 0 || *q2 == 0) {
+        return scmp(*q1, *q2);
+    }
+    //  Byte order, consistent with the radix sort
+    return strcmp(*q1, *q2);
 }
 
+/*
+    Sort a list. Lists of strings using the default comparison are radix sorted.
+ */
 PUBLIC RList *rSortList(RList *lp, RSortProc cmp, void *ctx)
 {
     if (!lp) {
         return 0;
     }
     if (cmp == 0) {
+        if (lp->length >= SORT_RADIX_MIN && sortStrings((char**) lp->items, (size_t) lp->length)) {
+            return lp;
+        }
         cmp = (RSortProc) defaultSort;
     }
     rSort(lp->items, lp->length, sizeof(void*), cmp, ctx);
     return lp;
 }
 
-static void swapElt(char *a, char *b, int width)
+/*
+    Pattern-defeating quicksort (introsort). Uses median of three or ninther pivots, insertion sort for
+    small partitions and switches to heapsort after too many unbalanced partitions. Runs of equal elements
+    and already sorted input are handled in linear time. Recursion is only on the smaller partition, so
+    stack depth is bounded by log2(nelt).
+ */
+PUBLIC void *rSort(void *base, int nelt, int esize, RSortProc cmp, void *ctx)
 {
-    char tmp;
+    Sorter sorter;
+    char   *array;
+
+    if (!base || nelt < 2 || esize <= 0) {
+        return base;
+    }
+    if (!cmp) {
+        cmp = (RSortProc) defaultSort;
+    }
+    array = base;
+    sorter.cmp = cmp;
+    sorter.ctx = ctx;
+    sorter.esize = (size_t) esize;
+    if (((size_t) esize | (size_t) array) % sizeof(uint64) == 0) {
+        sorter.unit = sizeof(uint64);
+    } else if (((size_t) esize | (size_t) array) % sizeof(uint32) == 0) {
+        sorter.unit = sizeof(uint32);
+    } else {
+        sorter.unit = 1;
+    }
+    sortLoop(&sorter, array, array + (size_t) nelt * sorter.esize, sortLog2((size_t) nelt), 1);
+    return base;
+}
+
+static void sortLoop(Sorter *sp, char *begin, char *end, int badAllowed, bool leftmost)
+{
+    char   *pivot;
+    size_t es, size, half, lsize, rsize;
+    bool   partitioned;
+
+    es = sp->esize;
+    while (1) {
+        size = (size_t) (end - begin) / es;
+        if (size < SORT_INSERTION) {
+            insertionSort(sp, begin, end);
+            return;
+        }
+        /*
+            Move the pivot to the start of the partition
+         */
+        half = size / 2;
+        if (size > SORT_NINTHER) {
+            sort3(sp, begin, begin + half * es, end - es);
+            sort3(sp, begin + es, begin + (half - 1) * es, end - 2 * es);
+            sort3(sp, begin + 2 * es, begin + (half + 1) * es, end - 3 * es);
+            sort3(sp, begin + (half - 1) * es, begin + half * es, begin + (half + 1) * es);
+            swapElt(sp, begin, begin + half * es);
+        } else {
+            sort3(sp, begin + half * es, begin, end - es);
+        }
+        /*
+            If the pivot equals the element before this partition, all elements less than or equal to the
+            pivot are equal. Put them on the left and only sort the elements greater than the pivot.
+         */
+        if (!leftmost && sp->cmp(begin - es, begin, sp->ctx) >= 0) {
+            begin = partitionLeft(sp, begin, end) + es;
+            continue;
+        }
+        pivot = partitionRight(sp, begin, end, &partitioned);
+        lsize = (size_t) (pivot - begin) / es;
+        rsize = (size_t) (end - pivot) / es - 1;
+
+        if (lsize < size / 8 || rsize < size / 8) {
+            //  Unbalanced partition. Fall back to heapsort if this keeps happening, otherwise break up patterns.
+            if (--badAllowed == 0) {
+                heapSort(sp, begin, end);
+                return;
+            }
+            if (lsize >= SORT_INSERTION) {
+                swapElt(sp, begin, begin + lsize / 4 * es);
+                swapElt(sp, pivot - es, pivot - lsize / 4 * es);
+                if (lsize > SORT_NINTHER) {
+                    swapElt(sp, begin + es, begin + (lsize / 4 + 1) * es);
+                    swapElt(sp, begin + 2 * es, begin + (lsize / 4 + 2) * es);
+                    swapElt(sp, pivot - 2 * es, pivot - (lsize / 4 + 1) * es);
+                    swapElt(sp, pivot - 3 * es, pivot - (lsize / 4 + 2) * es);
+                }
+            }
+            if (rsize >= SORT_INSERTION) {
+                swapElt(sp, pivot + es, pivot + (rsize / 4 + 1) * es);
+                swapElt(sp, end - es, end - rsize / 4 * es);
+                if (rsize > SORT_NINTHER) {
+                    swapElt(sp, pivot + 2 * es, pivot + (rsize / 4 + 2) * es);
+                    swapElt(sp, pivot + 3 * es, pivot + (rsize / 4 + 3) * es);
+                    swapElt(sp, end - 2 * es, end - (rsize / 4 + 1) * es);
+                    swapElt(sp, end - 3 * es, end - (rsize / 4 + 2) * es);
+                }
+            }
+        } else if (partitioned && partialInsertionSort(sp, begin, pivot) &&
+                   partialInsertionSort(sp, pivot + es, end)) {
+            //  Balanced partition that needed no swaps. Likely already sorted.
+            return;
+        }
+        if (lsize < rsize) {
+            sortLoop(sp, begin, pivot, badAllowed, leftmost);
+            begin = pivot + es;
+            leftmost = 0;
+        } else {
+            sortLoop(sp, pivot + es, end, badAllowed, 0);
+            end = pivot;
+        }
+    }
+}
+
+/*
+    Partition around the pivot at begin. Elements less than the pivot go left and the rest right.
+    Returns the final pivot position and sets partitioned if no elements needed to be moved.
+ */
+static char *partitionRight(Sorter *sp, char *begin, char *end, bool *partitioned)
+{
+    char   *first, *last;
+    size_t es;
+
+    es = sp->esize;
+    first = begin + es;
+    last = end - es;
+
+    while (first <= last && sp->cmp(first, begin, sp->ctx) < 0) {
+        first += es;
+    }
+    while (first <= last && sp->cmp(last, begin, sp->ctx) >= 0) {
+        last -= es;
+    }
+    *partitioned = first > last;
+
+    while (first < last) {
+        swapElt(sp, first, last);
+        first += es;
+        last -= es;
+        while (first <= last && sp->cmp(first, begin, sp->ctx) < 0) {
+            first += es;
+        }
+        while (first <= last && sp->cmp(last, begin, sp->ctx) >= 0) {
+            last -= es;
+        }
+    }
+    swapElt(sp, begin, last);
+    return last;
+}
+
+/*
+    Partition around the pivot at begin. Elements less than or equal to the pivot go left.
+ */
+static char *partitionLeft(Sorter *sp, char *begin, char *end)
+{
+    char   *first, *last;
+    size_t es;
+
+    es = sp->esize;
+    first = begin + es;
+    last = end - es;
+
+    while (first <= last && sp->cmp(begin, last, sp->ctx) < 0) {
+        last -= es;
+    }
+    while (first <= last && sp->cmp(begin, first, sp->ctx) >= 0) {
+        first += es;
+    }
+    while (first < last) {
+        swapElt(sp, first, last);
+        first += es;
+        last -= es;
+        while (first <= last && sp->cmp(begin, last, sp->ctx) < 0) {
+            last -= es;
+        }
+        while (first <= last && sp->cmp(begin, first, sp->ctx) >= 0) {
+            first += es;
+        }
+    }
+    swapElt(sp, begin, last);
+    return last;
+}
+
+static void insertionSort(Sorter *sp, char *begin, char *end)
+{
+    char   *cur, *p;
+    size_t es;
+
+    es = sp->esize;
+    for (cur = begin + es; cur < end; cur += es) {
+        for (p = cur; p > begin && sp->cmp(p - es, p, sp->ctx) > 0; p -= es) {
+            swapElt(sp, p - es, p);
+        }
+    }
+}
+
+/*
+    Insertion sort that gives up if too many elements are out of place
+ */
+static bool partialInsertionSort(Sorter *sp, char *begin, char *end)
+{
+    char   *cur, *p;
+    size_t es, moves;
+
+    es = sp->esize;
+    moves = 0;
+    for (cur = begin + es; cur < end; cur += es) {
+        for (p = cur; p > begin && sp->cmp(p - es, p, sp->ctx) > 0; p -= es) {
+            swapElt(sp, p - es, p);
+        }
+        moves += (size_t) (cur - p) / es;
+        if (moves > SORT_PARTIAL_LIMIT) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void heapSort(Sorter *sp, char *begin, char *end)
+{
+    size_t es, i, n;
+
+    es = sp->esize;
+    n = (size_t) (end - begin) / es;
+    for (i = n / 2; i-- > 0; ) {
+        siftDown(sp, begin, i, n);
+    }
+    for (i = n - 1; i > 0; i--) {
+        swapElt(sp, begin, begin + i * es);
+        siftDown(sp, begin, 0, i);
+    }
+}
+
+static void siftDown(Sorter *sp, char *base, size_t root, size_t n)
+{
+    size_t child, es;
+
+    es = sp->esize;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && sp->cmp(base + child * es, base + (child + 1) * es, sp->ctx) < 0) {
+            child++;
+        }
+        if (sp->cmp(base + root * es, base + child * es, sp->ctx) >= 0) {
+            return;
+        }
+        swapElt(sp, base + root * es, base + child * es);
+        root = child;
+    }
+}
+
+/*
+    Order three elements so that a <= b <= c
+ */
+static void sort3(Sorter *sp, char *a, char *b, char *c)
+{
+    if (sp->cmp(b, a, sp->ctx) < 0) {
+        swapElt(sp, a, b);
+    }
+    if (sp->cmp(c, b, sp->ctx) < 0) {
+        swapElt(sp, b, c);
+        if (sp->cmp(b, a, sp->ctx) < 0) {
+            swapElt(sp, a, b);
+        }
+    }
+}
+
+static void swapElt(Sorter *sp, char *a, char *b)
+{
+    uint64 *la, *lb, ltmp;
+    uint32 *ia, *ib, itmp;
+    size_t width;
+    char   tmp;
 
     if (a == b) {
         return;
     }
-    while (width--) {
-        tmp = *a;
-        *a++ = *b;
-        *b++ = tmp;
+    width = sp->esize;
+    if (sp->unit == sizeof(uint64)) {
+        la = (uint64*) (void*) a;
+        lb = (uint64*) (void*) b;
+        for (width /= sizeof(uint64); width > 0; width--) {
+            ltmp = *la;
+            *la++ = *lb;
+            *lb++ = ltmp;
+        }
+    } else if (sp->unit == sizeof(uint32)) {
+        ia = (uint32*) (void*) a;
+        ib = (uint32*) (void*) b;
+        for (width /= sizeof(uint32); width > 0; width--) {
+            itmp = *ia;
+            *ia++ = *ib;
+            *ib++ = itmp;
+        }
+    } else {
+        while (width--) {
+            tmp = *a;
+            *a++ = *b;
+            *b++ = tmp;
+        }
+    }
+}
+
+static int sortLog2(size_t n)
+{
+    int log;
+
+    for (log = 0; n > 1; n >>= 1) {
+        log++;
     }
+    return log;
 }
 
 /*
-    Quicksort
+    MSD radix sort for lists of strings in byte order. The largest bucket is sorted iteratively and the
+    others recursively, so recursion depth is bounded by log2 of the list length. Small buckets and
+    deep common prefixes fall back to the comparison sort. Returns false if the list cannot be radix sorted.
  */
-PUBLIC void *rSort(void *base, int nelt, int esize, RSortProc cmp, void *ctx)
+static bool sortStrings(char **items, size_t n)
 {
-    char *array, *pivot, *left, *right, *end;
+    Radix  radix;
+    size_t i;
+    int    level;
 
-    if (nelt < 2 || esize <= 0) {
-        return base;
+    for (i = 0; i < n; i++) {
+        if (items[i] == 0) {
+            return 0;
+        }
     }
-    if (!cmp) {
-        cmp = (RSortProc) defaultSort;
+    if (presorted(items, n)) {
+        return 1;
     }
-    array = base;
-    end = array + (nelt * esize);
-    left = array;
-    right = array + ((nelt - 1) * esize);
-    pivot = array;
+    memset(&radix, 0, sizeof(radix));
+    if ((radix.tmp = rAlloc(n * sizeof(char*))) == 0) {
+        return 0;
+    }
+    radixSort(&radix, items, n, 0, 0);
+    for (level = 0; level < SORT_RADIX_LEVELS; level++) {
+        rFree(radix.levels[level]);
+    }
+    rFree(radix.tmp);
+    return 1;
+}
+
+/*
+    Return the length of the prefix common to all items. The first depth bytes are known to be common.
+ */
+static size_t commonPrefix(char **items, size_t n, size_t depth)
+{
+    cchar  *first, *s;
+    size_t i, j, len;
+
+    first = items[0];
+    len = depth + strlen(&first[depth]);
+    for (i = 1; i < n && len > depth; i++) {
+        s = items[i];
+        for (j = depth; j < len && s[j] == first[j]; j++) {}
+        len = j;
+    }
+    return len;
+}
+
+/*
+    Check for input that is already in ascending order or in strictly descending order. Descending input is
+    reversed in place.
+ */
+static bool presorted(char **items, size_t n)
+{
+    char   *tmp;
+    size_t i;
+
+    for (i = 1; i < n && strcmp(items[i - 1], items[i]) <= 0; i++) {}
+    if (i == n) {
+        return 1;
+    }
+    if (i > 1) {
+        return 0;
+    }
+    for (i = 1; i < n && strcmp(items[i - 1], items[i]) > 0; i++) {}
+    if (i < n) {
+        return 0;
+    }
+    for (i = 0; i < n / 2; i++) {
+        tmp = items[i];
+        items[i] = items[n - i - 1];
+        items[n - i - 1] = tmp;
+    }
+    return 1;
+}
+
+static void radixSort(Radix *rp, char **items, size_t n, size_t depth, int level)
+{
+    size_t *counts, i, start, size, bigStart, bigSize;
+    int    c;
 
-    while (left < right) {
-        while (left < end && cmp(left, pivot, ctx) <= 0) {
-            left += esize;
+    while (n >= SORT_RADIX_BUCKET && level < SORT_RADIX_LEVELS) {
+        if (!rp->levels[level] && (rp->levels[level] = rAlloc(257 * sizeof(size_t))) == 0) {
+            break;
         }
-        while (right > array && cmp(right, pivot, ctx) > 0) {
-            right -= esize;
+        counts = rp->levels[level];
+        memset(counts, 0, 257 * sizeof(size_t));
+        for (i = 0; i < n; i++) {
+            counts[(uchar) items[i][depth] + 1]++;
+        }
+        c = (uchar) items[0][depth];
+        if (counts[c + 1] == n) {
+            //  All items share this byte. Skip the rest of the common prefix in one pass.
+            if (c == 0) {
+                return;
+            }
+            depth = commonPrefix(items, n, depth + 1);
+            continue;
+        }
+        for (c = 1; c <= 256; c++) {
+            counts[c] += counts[c - 1];
+        }
+        //  Distribute. Afterwards counts[c] is the end of bucket c
+        for (i = 0; i < n; i++) {
+            rp->tmp[counts[(uchar) items[i][depth]]++] = items[i];
+        }
+        memcpy(items, rp->tmp, n * sizeof(char*));
+
+        //  Bucket zero holds strings that end here and are all equal
+        bigStart = bigSize = 0;
+        for (c = 1; c < 256; c++) {
+            start = counts[c - 1];
+            size = counts[c] - start;
+            if (size > bigSize) {
+                bigStart = start;
+                bigSize = size;
+            }
         }
-        if (left < right) {
-            swapElt(left, right, esize);
+        for (c = 1; c < 256; c++) {
+            start = counts[c - 1];
+            size = counts[c] - start;
+            if (size > 1 && start != bigStart) {
+                radixSort(rp, &items[start], size, depth + 1, level + 1);
+            }
         }
+        items += bigStart;
+        n = bigSize;
+        depth++;
+    }
+    if (n > 1) {
+        rSort(items, (int) n, sizeof(char*), (RSortProc) defaultSort, NULL);
     }
-    swapElt(pivot, right, esize);
-    rSort(array, (int) ((right - array) / esize), esize, cmp, ctx);
-    rSort(left, nelt - (int) ((left - array) / esize), esize, cmp, ctx);
-    return base;
 }
 
 PUBLIC char *rListToString(RList *list, cchar *join)
@@ -4764,6 +6581,44 @@ PUBLIC void rPushItem(RList *list, void *item)
     #define ME_R_LOG_SIZE  (2 * 1024 * 1024)
 #endif
 
+/*
+    Async logging requires pthreads
+ */
+#ifndef ME_R_LOG_ASYNC
+    #if ME_UNIX_LIKE && R_USE_THREAD
+        #define ME_R_LOG_ASYNC 1
+    #else
+        #define ME_R_LOG_ASYNC 0
+    #endif
+#endif
+
+#if ME_R_LOG_ASYNC
+/*
+    Single producer, single consumer ring of formatted log text. The runtime thread appends at head and the
+    writer thread consumes from tail. Both are free running byte counts masked by the ring size.
+ */
+typedef struct LogRing {
+    char *data;
+    size_t size;                        /* Ring size (power of two) */
+    uint64 head;                        /* Producer position */
+    uint64 tail;                        /* Consumer position */
+    int policy;                         /* Overflow policy */
+    int fd;                             /* Log file descriptor */
+    int sleeping;                       /* Writer is waiting for data */
+    int backup;                         /* Backup requested via rBackupLog */
+    int stop;                           /* Writer should drain and exit */
+    char *path;                         /* Log file path for backups (may be null) */
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} LogRing;
+
+static LogRing *logRing;                /* Async log ring when enabled */
+static int     logPolicy = R_LOG_COUNT; /* Current overflow policy */
+static uint64  logDropped;              /* Messages dropped because the ring was full */
+static uint64  logReported;             /* Dropped messages already reported (R_LOG_COUNT) */
+#endif
+
 static RLogHandler rLogHandler = rDefaultLogHandler;
 
 static RHash *logTypes;                /* Hash of message types */
@@ -4775,6 +6630,38 @@ static int   logFd = -1;               /* stdout */
 static bool  rTimeouts = 1;            /* Enable timeouts */
 static bool  sticky = 0;               /* Forced settings are sticky */
 
+PUBLIC uint rLogFilterGen = 2;          /* Log filter generation for call site caches */
+
+/*
+    Log formats are compiled into a list of operations by rSetLogFormat
+ */
+#ifndef ME_R_LOG_OPS
+    #define ME_R_LOG_OPS 32             /* Max compiled format operations */
+#endif
+
+#define LOG_OP_TEXT   0                 /* Literal text */
+#define LOG_OP_APP    1                 /* %A application name */
+#define LOG_OP_TICKS  2                 /* %C clock ticks */
+#define LOG_OP_DATE   3                 /* %D local date */
+#define LOG_OP_MSG    4                 /* %M message */
+#define LOG_OP_SOURCE 5                 /* %S message source */
+#define LOG_OP_TYPE   6                 /* %T message type */
+#define LOG_OP_PID    7                 /* %P process ID */
+
+typedef struct LogOp {
+    int code;                           /* Operation code */
+    size_t len;                         /* Length of literal text */
+    cchar *text;                        /* Literal text in logText */
+} LogOp;
+
+static LogOp  logOps[ME_R_LOG_OPS];     /* Compiled logFormat */
+static int    logOpCount;               /* Number of compiled operations */
+static char   *logText;                 /* Compiled literal text */
+static char   logHost[256];             /* Cached hostname */
+static char   logDate[64];              /* Cached date for logDateSecond */
+static size_t logDateLen;               /* Length of logDate */
+static Time   logDateSecond = -1;       /* Second of the cached date */
+
 static const char *errors[] = {
     "R_ERR_OK",
     "R_ERR_BASE",
@@ -4827,6 +6714,23 @@ static void closeLog(void);
 static int  allocLog(void);
 static void freeLog(void);
 static int  openLog(cchar *path);
+static void writeLog(cchar *msg, size_t len);
+static int compileLogFormat(cchar *format);
+static void emitLog(cchar *type, cchar *source, cchar *fmt, va_list args);
+static int  localTime(struct tm *timep, Time time);
+static void putLogDate(RBuf *buf);
+
+#if ME_R_LOG_ASYNC
+static void backupAsync(LogRing *ring);
+static void flushAtExit(void);
+static void forkAsync(void);
+static int  parseLogPolicy(cchar *option);
+static bool queueLog(LogRing *ring, cchar *msg, size_t len);
+static int  startAsync(int policy);
+static void stopAsync(void);
+static void wakeWriter(LogRing *ring);
+static void *writerMain(void *arg);
+#endif
 
 /************************************ Code ************************************/
 
@@ -4856,6 +6760,9 @@ PUBLIC int rInitLog(void)
 
 PUBLIC void rTermLog(void)
 {
+#if ME_R_LOG_ASYNC
+    stopAsync();
+#endif
     closeLog();
     freeLog();
 }
@@ -4878,8 +6785,12 @@ static void freeLog(void)
     logBuf = 0;
     logTypes = 0;
     logSources = 0;
+    rLogFilterGen += 2;
     logPath = 0;
     logFormat = 0;
+    rFree(logText);
+    logText = 0;
+    logOpCount = 0;
 }
 
 /*
@@ -4887,8 +6798,9 @@ static void freeLog(void)
  */
 PUBLIC int rSetLog(cchar *path, cchar *format, bool force)
 {
-    char *filter, *sources, *types;
+    char *filter, *option, *sources, *types;
     char localPath[ME_MAX_FNAME];
+    int  policy;
 
     if (sticky && !force) {
         //  Silently ignore because command line has overridden
@@ -4905,6 +6817,15 @@ PUBLIC int rSetLog(cchar *path, cchar *format, bool force)
     scopy(localPath, sizeof(localPath), path);
     stok(localPath, ":", &filter);
 
+    policy = -1;
+    if (filter && sstarts(filter, "async") && (filter[5] == '\0' || filter[5] == ':' || filter[5] == '=')) {
+        option = stok(filter, ":", &filter);
+#if ME_R_LOG_ASYNC
+        policy = parseLogPolicy(option);
+#else
+        (void) option;
+#endif
+    }
     if (filter) {
         types = stok(filter, ":", &sources);
         if (types && !sources) {
@@ -4916,6 +6837,10 @@ PUBLIC int rSetLog(cchar *path, cchar *format, bool force)
         return R_ERR_CANT_OPEN;
     }
     rSetLogFormat(format, force);
+    if (policy >= 0) {
+        //  Only change the async state if requested so async logging enabled via rSetLogAsync is preserved
+        rSetLogAsync(1, policy);
+    }
     if (force) {
         sticky = 1;
     }
@@ -4934,14 +6859,123 @@ PUBLIC void rSetLogFormat(cchar *format, bool force)
     } else if (!logFormat) {
         logFormat = sclone(R_LOG_FORMAT);
     }
+    if (compileLogFormat(logFormat) < 0) {
+        //  Revert to the default format so the error and later messages are complete
+        rFree(logFormat);
+        logFormat = sclone(R_LOG_FORMAT);
+        compileLogFormat(logFormat);
+        rError("log", "Log format has more than %d items, using the default format", ME_R_LOG_OPS);
+    }
+}
+
+/*
+    Compile the log format into operations so rFormatLog does not reparse it for every message.
+    The hostname is constant and is rendered into the literal text. The process ID is rendered per message
+    as forked processes inherit the compiled format. Adjacent literals are merged.
+    Returns R_ERR_WONT_FIT if the format needs more than ME_R_LOG_OPS operations.
+ */
+static int compileLogFormat(cchar *format)
+{
+    LogOp  *op;
+    cchar  *cp, *text;
+    char   *tp;
+    size_t len;
+    int    code;
+
+    logOpCount = 0;
+    rFree(logText);
+    logText = 0;
+    if (!format) {
+        return 0;
+    }
+    for (len = slen(format) + 1, cp = format; (cp = schr(cp, '%')) != 0 && cp[1]; cp += 2) {
+        len += cp[1] == 'H' ? sizeof(logHost) : 0;
+    }
+    if ((logText = rAlloc(len)) == 0) {
+        return R_ERR_MEMORY;
+    }
+    tp = logText;
+    for (cp = format; *cp; cp++) {
+        text = cp;
+        len = 1;
+        code = LOG_OP_TEXT;
+        if (*cp == '%') {
+            switch (*++cp) {
+            case '\0':
+                cp--;
+                len = 0;
+                break;
+            case 'A':
+                code = LOG_OP_APP;
+                break;
+            case 'C':
+                code = LOG_OP_TICKS;
+                break;
+            case 'D':
+                code = LOG_OP_DATE;
+                break;
+            case 'H':
+                if (logHost[0] == '\0') {
+                    if (gethostname(logHost, sizeof(logHost)) != 0) {
+                        logHost[0] = '\0';
+                    }
+                    logHost[sizeof(logHost) - 1] = '\0';
+                }
+                text = logHost;
+                len = slen(logHost);
+                break;
+            case 'M':
+                code = LOG_OP_MSG;
+                break;
+            case 'P':
+                code = LOG_OP_PID;
+                break;
+            case 'S':
+                code = LOG_OP_SOURCE;
+                break;
+            case 'T':
+                code = LOG_OP_TYPE;
+                break;
+            default:
+                //  Unknown tokens are emitted without the "%"
+                text = cp;
+                break;
+            }
+        }
+        if (code == LOG_OP_TEXT && logOpCount > 0 && logOps[logOpCount - 1].code == LOG_OP_TEXT) {
+            op = &logOps[logOpCount - 1];
+        } else if (logOpCount >= ME_R_LOG_OPS) {
+            return R_ERR_WONT_FIT;
+        } else {
+            op = &logOps[logOpCount++];
+            op->code = code;
+            op->text = tp;
+            op->len = 0;
+        }
+        if (code == LOG_OP_TEXT) {
+            memcpy(tp, text, len);
+            tp += len;
+            op->len += len;
+        }
+    }
+    return 0;
 }
 
 PUBLIC int rSetLogPath(cchar *path, bool force)
 {
+    bool async;
+
     if (sticky && !force) {
         //  Silently ignore because command line has overridden
         return 0;
     }
+#if ME_R_LOG_ASYNC
+    //  Drain queued messages to the old log before switching
+    async = logRing != 0;
+    stopAsync();
+#else
+    async = 0;
+#endif
     closeLog();
     rFree(logPath);
     logPath = 0;
@@ -4961,6 +6995,9 @@ PUBLIC int rSetLogPath(cchar *path, bool force)
         }
         logPath = sclone(path);
     }
+    if (async) {
+        rSetLogAsync(1, -1);
+    }
     if (force) {
         sticky = 1;
     }
@@ -4991,6 +7028,7 @@ PUBLIC void rSetLogFilter(cchar *types, cchar *sources, bool force)
      */
     rFreeHash(logTypes);
     rFreeHash(logSources);
+    rLogFilterGen += 2;
     logTypes = rAllocHash(0, R_HASH_CASELESS);
     logSources = rAllocHash(0, R_HASH_CASELESS);
     if (!logTypes || !logSources) {
@@ -5097,80 +7135,101 @@ PUBLIC bool rEmitLog(cchar *type, cchar *source)
     return 1;
 }
 
+/*
+    Test a log call site and cache the result until the log filter changes
+ */
+PUBLIC bool rEmitLogSite(uint *site, cchar *type, cchar *source)
+{
+    bool enable;
+
+    enable = rEmitLog(type, source);
+    if (site) {
+        *site = rLogFilterGen | (enable ? 1 : 0);
+    }
+    return enable;
+}
+
+/*
+    Format a log message using the compiled log format. This does not allocate memory unless the buffer must grow.
+ */
 PUBLIC RBuf *rFormatLog(RBuf *buf, cchar *type, cchar *source, cchar *msg)
 {
-    static char host[256] = { 0 };
-    static int  pid = 0;
-    char        *data;
-    cchar       *cp, *name;
+    LogOp  *op, *end;
+    size_t len;
 
-    name = rGetAppName();
     rFlushBuf(buf);
 
     if (smatch(type, "raw")) {
         rPutStringToBuf(buf, msg);
-
-    } else {
-        for (cp = logFormat; cp && *cp; cp++) {
-            if (*cp != '%') {
-                rPutCharToBuf(buf, *cp);
-                continue;
-            }
-            switch (*++cp) {
-            case 'A':
-                rPutStringToBuf(buf, name);
-                break;
-            case 'C':
-                //  Clock ticks
-                rPutIntToBuf(buf, (int64) rGetTicks());
-                break;
-            case 'D':
-                data = rFormatLocalTime(R_SYSLOG_DATE, rGetTime());
-                rPutStringToBuf(buf, data);
-                rFree(data);
-                break;
-            case 'S':   /* Alias for source */
-                rPutStringToBuf(buf, source);
-                break;
-            case 'H':
-                if (host[0] == '\0') {
-                    if (gethostname(host, sizeof(host)) != 0) {
-                        host[0] = '\0';
-                    }
-                    host[sizeof(host) - 1] = '\0';
-                }
-                rPutStringToBuf(buf, host);
-                break;
-            case 'M':
-                rPutStringToBuf(buf, msg);
-                if (*msg && msg[slen(msg) - 1] != '\n') {
-                    rPutCharToBuf(buf, '\n');
-                }
-                break;
-            case 'P':
-                if (!pid) {
-                    pid = getpid();
-                }
-                rPutIntToBuf(buf, pid);
-                break;
-            case 'T':
-                rPutStringToBuf(buf, type);
-                break;
-            case '\0':
-                break;
-            default:
-                rPutCharToBuf(buf, *cp);
-                break;
+        return buf;
+    }
+    for (op = logOps, end = &logOps[logOpCount]; op < end; op++) {
+        switch (op->code) {
+        case LOG_OP_TEXT:
+            rPutBlockToBuf(buf, op->text, op->len);
+            break;
+        case LOG_OP_APP:
+            rPutStringToBuf(buf, rGetAppName());
+            break;
+        case LOG_OP_TICKS:
+            rPutIntToBuf(buf, (int64) rGetTicks());
+            break;
+        case LOG_OP_DATE:
+            putLogDate(buf);
+            break;
+        case LOG_OP_MSG:
+            len = slen(msg);
+            rPutBlockToBuf(buf, msg, len);
+            if (len > 0 && msg[len - 1] != '\n') {
+                rPutCharToBuf(buf, '\n');
             }
+            break;
+        case LOG_OP_SOURCE:
+            rPutStringToBuf(buf, source);
+            break;
+        case LOG_OP_TYPE:
+            rPutStringToBuf(buf, type);
+            break;
+        case LOG_OP_PID:
+            rPutIntToBuf(buf, (int64) getpid());
+            break;
         }
     }
     return buf;
 }
 
+/*
+    Render the date. The rendered text is reused for all messages in the same second.
+ */
+static void putLogDate(RBuf *buf)
+{
+    struct tm tm;
+    Time      now, second;
+
+    now = rGetTime();
+    second = now / TPS;
+    if (second != logDateSecond) {
+        if (localTime(&tm, now) < 0) {
+            return;
+        }
+        logDateLen = strftime(logDate, sizeof(logDate), R_SYSLOG_DATE, &tm);
+        logDateSecond = second;
+    }
+    rPutBlockToBuf(buf, logDate, logDateLen);
+}
+
 PUBLIC void rBackupLog(void)
 {
     struct stat info;
 
+#if ME_R_LOG_ASYNC
+    if (logRing) {
+        //  The writer thread performs the backup so the caller is not blocked
+        __atomic_store_n(&logRing->backup, 1, __ATOMIC_SEQ_CST);
+        wakeWriter(logRing);
+        return;
+    }
+#endif
     if (logFd > 2 && fstat(logFd, &info) == 0 && info.st_size >= ME_R_LOG_SIZE) {
         closeLog();
         rBackupFile(logPath, ME_R_LOG_COUNT);
@@ -5184,12 +7243,12 @@ PUBLIC void rBackupLog(void)
 PUBLIC void rDefaultLogHandler(cchar *type, cchar *source, cchar *msg)
 {
     rFormatLog(logBuf, type, source, msg);
-    msg = rBufToString(logBuf);
-    if (logFd > 1) {
-        write(logFd, msg, (uint) rGetBufLength(logBuf));
-    } else {
-        rPrintf("%s", rBufToString(logBuf));
+    writeLog(rBufToString(logBuf), rGetBufLength(logBuf));
+#if ME_R_LOG_ASYNC
+    if (logRing && smatch(type, "fatal")) {
+        rFlushLog();
     }
+#endif
 #if ME_DEBUG
     if (smatch(type, "error") || smatch(type, "fatal")) {
         rBreakpoint();
@@ -5197,6 +7256,318 @@ PUBLIC void rDefaultLogHandler(cchar *type, cchar *source, cchar *msg)
 #endif
 }
 
+/*
+    Write formatted log text to the log file or queue it for the async writer
+ */
+static void writeLog(cchar *msg, size_t len)
+{
+#if ME_R_LOG_ASYNC
+    if (logRing && queueLog(logRing, msg, len)) {
+        return;
+    }
+#endif
+    if (logFd > 1) {
+        write(logFd, msg, (uint) len);
+    } else {
+        rPrintf("%s", msg);
+    }
+}
+
+#if ME_R_LOG_ASYNC
+PUBLIC int rSetLogAsync(bool enable, int policy)
+{
+    if (policy >= 0) {
+        logPolicy = policy;
+    }
+    if (!enable) {
+        stopAsync();
+        return 0;
+    }
+    if (logRing) {
+        logRing->policy = logPolicy;
+        return 0;
+    }
+    return startAsync(logPolicy);
+}
+
+PUBLIC void rFlushLog(void)
+{
+    LogRing         *ring;
+    struct timespec delay = { 0, 100 * 1000 };
+
+    if ((ring = logRing) == 0) {
+        return;
+    }
+    while (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) != ring->head) {
+        wakeWriter(ring);
+        nanosleep(&delay, NULL);
+    }
+}
+
+PUBLIC uint64 rGetLogDropped(void)
+{
+    return __atomic_load_n(&logDropped, __ATOMIC_RELAXED);
+}
+
+static int parseLogPolicy(cchar *option)
+{
+    cchar *value;
+
+    if ((value = schr(option, '=')) != 0) {
+        value++;
+        if (smatch(value, "block")) {
+            return R_LOG_BLOCK;
+        } else if (smatch(value, "drop")) {
+            return R_LOG_DROP;
+        }
+    }
+    return R_LOG_COUNT;
+}
+
+static int startAsync(int policy)
+{
+    static bool registered = 0;
+    LogRing     *ring;
+
+    if ((ring = rAllocType(LogRing)) == 0) {
+        return R_ERR_MEMORY;
+    }
+    ring->size = ME_R_LOG_RING;
+    if ((ring->size & (ring->size - 1)) != 0 || (ring->data = rAlloc(ring->size)) == 0) {
+        rFree(ring);
+        return R_ERR_MEMORY;
+    }
+    ring->policy = policy;
+    ring->fd = logFd > 1 ? logFd : 1;
+    ring->path = logFd > 2 ? sclone(logPath) : NULL;
+    pthread_mutex_init(&ring->mutex, NULL);
+    pthread_cond_init(&ring->cond, NULL);
+    if (pthread_create(&ring->thread, NULL, writerMain, ring) != 0) {
+        pthread_cond_destroy(&ring->cond);
+        pthread_mutex_destroy(&ring->mutex);
+        rFree(ring->path);
+        rFree(ring->data);
+        rFree(ring);
+        return R_ERR_CANT_CREATE;
+    }
+    if (!registered) {
+        //  Write queued messages if the app exits, including via rFatal
+        atexit(flushAtExit);
+        //  The writer thread is not inherited by forked children
+        pthread_atfork(NULL, NULL, forkAsync);
+        registered = 1;
+    }
+    logRing = ring;
+    return 0;
+}
+
+/*
+    Drain the ring, stop the writer and revert to synchronous writes
+ */
+static void stopAsync(void)
+{
+    LogRing *ring;
+
+    if ((ring = logRing) == 0) {
+        return;
+    }
+    logRing = 0;
+    __atomic_store_n(&ring->stop, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&ring->mutex);
+    pthread_cond_signal(&ring->cond);
+    pthread_mutex_unlock(&ring->mutex);
+    pthread_join(ring->thread, NULL);
+
+    pthread_cond_destroy(&ring->cond);
+    pthread_mutex_destroy(&ring->mutex);
+    rFree(ring->path);
+    rFree(ring->data);
+    rFree(ring);
+}
+
+static void flushAtExit(void)
+{
+    stopAsync();
+}
+
+/*
+    Restart the writer in a forked child. The inherited ring has no writer and its mutex may have been held by
+    the parent's writer when forked, so it is abandoned. Queued messages are written by the parent.
+ */
+static void forkAsync(void)
+{
+    LogRing *ring;
+
+    if ((ring = logRing) == 0) {
+        return;
+    }
+    logRing = 0;
+    rFree(ring->path);
+    rFree(ring->data);
+    rFree(ring);
+    if (startAsync(logPolicy) < 0) {
+        //  Fall back to synchronous writes
+        logRing = 0;
+    }
+}
+
+/*
+    Append a message to the ring. Returns false if the message must be written synchronously.
+ */
+static bool queueLog(LogRing *ring, cchar *msg, size_t len)
+{
+    struct timespec delay = { 0, 50 * 1000 };
+    char            note[80];
+    uint64          head, tail;
+    size_t          offset, first, nlen;
+    bool            empty;
+
+    if (len > ring->size / 2) {
+        //  Too big to queue. Preserve ordering by draining first.
+        rFlushLog();
+        return 0;
+    }
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (ring->policy == R_LOG_COUNT && logDropped != logReported) {
+        nlen = (size_t) sfmtbuf(note, sizeof(note), "Log dropped %lld messages\n", (int64) (logDropped - logReported));
+        if (ring->size - (size_t) (head - tail) >= nlen + len) {
+            logReported = logDropped;
+            queueLog(ring, note, nlen);
+            head = ring->head;
+        }
+    }
+    while (ring->size - (size_t) (head - tail) < len) {
+        if (ring->policy != R_LOG_BLOCK) {
+            __atomic_store_n(&logDropped, logDropped + 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+        wakeWriter(ring);
+        nanosleep(&delay, NULL);
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    }
+    empty = head == tail;
+    offset = (size_t) head & (ring->size - 1);
+    first = min(len, ring->size - offset);
+    memcpy(&ring->data[offset], msg, first);
+    memcpy(ring->data, &msg[first], len - first);
+    __atomic_store_n(&ring->head, head + len, __ATOMIC_SEQ_CST);
+    if (empty) {
+        wakeWriter(ring);
+    }
+    return 1;
+}
+
+/*
+    Wake the writer if it is waiting. The writer sets sleeping under the mutex before re-checking for data,
+    so either it sees the new head or this sees sleeping and signals.
+ */
+static void wakeWriter(LogRing *ring)
+{
+    if (__atomic_load_n(&ring->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&ring->mutex);
+        pthread_cond_signal(&ring->cond);
+        pthread_mutex_unlock(&ring->mutex);
+    }
+}
+
+/*
+    Writer thread. Writes all queued text in one writev per wakeup.
+ */
+static void *writerMain(void *arg)
+{
+    LogRing         *ring;
+    struct iovec    iov[2];
+    struct timespec deadline;
+    uint64          head, tail;
+    size_t          len, offset;
+    ssize           written;
+    int             count, retries;
+
+    ring = arg;
+    while (1) {
+        pthread_mutex_lock(&ring->mutex);
+        __atomic_store_n(&ring->sleeping, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == ring->tail &&
+               !__atomic_load_n(&ring->stop, __ATOMIC_SEQ_CST) &&
+               !__atomic_load_n(&ring->backup, __ATOMIC_SEQ_CST)) {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec++;
+            pthread_cond_timedwait(&ring->cond, &ring->mutex, &deadline);
+        }
+        __atomic_store_n(&ring->sleeping, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&ring->mutex);
+
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        tail = ring->tail;
+        retries = 0;
+        while (tail < head) {
+            len = (size_t) (head - tail);
+            offset = (size_t) tail & (ring->size - 1);
+            iov[0].iov_base = &ring->data[offset];
+            iov[0].iov_len = min(len, ring->size - offset);
+            iov[1].iov_base = ring->data;
+            iov[1].iov_len = len - iov[0].iov_len;
+            count = iov[1].iov_len ? 2 : 1;
+            if ((written = writev(ring->fd, iov, count)) < 0) {
+                if (errno == EINTR || (errno == EAGAIN && ++retries < 100)) {
+                    continue;
+                }
+                //  Cannot write. Discard rather than spin.
+                written = (ssize) len;
+            }
+            tail += (uint64) written;
+            __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+        }
+        if (__atomic_load_n(&ring->backup, __ATOMIC_SEQ_CST)) {
+            backupAsync(ring);
+        }
+        if (__atomic_load_n(&ring->stop, __ATOMIC_SEQ_CST) &&
+            __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring->tail) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/*
+    Backup the log file from the writer thread. The new file is moved onto the same descriptor so
+    rGetLogFile() remains valid.
+ */
+static void backupAsync(LogRing *ring)
+{
+    struct stat info;
+    int         fd;
+
+    __atomic_store_n(&ring->backup, 0, __ATOMIC_SEQ_CST);
+    if (!ring->path || fstat(ring->fd, &info) != 0 || info.st_size < ME_R_LOG_SIZE) {
+        return;
+    }
+    rBackupFile(ring->path, ME_R_LOG_COUNT);
+    if ((fd = open(ring->path, O_APPEND | O_CREAT | O_WRONLY | O_TEXT, 0600)) >= 0) {
+        dup2(fd, ring->fd);
+        close(fd);
+    }
+}
+
+#else /* !ME_R_LOG_ASYNC */
+
+PUBLIC int rSetLogAsync(bool enable, int policy)
+{
+    return enable ? R_ERR_BAD_STATE : 0;
+}
+
+PUBLIC void rFlushLog(void)
+{
+}
+
+PUBLIC uint64 rGetLogDropped(void)
+{
+    return 0;
+}
+#endif /* ME_R_LOG_ASYNC */
+
 PUBLIC void rLogConfig(void)
 {
     rTrace("app", ME_TITLE " Configuration");
@@ -5234,102 +7605,113 @@ PUBLIC void rBreakpoint(void)
 
 PUBLIC void rLog(cchar *type, cchar *source, cchar *fmt, ...)
 {
-    char *buf;
+    va_list args;
 
     if (rEmitLog(type, source)) {
-        va_list args;
         va_start(args, fmt);
-        if (rVsaprintf(&buf, 0, fmt, args) >= 0) {
-            (rLogHandler) (type, source, buf);
-            rFree(buf);
-        }
+        emitLog(type, source, fmt, args);
         va_end(args);
     }
 }
 
 PUBLIC void rLogv(cchar *type, cchar *source, cchar *fmt, va_list args)
 {
-    char *buf;
-
     if (rEmitLog(type, source)) {
-        if (rVsaprintf(&buf, 0, fmt, args) >= 0) {
-            (rLogHandler) (type, source, buf);
-            rFree(buf);
-        }
+        emitLog(type, source, fmt, args);
+    }
+}
+
+/*
+    Format the message on the stack and pass to the log handler. Only messages longer than
+    ME_MAX_LOG_LINE are allocated.
+ */
+static void emitLog(cchar *type, cchar *source, cchar *fmt, va_list args)
+{
+    va_list copy;
+    char    line[ME_MAX_LOG_LINE], *buf;
+    ssize   len;
+
+    va_copy(copy, args);
+    len = rVsnprintf(line, sizeof(line), fmt, copy);
+    va_end(copy);
+
+    if (len >= 0 && (size_t) len < sizeof(line)) {
+        (rLogHandler) (type, source, line);
+
+    } else if (rVsaprintf(&buf, 0, fmt, args) >= 0) {
+        (rLogHandler) (type, source, buf);
+        rFree(buf);
     }
 }
 
 /*
-    Emit a log message to create an AWS metric via EMT log format
+    Emit a log message to create an AWS metric via EMF log format.
+    The message is followed by a single line JSON document. Numeric values are metrics, other values are properties.
  */
 PUBLIC void rMetrics(cchar *message, cchar *namespace, cchar *dimensions, cchar *values, ...)
 {
     RBuf    *buf;
     va_list args;
-    cchar   *key, *type, *value;
-    int64   i64value;
-    int     ivalue;
+    cchar   *key, *type;
+    char    *dims, *dim, *tok;
+    int     count;
 
     if ((buf = rAllocBuf(1024)) == 0) {
         return;
     }
-    rPutToBuf(buf,
-              "%s\n\
-        _aws: {\n\
-            Timestamp: %lld,\n\
-            CloudWatchMetrics: [{\n\
-                Dimensions: [dimensions],\n\
-                Namespace: %s,\n",
-              message,
-              rGetTime(), namespace);
-
-    if (dimensions) {
-        rPutToBuf(buf, "Dimensions: [[%s]]\n,", dimensions);
+    if (message) {
+        rPutToBuf(buf, "%s\n", message);
+    }
+    rPutToBuf(buf, "{\"_aws\":{\"Timestamp\":%lld,\"CloudWatchMetrics\":[{\"Namespace\":\"%s\",\"Dimensions\":[[",
+              rGetTime(), namespace ? namespace : "");
+    dims = sclone(dimensions);
+    for (count = 0, dim = stok(dims, ", \t", &tok); dim; dim = stok(NULL, ", \t", &tok)) {
+        rPutToBuf(buf, "%s\"%s\"", count++ ? "," : "", dim);
     }
-    rPutToBuf(buf, "Metrics: [");
+    rFree(dims);
+    rPutStringToBuf(buf, "]],\"Metrics\":[");
 
     va_start(args, values);
-    do {
-        key = va_arg(args, cchar*);
-        (void) va_arg(args, cchar*);
-        value = va_arg(args, void*);
-        rPutToBuf(buf, "{\"Name\": \"%s\"},", key);
-    } while (key && value);
-    va_end(args);
-    if (rGetBufLength(buf) > 0) {
-        rAdjustBufEnd(buf, -1);
+    for (count = 0; (key = va_arg(args, cchar*)) != 0; ) {
+        type = va_arg(args, cchar*);
+        if (smatch(type, "int")) {
+            (void) va_arg(args, int);
+        } else if (smatch(type, "int64")) {
+            (void) va_arg(args, int64);
+        } else if (smatch(type, "double")) {
+            (void) va_arg(args, double);
+        } else {
+            (void) va_arg(args, cchar*);
+            continue;
+        }
+        rPutToBuf(buf, "%s{\"Name\":\"%s\"}", count++ ? "," : "", key);
     }
-
-    rPutStringToBuf(buf, "]}]},\n");
+    va_end(args);
+    rPutStringToBuf(buf, "]}]}");
 
     va_start(args, values);
-    do {
-        key = va_arg(args, cchar*);
+    while ((key = va_arg(args, cchar*)) != 0) {
         type = va_arg(args, cchar*);
         if (smatch(type, "int")) {
-            ivalue = va_arg(args, int);
-            rPutToBuf(buf, "\"%s\": %d", key, ivalue);
-            value = NULL;
+            rPutToBuf(buf, ",\"%s\":%d", key, va_arg(args, int));
 
         } else if (smatch(type, "int64")) {
-            i64value = va_arg(args, int64);
-            rPutToBuf(buf, "\"%s\": %lld", key, i64value);
-            value = NULL;
+            rPutToBuf(buf, ",\"%s\":%lld", key, va_arg(args, int64));
+
+        } else if (smatch(type, "double")) {
+            rPutToBuf(buf, ",\"%s\":%g", key, va_arg(args, double));
 
         } else if (smatch(type, "boolean")) {
-            value = va_arg(args, cchar*);
-            rPutToBuf(buf, "\"%s\": %s", key, value);
+            rPutToBuf(buf, ",\"%s\":%s", key, va_arg(args, cchar*));
+
         } else {
-            value = va_arg(args, cchar*);
-            rPutToBuf(buf, "\"%s\": \"%s\"", key, value);
+            rPutToBuf(buf, ",\"%s\":\"%s\"", key, va_arg(args, cchar*));
         }
-    } while (key && type);
-    if (rGetBufLength(buf) > 0) {
-        rAdjustBufEnd(buf, -1);
     }
+    va_end(args);
     rPutStringToBuf(buf, "}\n");
 
-    write(logFd, rBufToString(buf), (uint) rGetBufLength(buf));
+    writeLog(rBufToString(buf), rGetBufLength(buf));
     rFreeBuf(buf);
 }
 
@@ -6384,7 +8766,97 @@ PUBLIC void mbedDummy(void)
 
 /*********************************** Locals **********************************/
 
+/*
+    Object pool. Objects are carved from slabs and recycled via a free list that is only used by the main thread.
+    Foreign threads push freed objects onto the remote list which the main thread claims when the free list is empty.
+ */
+struct RPool {
+    size_t size;                //  Object size (size class)
+    void *free;                 //  Free list linked through the first word of each object
+    void *volatile remote;      //  Objects freed by foreign threads
+    void *slabList;             //  Slabs linked through the slab header
+    int freeCount;              //  Objects on the free list
+    int slabs;                  //  Number of slabs
+    int64 objects;              //  Objects carved from slabs
+    int64 allocs;               //  Allocations on the main thread
+    volatile int64 foreign;     //  Objects allocated via malloc by foreign threads
+    bool passthrough;           //  Objects are too large for slabs or pools are disabled
+};
+
+/*
+    Arena block. Blocks are linked from the current block. The first block is retained on reset.
+ */
+typedef struct RArenaBlock {
+    struct RArenaBlock *next;   //  Previous (older) block
+    size_t size;                //  Size of the data area
+} RArenaBlock;
+
+/*
+    Bump-pointer arena
+ */
+struct RArena {
+    RArenaBlock *blocks;        //  Current block
+    RArenaBlock *first;         //  First block which is retained on reset
+    char *pos;                  //  Next free byte in the current block
+    char *end;                  //  End of the current block
+    size_t blockSize;           //  Default data size of new blocks
+    size_t used;                //  Bytes allocated since the last reset
+    int64 allocs;               //  Allocations since the last reset
+};
+
+#define ARENA_ALIGN(n)        R_ALLOC_ALIGN(n, sizeof(void*) * 2)
+#define ARENA_HEADER          ARENA_ALIGN(sizeof(RArenaBlock))
+
 static RMemProc memHandler;
+static RPool    *pools[R_POOL_CLASSES + 1];    //  Indexed by size class. Index zero is unused.
+
+#if ME_R_MEM_TAGS
+/*
+    Accounting header prefixed to each block. Sized to preserve the malloc alignment of the user block.
+ */
+typedef struct RMemHeader {
+    size_t size;                //  User block size
+    uint32 tag;                 //  Accounting tag
+    uint32 magic;               //  Set while the block is allocated
+} RMemHeader;
+
+typedef struct MemTag {
+    volatile int64 bytes;       //  Live bytes
+    volatile int64 blocks;      //  Live blocks
+    volatile int64 allocs;      //  Total allocations
+    int64 peak;                 //  Peak live bytes (approximate if foreign threads allocate)
+} MemTag;
+
+#define R_MEM_HEADER          R_ALLOC_ALIGN(sizeof(RMemHeader), 16)
+#define R_MEM_MAGIC           0x4D454D54
+#define MEM_OVERHEAD          R_MEM_HEADER
+#define GET_HEADER(ptr)       ((RMemHeader*) (void*) ((char*) (ptr) - R_MEM_HEADER))
+
+static MemTag memTags[R_MEM_TAGS];
+static cchar  *memTagNames[R_MEM_TAGS] = { "other", "pool", "web", "db", "json", "mqtt", "url" };
+static int    memTag;                           //  Tag of the running fiber
+#else
+#define MEM_OVERHEAD          0
+#endif
+
+#if ME_R_MEM_TAGS && R_USE_EVENT
+static REvent memReportEvent;
+static Ticks  memReportPeriod;
+#endif
+
+/*********************************** Forwards *********************************/
+
+static void *growArena(RArena *arena, size_t size);
+static void growPool(RPool *pool);
+static bool inSlab(RPool *pool, void *ptr);
+static void pushFree(RPool *pool, void *ptr);
+
+#if ME_R_MEM_TAGS
+static void *tagBlock(RMemHeader *hp, size_t size);
+#if R_USE_EVENT
+static void memReport(void *arg);
+#endif
+#endif
 
 /************************************ Code ************************************/
 
@@ -6394,7 +8866,7 @@ PUBLIC void *rAllocMem(size_t size)
     size_t aligned;
 
     // Check for overflow before alignment
-    if (size > SIZE_MAX - 8) {
+    if (size > SIZE_MAX - 8 - MEM_OVERHEAD) {
         rAllocException(R_MEM_FAIL, size);
         return 0;
     }
@@ -6410,14 +8882,17 @@ PUBLIC void *rAllocMem(size_t size)
     size = aligned;
 #if ESP32
     //  Allocate memory from PSIRAM
-    ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    ptr = heap_caps_malloc(size + MEM_OVERHEAD, MALLOC_CAP_SPIRAM);
 #else
-    ptr = malloc(size);
+    ptr = malloc(size + MEM_OVERHEAD);
 #endif
     if (ptr == 0) {
         rAllocException(R_MEM_FAIL, size);
         return 0;
     }
+#if ME_R_MEM_TAGS
+    ptr = tagBlock(ptr, size);
+#endif
 #if ME_FIBER_GUARD_PAD
     rCheckFiber();
 #endif
@@ -6426,9 +8901,25 @@ PUBLIC void *rAllocMem(size_t size)
 
 PUBLIC void rFreeMem(void *ptr)
 {
+#if ME_R_MEM_TAGS
+    RMemHeader *hp;
+    MemTag     *mp;
+
+    if (ptr) {
+        //  Blocks must come from rAlloc. Memory from system APIs must be released via free().
+        hp = GET_HEADER(ptr);
+        assert(hp->magic == R_MEM_MAGIC);
+        hp->magic = 0;
+        mp = &memTags[hp->tag];
+        rAtomicAdd64(&mp->bytes, -(int64) hp->size);
+        rAtomicAdd64(&mp->blocks, -1);
+        free(hp);
+    }
+#else
     if (ptr) {
         free(ptr);
     }
+#endif
 }
 
 PUBLIC void *rMemdup(cvoid *ptr, size_t usize)
@@ -6488,8 +8979,13 @@ PUBLIC void *rReallocMem(void *mem, size_t size)
 {
     void   *ptr;
     size_t aligned;
+#if ME_R_MEM_TAGS
+    RMemHeader *hp;
+    MemTag     *mp;
+    size_t     prior;
+#endif
 
-    if (size > SIZE_MAX - 8) {
+    if (size > SIZE_MAX - 8 - MEM_OVERHEAD) {
         rAllocException(R_MEM_FAIL, size);
         return 0;
     }
@@ -6503,10 +8999,32 @@ PUBLIC void *rReallocMem(void *mem, size_t size)
         return 0;
     }
     size = aligned;
+#if ME_R_MEM_TAGS
+    if (!mem) {
+        return rAllocMem(size);
+    }
+    hp = GET_HEADER(mem);
+    assert(hp->magic == R_MEM_MAGIC);
+
+    //  Resized blocks keep their original tag
+    prior = hp->size;
+    if ((hp = realloc(hp, size + R_MEM_HEADER)) == 0) {
+        rAllocException(R_MEM_FAIL, size);
+        return 0;
+    }
+    hp->size = size;
+    mp = &memTags[hp->tag];
+    rAtomicAdd64(&mp->bytes, (int64) size - (int64) prior);
+    if (size > prior && mp->bytes > mp->peak) {
+        mp->peak = mp->bytes;
+    }
+    ptr = (char*) hp + R_MEM_HEADER;
+#else
     if ((ptr = realloc(mem, size)) == 0) {
         rAllocException(R_MEM_FAIL, size);
         return 0;
     }
+#endif
 #if ME_FIBER_GUARD_PAD
     rCheckFiber();
 #endif
@@ -6529,13 +9047,554 @@ PUBLIC void rAllocException(int cause, size_t size)
 }
 
 /*
-    Allocate memory via virtual memory allocation (mmap/VirtualAlloc).
-    This keeps stack allocations separate from the heap to reduce fragmentation.
+    Get the pool for a size class. Objects too large for slabs get a private passthrough pool.
  */
-PUBLIC void *rAllocVirt(size_t size)
+PUBLIC RPool *rAllocPool(size_t size)
 {
-#if MACOSX || LINUX || FREEBSD
-    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    RPool  *pool;
+    size_t index;
+
+    size = R_ALLOC_ALIGN(max(size, sizeof(void*)), R_POOL_ALIGN);
+    index = size / R_POOL_ALIGN;
+    if (index <= R_POOL_CLASSES && pools[index]) {
+        return pools[index];
+    }
+    if ((pool = rAlloc(sizeof(RPool))) == 0) {
+        return 0;
+    }
+    memset(pool, 0, sizeof(RPool));
+    pool->size = size;
+    if (index <= R_POOL_CLASSES) {
+        pool->passthrough = !ME_MEM_POOL;
+        pools[index] = pool;
+    } else {
+        pool->passthrough = 1;
+    }
+    return pool;
+}
+
+PUBLIC void *rAllocFromPool(RPool *pool)
+{
+    void **obj, **next;
+
+    if (pool->passthrough || rIsForeignThread()) {
+        if ((obj = rAlloc(pool->size)) == 0) {
+            return 0;
+        }
+        if (!pool->passthrough) {
+            rAtomicAdd64(&pool->foreign, 1);
+        }
+        return memset(obj, 0, pool->size);
+    }
+    if (!pool->free) {
+        if (pool->remote) {
+            for (obj = rAtomicExchange(&pool->remote, 0); obj; obj = next) {
+                next = *obj;
+                pushFree(pool, obj);
+            }
+        }
+        if (!pool->free) {
+            growPool(pool);
+            if (!pool->free) {
+                return 0;
+            }
+        }
+    }
+    obj = pool->free;
+    pool->free = *obj;
+    pool->freeCount--;
+    pool->allocs++;
+    return memset(obj, 0, pool->size);
+}
+
+PUBLIC void rFreeToPool(RPool *pool, void *ptr)
+{
+    void *head;
+
+    if (!ptr) {
+        return;
+    }
+    if (pool->passthrough) {
+        rFree(ptr);
+
+    } else if (rIsForeignThread()) {
+        do {
+            head = pool->remote;
+            *(void**) ptr = head;
+        } while (!rAtomicCas(&pool->remote, head, ptr));
+
+    } else {
+        pushFree(pool, ptr);
+    }
+}
+
+/*
+    Add an object to the free list. Must be called on the main thread.
+    Objects allocated via malloc by foreign threads join the free list only while it holds fewer objects than the
+    slabs provide. Beyond that they are released to the heap, so the pool is bounded by twice its slab capacity.
+ */
+static void pushFree(RPool *pool, void *ptr)
+{
+    if (pool->freeCount >= pool->objects && !inSlab(pool, ptr)) {
+        rAtomicAdd64(&pool->foreign, -1);
+        rFree(ptr);
+        return;
+    }
+    *(void**) ptr = pool->free;
+    pool->free = ptr;
+    pool->freeCount++;
+}
+
+/*
+    Test if an object was carved from one of the pool slabs. Only used once the free list is over capacity.
+ */
+static bool inSlab(RPool *pool, void *ptr)
+{
+    char   *slab;
+    size_t size;
+
+    size = R_POOL_ALIGN + max(ME_MEM_POOL_SLAB / pool->size, 1) * pool->size;
+    for (slab = pool->slabList; slab; slab = *(char**) slab) {
+        if ((char*) ptr >= slab && (char*) ptr < slab + size) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+    Add a slab of objects to the free list. The slab header links the slabs so they remain reachable.
+ */
+static void growPool(RPool *pool)
+{
+    char   *slab, *obj;
+    size_t count, i;
+#if ME_R_MEM_TAGS
+    int    tag;
+#endif
+
+    count = max(ME_MEM_POOL_SLAB / pool->size, 1);
+#if ME_R_MEM_TAGS
+    //  Slabs are retained for reuse by all subsystems, so charge them to the pool rather than the caller
+    tag = rSetMemTag(R_MEM_POOL);
+    slab = rAlloc(R_POOL_ALIGN + count * pool->size);
+    rSetMemTag(tag);
+#else
+    slab = rAlloc(R_POOL_ALIGN + count * pool->size);
+#endif
+    if (slab == 0) {
+        return;
+    }
+    *(void**) slab = pool->slabList;
+    pool->slabList = slab;
+
+    for (i = count; i-- > 0; ) {
+        obj = slab + R_POOL_ALIGN + i * pool->size;
+        *(void**) obj = pool->free;
+        pool->free = obj;
+    }
+    pool->freeCount += (int) count;
+    pool->objects += (int64) count;
+    pool->slabs++;
+}
+
+PUBLIC void rGetMemStats(RMemStats *stats)
+{
+    RPool      *pool;
+    RPoolStats *sp;
+    int        i;
+
+    if (!stats) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+#if LINUX && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    stats->heap = info.arena + info.hblkhd;
+    stats->heapFree = info.fordblks;
+#endif
+    for (i = 1; i <= R_POOL_CLASSES; i++) {
+        if ((pool = pools[i]) == 0 || pool->passthrough) {
+            continue;
+        }
+        sp = &stats->stats[stats->pools++];
+        sp->size = pool->size;
+        sp->objects = pool->objects + pool->foreign;
+        sp->inUse = sp->objects - pool->freeCount;
+        sp->allocs = pool->allocs + pool->foreign;
+        sp->slabs = pool->slabs;
+        stats->poolBytes += (size_t) pool->objects * pool->size;
+        stats->poolUsed += (size_t) sp->inUse * pool->size;
+    }
+}
+
+#if ME_R_MEM_TAGS
+/*
+    Initialize the block header and charge the block to the tag of the running fiber
+ */
+static void *tagBlock(RMemHeader *hp, size_t size)
+{
+    MemTag *mp;
+    int    tag;
+
+    tag = rIsForeignThread() ? R_MEM_OTHER : memTag;
+    hp->size = size;
+    hp->tag = (uint32) tag;
+    hp->magic = R_MEM_MAGIC;
+
+    mp = &memTags[tag];
+    rAtomicAdd64(&mp->bytes, (int64) size);
+    rAtomicAdd64(&mp->blocks, 1);
+    rAtomicAdd64(&mp->allocs, 1);
+    if (mp->bytes > mp->peak) {
+        mp->peak = mp->bytes;
+    }
+    return (char*) hp + R_MEM_HEADER;
+}
+
+PUBLIC int rSetMemTag(int tag)
+{
+    int prior;
+
+    if (rIsForeignThread()) {
+        return R_MEM_OTHER;
+    }
+    prior = memTag;
+    if (tag >= 0 && tag < R_MEM_TAGS) {
+        memTag = tag;
+    }
+    return prior;
+}
+
+PUBLIC int rGetMemTag(void)
+{
+    return rIsForeignThread() ? R_MEM_OTHER : memTag;
+}
+
+PUBLIC int rSetMemTagName(int tag, cchar *name)
+{
+    if (tag < 0 || tag >= R_MEM_TAGS) {
+        return R_ERR_BAD_ARGS;
+    }
+    memTagNames[tag] = name;
+    return 0;
+}
+
+PUBLIC void rGetMemSnapshot(RMemSnapshot *snapshot)
+{
+    RMemTagStats *sp;
+    MemTag       *mp;
+    int          i;
+
+    if (!snapshot) {
+        return;
+    }
+    snapshot->when = rGetTicks();
+    for (i = 0; i < R_MEM_TAGS; i++) {
+        mp = &memTags[i];
+        sp = &snapshot->tags[i];
+        sp->name = memTagNames[i];
+        sp->bytes = mp->bytes;
+        sp->blocks = mp->blocks;
+        sp->allocs = mp->allocs;
+        sp->peak = mp->peak;
+    }
+}
+
+PUBLIC void rReportMem(void)
+{
+    RMemSnapshot snapshot;
+    RMemTagStats *sp;
+    char         name[16];
+    int          i;
+
+    rGetMemSnapshot(&snapshot);
+    for (i = 0; i < R_MEM_TAGS; i++) {
+        sp = &snapshot.tags[i];
+        if (sp->allocs == 0) {
+            continue;
+        }
+        if (!sp->name) {
+            sfmtbuf(name, sizeof(name), "tag-%d", i);
+        }
+        rMetrics(NULL, rGetAppName(), "Tag", NULL,
+                 "Tag", "string", sp->name ? sp->name : name,
+                 "Bytes", "int64", sp->bytes,
+                 "Blocks", "int64", sp->blocks,
+                 "Allocs", "int64", sp->allocs,
+                 "Peak", "int64", sp->peak,
+                 NULL);
+    }
+}
+
+#if R_USE_EVENT
+static void memReport(void *arg)
+{
+    rReportMem();
+    memReportEvent = rStartEvent(memReport, NULL, memReportPeriod);
+}
+#endif
+
+PUBLIC void rSetMemReport(Ticks period)
+{
+#if R_USE_EVENT
+    if (memReportEvent) {
+        rStopEvent(memReportEvent);
+        memReportEvent = 0;
+    }
+    memReportPeriod = period;
+    if (period > 0) {
+        memReportEvent = rStartEvent(memReport, NULL, period);
+    }
+#endif
+}
+
+#else /* !ME_R_MEM_TAGS */
+
+PUBLIC int rSetMemTag(int tag)
+{
+    return R_MEM_OTHER;
+}
+
+PUBLIC int rGetMemTag(void)
+{
+    return R_MEM_OTHER;
+}
+
+PUBLIC int rSetMemTagName(int tag, cchar *name)
+{
+    return R_ERR_BAD_STATE;
+}
+
+PUBLIC void rGetMemSnapshot(RMemSnapshot *snapshot)
+{
+    if (snapshot) {
+        memset(snapshot, 0, sizeof(*snapshot));
+    }
+}
+
+PUBLIC void rReportMem(void)
+{
+}
+
+PUBLIC void rSetMemReport(Ticks period)
+{
+}
+#endif /* ME_R_MEM_TAGS */
+
+PUBLIC void rDiffMemSnapshot(RMemSnapshot *diff, const RMemSnapshot *before, const RMemSnapshot *after)
+{
+    int i;
+
+    if (!diff || !before || !after) {
+        return;
+    }
+    for (i = 0; i < R_MEM_TAGS; i++) {
+        diff->tags[i].name = after->tags[i].name;
+        diff->tags[i].bytes = after->tags[i].bytes - before->tags[i].bytes;
+        diff->tags[i].blocks = after->tags[i].blocks - before->tags[i].blocks;
+        diff->tags[i].allocs = after->tags[i].allocs - before->tags[i].allocs;
+        diff->tags[i].peak = after->tags[i].peak;
+    }
+    diff->when = after->when;
+}
+
+/*
+    Allocate an arena. The first block is allocated immediately and is retained for the life of the arena.
+ */
+PUBLIC RArena *rAllocArena(size_t blockSize)
+{
+    RArena      *arena;
+    RArenaBlock *bp;
+
+    if (blockSize == 0) {
+        blockSize = ME_ARENA_BLOCK;
+    }
+    blockSize = ARENA_ALIGN(blockSize);
+    if ((arena = rAllocType(RArena)) == 0) {
+        return 0;
+    }
+    if ((bp = rAlloc(ARENA_HEADER + blockSize)) == 0) {
+        rFree(arena);
+        return 0;
+    }
+    bp->next = 0;
+    bp->size = blockSize;
+    arena->blocks = arena->first = bp;
+    arena->blockSize = blockSize;
+    arena->pos = (char*) bp + ARENA_HEADER;
+    arena->end = arena->pos + blockSize;
+    return arena;
+}
+
+PUBLIC void rFreeArena(RArena *arena)
+{
+    RArenaBlock *bp, *next;
+
+    if (!arena) {
+        return;
+    }
+    for (bp = arena->blocks; bp; bp = next) {
+        next = bp->next;
+        rFree(bp);
+    }
+    rFree(arena);
+}
+
+/*
+    Release all arena allocations. Overflow blocks are freed and the first block is reused.
+    This is O(1) when the arena did not overflow its first block.
+ */
+PUBLIC void rResetArena(RArena *arena)
+{
+    RArenaBlock *bp, *next;
+
+    if (!arena) {
+        return;
+    }
+    for (bp = arena->blocks; bp; bp = next) {
+        next = bp->next;
+        if (bp != arena->first) {
+            rFree(bp);
+        }
+    }
+    bp = arena->blocks = arena->first;
+    bp->next = 0;
+    arena->pos = (char*) bp + ARENA_HEADER;
+    arena->end = arena->pos + bp->size;
+    arena->used = 0;
+    arena->allocs = 0;
+}
+
+PUBLIC void *rArenaAlloc(RArena *arena, size_t size)
+{
+    char *ptr;
+
+    if (!arena) {
+        return 0;
+    }
+    if (size > SIZE_MAX / 2) {
+        rAllocException(R_MEM_FAIL, size);
+        return 0;
+    }
+    size = ARENA_ALIGN(max(size, 1));
+    arena->used += size;
+    arena->allocs++;
+    if (size <= (size_t) (arena->end - arena->pos)) {
+        ptr = arena->pos;
+        arena->pos += size;
+        return ptr;
+    }
+    return growArena(arena, size);
+}
+
+PUBLIC char *rArenaClone(RArena *arena, cchar *str)
+{
+    char   *ptr;
+    size_t len;
+
+    if (!str) {
+        str = "";
+    }
+    len = slen(str);
+    if ((ptr = rArenaAlloc(arena, len + 1)) != 0) {
+        memcpy(ptr, str, len + 1);
+    }
+    return ptr;
+}
+
+PUBLIC char *rArenaFmt(RArena *arena, cchar *fmt, ...)
+{
+    va_list ap;
+    char    *result;
+
+    va_start(ap, fmt);
+    result = rArenaFmtv(arena, fmt, ap);
+    va_end(ap);
+    return result;
+}
+
+/*
+    Format directly into the free space of the current block. If it does not fit, format via the heap and copy.
+ */
+PUBLIC char *rArenaFmtv(RArena *arena, cchar *fmt, va_list args)
+{
+    va_list copy;
+    char    *buf, *ptr;
+    ssize   len;
+    size_t  avail;
+
+    if (!arena || !fmt) {
+        return 0;
+    }
+    avail = (size_t) (arena->end - arena->pos);
+    if (avail > 0) {
+        va_copy(copy, args);
+        len = rVsnprintf(arena->pos, avail, fmt, copy);
+        va_end(copy);
+        if (len >= 0 && (size_t) len < avail) {
+            return rArenaAlloc(arena, (size_t) len + 1);
+        }
+    }
+    buf = 0;
+    if ((len = rVsaprintf(&buf, 0, fmt, args)) < 0 || !buf) {
+        rFree(buf);
+        return 0;
+    }
+    if ((ptr = rArenaAlloc(arena, (size_t) len + 1)) != 0) {
+        memcpy(ptr, buf, (size_t) len + 1);
+    }
+    rFree(buf);
+    return ptr;
+}
+
+PUBLIC size_t rGetArenaUsed(RArena *arena)
+{
+    return arena ? arena->used : 0;
+}
+
+/*
+    Add an overflow block large enough for the request and allocate from it.
+    Allocations larger than a quarter of the block size get a dedicated block so the current block is not wasted.
+ */
+static void *growArena(RArena *arena, size_t size)
+{
+    RArenaBlock *bp, *current;
+    char        *ptr;
+    size_t      blockSize;
+
+    current = arena->blocks;
+    if (size > arena->blockSize / 4) {
+        if ((bp = rAlloc(ARENA_HEADER + size)) == 0) {
+            return 0;
+        }
+        bp->size = size;
+        //  Insert behind the current block so bump allocation continues in the current block
+        bp->next = current->next;
+        current->next = bp;
+        return (char*) bp + ARENA_HEADER;
+    }
+    blockSize = arena->blockSize;
+    if ((bp = rAlloc(ARENA_HEADER + blockSize)) == 0) {
+        return 0;
+    }
+    bp->size = blockSize;
+    bp->next = current;
+    arena->blocks = bp;
+    ptr = (char*) bp + ARENA_HEADER;
+    arena->pos = ptr + size;
+    arena->end = ptr + blockSize;
+    return ptr;
+}
+
+/*
+    Allocate memory via virtual memory allocation (mmap/VirtualAlloc).
+    This keeps stack allocations separate from the heap to reduce fragmentation.
+ */
+PUBLIC void *rAllocVirt(size_t size)
+{
+#if MACOSX || LINUX || FREEBSD
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
     if (ptr == MAP_FAILED) {
         return NULL;
     }
@@ -6626,6 +9685,34 @@ PUBLIC int rProtectPages(void *addr, size_t size, int prot)
 #endif
 }
 
+/*
+    Discard the contents of pages and set their protection. Accessible pages read as zero when next touched.
+ */
+PUBLIC int rDiscardPages(void *addr, size_t size, int prot)
+{
+#if MACOSX || LINUX || FREEBSD
+    int mprot = PROT_NONE;
+    if (prot & R_PROT_READ) mprot |= PROT_READ;
+    if (prot & R_PROT_WRITE) mprot |= PROT_WRITE;
+    if (prot & R_PROT_EXEC) mprot |= PROT_EXEC;
+    //  Replacing the mapping releases the pages on all platforms (madvise does not zero on MacOS)
+    if (mmap(addr, size, mprot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+        return -1;
+    }
+    return 0;
+#elif WINDOWS
+    if (!VirtualFree(addr, size, MEM_DECOMMIT)) {
+        return -1;
+    }
+    if (prot != R_PROT_NONE) {
+        return rProtectPages(addr, size, prot);
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 /*
     Get system page size (cached)
  */
@@ -6987,7 +10074,8 @@ PUBLIC int rConfigTls(Rtls *tp, bool server)
         }
         SSL_CTX_set_verify(ctx, verifyMode, verifyPeerCertificate);
     }
-    SSL_CTX_set_mode(ctx, SSL_MODE_AUTO_RETRY | SSL_MODE_RELEASE_BUFFERS | SSL_MODE_ENABLE_PARTIAL_WRITE);
+    SSL_CTX_set_mode(ctx, SSL_MODE_AUTO_RETRY | SSL_MODE_RELEASE_BUFFERS | SSL_MODE_ENABLE_PARTIAL_WRITE |
+                     SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
     // Enable TLS session resumption for server connections
     if (server) {
@@ -7776,6 +10864,21 @@ PUBLIC char classMap[] = {
 #define SPRINTF_UPPER_CASE  0x400       /* As the name says for numbers */
 #define SPRINTF_SSIZE       0x800       /* Size of ssize */
 
+/*
+    Decimal digit pairs for converting integers two digits at a time
+ */
+static cchar digitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64 powersOfTen[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+};
+
 typedef struct PContext {
     uchar *buf;
     uchar *endbuf;
@@ -7788,7 +10891,6 @@ typedef struct PContext {
     int precision;
     int width;
     int upper;
-    int floating;
     int overflow;
 } PContext;
 
@@ -7820,10 +10922,13 @@ typedef struct PContext {
 
 static int  getNextState(char c, int state);
 static int  growBuf(PContext *ctx);
+static int  getDigits(double value, char *digits, int *point);
+static int  getExactDigits(double value, int precision, bool fixed, char *digits, int size, int *point);
 static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args);
-static void outFloat(PContext *ctx, char specChar, double value);
-static void outFloatE(PContext *ctx, char specChar, double value);
-static void outNum(PContext *ctx, size_t radix, int64 value);
+static void outBlock(PContext *ctx, cchar *str, ssize len);
+static void outFloat(PContext *ctx, double value);
+static void outNum(PContext *ctx, int radix, uint64 value, bool negative);
+static void outPad(PContext *ctx, char c, ssize count);
 static void outString(PContext *ctx, char *str, ssize len);
 
 #endif /* R_OWN_PRINTF */
@@ -7902,6 +11007,7 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
     uint64   uValue;
     bool     allocating;
     int      state;
+    cchar    *cp;
     char     c;
 
     assert(buf);
@@ -7937,7 +11043,6 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
     ctx.maxsize = (int) maxsize;
     ctx.precision = 0;
     ctx.format = 0;
-    ctx.floating = 0;
     ctx.width = 0;
     ctx.upper = 0;
     ctx.len = 0;
@@ -7952,7 +11057,11 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
 
         switch (state) {
         case STATE_NORMAL:
-            BPUT(&ctx, c);
+            //  Copy the run of literal characters up to the next format
+            for (cp = spec; *cp && *cp != '%'; cp++) {
+            }
+            outBlock(&ctx, spec - 1, cp - spec + 1);
+            spec = cp;
             break;
 
         case STATE_PERCENT:
@@ -7960,7 +11069,6 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
             ctx.width = 0;
             ctx.flags = 0;
             ctx.upper = 0;
-            ctx.floating = 0;
             break;
 
         case STATE_MODIFIER:
@@ -8058,14 +11166,9 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
             case 'G':
             case 'g':
             case 'f':
-                ctx.floating = 1;
-                outFloat(&ctx, c, (double) va_arg(args, double));
-                break;
-
             case 'e':
             case 'E':
-                ctx.floating = 1;
-                outFloatE(&ctx, c, (double) va_arg(args, double));
+                outFloat(&ctx, (double) va_arg(args, double));
                 break;
 
             case 'c':
@@ -8090,7 +11193,11 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
                 } else {
                     iValue = (int) va_arg(args, int);
                 }
-                outNum(&ctx, 10, iValue);
+                if (iValue < 0) {
+                    outNum(&ctx, 10, (uint64) - (iValue + 1) + 1, 1);
+                } else {
+                    outNum(&ctx, 10, (uint64) iValue, 0);
+                }
                 break;
 
             case 'X':
@@ -8117,14 +11224,14 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
                     uValue = va_arg(args, uint);
                 }
                 if (c == 'u') {
-                    outNum(&ctx, 10, (int64) uValue);
+                    outNum(&ctx, 10, uValue, 0);
                 } else if (c == 'o') {
-                    outNum(&ctx, 8, (int64) uValue);
+                    outNum(&ctx, 8, uValue, 0);
                 } else {
                     if (c == 'X') {
                         ctx.upper = 1;
                     }
-                    outNum(&ctx, 16, (int64) uValue);
+                    outNum(&ctx, 16, uValue, 0);
                 }
                 break;
 
@@ -8150,7 +11257,7 @@ static ssize innerSprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
                 uValue = (uint) PTOI(va_arg(args, void*));
 #endif
                 ctx.flags |= SPRINTF_LEAD_PREFIX;
-                outNum(&ctx, 16, (int64) uValue);
+                outNum(&ctx, 16, uValue, 0);
                 break;
 
             default:
@@ -8189,49 +11296,90 @@ static int getNextState(char c, int state)
 static void outString(PContext *ctx, char *str, ssize flen)
 {
     char   *cp;
-    size_t i, len;
+    size_t len, limit;
+    ssize  fill;
 
     if (str == NULL) {
         str = "null";
         len = 4;
     } else if (ctx->flags & SPRINTF_LEAD_PREFIX) {
         len = slen(str);
-    } else if (ctx->precision >= 0) {
-        for (cp = str, len = 0; len < (size_t) ctx->precision; len++) {
-            if (*cp++ == '\0') {
-                break;
-            }
+    } else if (ctx->precision >= 0 || flen >= 0) {
+        limit = (size_t) (ctx->precision >= 0 ? ctx->precision : flen);
+        for (cp = str, len = 0; len < limit && *cp; len++, cp++) {
         }
-    } else if (flen < 0) {
-        len = slen(str);
     } else {
-        len = (size_t) flen;
+        len = slen(str);
     }
+    fill = ctx->width > (ssize) len ? ctx->width - (ssize) len : 0;
     if (!(ctx->flags & SPRINTF_LEFT_ALIGN)) {
-        for (i = len; i < (size_t) ctx->width; i++) {
-            BPUT(ctx, (char) ' ');
+        outPad(ctx, ' ', fill);
+    }
+    outBlock(ctx, str, (ssize) len);
+    if (ctx->flags & SPRINTF_LEFT_ALIGN) {
+        outPad(ctx, ' ', fill);
+    }
+}
+
+/*
+    Append a block of characters. Copy directly if there is room, otherwise grow or truncate via BPUT.
+ */
+static void outBlock(PContext *ctx, cchar *str, ssize len)
+{
+    if (len <= 0) {
+        return;
+    }
+    //  Less one to allow room for the null
+    if (len < ctx->endbuf - ctx->end) {
+        memcpy(ctx->end, str, (size_t) len);
+        ctx->end += len;
+        ctx->len += (int) len;
+    } else {
+        while (len-- > 0) {
+            BPUT(ctx, *str++);
         }
     }
-    for (i = 0; i < len && *str; i++) {
-        BPUT(ctx, *str++);
+}
+
+static void outPad(PContext *ctx, char c, ssize count)
+{
+    while (count-- > 0) {
+        BPUT(ctx, c);
     }
+}
+
+/*
+    Emit the leading padding and sign prefix for a field of "len" characters.
+    Returns the number of pad characters to emit after the field for left aligned fields.
+ */
+static ssize outLead(PContext *ctx, cchar *prefix, ssize len)
+{
+    ssize fill;
+
+    fill = ctx->width > len ? ctx->width - len : 0;
     if (ctx->flags & SPRINTF_LEFT_ALIGN) {
-        for (i = len; i < (size_t) ctx->width; i++) {
-            BPUT(ctx, (char) ' ');
-        }
+        outBlock(ctx, prefix, (ssize) slen(prefix));
+        return fill;
+    }
+    if (!(ctx->flags & SPRINTF_LEAD_ZERO)) {
+        outPad(ctx, ' ', fill);
+    }
+    outBlock(ctx, prefix, (ssize) slen(prefix));
+    if (ctx->flags & SPRINTF_LEAD_ZERO) {
+        outPad(ctx, '0', fill);
     }
+    return 0;
 }
 
-static void outNum(PContext *ctx, size_t radix, int64 value)
+static void outNum(PContext *ctx, int radix, uint64 value, bool negative)
 {
-    static char numBuf[64];
-    char        *cp, *endp;
-    cchar       *prefix;
-    int         letter, len, leadingZeros, i, fill, precision;
-    uint64      uval;
+    char  numBuf[32], *cp, *endp;
+    cchar *digits, *prefix;
+    ssize fill;
+    uint  index;
+    int   len, leadingZeros, i;
 
-    cp = endp = &numBuf[sizeof(numBuf) - 1];
-    *endp = '\0';
+    cp = endp = &numBuf[sizeof(numBuf)];
     prefix = "";
 
     if (ctx->flags & SPRINTF_LEAD_PREFIX) {
@@ -8240,318 +11388,1128 @@ static void outNum(PContext *ctx, size_t radix, int64 value)
         } else if (radix == 8) {
             prefix = "0";
         }
-    } else if (ctx->flags & SPRINTF_LEAD_SPACE && value >= 0) {
+    } else if (ctx->flags & SPRINTF_LEAD_SPACE && !negative) {
         prefix = " ";
-    } else if (ctx->flags & SPRINTF_LEAD_SIGN && value >= 0) {
+    } else if (ctx->flags & SPRINTF_LEAD_SIGN && !negative) {
         prefix = "+";
-    } else if (value < 0) {
+    } else if (negative) {
         prefix = "-";
     }
     /*
         Convert to ascii
      */
-    if (value < 0) {
-        uval = (value == INT64_MIN) ? (uint64) INT64_MAX + 1 : (uint64) - value;
-    } else {
-        uval = (uint64) value;
-    }
     if (radix == 16) {
+        digits = (ctx->flags & SPRINTF_UPPER_CASE) ? "0123456789ABCDEF" : "0123456789abcdef";
         do {
-            letter = (int) (uval % radix);
-            if (letter > 9) {
-                if (ctx->flags & SPRINTF_UPPER_CASE) {
-                    letter = 'A' + letter - 10;
-                } else {
-                    letter = 'a' + letter - 10;
-                }
-            } else {
-                letter += '0';
-            }
-            *--cp = letter;
-            uval /= radix;
-        } while (uval != 0);
+            *--cp = digits[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+
+    } else if (radix == 8) {
+        do {
+            *--cp = (char) ('0' + (value & 0x7));
+            value >>= 3;
+        } while (value != 0);
 
     } else if (ctx->flags & SPRINTF_COMMA) {
         i = 1;
         do {
-            int digit = (int) (uval % radix);
-            *--cp = '0' + digit;
-            uval /= radix;
-            if ((i++ % 3) == 0 && uval != 0) {
+            *--cp = (char) ('0' + value % 10);
+            value /= 10;
+            if ((i++ % 3) == 0 && value != 0) {
                 *--cp = ',';
             }
-        } while (uval != 0);
+        } while (value != 0);
+
     } else {
-        do {
-            int digit = (int) (uval % radix);
-            *--cp = '0' + digit;
-            uval /= radix;
-        } while (uval != 0);
+        //  Emit two digits per division
+        while (value >= 100) {
+            index = (uint) (value % 100) * 2;
+            value /= 100;
+            *--cp = digitPairs[index + 1];
+            *--cp = digitPairs[index];
+        }
+        if (value >= 10) {
+            index = (uint) value * 2;
+            *--cp = digitPairs[index + 1];
+            *--cp = digitPairs[index];
+        } else {
+            *--cp = (char) ('0' + value);
+        }
     }
-
     len = (int) (endp - cp);
-    precision = max(ctx->precision, 0);
-    leadingZeros = (!ctx->floating && precision > len) ? precision - len : 0;
+    leadingZeros = ctx->precision > len ? ctx->precision - len : 0;
 
-    if (ctx->width) {
-        if (ctx->floating) {
-            //  Doing the integer portion of a float
-            fill = ctx->width - precision - len - 1;
-        } else {
-            fill = ctx->width - max(precision, len);
+    fill = outLead(ctx, prefix, (ssize) slen(prefix) + len + leadingZeros);
+    outPad(ctx, '0', leadingZeros);
+    outBlock(ctx, cp, len);
+    outPad(ctx, ' ', fill);
+}
+
+/*
+    Emit the digits at positions [from, to). Positions outside the digits are zero.
+ */
+static void outDigits(PContext *ctx, cchar *digits, int len, int64 from, int64 to)
+{
+    int64 count;
+
+    if (from < 0) {
+        count = min(to, 0) - from;
+        outPad(ctx, '0', (ssize) count);
+        from += count;
+    }
+    if (from < len && from < to) {
+        count = min(to, len) - from;
+        outBlock(ctx, &digits[from], (ssize) count);
+        from += count;
+    }
+    outPad(ctx, '0', (ssize) (to - from));
+}
+
+/*
+    Arbitrary precision unsigned integers for exact decimal conversion. The largest value required is a
+    double significand scaled by 10^325 which needs 1133 bits.
+ */
+#define BIG_WORDS 40
+
+typedef struct BigNum {
+    uint32 words[BIG_WORDS];            /* Least significant word first */
+    int len;                            /* Count of words in use */
+} BigNum;
+
+static void bigSet(BigNum *b, uint64 value)
+{
+    b->words[0] = (uint32) value;
+    b->words[1] = (uint32) (value >> 32);
+    b->len = b->words[1] ? 2 : 1;
+}
+
+/*
+    Multiply by a small factor
+ */
+static void bigMultiply(BigNum *b, uint32 factor)
+{
+    uint64 carry;
+    int    i;
+
+    carry = 0;
+    for (i = 0; i < b->len; i++) {
+        carry += (uint64) b->words[i] * factor;
+        b->words[i] = (uint32) carry;
+        carry >>= 32;
+    }
+    if (carry && b->len < BIG_WORDS) {
+        b->words[b->len++] = (uint32) carry;
+    }
+}
+
+/*
+    Multiply by 10^count
+ */
+static void bigMultiplyPow10(BigNum *b, int count)
+{
+    for (; count >= 9; count -= 9) {
+        bigMultiply(b, 1000000000);
+    }
+    if (count > 0) {
+        bigMultiply(b, (uint32) powersOfTen[count]);
+    }
+}
+
+/*
+    Multiply by 2^count
+ */
+static void bigShift(BigNum *b, int count)
+{
+    int i, words, bits;
+
+    words = count / 32;
+    bits = count % 32;
+    if (bits) {
+        if (b->words[b->len - 1] >> (32 - bits) && b->len < BIG_WORDS) {
+            b->words[b->len++] = 0;
         }
-        if (prefix) {
-            fill -= (int) slen(prefix);
+        for (i = b->len - 1; i > 0; i--) {
+            b->words[i] = (b->words[i] << bits) | (b->words[i - 1] >> (32 - bits));
         }
-        if (fill < 0) {
-            fill = 0;
+        b->words[0] <<= bits;
+    }
+    if (words) {
+        words = min(words, BIG_WORDS - b->len);
+        memmove(&b->words[words], b->words, (size_t) b->len * sizeof(uint32));
+        memset(b->words, 0, (size_t) words * sizeof(uint32));
+        b->len += words;
+    }
+}
+
+static int bigCompare(const BigNum *a, const BigNum *b)
+{
+    int i;
+
+    if (a->len != b->len) {
+        return a->len < b->len ? -1 : 1;
+    }
+    for (i = a->len - 1; i >= 0; i--) {
+        if (a->words[i] != b->words[i]) {
+            return a->words[i] < b->words[i] ? -1 : 1;
         }
-    } else {
-        fill = 0;
     }
+    return 0;
+}
 
-    if (!(ctx->flags & SPRINTF_LEFT_ALIGN)) {
-        if (!(ctx->flags & SPRINTF_LEAD_ZERO)) {
-            for (i = 0; i < fill; i++) {
-                BPUT(ctx, ' ');
-            }
+/*
+    Subtract b from a where a >= b
+ */
+static void bigSubtract(BigNum *a, const BigNum *b)
+{
+    int64 borrow;
+    int   i;
+
+    borrow = 0;
+    for (i = 0; i < a->len; i++) {
+        borrow += (int64) a->words[i] - (i < b->len ? (int64) b->words[i] : 0);
+        a->words[i] = (uint32) borrow;
+        borrow = borrow < 0 ? -1 : 0;
+    }
+    while (a->len > 1 && a->words[a->len - 1] == 0) {
+        a->len--;
+    }
+}
+
+/*
+    Round value * 10^shift to an integer half to even. The scaled value is within half a unit in the last place
+    of the exact product, so only a fraction of exactly one half is ambiguous. The product error from fma decides
+    the rounding in that case. Returns false if the shift is out of range or the scaled value is 2^52 or more.
+ */
+static bool scaleToInteger(double value, int shift, uint64 *result)
+{
+    double scaled, fraction, error, power;
+    uint64 n;
+
+    if (shift < 0 || shift > 19) {
+        return 0;
+    }
+    power = (double) powersOfTen[shift];
+    scaled = value * power;
+    if (scaled >= 4503599627370496.0) {
+        return 0;
+    }
+    n = (uint64) scaled;
+    fraction = scaled - (double) n;
+    if (fraction > 0.5) {
+        n++;
+    } else if (fraction == 0.5) {
+        error = fma(value, power, -scaled);
+        if (error > 0 || (error == 0 && (n & 1))) {
+            n++;
         }
-        if (prefix && *prefix) {
-            while (*prefix) {
-                BPUT(ctx, *prefix++);
-            }
+    }
+    *result = n;
+    return 1;
+}
+
+/*
+    Get the exact decimal digits of a finite, non-negative value rounded half to even like the C library.
+    If fixed, the digits are rounded to "precision" digits after the decimal point, otherwise to "precision" + 1
+    significant digits. Returns the count of digits (without trailing zeros) and sets *point to the position of
+    the decimal point relative to the first digit. A count of zero means the value rounded to zero.
+ */
+static int getExactDigits(double value, int precision, bool fixed, char *digits, int size, int *point)
+{
+    BigNum num, den, half;
+    uint64 bits, mantissa, n;
+    char   numBuf[24], *cp;
+    uint   index;
+    int    biased, exponent, k, count, i, cmp, shift;
+
+    *point = 1;
+    if (value == 0) {
+        return 0;
+    }
+    /*
+        Most values can be rounded exactly as a scaled integer. The estimate of the decimal exponent may be one
+        too small or too large in which case the result has the wrong number of significant digits.
+     */
+    k = (int) ceil(log10(value));
+    shift = fixed ? precision : precision + 1 - k;
+    if ((fixed || precision < 16) && scaleToInteger(value, shift, &n) &&
+        (fixed || (n >= powersOfTen[precision] && n <= powersOfTen[precision + 1]))) {
+        if (n == 0) {
+            return 0;
         }
-        if (ctx->flags & SPRINTF_LEAD_ZERO) {
-            for (i = 0; i < fill; i++) {
-                BPUT(ctx, '0');
-            }
+        for (cp = &numBuf[sizeof(numBuf)]; n >= 10; n /= 100) {
+            index = (uint) (n % 100) * 2;
+            *--cp = digitPairs[index + 1];
+            *--cp = digitPairs[index];
+        }
+        if (n) {
+            *--cp = (char) ('0' + n);
+        }
+        //  Drop a leading zero from the last digit pair
+        cp += (*cp == '0');
+        count = (int) (&numBuf[sizeof(numBuf)] - cp);
+        *point = count - shift;
+        while (cp[count - 1] == '0') {
+            count--;
+        }
+        count = min(count, size);
+        memcpy(digits, cp, (size_t) count);
+        return count;
+    }
+    memcpy(&bits, &value, sizeof(bits));
+    biased = (int) ((bits >> 52) & 0x7FF);
+    mantissa = bits & 0xFFFFFFFFFFFFFULL;
+    if (biased) {
+        mantissa += (uint64) 1 << 52;
+        exponent = biased - 1075;
+    } else {
+        exponent = -1074;
+    }
+    //  value == num / den
+    bigSet(&num, mantissa);
+    bigSet(&den, 1);
+    if (exponent > 0) {
+        bigShift(&num, exponent);
+    } else {
+        bigShift(&den, -exponent);
+    }
+    /*
+        Scale by the estimate of the decimal exponent then correct so that value == num / den * 10^(k - 1)
+        where 1 <= num / den < 10
+     */
+    if (k > 0) {
+        bigMultiplyPow10(&den, k);
+    } else {
+        bigMultiplyPow10(&num, -k);
+    }
+    while (bigCompare(&num, &den) >= 0) {
+        bigMultiply(&den, 10);
+        k++;
+    }
+    bigMultiply(&num, 10);
+    while (bigCompare(&num, &den) < 0) {
+        bigMultiply(&num, 10);
+        k--;
+    }
+    count = fixed ? k + precision : precision + 1;
+    if (count < 0) {
+        return 0;
+    }
+    //  Exact values have at most 767 significant digits so digits past the buffer are zero
+    count = min(count, size);
+    for (i = 0; i < count; i++) {
+        digits[i] = '0';
+        while (bigCompare(&num, &den) >= 0) {
+            bigSubtract(&num, &den);
+            digits[i]++;
+        }
+        bigMultiply(&num, 10);
+    }
+    //  The remainder is compared with half of the last digit
+    half = den;
+    bigMultiply(&half, 5);
+    cmp = bigCompare(&num, &half);
+    if (cmp > 0 || (cmp == 0 && count > 0 && (digits[count - 1] & 1))) {
+        for (i = count - 1; i >= 0 && digits[i] == '9'; i--) {
+        }
+        if (i < 0) {
+            digits[0] = '1';
+            *point = k + 1;
+            return 1;
         }
+        digits[i]++;
+        count = i + 1;
+    }
+    while (count > 0 && digits[count - 1] == '0') {
+        count--;
+    }
+    *point = count > 0 ? k : 1;
+    return count;
+}
+
+/*
+    Fast path for fixed notation with a modest precision. The value is scaled by the precision and rounded exactly.
+    Returns false if the scaled value is too large.
+ */
+static bool outFixed(PContext *ctx, cchar *prefix, double value, int precision)
+{
+    char   numBuf[40], *cp, *endp;
+    uint64 n;
+    ssize  fill;
+    uint   index;
+    int    i;
 
-    } else if (prefix != 0) {
-        while (*prefix) {
-            BPUT(ctx, *prefix++);
+    if (precision > 15 || !scaleToInteger(value, precision, &n)) {
+        return 0;
+    }
+    cp = endp = &numBuf[sizeof(numBuf)];
+    if (precision > 0) {
+        for (i = 0; i < precision; i++) {
+            *--cp = (char) ('0' + n % 10);
+            n /= 10;
+        }
+        *--cp = '.';
+    }
+    while (n >= 100) {
+        index = (uint) (n % 100) * 2;
+        n /= 100;
+        *--cp = digitPairs[index + 1];
+        *--cp = digitPairs[index];
+    }
+    if (n >= 10) {
+        index = (uint) n * 2;
+        *--cp = digitPairs[index + 1];
+        *--cp = digitPairs[index];
+    } else {
+        *--cp = (char) ('0' + n);
+    }
+    fill = outLead(ctx, prefix, (ssize) slen(prefix) + (endp - cp));
+    outBlock(ctx, cp, endp - cp);
+    outPad(ctx, ' ', fill);
+    return 1;
+}
+
+/*
+    Format a double for the e, E, f, g and G formats.
+    Without a precision, the g and G formats emit the shortest digits that read back as the same value.
+    Otherwise the exact digits are rounded to the precision (default 6) half to even like the C library.
+    The g and G formats use an exponent if abs(value) < 0.0001 or abs(value) > 1000000.
+ */
+static void outFloat(PContext *ctx, double value)
+{
+    char  digitBuf[48], *digits, exp[8];
+    cchar *prefix;
+    ssize fill, expLen;
+    int   len, point, precision, exponent, format, shortest, size;
+
+    if (signbit(value)) {
+        prefix = "-";
+        value = -value;
+    } else if (ctx->flags & SPRINTF_LEAD_SIGN) {
+        prefix = "+";
+    } else if (ctx->flags & SPRINTF_LEAD_SPACE) {
+        prefix = " ";
+    } else {
+        prefix = "";
+    }
+    if (isnan(value) || isinf(value)) {
+        ctx->flags &= ~SPRINTF_LEAD_ZERO;
+        fill = outLead(ctx, prefix, (ssize) slen(prefix) + 3);
+        outBlock(ctx, isnan(value) ? "nan" : "inf", 3);
+        outPad(ctx, ' ', fill);
+        return;
+    }
+    if (ctx->format == 'f' && outFixed(ctx, prefix, value, ctx->precision < 0 ? 6 : ctx->precision)) {
+        return;
+    }
+    format = ctx->format;
+    precision = ctx->precision;
+    shortest = 0;
+
+    if (format == 'g' || format == 'G') {
+        shortest = precision < 0;
+        if (value != 0 && (value < 0.0001 || value > 1000000)) {
+            format = (format == 'G') ? 'E' : 'e';
+        } else {
+            format = 'f';
         }
     }
-    for (i = 0; i < leadingZeros; i++) {
-        BPUT(ctx, '0');
+    if (precision < 0) {
+        precision = 6;
     }
-    while (*cp) {
-        BPUT(ctx, *cp);
-        cp++;
+    digits = digitBuf;
+    if (shortest) {
+        len = getDigits(value, digits, &point);
+    } else {
+        //  Integral digits are limited to 309 and significant digits to 767
+        size = min(min(precision, 800) + (format == 'f' ? 310 : 1), 800);
+        if (size > (int) sizeof(digitBuf) && (digits = rAlloc((size_t) size)) == 0) {
+            return;
+        }
+        len = getExactDigits(value, precision, format == 'f', digits, size, &point);
     }
-    if (ctx->flags & SPRINTF_LEFT_ALIGN) {
-        for (i = 0; i < fill; i++) {
-            BPUT(ctx, ' ');
+    if (format == 'f') {
+        if (shortest) {
+            precision = max(len - point, 0);
+        }
+        fill = outLead(ctx, prefix, (ssize) slen(prefix) + max(point, 1) + (precision > 0 ? (ssize) precision + 1 : 0));
+        if (point > 0) {
+            outDigits(ctx, digits, len, 0, point);
+        } else {
+            BPUT(ctx, '0');
+        }
+        if (precision > 0) {
+            BPUT(ctx, '.');
+            outDigits(ctx, digits, len, point, (int64) point + precision);
         }
+    } else {
+        if (shortest) {
+            precision = max(len - 1, 0);
+        }
+        exponent = (len > 0) ? point - 1 : 0;
+        exp[0] = (char) format;
+        exp[1] = exponent < 0 ? '-' : '+';
+        exponent = abs(exponent);
+        expLen = 2;
+        if (exponent >= 100) {
+            exp[expLen++] = (char) ('0' + exponent / 100);
+        }
+        exp[expLen++] = (char) ('0' + (exponent / 10) % 10);
+        exp[expLen++] = (char) ('0' + exponent % 10);
+
+        fill = outLead(ctx, prefix, (ssize) slen(prefix) + 1 + (precision > 0 ? (ssize) precision + 1 : 0) + expLen);
+        outDigits(ctx, digits, len, 0, 1);
+        if (precision > 0) {
+            BPUT(ctx, '.');
+            outDigits(ctx, digits, len, 1, (int64) precision + 1);
+        }
+        outBlock(ctx, exp, expLen);
+    }
+    outPad(ctx, ' ', fill);
+    if (digits != digitBuf) {
+        rFree(digits);
     }
 }
 
-static void outFloat(PContext *ctx, char specchar, double value)
+/*
+    grow the buffer to fit new data. return 1 if the buffer can grow.
+    grow using the growby size specified when creating the buffer.
+ */
+static int growBuf(PContext *ctx)
 {
-    double fpart, round, v;
-    uchar  *last;
-    int    digit, precision;
-    int64  ipart;
+    uchar  *newbuf;
+    size_t buflen, newSize;
 
-    if (ctx->format == 'g' || ctx->format == 'G') {
-        v = fabs(value);
-        if (v < 0.0001 || v > 1000000) {
-            outFloatE(ctx, specchar, value);
-            return;
+    buflen = (size_t) (ctx->endbuf - ctx->buf);
+    if (ctx->maxsize > 0 && buflen >= (size_t) ctx->maxsize) {
+        return R_ERR_BAD_ARGS;
+    }
+    if (ctx->growBy <= 0) {
+        //  User supplied buffer
+        return 0;
+    }
+    if (ctx->growBy > 0 && buflen > MAXSSIZE - (size_t) ctx->growBy) {
+        // Integer overflow
+        return R_ERR_MEMORY;
+    }
+    newSize = buflen + (size_t) ctx->growBy;
+    if ((newbuf = rAlloc(newSize)) == 0) {
+        return R_ERR_MEMORY;
+    }
+    if (ctx->buf) {
+        memcpy(newbuf, ctx->buf, buflen);
+        rFree(ctx->buf);
+    }
+    ctx->end = newbuf + (ctx->end - ctx->buf);
+    ctx->buf = newbuf;
+    ctx->endbuf = &ctx->buf[newSize];
+
+    /*
+        Increase growBy to reduce overhead
+     */
+    if (ctx->growBy <= (int) (INT_MAX / 2)) {
+        ctx->growBy *= 2;
+    }
+    return 1;
+}
+
+/*
+    Shortest round-trip double to decimal conversion using the Grisu2 algorithm from "Printing Floating-Point
+    Numbers Quickly and Accurately with Integers" by Florian Loitsch. The generated digits always read back
+    as the same double and are the shortest such digits for nearly all values. Only integer arithmetic is used.
+ */
+typedef struct DiyFp {
+    uint64 f;                           /* Significand */
+    int e;                              /* Binary exponent */
+} DiyFp;
+
+/*
+    Normalized powers of ten from 10^-348 to 10^340 in steps of 8
+ */
+static const uint64 cachedPowersF[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16 cachedPowersE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066,
+};
+
+static DiyFp diyMultiply(DiyFp x, DiyFp y)
+{
+    DiyFp  r;
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product;
+
+    //  Round the discarded low 64 bits
+    product = (unsigned __int128) x.f * y.f;
+    r.f = (uint64) (product >> 64) + ((uint64) product >> 63);
+#else
+    uint64 a, b, c, d, ac, bc, ad, bd, mid;
+
+    a = x.f >> 32;
+    b = x.f & 0xFFFFFFFF;
+    c = y.f >> 32;
+    d = y.f & 0xFFFFFFFF;
+    ac = a * c;
+    bc = b * c;
+    ad = a * d;
+    bd = b * d;
+    //  Round the discarded low 64 bits
+    mid = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + (1U << 31);
+    r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+#endif
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static DiyFp diyNormalize(DiyFp x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    int shift = __builtin_clzll(x.f);
+
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & 0xFFC0000000000000ULL)) {
+        x.f <<= 10;
+        x.e -= 10;
+    }
+    while (!(x.f & 0x8000000000000000ULL)) {
+        x.f <<= 1;
+        x.e--;
+    }
+#endif
+    return x;
+}
+
+static int countDigits(uint n)
+{
+    int count;
+
+    //  The integral part of the scaled value never exceeds 9 digits
+    for (count = 1; count < 9 && n >= powersOfTen[count]; count++) {
+    }
+    return count;
+}
+
+/*
+    Move the last digit closer to the exact value while it stays within the rounding interval
+ */
+static void grisuRound(char *digits, int len, uint64 delta, uint64 rest, uint64 tenKappa, uint64 distance)
+{
+    while (rest < distance && delta - rest >= tenKappa &&
+           (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        digits[len - 1]--;
+        rest += tenKappa;
+    }
+}
+
+/*
+    Generate the digits of "high" down to the precision permitted by the rounding interval "delta"
+ */
+static int grisuDigits(DiyFp w, DiyFp high, uint64 delta, char *digits, int *K)
+{
+    uint64 one, distance, fraction, rest;
+    uint   integral, digit;
+    int    kappa, len, shift;
+
+    shift = -high.e;
+    one = (uint64) 1 << shift;
+    distance = high.f - w.f;
+    integral = (uint) (high.f >> shift);
+    fraction = high.f & (one - 1);
+    kappa = countDigits(integral);
+    len = 0;
+
+    while (kappa > 0) {
+        //  Constant divisors are much faster than dividing by a table entry
+        switch (kappa) {
+        case 9:
+            digit = integral / 100000000;
+            integral %= 100000000;
+            break;
+        case 8:
+            digit = integral / 10000000;
+            integral %= 10000000;
+            break;
+        case 7:
+            digit = integral / 1000000;
+            integral %= 1000000;
+            break;
+        case 6:
+            digit = integral / 100000;
+            integral %= 100000;
+            break;
+        case 5:
+            digit = integral / 10000;
+            integral %= 10000;
+            break;
+        case 4:
+            digit = integral / 1000;
+            integral %= 1000;
+            break;
+        case 3:
+            digit = integral / 100;
+            integral %= 100;
+            break;
+        case 2:
+            digit = integral / 10;
+            integral %= 10;
+            break;
+        default:
+            digit = integral;
+            integral = 0;
+            break;
+        }
+        if (digit || len) {
+            digits[len++] = (char) ('0' + digit);
+        }
+        kappa--;
+        rest = ((uint64) integral << shift) + fraction;
+        if (rest <= delta) {
+            *K += kappa;
+            grisuRound(digits, len, delta, rest, powersOfTen[kappa] << shift, distance);
+            return len;
+        }
+    }
+    for (;;) {
+        fraction *= 10;
+        delta *= 10;
+        digit = (uint) (fraction >> shift);
+        if (digit || len) {
+            digits[len++] = (char) ('0' + digit);
         }
+        fraction &= one - 1;
+        kappa--;
+        if (fraction < delta) {
+            *K += kappa;
+            grisuRound(digits, len, delta, fraction, one, -kappa < 20 ? distance * powersOfTen[-kappa] : 0);
+            return len;
+        }
+    }
+}
+
+/*
+    Get the shortest decimal digits for a finite, non-negative value. Returns the count of digits and sets
+    *point to the position of the decimal point relative to the first digit. Zero has no digits.
+ */
+static int getDigits(double value, char *digits, int *point)
+{
+    DiyFp  v, w, high, low, power;
+    uint64 bits;
+    int    biased, index, k, K, len;
+
+    if (value == 0) {
+        *point = 1;
+        return 0;
     }
-    precision = ctx->precision < 0 ? 6 : ctx->precision;
+    memcpy(&bits, &value, sizeof(bits));
+    biased = (int) ((bits >> 52) & 0x7FF);
+    v.f = bits & 0xFFFFFFFFFFFFFULL;
+    if (biased) {
+        v.f += (uint64) 1 << 52;
+        v.e = biased - 1075;
+    } else {
+        v.e = -1074;
+    }
+    /*
+        The rounding interval is halfway to the neighbouring doubles. The lower neighbour is closer for
+        exact powers of two.
+     */
+    high.f = (v.f << 1) + 1;
+    high.e = v.e - 1;
+    high = diyNormalize(high);
+    if (v.f == ((uint64) 1 << 52)) {
+        low.f = (v.f << 2) - 1;
+        low.e = v.e - 2;
+    } else {
+        low.f = (v.f << 1) - 1;
+        low.e = v.e - 1;
+    }
+    low.f <<= low.e - high.e;
+    low.e = high.e;
 
     /*
-        Round the value before splitting into integer and fractional parts.
-        This handles cases like 0.99 rounded to 1.0.
+        Select the power of ten that scales the upper bound into the range of [2^-60, 2^-32].
+        This needs ceil((-61 - e) * log10(2)) where (n * 78913) >> 18 is floor(n * log10(2)) for this range.
      */
-    round = 0.5;
-    for (int i = 0; i < precision; i++) {
-        round /= 10.0;
+    k = -61 - high.e;
+    k = ((k * 78913) >> 18) + (k != 0) + 347;
+    index = (k >> 3) + 1;
+    K = -(-348 + index * 8);
+    power.f = cachedPowersF[index];
+    power.e = cachedPowersE[index];
+
+    w = diyMultiply(diyNormalize(v), power);
+    high = diyMultiply(high, power);
+    low = diyMultiply(low, power);
+    low.f++;
+    high.f--;
+    len = grisuDigits(w, high, high.f - low.f, digits, &K);
+    *point = len + K;
+    return len;
+}
+
+/*
+    Convert a double to the shortest string that reads back as the same value without parsing a format
+ */
+PUBLIC char *sftosbuf(char *buf, size_t size, double value)
+{
+    PContext ctx;
+
+    if (buf == 0 || size < 2) {
+        return 0;
     }
-    value += value < 0 ? -round : round;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.buf = ctx.end = (uchar*) buf;
+    ctx.endbuf = &ctx.buf[size];
+    ctx.growBy = -1;
+    ctx.maxsize = (int) size;
+    ctx.format = 'g';
+    ctx.precision = -1;
+    outFloat(&ctx, value);
+    BPUT_NULL(&ctx);
+    if ((size_t) ctx.len >= size) {
+        return 0;
+    }
+    return buf;
+}
 
-    ipart = (int64) value;
-    outNum(ctx, 10, ipart);
+#else /* R_OWN_PRINTF */
 
-    if (precision > 0) {
-        BPUT(ctx, '.');
-    }
-    fpart = value - (double) ipart;
-    if (fpart < 0) {
-        fpart = -fpart;
-    }
-    for (int i = 0; i < precision; i++) {
-        fpart *= 10;
-        digit = (int) fpart;
-        BPUT(ctx, digit + '0');
-        fpart -= digit;
-    }
-    if (ctx->format == 'g') {
-        //  Remove trailing zeros and decimal point if precision is 0
-        if (ctx->precision < 0) {
-            for (last = &ctx->end[-1]; ctx->end > ctx->buf; last--, ctx->end--, ctx->len--) {
-                if (*last == '.') {
-                    *last = '\0';
-                    ctx->end = last;
-                    break;
-                } else if (*last == '0') {
-                    *last = '\0';
-                } else {
-                    break;
-                }
-            }
+/*
+    Incase you want to map onto the real printf
+ */
+PUBLIC ssize rVsnprintf(char *buf, size_t maxsize, cchar *spec, va_list args)
+{
+    return vsnprintf(buf, maxsize, spec, args);
+}
+
+PUBLIC ssize rVsaprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
+{
+    char  *str;
+    ssize len;
+
+    //  Copy into an rAlloc block as callers release the result via rFree
+    *buf = 0;
+    if ((len = vasprintf(&str, spec, args)) < 0) {
+        return len;
+    }
+    *buf = rMemdup(str, (size_t) len + 1);
+    free(str);
+    return *buf ? len : R_ERR_MEMORY;
+}
+
+PUBLIC char *sftosbuf(char *buf, size_t size, double value)
+{
+    if (buf == 0 || size < 2) {
+        return 0;
+    }
+    if (snprintf(buf, size, "%.17g", value) >= (int) size) {
+        return 0;
+    }
+    return buf;
+}
+#endif /* R_OWN_PRINTF */
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This software is distributed under a commercial license. Consult the LICENSE.md
+    distributed with this software for full details and copyrights.
+ */
+
+
+/********* Start of file src/profile.c ************/
+
+/*
+    profile.c - Sampling CPU profiler
+
+    A SIGPROF timer samples the runtime thread. The signal handler records the current fiber, its entry
+    proc and a backtrace into a preallocated buffer and does nothing else. Samples are symbolized and
+    folded into flamegraph stacks on demand, outside the signal handler.
+
+    The handler runs on the current fiber stack. If that overflows into the guard region, the guard page
+    handler grows the stack as for any other code. The guard page handler blocks SIGPROF while it runs.
+    A sample taken during a context switch may be attributed to the prior fiber.
+
+    Copyright (c) All Rights Reserved. See copyright notice at the bottom of the file.
+ */
+
+/********************************** Includes **********************************/
+
+
+
+#if ME_R_PROFILE
+#include    <execinfo.h>
+
+/*********************************** Locals ***********************************/
+
+/*
+    Frames recorded by backtrace for the signal handler and the signal trampoline
+ */
+#define PROFILE_SKIP 2
+
+typedef struct ProfileSample {
+    void *proc;                         // Fiber entry proc (NULL for the main fiber)
+    int depth;                          // Frames in pcs
+    void *pcs[R_PROFILE_DEPTH + PROFILE_SKIP];
+} ProfileSample;
+
+typedef struct Profile {
+    ProfileSample *samples;             // Preallocated sample buffer
+    volatile sig_atomic_t running;      // Recording samples
+    volatile int count;                 // Samples recorded
+    int max;                            // Size of the samples buffer
+    int64 dropped;                      // Samples dropped when the buffer was full
+    struct sigaction prior;             // Prior SIGPROF action
+} Profile;
+
+static Profile profile;
+
+/*********************************** Forwards *********************************/
+
+static void profileHandler(int signo, siginfo_t *info, void *arg);
+
+/************************************* Code ***********************************/
+
+PUBLIC int rStartProfile(int frequency, int maxSamples)
+{
+    struct sigaction sa;
+    struct itimerval timer;
+    void             *pcs[1];
+
+    if (profile.running) {
+        return R_ERR_BAD_STATE;
+    }
+    if (frequency <= 0) {
+        frequency = ME_R_PROFILE_HZ;
+    }
+    if (maxSamples <= 0) {
+        maxSamples = ME_R_PROFILE_SAMPLES;
+    }
+    if (maxSamples != profile.max) {
+        rFree(profile.samples);
+        if ((profile.samples = rAllocMem(sizeof(ProfileSample) * (size_t) maxSamples)) == 0) {
+            profile.max = 0;
+            return R_ERR_MEMORY;
         }
+        profile.max = maxSamples;
+    }
+    profile.count = 0;
+    profile.dropped = 0;
+
+    //  The first backtrace loads the unwinder which is not safe in a signal handler
+    backtrace(pcs, 1);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = profileHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, &profile.prior) < 0) {
+        return R_ERR_CANT_INITIALIZE;
+    }
+    profile.running = 1;
+
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_usec = max(1000000 / frequency, 1);
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, NULL) < 0) {
+        profile.running = 0;
+        sigaction(SIGPROF, &profile.prior, NULL);
+        return R_ERR_CANT_INITIALIZE;
     }
+    return 0;
 }
 
-static double normalizeScientific(double x, int *exponent)
+PUBLIC void rStopProfile(void)
 {
-    if (x == 0.0) {
-        *exponent = 0;
-        return 0.0;
-    }
-    int    exp = (int) floor(log10(fabs(x)));
-    double mantissa = x / pow(10.0, exp);
+    struct itimerval timer;
 
-    // Adjust if mantissa is not in the range [1.0, 10.0)
-    if (fabs(mantissa) < 1.0) {
-        mantissa *= 10.0;
-        exp -= 1;
+    if (!profile.running) {
+        return;
     }
-    *exponent = exp;
-    return mantissa;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    profile.running = 0;
+    sigaction(SIGPROF, &profile.prior, NULL);
 }
 
-static void outFloatE(PContext *ctx, char specchar, double value)
+PUBLIC void rTermProfile(void)
 {
-    double fpart, mantissa, round;
-    uchar  *last;
-    int64  ipart;
-    int    digit, exponent, fexp, precision;
+    rStopProfile();
+    rFree(profile.samples);
+    profile.samples = NULL;
+    profile.max = 0;
+    profile.count = 0;
+}
 
-    precision = ctx->precision < 0 ? 6 : ctx->precision;
-    mantissa = normalizeScientific(value, &exponent);
+/*
+    Record a sample. Only async-signal-safe operations are permitted here.
+ */
+static void profileHandler(int signo, siginfo_t *info, void *arg)
+{
+    ProfileSample *sp;
+    RFiber        *fiber;
+    int           index, saveErrno;
 
-    /*
-        Round the mantissa.
-     */
-    round = 0.5;
-    for (int i = 0; i < precision; i++) {
-        round /= 10.0;
+    //  Fibers are torn down and recreated while restarting
+    if (!profile.running || rState == R_RESTART || rIsForeignThread()) {
+        return;
     }
-    mantissa += (mantissa < 0) ? -round : round;
-
-    if (fabs(mantissa) >= 10.0) {
-        mantissa /= 10.0;
-        exponent++;
+    index = profile.count;
+    if (index >= profile.max) {
+        profile.dropped++;
+        return;
     }
+    saveErrno = errno;
+    sp = &profile.samples[index];
+    fiber = rGetFiber();
+    sp->proc = (fiber && !rIsMain()) ? (void*) fiber->func : NULL;
+    sp->depth = backtrace(sp->pcs, R_PROFILE_DEPTH + PROFILE_SKIP);
+    profile.count = index + 1;
+    errno = saveErrno;
+}
 
-    ipart = (int64) mantissa;
-    outNum(ctx, 10, ipart);
-
-    if (precision > 0) {
-        BPUT(ctx, '.');
-    }
-    fpart = mantissa - (double) ipart;
-    if (fpart < 0) {
-        fpart = -fpart;
-    }
-    for (int i = 0; i < precision; i++) {
-        fpart *= 10;
-        //  Round out IEEE imprecision
-        digit = (int) (fpart + 1.0e-15);
-        BPUT(ctx, digit + '0');
-        fpart -= digit;
-    }
-    if (ctx->format == 'g') {
-        //  Remove trailing zeros and decimal point if precision is 0
-        if (ctx->precision < 0) {
-            for (last = &ctx->end[-1]; ctx->end > ctx->buf; last--, ctx->end--) {
-                if (*last == '0' || *last == '.') {
-                    *last = '\0';
-                } else {
-                    break;
-                }
-            }
-        }
-    }
-    fexp = abs(exponent);
-    BPUT(ctx, (ctx->format == 'E' || ctx->format == 'G') ? 'E' : 'e');
-    BPUT(ctx, exponent < 0 ? '-' : '+');
-    if (fexp >= 100) {
-        BPUT(ctx, '0' + fexp / 100);
-        BPUT(ctx, '0' + (fexp / 10) % 10);
-        BPUT(ctx, '0' + fexp % 10);
+/*
+    Format a code address as a symbol name or module+offset. Return addresses are adjusted to lie within
+    the calling instruction. The entry flag indicates a function entry address which must match the symbol.
+ */
+static void putSymbol(RBuf *buf, void *pc, bool ret, bool entry, int flags)
+{
+    Dl_info info;
+    cchar   *module;
+    size_t  addr;
+
+    addr = (size_t) pc - (ret ? 1 : 0);
+    if (!dladdr((void*) addr, &info)) {
+        info.dli_fname = NULL;
+        info.dli_sname = NULL;
+    }
+    if (info.dli_sname && !(flags & R_PROFILE_RAW) && (!entry || info.dli_saddr == pc)) {
+        rPutStringToBuf(buf, info.dli_sname);
+    } else if (info.dli_fname) {
+        module = rBasename(info.dli_fname);
+        rPutToBuf(buf, "%s+0x%zx", module, addr - (size_t) info.dli_fbase);
     } else {
-        BPUT(ctx, '0' + fexp / 10);
-        BPUT(ctx, '0' + fexp % 10);
+        rPutToBuf(buf, "0x%zx", addr);
     }
 }
 
-/*
-    grow the buffer to fit new data. return 1 if the buffer can grow.
-    grow using the growby size specified when creating the buffer.
- */
-static int growBuf(PContext *ctx)
+static int compareStacks(cvoid *s1, cvoid *s2, void *ctx)
 {
-    uchar  *newbuf;
-    size_t buflen, newSize;
+    return strcmp(*(char**) s1, *(char**) s2);
+}
 
-    buflen = (size_t) (ctx->endbuf - ctx->buf);
-    if (ctx->maxsize > 0 && buflen >= (size_t) ctx->maxsize) {
-        return R_ERR_BAD_ARGS;
-    }
-    if (ctx->growBy <= 0) {
-        //  User supplied buffer
-        return 0;
-    }
-    if (ctx->growBy > 0 && buflen > MAXSSIZE - (size_t) ctx->growBy) {
-        // Integer overflow
-        return R_ERR_MEMORY;
-    }
-    newSize = buflen + (size_t) ctx->growBy;
-    if ((newbuf = rAlloc(newSize)) == 0) {
-        return R_ERR_MEMORY;
+PUBLIC char *rGetProfile(int flags)
+{
+    ProfileSample *sp;
+    RHash         *stacks;
+    RName         *np;
+    RBuf          *buf, *result;
+    char          **keys;
+    int           i, frame, count;
+
+    stacks = rAllocHash(0, R_TEMPORAL_NAME | R_STATIC_VALUE);
+    buf = rAllocBuf(256);
+    count = profile.count;
+    for (i = 0; i < count; i++) {
+        sp = &profile.samples[i];
+        rFlushBuf(buf);
+        if (sp->proc) {
+            rPutStringToBuf(buf, "fiber:");
+            putSymbol(buf, sp->proc, 0, 1, flags);
+        } else {
+            rPutStringToBuf(buf, "main");
+        }
+        //  Frames are leaf first. The interrupted frame is exact, callers are return addresses.
+        for (frame = sp->depth - 1; frame >= PROFILE_SKIP; frame--) {
+            rPutCharToBuf(buf, ';');
+            putSymbol(buf, sp->pcs[frame], frame > PROFILE_SKIP, 0, flags);
+        }
+        if ((np = rLookupNameEntry(stacks, rBufToString(buf))) != 0) {
+            np->value = (void*) ((ssize) np->value + 1);
+        } else {
+            rAddName(stacks, rBufToString(buf), (void*) (ssize) 1, 0);
+        }
     }
-    if (ctx->buf) {
-        memcpy(newbuf, ctx->buf, buflen);
-        rFree(ctx->buf);
+    //  Sort for stable output
+    keys = rAlloc(sizeof(char*) * (size_t) (rGetHashLength(stacks) + 1));
+    i = 0;
+    for (ITERATE_NAMES(stacks, np)) {
+        keys[i++] = np->name;
     }
-    ctx->end = newbuf + (ctx->end - ctx->buf);
-    ctx->buf = newbuf;
-    ctx->endbuf = &ctx->buf[newSize];
+    rSort(keys, i, sizeof(char*), compareStacks, 0);
 
-    /*
-        Increase growBy to reduce overhead
-     */
-    if (ctx->growBy <= (int) (INT_MAX / 2)) {
-        ctx->growBy *= 2;
+    result = rAllocBuf(1024);
+    for (frame = 0; frame < i; frame++) {
+        rPutToBuf(result, "%s %zd\n", keys[frame], (ssize) rLookupName(stacks, keys[frame]));
     }
-    return 1;
+    rFree(keys);
+    rFreeBuf(buf);
+    rFreeHash(stacks);
+    return rBufToStringAndFree(result);
 }
 
-#else /* R_OWN_PRINTF */
-
-/*
-    Incase you want to map onto the real printf
- */
-PUBLIC ssize rVsnprintf(char *buf, size_t maxsize, cchar *spec, va_list args)
+PUBLIC void rGetProfileStats(int64 *samples, int64 *dropped)
 {
-    return vsnprintf(buf, maxsize, spec, args);
+    if (samples) {
+        *samples = profile.count;
+    }
+    if (dropped) {
+        *dropped = profile.dropped;
+    }
 }
 
-PUBLIC ssize rVsaprintf(char **buf, size_t maxsize, cchar *spec, va_list args)
+PUBLIC int rWriteProfile(cchar *path, int flags)
 {
-    return vasprintf(buf, spec, args);
+    char *data;
+    int  rc;
+
+    data = rGetProfile(flags);
+    rc = rWriteFile(path, data, slen(data), 0600) < 0 ? R_ERR_CANT_WRITE : 0;
+    rFree(data);
+    return rc;
 }
-#endif /* R_OWN_PRINTF */
+#endif /* ME_R_PROFILE */
 
 /*
     Copyright (c) Embedthis Software. All Rights Reserved.
-    This software is distributed under a commercial license. Consult the LICENSE.md
-    distributed with this software for full details and copyrights.
+    This is proprietary software and requires a commercial license from the author.
  */
 
 
@@ -9377,6 +13335,9 @@ PUBLIC ssize rMakeArgs(cchar *command, char ***argvp, bool argsOnly)
 
 
 #if R_USE_SOCKET
+#if LINUX
+    #include <linux/filter.h>
+#endif
 /*********************************** Locals ***********************************/
 
 #define ME_SOCKET_TIMEOUT    (30 * 1000)
@@ -9385,6 +13346,11 @@ PUBLIC ssize rMakeArgs(cchar *command, char ***argvp, bool argsOnly)
     #define ME_SOCKET_MAX    1000
 #endif
 
+/*
+    TLS writes of small leading blocks are coalesced up to the maximum TLS record payload
+ */
+#define TLS_COALESCE_SIZE    (16 * 1024)
+
 static int           activeSockets = 0;
 static int           socketLimit = ME_SOCKET_MAX;
 static RSocketCustom socketCustom;
@@ -9394,9 +13360,13 @@ static RSocketCustom socketCustom;
 static void acceptSocket(RSocket *listen, int mask);
 static void socketHandlerFiber(RSocket *sp);
 static int getOsError(RSocket *sp);
+static ssize writeSocketv(RSocket *sp, RIOVec *iov, int count);
 #if ME_DEBUG
 static void traceSocket(Socket fd, cchar *label);
 #endif
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+static void attachReusePortFilter(RSocket *lp);
+#endif
 
 /************************************ Code ************************************/
 
@@ -9502,6 +13472,7 @@ PUBLIC int rConnectSocket(RSocket *sp, cchar *host, int port, Ticks deadline)
     struct sockaddr_storage peerAddr;
     Socklen                 errorLen, peerLen;
     char                    pbuf[16];
+    uint64                  span;
     int                     error, rc;
 
     if (!host) {
@@ -9529,7 +13500,10 @@ PUBLIC int rConnectSocket(RSocket *sp, cchar *host, int port, Ticks deadline)
     hints.ai_protocol = IPPROTO_TCP;
 
     sitosbuf(pbuf, sizeof(pbuf), port, 10);
-    if (getaddrinfo(host, pbuf, &hints, &res) != 0) {
+    span = rSpanBegin("socket", "resolve");
+    rc = getaddrinfo(host, pbuf, &hints, &res);
+    rSpanEnd(span);
+    if (rc != 0) {
         rSetSocketError(sp, "Cannot find address of %s:%d", host, port);
         return R_ERR_BAD_ARGS;
     }
@@ -9623,8 +13597,13 @@ PUBLIC int rConnectSocket(RSocket *sp, cchar *host, int port, Ticks deadline)
         return R_ERR_CANT_CONNECT;
     }
  #if ME_COM_SSL
-    if (sp->tls && rUpgradeTls(sp->tls, sp->fd, host, deadline) < 0) {
-        return rSetSocketError(sp, "Cannot upgrade socket to TLS");
+    if (sp->tls) {
+        span = rSpanBegin("tls", "handshake");
+        rc = rUpgradeTls(sp->tls, sp->fd, host, deadline);
+        rSpanEnd(span);
+        if (rc < 0) {
+            return rSetSocketError(sp, "Cannot upgrade socket to TLS");
+        }
     }
  #endif
     if (sp->linger >= 0) {
@@ -9703,6 +13682,17 @@ PUBLIC int rListenSocket(RSocket *lp, cchar *host, int port, RSocketProc handler
             continue;
         }
  #endif
+ #if defined(SO_REUSEPORT)
+        if (lp->flags & R_SOCKET_REUSE_PORT) {
+            int reuse = 1;
+            if (setsockopt(lp->fd, SOL_SOCKET, SO_REUSEPORT, (char*) &reuse, sizeof(reuse)) != 0) {
+                rSetSocketError(lp, "Cannot set reuseport, errno %d", rGetOsError());
+                closesocket(lp->fd);
+                lp->fd = INVALID_SOCKET;
+                continue;
+            }
+        }
+ #endif
  #if defined(IPV6_V6ONLY)
         //  For IPv6 sockets, disable IPv6-only mode to allow IPv4 connections on dual-stack systems
         if (family == AF_INET6) {
@@ -9738,6 +13728,12 @@ PUBLIC int rListenSocket(RSocket *lp, cchar *host, int port, RSocketProc handler
         closesocket(lp->fd);
         return R_ERR_CANT_OPEN;
     }
+ #if defined(SO_ATTACH_REUSEPORT_CBPF)
+    if ((lp->flags & R_SOCKET_REUSE_PORT) && lp->shards > 1) {
+        //  The listener must have joined the reuse-port group before the filter is attached
+        attachReusePortFilter(lp);
+    }
+ #endif
  #if ME_UNIX_LIKE
     fcntl(lp->fd, F_SETFD, FD_CLOEXEC);
  #endif
@@ -9754,6 +13750,34 @@ PUBLIC int rListenSocket(RSocket *lp, cchar *host, int port, RSocketProc handler
     return 0;
 }
 
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+/*
+    Select the listener in the reuse-port group by client address so a client always reaches the same process.
+    The filter hashes the low word of the IPv4 or IPv6 source address modulo the group size. Until all listeners
+    have joined the group, out of range selections fall back to the kernel connection hash.
+ */
+static void attachReusePortFilter(RSocket *lp)
+{
+    struct sock_fprog prog;
+
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, (uint) SKF_NET_OFF),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 4),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 6, 0, 2),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, (uint) SKF_NET_OFF + 20),
+        BPF_JUMP(BPF_JMP | BPF_JA, 1, 0, 0),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, (uint) SKF_NET_OFF + 12),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, (uint) lp->shards),
+        BPF_STMT(BPF_RET | BPF_A, 0),
+    };
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    if (setsockopt(lp->fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) != 0) {
+        rInfo("socket", "Cannot attach reuseport filter, errno %d. Using connection distribution.", rGetOsError());
+    }
+}
+#endif
+
 /*
     This routine is called by the accept wait handler when a new connection is accepted.
     Runs on main fiber - only does accept() and basic field assignment.
@@ -9993,6 +14017,131 @@ PUBLIC ssize rWriteSocketSync(RSocket *sp, cvoid *buf, size_t bufsize)
     return bytes;
 }
 
+/*
+    Write a set of blocks and wait while the socket drains. The blocks are copied so partial writes can advance
+    through them without modifying the caller's array.
+ */
+PUBLIC ssize rWriteSocketv(RSocket *sp, const RIOVec *iov, int count, Ticks deadline)
+{
+    RIOVec vec[ME_R_IOV_MAX];
+    size_t total, written;
+    ssize  bytes;
+    int    i, n;
+
+    if (!sp || !iov || count < 0 || count > ME_R_IOV_MAX) {
+        return R_ERR_BAD_ARGS;
+    }
+    for (i = n = 0, total = 0; i < count; i++) {
+        if (iov[i].iov_len > 0) {
+            vec[n++] = iov[i];
+            total += iov[i].iov_len;
+        }
+    }
+    if (deadline <= 0) {
+        deadline = rGetTicks() + ME_HANDSHAKE_TIMEOUT;
+    }
+    for (i = 0; i < n; ) {
+        if ((bytes = writeSocketv(sp, &vec[i], n - i)) < 0) {
+            return bytes;
+        }
+        for (written = (size_t) bytes; i < n && written >= vec[i].iov_len; i++) {
+            written -= vec[i].iov_len;
+        }
+        if (i < n) {
+            vec[i].iov_base = (char*) vec[i].iov_base + written;
+            vec[i].iov_len -= written;
+            //  writeSocketv returns a short count without blocking, so wait here until the socket is writable
+            if (rWaitForIO(sp->wait, R_WRITABLE, deadline) == 0) {
+                return R_ERR_TIMEOUT;
+            }
+        }
+    }
+    if (sp->flags & R_SOCKET_EOF) {
+        return R_ERR_CANT_WRITE;
+    }
+    return (ssize) total;
+}
+
+/*
+    Write as much of a set of non-empty blocks as the socket can absorb without waiting.
+    Returns the count of bytes written which may be less than the total. Returns a negative error code on errors.
+ */
+static ssize writeSocketv(RSocket *sp, RIOVec *iov, int count)
+{
+    ssize bytes;
+
+    if (sp->flags & R_SOCKET_EOF) {
+        return R_ERR_CANT_WRITE;
+    }
+#if ME_COM_SSL
+    if (sp->tls) {
+        char   *buf;
+        size_t len, size;
+        int    i;
+
+        /*
+            Each TLS write emits at least one record. Coalesce small leading blocks (headers and chunk framing)
+            with the start of the following data into one record. Large blocks are written directly.
+         */
+        if (count == 1 || iov[0].iov_len >= TLS_COALESCE_SIZE) {
+            bytes = rWriteTls(sp->tls, iov[0].iov_base, iov[0].iov_len);
+        } else {
+            for (i = 0, size = 0; i < count && size < TLS_COALESCE_SIZE; i++) {
+                size += iov[i].iov_len;
+            }
+            size = min(size, TLS_COALESCE_SIZE);
+            buf = rAlloc(size);
+            for (i = 0, len = 0; len < size; i++) {
+                memcpy(&buf[len], iov[i].iov_base, min(iov[i].iov_len, size - len));
+                len += min(iov[i].iov_len, size - len);
+            }
+            bytes = rWriteTls(sp->tls, buf, size);
+            rFree(buf);
+        }
+        if (bytes < 0) {
+            sp->flags |= R_SOCKET_EOF;
+        }
+        return bytes;
+    }
+#endif
+#if ME_UNIX_LIKE
+    {
+        struct msghdr msg;
+        int           error;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t) count;
+        while ((bytes = sendmsg(sp->fd, &msg, MSG_NOSIGNAL)) < 0) {
+            error = getOsError(sp);
+            if (error == EINTR) {
+                continue;
+            } else if (error == EAGAIN || error == EWOULDBLOCK) {
+                return 0;
+            }
+            return -error;
+        }
+        sp->activity = rGetTime();
+    }
+#else
+    {
+        ssize written;
+        int   i;
+
+        for (i = 0, bytes = 0; i < count; i++) {
+            if ((written = rWriteSocketSync(sp, iov[i].iov_base, iov[i].iov_len)) < 0) {
+                return bytes > 0 ? bytes : written;
+            }
+            bytes += written;
+            if ((size_t) written < iov[i].iov_len) {
+                break;
+            }
+        }
+    }
+#endif
+    return bytes;
+}
+
 /*
     Set a socket into blocking I/O mode. from a socket.
     Sockets are opened in non-blocking mode by default.
@@ -10105,6 +14254,14 @@ PUBLIC void rSetSocketLinger(RSocket *sp, int linger)
     }
 }
 
+PUBLIC void rSetSocketReusePort(RSocket *sp, int shards)
+{
+    if (sp) {
+        sp->flags |= R_SOCKET_REUSE_PORT;
+        sp->shards = shards;
+    }
+}
+
 PUBLIC void rSetSocketNoDelay(RSocket *sp, int enable)
 {
     int value = enable ? 1 : 0;
@@ -10367,26 +14524,218 @@ PUBLIC ssize rSendFile(RSocket *sock, int fd, Offset offset, size_t len)
                 }
                 continue;
             }
-            return (total > 0) ? (ssize) total : -1;
-        }
-        total += written;
-        remaining -= written;
-        if (written == 0) {
-            break;
+            return (total > 0) ? (ssize) total : -1;
+        }
+        total += written;
+        remaining -= written;
+        if (written == 0) {
+            break;
+        }
+    }
+    return (ssize) total;
+
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+#endif /* ME_HAS_SENDFILE */
+
+#endif /* R_USE_SOCKET */
+/*
+    Copyright (c) Michael O'Brien. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
+
+
+/********* Start of file src/span.c ************/
+
+/*
+    span.c - Structured trace spans
+
+    Spans are recorded into a ring buffer that overwrites the oldest spans when full. Each fiber tracks its
+    current span so nested spans record their parent, even when fibers interleave. Spans are exported as
+    Chrome trace-event JSON with one track per fiber.
+
+    Copyright (c) All Rights Reserved. See copyright notice at the bottom of the file.
+ */
+
+/********************************** Includes **********************************/
+
+
+
+#if ME_R_SPAN
+/*********************************** Locals ***********************************/
+
+typedef struct Span {
+    uint64 id;                          // Span ID. Used to detect overwritten spans.
+    uint64 parent;                      // Parent span ID
+    uint64 start;                       // Start time in microseconds
+    uint64 end;                         // End time in microseconds. Zero while open.
+    cchar *category;
+    cchar *name;
+    int track;                          // Fiber track
+} Span;
+
+typedef struct Spans {
+    Span *ring;                         // Span ring buffer
+    char *path;                         // Default file for rWriteSpans
+    uint64 next;                        // Last allocated span ID
+    int max;                            // Size of ring
+    int mainTrack;                      // Track of the main fiber
+    int tracks;                         // Last allocated track
+    bool running;
+} Spans;
+
+static Spans spans;
+
+/************************************ Code ************************************/
+
+PUBLIC int rStartSpans(int maxSpans, cchar *path)
+{
+    Span *ring;
+
+    if (maxSpans <= 0) {
+        maxSpans = ME_R_SPAN_MAX;
+    }
+    if ((ring = rAllocMem(sizeof(Span) * (size_t) maxSpans)) == 0) {
+        return R_ERR_MEMORY;
+    }
+    memset(ring, 0, sizeof(Span) * (size_t) maxSpans);
+    rFree(spans.ring);
+    rFree(spans.path);
+    spans.ring = ring;
+    spans.max = maxSpans;
+    spans.path = path ? sclone(path) : NULL;
+    spans.running = 1;
+    return 0;
+}
+
+PUBLIC void rStopSpans(void)
+{
+    spans.running = 0;
+}
+
+PUBLIC void rTermSpans(void)
+{
+    spans.running = 0;
+    rFree(spans.ring);
+    rFree(spans.path);
+    spans.ring = NULL;
+    spans.path = NULL;
+    spans.max = 0;
+}
+
+PUBLIC uint64 rSpanBegin(cchar *category, cchar *name)
+{
+    RFiber *fiber;
+    Span   *sp;
+    uint64 id;
+
+    if (!spans.running || rIsForeignThread()) {
+        return 0;
+    }
+    fiber = rGetFiber();
+    if (fiber->spanTrack == 0) {
+        fiber->spanTrack = ++spans.tracks;
+        if (rIsMain()) {
+            spans.mainTrack = fiber->spanTrack;
+        }
+    }
+    /*
+        Span IDs are never reused (even across restarts) so a stale ID will not match a recycled ring slot
+     */
+    id = ++spans.next;
+    sp = &spans.ring[id % (uint64) spans.max];
+    sp->id = id;
+    sp->parent = fiber->span;
+    sp->category = category;
+    sp->name = name;
+    sp->track = fiber->spanTrack;
+    sp->end = 0;
+    sp->start = rGetEventClock();
+    fiber->span = id;
+    return id;
+}
+
+PUBLIC void rSpanEnd(uint64 id)
+{
+    RFiber *fiber;
+    Span   *sp;
+    uint64 parent;
+
+    if (id == 0 || !spans.ring) {
+        return;
+    }
+    parent = 0;
+    sp = &spans.ring[id % (uint64) spans.max];
+    if (sp->id == id) {
+        //  Ensure a non-zero duration to mark the span as ended
+        sp->end = max(rGetEventClock(), sp->start + 1);
+        parent = sp->parent;
+    }
+    fiber = rGetFiber();
+    if (fiber->span == id) {
+        fiber->span = parent;
+    }
+}
+
+PUBLIC char *rGetSpans(void)
+{
+    RBuf   *buf;
+    Span   *sp;
+    uint64 count, id;
+    int    pid;
+    bool   first;
+
+    buf = rAllocBuf(ME_BUFSIZE);
+    pid = (int) getpid();
+    rPutStringToBuf(buf, "{\"traceEvents\":[\n");
+    first = 1;
+    if (spans.mainTrack) {
+        rPutToBuf(buf, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"main\"}}",
+                  pid, spans.mainTrack);
+        first = 0;
+    }
+    if (spans.ring) {
+        //  Emit spans oldest first
+        count = min(spans.next, (uint64) spans.max);
+        for (id = spans.next - count + 1; id <= spans.next; id++) {
+            sp = &spans.ring[id % (uint64) spans.max];
+            if (sp->id != id || sp->end == 0) {
+                continue;
+            }
+            rPutToBuf(buf, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+                      "\"pid\":%d,\"tid\":%d,\"args\":{\"id\":%lld,\"parent\":%lld}}",
+                      first ? "" : ",\n", sp->name, sp->category, (int64) sp->start, (int64) (sp->end - sp->start),
+                      pid, sp->track, (int64) sp->id, (int64) sp->parent);
+            first = 0;
         }
     }
-    return (ssize) total;
+    rPutStringToBuf(buf, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return rBufToStringAndFree(buf);
+}
 
-#else
-    errno = ENOSYS;
-    return -1;
-#endif
+PUBLIC int rWriteSpans(cchar *path)
+{
+    char *data;
+    int  rc;
+
+    if (!path) {
+        path = spans.path;
+    }
+    if (!path) {
+        return R_ERR_BAD_ARGS;
+    }
+    data = rGetSpans();
+    rc = rWriteFile(path, data, slen(data), 0600) < 0 ? R_ERR_CANT_WRITE : 0;
+    rFree(data);
+    return rc;
 }
-#endif /* ME_HAS_SENDFILE */
+#endif /* ME_R_SPAN */
 
-#endif /* R_USE_SOCKET */
 /*
-    Copyright (c) Michael O'Brien. All Rights Reserved.
+    Copyright (c) Embedthis Software. All Rights Reserved.
     This is proprietary software and requires a commercial license from the author.
  */
 
@@ -10441,11 +14790,20 @@ PUBLIC char *sitosbuf(char *buf, size_t size, int64 value, int radix)
         uval = (uint64_t) value;
         negative = 0;
     }
-    do {
-        if (cp == buf) return 0; // Out of space
-        *--cp = digits[uval % (uint64) radix];
-        uval /= (uint64) radix;
-    } while (uval > 0);
+    if (radix == 10) {
+        //  A constant divisor is much faster
+        do {
+            if (cp == buf) return 0; // Out of space
+            *--cp = (char) ('0' + uval % 10);
+            uval /= 10;
+        } while (uval > 0);
+    } else {
+        do {
+            if (cp == buf) return 0; // Out of space
+            *--cp = digits[uval % (uint64) radix];
+            uval /= (uint64) radix;
+        } while (uval > 0);
+    }
 
     if (negative) {
         if (cp == buf) {
@@ -11961,6 +16319,92 @@ PUBLIC void rMemoryBarrier(void)
     #endif
 }
 
+PUBLIC bool rAtomicCas(void *volatile *target, void *expected, cvoid *value)
+{
+    #if ME_WIN_LIKE
+    return InterlockedCompareExchangePointer(target, (void*) value, expected) == expected;
+
+    #elif ME_COMPILER_HAS_ATOMIC
+    return __atomic_compare_exchange_n(target, &expected, (void*) value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+    #elif ME_COMPILER_HAS_SYNC_CAS
+    return __sync_bool_compare_and_swap(target, expected, (void*) value);
+
+    #else
+    bool rc;
+
+    rGlobalLock();
+    if ((rc = (*target == expected)) != 0) {
+        *target = (void*) value;
+    }
+    rGlobalUnlock();
+    return rc;
+    #endif
+}
+
+PUBLIC void *rAtomicExchange(void *volatile *target, cvoid *value)
+{
+    #if ME_WIN_LIKE
+    return InterlockedExchangePointer(target, (void*) value);
+
+    #elif ME_COMPILER_HAS_ATOMIC
+    return __atomic_exchange_n(target, (void*) value, __ATOMIC_SEQ_CST);
+
+    #else
+    void *prior;
+
+    do {
+        prior = *target;
+    } while (!rAtomicCas(target, prior, value));
+    return prior;
+    #endif
+}
+
+PUBLIC bool rAtomicCas64(volatile int64 *target, int64 expected, int64 value)
+{
+    #if ME_WIN_LIKE
+    return InterlockedCompareExchange64(target, value, expected) == expected;
+
+    #elif ME_COMPILER_HAS_ATOMIC && ME_COMPILER_HAS_ATOMIC64
+    return __atomic_compare_exchange_n(target, &expected, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+    #elif ME_COMPILER_HAS_SYNC64
+    return __sync_bool_compare_and_swap(target, expected, value);
+
+    #else
+    bool rc;
+
+    rGlobalLock();
+    if ((rc = (*target == expected)) != 0) {
+        *target = value;
+    }
+    rGlobalUnlock();
+    return rc;
+    #endif
+}
+
+PUBLIC int64 rAtomicAdd64(volatile int64 *target, int64 value)
+{
+    #if ME_WIN_LIKE
+    return InterlockedExchangeAdd64(target, value);
+
+    #elif ME_COMPILER_HAS_ATOMIC && ME_COMPILER_HAS_ATOMIC64
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+
+    #elif ME_COMPILER_HAS_SYNC64
+    return __sync_fetch_and_add(target, value);
+
+    #else
+    int64 prior;
+
+    rGlobalLock();
+    prior = *target;
+    *target += value;
+    rGlobalUnlock();
+    return prior;
+    #endif
+}
+
 #endif /* R_USE_THREAD */
 /*
     Copyright (c) Embedthis Software. All Rights Reserved.
@@ -12581,6 +17025,9 @@ static void setLogFilter(void)
 }
 #endif
 
+/*
+    Signal handler for SIGUSR2 to enable all log trace
+ */
 static void logHandler(int signo)
 {
 #if R_USE_EVENT
@@ -12900,6 +17347,12 @@ void vxworksDummy(void)
 
 
 #if R_USE_WAIT
+
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    #include    <linux/io_uring.h>
+    #include    <sys/syscall.h>
+#endif
+
 /*********************************** Locals ***********************************/
 /**
     Maximum number of wait events
@@ -12908,6 +17361,64 @@ void vxworksDummy(void)
     #define ME_MAX_EVENTS 128
 #endif
 
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+/*
+    Size of the io_uring submission queue. The completion queue is twice this size.
+ */
+#ifndef ME_URING_ENTRIES
+    #define ME_URING_ENTRIES 256
+#endif
+
+/*
+    The io_uring notifier arms a one-shot poll for each wait object. Poll requests are queued on the
+    submission ring by rSetWaitMask without a system call, and are submitted in one batch together with the
+    wait for completions in rWait. A fired poll is re-armed before its handler runs, giving level-triggered
+    semantics like epoll. Requests are tagged with the fd and a per-fd generation so stale completions for
+    removed or replaced polls are discarded. If the kernel does not support io_uring, epoll is used instead.
+ */
+#define URING_IGNORE   ((uint64) - 1)
+#define URING_TAG(fd, gen) (((uint64) (gen) << 32) | (uint32) (fd))
+
+typedef struct UringFd {
+    int mask;                   /* Current poll mask (POLLIN | POLLOUT) */
+    uint gen;                   /* Generation of the current poll request */
+    bool armed;                 /* Poll request outstanding */
+} UringFd;
+
+typedef struct Uring {
+    int fd;                     /* Ring file descriptor */
+    uint *sqHead;
+    uint *sqTail;
+    uint *sqMask;
+    uint *sqArray;
+    uint sqEntries;
+    uint sqLocalTail;           /* Tail including queued but unsubmitted entries */
+    uint pending;               /* Entries queued since the last io_uring_enter */
+    uint *cqHead;
+    uint *cqTail;
+    uint *cqMask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sqRing;
+    void *cqRing;
+    size_t sqRingSize;
+    size_t cqRingSize;
+    UringFd *fds;               /* Per-fd poll state indexed by fd */
+    int maxFds;
+} Uring;
+
+static Uring uring = { .fd = -1 };
+static bool  useUring = 0;
+
+static void armUringPoll(int fd, int mask);
+static int enterUring(uint submit, uint wait, Ticks timeout);
+static struct io_uring_sqe *getUringSqe(void);
+static int initUring(void);
+static void setUringMask(int fd, int64 mask);
+static void termUring(void);
+static int waitUring(Ticks timeout);
+#endif
+
 #if ME_EVENT_NOTIFIER == R_EVENT_SELECT
 static fd_set readMask, writeMask, readEvents, writeEvents;
 static int    highestFd = -1;
@@ -12938,7 +17449,12 @@ PUBLIC int rInitWait(void)
     if (!waitMap) {
         return R_ERR_MEMORY;
     }
-#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    if ((useUring = initUring() == 0) == 0) {
+        rInfo("runtime", "io_uring is not supported by this kernel, using epoll");
+    }
+#endif
+#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
     if ((waitfd = epoll_create(ME_MAX_EVENTS)) < 0) {
         rError("runtime", "Call to epoll failed");
         return R_ERR_CANT_INITIALIZE;
@@ -12978,7 +17494,10 @@ PUBLIC void rTermWait(void)
 {
     rFreeHash(waitMap);
 
-#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    termUring();
+#endif
+#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
     if (waitfd >= 0) {
         close(waitfd);
         waitfd = -1;
@@ -13003,6 +17522,44 @@ PUBLIC void rTermWait(void)
 #endif
 }
 
+/*
+    Re-create the notifier in a forked child and re-register the current wait masks
+ */
+PUBLIC int rResetWait(void)
+{
+    RName *np;
+    RWait *wp;
+    int   mask;
+
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    //  The rings are MAP_SHARED with the parent, so unmap our view and create a new ring
+    termUring();
+    useUring = initUring() == 0;
+#endif
+#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
+    if (waitfd >= 0) {
+        close(waitfd);
+    }
+    if ((waitfd = epoll_create(ME_MAX_EVENTS)) < 0) {
+        rError("runtime", "Call to epoll failed");
+        return R_ERR_CANT_INITIALIZE;
+    }
+#elif ME_EVENT_NOTIFIER == R_EVENT_KQUEUE
+    //  Kqueues are not inherited by the child
+    if ((waitfd = kqueue()) < 0) {
+        rError("runtime", "Call to kqueue failed");
+        return R_ERR_CANT_INITIALIZE;
+    }
+#endif
+    for (ITERATE_NAMES(waitMap, np)) {
+        wp = np->value;
+        mask = wp->mask;
+        wp->mask = 0;
+        rSetWaitMask(wp, mask, wp->deadline);
+    }
+    return 0;
+}
+
 PUBLIC RWait *rAllocWait(int fd)
 {
     RWait *wp;
@@ -13027,8 +17584,8 @@ PUBLIC void rFreeWait(RWait *wp)
 
     if (wp) {
         if (wp->fd != INVALID_SOCKET) {
-#if ME_EVENT_NOTIFIER == R_EVENT_WSAPOLL
-            //  Must remove from pollFds array since we manage it manually
+#if ME_EVENT_NOTIFIER == R_EVENT_WSAPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
+            //  Must remove from pollFds array (or cancel the io_uring poll) since we manage it manually
             rSetWaitMask(wp, 0, 0);
 #endif
             rRemoveName(waitMap, sitosbuf(fdbuf, sizeof(fdbuf), (int64) wp->fd, 10));
@@ -13078,7 +17635,13 @@ PUBLIC void rSetWaitMask(RWait *wp, int64 mask, Ticks deadline)
     priorMask = wp->mask;
     wp->mask = (int) mask;
 
-#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    if (useUring) {
+        setUringMask((int) fd, mask);
+        return;
+    }
+#endif
+#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
     struct epoll_event ev;
 
     if (fd < 0 || fd >= FD_SETSIZE) {
@@ -13241,7 +17804,14 @@ PUBLIC int rWait(Ticks deadline)
 
     timeout = getTimeout(deadline);
 
-#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    if (useUring) {
+        int numEvents = waitUring(timeout);
+        waiting = 0;
+        return numEvents;
+    }
+#endif
+#if ME_EVENT_NOTIFIER == R_EVENT_EPOLL || ME_EVENT_NOTIFIER == R_EVENT_URING
     struct epoll_event events[ME_MAX_EVENTS];
     int                event, fd, i, numEvents;
 
@@ -13494,6 +18064,11 @@ PUBLIC int rWaitForIO(RWait *wp, int mask, Ticks deadline)
 
 PUBLIC int rGetWaitFd(void)
 {
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+    if (useUring) {
+        return uring.fd;
+    }
+#endif
     return waitfd;
 }
 
@@ -13537,6 +18112,292 @@ static Ticks getTimeout(Ticks deadline)
     return timeout;
 }
 
+#if ME_EVENT_NOTIFIER == R_EVENT_URING
+/*
+    Create the io_uring and map the submission and completion rings.
+    Requires IORING_FEAT_EXT_ARG (Linux 5.11) to wait for completions with a timeout.
+ */
+static int initUring(void)
+{
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = ME_URING_ENTRIES * 2;
+
+    if ((uring.fd = (int) syscall(__NR_io_uring_setup, ME_URING_ENTRIES, &params)) < 0) {
+        uring.fd = -1;
+        return R_ERR_CANT_INITIALIZE;
+    }
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)) {
+        termUring();
+        return R_ERR_BAD_STATE;
+    }
+    uring.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint);
+    uring.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring.sqRingSize = uring.cqRingSize = max(uring.sqRingSize, uring.cqRingSize);
+    }
+    uring.sqRing = mmap(0, uring.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+                        IORING_OFF_SQ_RING);
+    if (uring.sqRing == MAP_FAILED) {
+        uring.sqRing = 0;
+        termUring();
+        return R_ERR_CANT_INITIALIZE;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring.cqRing = uring.sqRing;
+    } else {
+        uring.cqRing = mmap(0, uring.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+                            IORING_OFF_CQ_RING);
+        if (uring.cqRing == MAP_FAILED) {
+            uring.cqRing = 0;
+            termUring();
+            return R_ERR_CANT_INITIALIZE;
+        }
+    }
+    uring.sqes = mmap(0, params.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, uring.fd, IORING_OFF_SQES);
+    if (uring.sqes == MAP_FAILED) {
+        uring.sqes = 0;
+        termUring();
+        return R_ERR_CANT_INITIALIZE;
+    }
+    uring.sqEntries = params.sq_entries;
+    uring.sqHead = (uint*) ((char*) uring.sqRing + params.sq_off.head);
+    uring.sqTail = (uint*) ((char*) uring.sqRing + params.sq_off.tail);
+    uring.sqMask = (uint*) ((char*) uring.sqRing + params.sq_off.ring_mask);
+    uring.sqArray = (uint*) ((char*) uring.sqRing + params.sq_off.array);
+    uring.cqHead = (uint*) ((char*) uring.cqRing + params.cq_off.head);
+    uring.cqTail = (uint*) ((char*) uring.cqRing + params.cq_off.tail);
+    uring.cqMask = (uint*) ((char*) uring.cqRing + params.cq_off.ring_mask);
+    uring.cqes = (struct io_uring_cqe*) ((char*) uring.cqRing + params.cq_off.cqes);
+    uring.sqLocalTail = *uring.sqTail;
+    uring.pending = 0;
+    return 0;
+}
+
+static void termUring(void)
+{
+    if (uring.sqes) {
+        munmap(uring.sqes, uring.sqEntries * sizeof(struct io_uring_sqe));
+    }
+    if (uring.cqRing && uring.cqRing != uring.sqRing) {
+        munmap(uring.cqRing, uring.cqRingSize);
+    }
+    if (uring.sqRing) {
+        munmap(uring.sqRing, uring.sqRingSize);
+    }
+    if (uring.fd >= 0) {
+        close(uring.fd);
+    }
+    rFree(uring.fds);
+    memset(&uring, 0, sizeof(uring));
+    uring.fd = -1;
+    useUring = 0;
+}
+
+/*
+    Submit queued entries and optionally wait for completions up to the timeout
+ */
+static int enterUring(uint submit, uint wait, Ticks timeout)
+{
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec      ts;
+    uint                          flags;
+    int                           rc;
+
+    flags = 0;
+    memset(&arg, 0, sizeof(arg));
+    if (wait) {
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (timeout % 1000) * 1000 * 1000;
+        arg.ts = (uint64) (size_t) &ts;
+    }
+    rc = (int) syscall(__NR_io_uring_enter, uring.fd, submit, wait, flags, wait ? &arg : NULL,
+                       wait ? sizeof(arg) : 0);
+    if (rc > 0) {
+        uring.pending -= min((uint) rc, uring.pending);
+    }
+    return rc;
+}
+
+/*
+    Get the next free submission queue entry. If the queue is full, submit the queued entries first.
+ */
+static struct io_uring_sqe *getUringSqe(void)
+{
+    struct io_uring_sqe *sqe;
+    uint                head, index;
+
+    head = __atomic_load_n(uring.sqHead, __ATOMIC_ACQUIRE);
+    if (uring.sqLocalTail - head >= uring.sqEntries) {
+        if (enterUring(uring.pending, 0, 0) < 0) {
+            return 0;
+        }
+        head = __atomic_load_n(uring.sqHead, __ATOMIC_ACQUIRE);
+        if (uring.sqLocalTail - head >= uring.sqEntries) {
+            return 0;
+        }
+    }
+    index = uring.sqLocalTail & *uring.sqMask;
+    sqe = &uring.sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    uring.sqArray[index] = index;
+    uring.sqLocalTail++;
+    uring.pending++;
+    //  Publish the entry to the kernel. It is not consumed until the next io_uring_enter.
+    __atomic_store_n(uring.sqTail, uring.sqLocalTail, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+/*
+    Queue a one-shot poll request for the fd using the current mask
+ */
+static void armUringPoll(int fd, int mask)
+{
+    struct io_uring_sqe *sqe;
+    UringFd             *up;
+    uint                events;
+
+    up = &uring.fds[fd];
+    if ((sqe = getUringSqe()) == 0) {
+        rError("event", "Cannot queue io_uring poll for fd %d", fd);
+        return;
+    }
+    events = (uint) mask;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    events = (events << 16) | (events >> 16);
+#endif
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = events;
+    sqe->user_data = URING_TAG(fd, ++up->gen);
+    up->armed = 1;
+}
+
+/*
+    Update the poll mask for a fd. Cancels any outstanding poll request and arms a new request.
+ */
+static void setUringMask(int fd, int64 mask)
+{
+    struct io_uring_sqe *sqe;
+    UringFd             *up, *fds;
+    int                 events, count;
+
+    if (fd < 0) {
+        return;
+    }
+    if (fd >= uring.maxFds) {
+        if (mask == 0) {
+            return;
+        }
+        count = max(fd + 1, uring.maxFds * 2);
+        count = max(count, ME_MAX_EVENTS);
+        if ((fds = rRealloc(uring.fds, (size_t) count * sizeof(UringFd))) == 0) {
+            return;
+        }
+        memset(&fds[uring.maxFds], 0, (size_t) (count - uring.maxFds) * sizeof(UringFd));
+        uring.fds = fds;
+        uring.maxFds = count;
+    }
+    up = &uring.fds[fd];
+    events = 0;
+    if (mask & (R_READABLE | R_MODIFIED)) {
+        events |= POLLIN;
+    }
+    if (mask & R_WRITABLE) {
+        events |= POLLOUT;
+    }
+    if (up->armed) {
+        if (up->mask == events) {
+            return;
+        }
+        if ((sqe = getUringSqe()) != 0) {
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = URING_TAG(fd, up->gen);
+            sqe->user_data = URING_IGNORE;
+        }
+        up->armed = 0;
+    }
+    up->mask = events;
+    if (events) {
+        armUringPoll(fd, events);
+    }
+}
+
+/*
+    Submit queued requests, wait for completions and invoke handlers
+ */
+static int waitUring(Ticks timeout)
+{
+    struct io_uring_cqe *cqe;
+    UringFd             *up;
+    int                 fds[ME_MAX_EVENTS], masks[ME_MAX_EVENTS];
+    uint                head, tail;
+    int                 event, fd, i, numEvents, rc;
+
+    if ((rc = enterUring(uring.pending, 1, timeout)) < 0 && errno != ETIME && errno != EINTR) {
+        rTrace("event", "io_uring_enter returned %d, errno %d", rc, errno);
+    }
+    /*
+        Reap completions. Fired polls are re-armed before handlers run so that rSetWaitMask calls made by
+        handlers replace the new request.
+     */
+    numEvents = 0;
+    head = *uring.cqHead;
+    tail = __atomic_load_n(uring.cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail && numEvents < ME_MAX_EVENTS) {
+        cqe = &uring.cqes[head & *uring.cqMask];
+        head++;
+        if (cqe->user_data == URING_IGNORE) {
+            continue;
+        }
+        fd = (int) (uint32) cqe->user_data;
+        if (fd >= uring.maxFds) {
+            continue;
+        }
+        up = &uring.fds[fd];
+        if (!up->armed || up->gen != (uint) (cqe->user_data >> 32) || cqe->res == -ECANCELED) {
+            //  Stale completion for a removed or replaced poll
+            continue;
+        }
+        up->armed = 0;
+        event = 0;
+        if (cqe->res < 0) {
+            event = R_READABLE | R_WRITABLE;
+        } else {
+            if (cqe->res & (POLLIN | POLLERR | POLLHUP)) {
+                event |= R_READABLE;
+            }
+            if (cqe->res & (POLLOUT | POLLHUP)) {
+                event |= R_WRITABLE;
+            }
+        }
+        if (up->mask) {
+            armUringPoll(fd, up->mask);
+        }
+        if (event) {
+            fds[numEvents] = fd;
+            masks[numEvents] = event;
+            numEvents++;
+        }
+    }
+    __atomic_store_n(uring.cqHead, head, __ATOMIC_RELEASE);
+
+    if (numEvents == 0) {
+        invokeExpired();
+    } else {
+        for (i = 0; i < numEvents; i++) {
+            invokeHandler((size_t) fds[i], masks[i]);
+        }
+    }
+    return numEvents;
+}
+#endif /* R_EVENT_URING */
+
 #if ME_EVENT_NOTIFIER == R_EVENT_WSAPOLL
 /*
     Create a TCP loopback socket pair for wakeup notifications.
@@ -73,7 +73,9 @@ static Ticks timeout = ME_URL_TIMEOUT;
 /*********************************** Forwards *********************************/
 
 static int connectHost(Url *up);
+static ssize formatHeaders(Url *up, cchar *headers);
 static int fetch(Url *up, cchar *method, cchar *uri, cvoid *data, size_t len, cchar *headers);
+static size_t getChunkDivider(Url *up, char *chunk, size_t chunkSize, size_t len);
 static ssize getContentLength(cchar *headers, size_t length);
 static char *getHeader(char *line, char **key, char **value, int flags);
 static bool isprintable(cchar *s, size_t len);
@@ -89,7 +91,7 @@ static void resetState(Url *up);
 static void resetSocket(Url *up);
 static void setDeadline(Url *up);
 static int verifyWebSocket(Url *up);
-static int writeChunkDivider(Url *up, size_t len);
+static int writeRequest(Url *up, cchar *headers, cvoid *buf, size_t bufsize, bool body);
 static ssize addWebSocketHeaders(Url *up, RBuf *buf);
 
 #if URL_AUTH
@@ -104,10 +106,13 @@ PUBLIC Url *urlAlloc(int flags)
 {
     Url   *up;
     cchar *show;
+    int   tag;
 
+    tag = rSetMemTag(R_MEM_URL);
     up = rAllocType(Url);
     up->rx = rAllocBuf(URL_BUFSIZE);
     up->sock = rAllocSocket();
+    rSetMemTag(tag);
     up->protocol = 1;
     up->sse = 0;
     up->timeout = timeout;
@@ -285,8 +290,9 @@ PUBLIC int urlStart(Url *up, cchar *method, cchar *url)
  */
 static int connectHost(Url *up)
 {
-    char host[256];
-    int  port;
+    char   host[256];
+    uint64 span;
+    int    port, rc;
 
     if (!up) {
         return R_ERR_BAD_ARGS;
@@ -325,7 +331,10 @@ static int connectHost(Url *up)
         if (up->flags & URL_NO_LINGER) {
             rSetSocketLinger(up->sock, 0);
         }
-        if (rConnectSocket(up->sock, up->host, up->port, up->deadline) < 0) {
+        span = rSpanBegin("url", "connect");
+        rc = rConnectSocket(up->sock, up->host, up->port, up->deadline);
+        rSpanEnd(span);
+        if (rc < 0) {
             urlError(up, "%s", rGetSocketError(up->sock));
             return R_ERR_CANT_CONNECT;
         }
@@ -366,16 +375,11 @@ static int fetch(Url *up, cchar *method, cchar *uri, cvoid *data, size_t len, cc
                 }
                 up->txLen = (ssize) len;
             }
-            if (urlWriteHeaders(up, headers) < 0) {
-                urlError(up, "Cannot write headers");
+            //  Send the headers and any body in one write
+            if (writeRequest(up, headers, data, len, data && len > 0) < 0) {
+                urlError(up, "Cannot write request");
                 break;
             }
-            if (data && len > 0) {
-                if (urlWrite(up, data, len) < 0) {
-                    urlError(up, "Cannot write body");
-                    break;
-                }
-            }
             if (urlFinalize(up) < 0) {
                 return urlError(up, "Cannot finalize");
             }
@@ -514,7 +518,8 @@ PUBLIC int urlFetch(Url *up, cchar *method, cchar *uri, cvoid *data, size_t len,
     va_list args;
     Url     *tmpUp;
     char    *headers;
-    int     status;
+    uint64  span;
+    int     status, tag;
 
     tmpUp = 0;
     if (!up) {
@@ -524,7 +529,12 @@ PUBLIC int urlFetch(Url *up, cchar *method, cchar *uri, cvoid *data, size_t len,
     headers = headersFmt ? sfmtv(headersFmt, args) : 0;
     va_end(args);
 
+    //  Response headers and body are charged to the URL memory tag
+    tag = rSetMemTag(R_MEM_URL);
+    span = rSpanBegin("url", "fetch");
     status = fetch(up, method, uri, data, len, headers);
+    rSpanEnd(span);
+    rSetMemTag(tag);
 
     rFree(headers);
     if (tmpUp) {
@@ -634,22 +644,10 @@ PUBLIC ssize urlWrite(Url *up, cvoid *buf, size_t bufsize)
     } else if (bufsize == 0) {
         bufsize = slen(buf);
     }
-    if (!up->wroteHeaders && urlWriteHeaders(up, NULL) < 0) {
-        //  Already closed
-        return R_ERR_CANT_WRITE;
-    }
-    if (writeChunkDivider(up, bufsize) < 0) {
+    if (writeRequest(up, NULL, buf, bufsize, 1) < 0) {
         //  Already closed
         return R_ERR_CANT_WRITE;
     }
-    if (bufsize > 0) {
-        if (up->wroteHeaders && up->flags & URL_SHOW_REQ_BODY) {
-            rLog("raw", "url", "%.*s\n\n", (int) bufsize, (char*) buf);
-        }
-        if (rWriteSocket(up->sock, buf, bufsize, up->deadline) != (ssize) bufsize) {
-            return urlError(up, "Cannot write to socket");
-        }
-    }
     /*
         If all data written, finalize and read the response headers.
      */
@@ -711,16 +709,60 @@ PUBLIC ssize urlWriteFile(Url *up, cchar *path)
 }
 
 /*
-    Write a chunked transfer encoding header for a given length.
-    If len is zero, write the chunked trailer.
+    Write the request headers if not yet written and then the chunk divider and body data if writing body.
+    These are gathered and sent in a single write to avoid small packets that stall on delayed acknowledgements.
  */
-static int writeChunkDivider(Url *up, size_t len)
+static int writeRequest(Url *up, cchar *headers, cvoid *buf, size_t bufsize, bool body)
 {
-    char chunk[24];
+    RIOVec iov[3];
+    char   chunk[24];
+    ssize  start;
+    size_t len;
+    int    count;
 
-    if (!up) {
-        return R_ERR_BAD_ARGS;
+    count = 0;
+    start = -1;
+    if (!up->wroteHeaders) {
+        if ((start = formatHeaders(up, headers)) < 0) {
+            return (int) start;
+        }
+        iov[count].iov_base = rGetBufStart(up->txHeaders);
+        iov[count++].iov_len = rGetBufLength(up->txHeaders);
+    }
+    if (body) {
+        if ((len = getChunkDivider(up, chunk, sizeof(chunk), bufsize)) > 0) {
+            iov[count].iov_base = chunk;
+            iov[count++].iov_len = len;
+        }
+        if (bufsize > 0) {
+            if (up->flags & URL_SHOW_REQ_BODY) {
+                rLog("raw", "url", "%.*s\n\n", (int) bufsize, (char*) buf);
+            }
+            iov[count].iov_base = (void*) buf;
+            iov[count++].iov_len = bufsize;
+        }
+    }
+    if (count > 0 && rWriteSocketv(up->sock, iov, count, up->deadline) < 0) {
+        return urlError(up, start >= 0 ? "Cannot send request" : "Cannot write to socket");
     }
+    if (start >= 0) {
+        //  Preserve pure headers in the buffer for retries by SSE
+        rAdjustBufStart(up->txHeaders, start);
+        if (up->txLen >= 0 || up->boundary) {
+            rAdjustBufEnd(up->txHeaders, -2);
+        }
+        rCompactBuf(up->txHeaders);
+        up->wroteHeaders = 1;
+    }
+    return 0;
+}
+
+/*
+    Format a chunked transfer encoding header for a given length into the chunk buffer and return its length.
+    If len is zero, format the chunked trailer. Returns zero if not chunking.
+ */
+static size_t getChunkDivider(Url *up, char *chunk, size_t chunkSize, size_t len)
+{
     if (up->txLen >= 0 || up->boundary) {
         //  Content-Length is known or doing multipart mime file upload
         return 0;
@@ -730,14 +772,11 @@ static int writeChunkDivider(Url *up, size_t len)
         the \r\n after the prior item (header or body), the length and the chunk trailer in one write.
      */
     if (len == 0) {
-        scopy(chunk, sizeof(chunk), "\r\n0\r\n\r\n");
+        scopy(chunk, chunkSize, "\r\n0\r\n\r\n");
     } else {
-        sfmtbuf(chunk, sizeof(chunk), "\r\n%zx\r\n", len);
+        sfmtbuf(chunk, chunkSize, "\r\n%zx\r\n", len);
     }
-    if (rWriteSocket(up->sock, chunk, slen(chunk), up->deadline) < 0) {
-        return urlError(up, "Cannot write to socket");
-    }
-    return 0;
+    return slen(chunk);
 }
 
 /*
@@ -1471,15 +1510,24 @@ PUBLIC void urlSetDefaultTimeout(Ticks value)
  */
 PUBLIC int urlWriteHeaders(Url *up, cchar *headers)
 {
-    RBuf  *buf;
-    cchar *protocol, *hash, *hsep, *query, *qsep, *startHeaders;
-
     if (!up) {
         return R_ERR_BAD_ARGS;
     }
     if (up->wroteHeaders) {
         return 0;
     }
+    return writeRequest(up, headers, NULL, 0, 0);
+}
+
+/*
+    Format the HTTP request headers into up->txHeaders.
+    Returns the offset of the caller supplied headers in the buffer or a negative error code.
+ */
+static ssize formatHeaders(Url *up, cchar *headers)
+{
+    RBuf  *buf;
+    cchar *protocol, *hash, *hsep, *query, *qsep;
+    ssize startHeaders;
 
     protocol = up->protocol ? "HTTP/1.1" : "HTTP/1.0";
     query = up->query ? up->query : "";
@@ -1492,7 +1540,7 @@ PUBLIC int urlWriteHeaders(Url *up, cchar *headers)
     if (up->boundary) {
         rPutToBuf(buf, "Content-Type: multipart/form-data; boundary=%s\r\n", &up->boundary[2]);
     }
-    startHeaders = rGetBufEnd(buf);
+    startHeaders = rGetBufEnd(buf) - rGetBufStart(buf);
     if (headers) {
         rPutStringToBuf(buf, headers);
     }
@@ -1556,17 +1604,7 @@ PUBLIC int urlWriteHeaders(Url *up, cchar *headers)
     if (up->flags & URL_SHOW_REQ_HEADERS) {
         rLog("raw", "url", "%s\n", rBufToString(buf));
     }
-    if (rWriteSocket(up->sock, rBufToString(buf), rGetBufLength(buf), up->deadline) != (ssize) rGetBufLength(buf)) {
-        return urlError(up, "Cannot send request");
-    }
-    //  Preserve pure headers in the buffer for retries by SSE
-    rAdjustBufStart(buf, startHeaders - rGetBufStart(buf));
-    if (up->txLen >= 0 || up->boundary) {
-        rAdjustBufEnd(buf, -2);
-    }
-    rCompactBuf(buf);
-    up->wroteHeaders = 1;
-    return 0;
+    return startHeaders;
 }
 
 PUBLIC void urlSetStatus(Url *up, int status)
@@ -309,7 +309,7 @@ PUBLIC bool webUpdateUser(WebHost *host, cchar *username, cchar *password, cchar
     if (role) {
         rFree(user->role);
         user->role = sclone(role);
-        rFree(user->abilities);
+        rFreeHash(user->abilities);
         user->abilities = rAllocHash(0, 0);
         if (computeUserAbilities(host, user) < 0) {
             // User downgraded with no abilities and new role
@@ -328,7 +328,7 @@ PUBLIC void webFreeUser(WebUser *user)
         rFree(user->username);
         rFree(user->password);
         rFree(user->role);
-        rFree(user->abilities);
+        rFreeHash(user->abilities);
         rFree(user);
     }
 }
@@ -1254,20 +1254,94 @@ static char *computeDigest(Web *web, cchar *password)
 
 typedef struct stat FileInfo;
 
+/*
+    File served by the file handler. Cached entries are indexed by the preferred encoding and the request
+    file path as "encoding:path". The entry holds the selected file variant, its validators and formatted
+    response header values, and the file contents if the file is small enough to cache.
+ */
+typedef struct WebFileEntry {
+    char *key;                          /* Cache key */
+    char *path;                         /* Selected file path including any .br or .gz extension */
+    cchar *encoding;                    /* Content encoding of the selected file: "br", "gzip" or NULL */
+    char *data;                         /* File contents or NULL if not cached */
+    int64 size;                         /* File size */
+    time_t mtime;                       /* File modification time */
+    uint64 inode;                       /* File inode */
+    Ticks expires;                      /* When to check the file for changes */
+    Ticks lastUsed;                     /* When last used. For LRU eviction */
+    int inuse;                          /* Count of requests using the entry */
+    bool removed : 1;                   /* Removed from the cache. Free when no longer in use */
+    char etag[24];                      /* Unquoted ETag for comparisons */
+    char etagHeader[26];                /* Quoted ETag response header value */
+    char modified[32];                  /* Last-Modified response header value */
+} WebFileEntry;
+
+typedef struct WebFileCache {
+    RHash *entries;                     /* Cached entries indexed by key */
+    int maxFiles;                       /* Maximum number of cached entries */
+    size_t maxSize;                     /* Maximum size of a file whose contents are cached */
+    size_t maxMemory;                   /* Maximum total size of cached contents */
+    size_t memory;                      /* Total size of cached contents */
+    Ticks lifespan;                     /* Time before checking a cached file for changes */
+} WebFileCache;
+
+#if ME_WEB_ARCHIVE
+/*
+    Zip archive record signatures and fixed sizes
+ */
+#define ZIP_LOCAL_SIG      0x04034b50
+#define ZIP_CENTRAL_SIG    0x02014b50
+#define ZIP_END_SIG        0x06054b50
+#define ZIP_LOCAL_SIZE     30
+#define ZIP_CENTRAL_SIZE   46
+#define ZIP_END_SIZE       22
+#define ZIP_MAX_COMMENT    0xFFFF
+
+/*
+    Packed document archive. Entries are WebFileEntry objects indexed by request path whose data references the
+    archive contents. The validators are derived from the archive index when mounted.
+ */
+typedef struct WebArchive {
+    char *path;                         /* Archive file path */
+    char *data;                         /* Archive contents */
+    size_t size;                        /* Archive size */
+    RHash *entries;                     /* Archive entries indexed by request path */
+    bool mapped : 1;                    /* Contents are memory mapped */
+} WebArchive;
+#endif
+
 /************************************ Forwards *********************************/
 
+static WebFileEntry *addCachedFile(WebFileCache *cache, cchar *key, cchar *path, int fd, FileInfo *info,
+                                   cchar *encoding);
 static int deleteFile(Web *web, char *path, size_t pathSize);
+static bool evictCachedFile(WebFileCache *cache);
 static int fixRanges(Web *web, int64 fileSize);
+static void freeCachedFile(WebFileEntry *entry);
 static int getFile(Web *web, char *path, size_t pathSize);
 static cchar *getEncoding(Web *web);
-static int sendFile(Web *web, int fd, FileInfo *info, cchar *encoding);
-static int pickRanges(Web *web, FileInfo *info, cchar *etag);
+static WebFileEntry *lookupCachedFile(WebFileCache *cache, cchar *key);
+static int sendFile(Web *web, int fd, WebFileEntry *entry);
+static int pickRanges(Web *web, WebFileEntry *entry);
 static int putFile(Web *web, char *path, size_t pathSize);
 static void redirectToDir(Web *web);
+static void releaseCachedFile(WebFileEntry *entry);
+static void removeCachedFile(WebFileCache *cache, WebFileEntry *entry);
 static bool pickFile(Web *web, char path[ME_MAX_FNAME], FileInfo *info, cchar **pEncoding);
-static int sendFileContent(Web *web, int fd, FileInfo *info);
+static int sendFileContent(Web *web, int fd, WebFileEntry *entry);
+static ssize sendFileData(Web *web, int fd, WebFileEntry *entry, Offset offset, ssize len);
+static void setFileEntry(WebFileEntry *entry, FileInfo *info, cchar *encoding);
 static void writeRangeHeader(Web *web, WebRange *range, int64 fileSize);
 
+#if ME_WEB_ARCHIVE
+static int indexArchive(WebArchive *archive, cchar *root);
+static int loadArchive(WebArchive *archive);
+static WebFileEntry *pickArchiveFile(Web *web, cchar **encoding);
+static time_t zipTime(uint date, uint time);
+static uint zipUint16(cuchar *p);
+static uint zipUint32(cuchar *p);
+#endif
+
 /************************************* Code ***********************************/
 
 PUBLIC int webFileHandler(Web *web)
@@ -1285,8 +1359,10 @@ PUBLIC int webFileHandler(Web *web)
         rc = getFile(web, path, sizeof(path));
     } else if (web->put) {
         rc = putFile(web, path, sizeof(path));    // PUT always uses original path
+        webFlushFileCache(web->host);
     } else if (web->del) {
         rc = deleteFile(web, path, sizeof(path)); // DELETE uses original path
+        webFlushFileCache(web->host);
     } else {
         rc = webError(web, 405, "Unsupported method");
     }
@@ -1295,10 +1371,52 @@ PUBLIC int webFileHandler(Web *web)
 
 static int getFile(Web *web, char *path, size_t pathSize)
 {
-    FileInfo info;
-    cchar    *encoding;
-    int      fd, rc;
-
+    WebFileCache *cache;
+    WebFileEntry *entry, local;
+    FileInfo     info;
+    cchar        *encoding;
+    char         key[ME_MAX_FNAME + 8];
+    int          fd, rc;
+
+#if ME_WEB_ARCHIVE
+    if (web->host->archive) {
+        if ((entry = pickArchiveFile(web, &encoding)) != 0) {
+            if (encoding) {
+                //  Archive entries are shared. Serve a pre-compressed variant via a copy with the encoding.
+                local = *entry;
+                local.encoding = encoding;
+                entry = &local;
+            }
+            web->exists = 1;
+            return sendFile(web, -1, entry);
+        }
+        if (web->finalized) {
+            //  Redirected to the archive directory
+            return 0;
+        }
+    }
+#endif
+    if ((cache = web->host->fileCache) != 0) {
+        encoding = web->route->compressed ? getEncoding(web) : NULL;
+        sfmtbuf(key, sizeof(key), "%s:%s", encoding ? encoding : "", path);
+        if ((entry = lookupCachedFile(cache, key)) != 0) {
+            //  Files too large to cache are still sent from the file
+            fd = -1;
+            if (entry->data || (fd = open(entry->path, O_RDONLY | O_BINARY, 0)) >= 0) {
+                if (sends(path, "/")) {
+                    web->ext = strrchr(web->host->index, '.');
+                }
+                web->exists = 1;
+                rc = sendFile(web, fd, entry);
+                if (fd >= 0) {
+                    close(fd);
+                }
+                releaseCachedFile(entry);
+                return rc;
+            }
+            releaseCachedFile(entry);
+        }
+    }
     if (!pickFile(web, path, &info, &encoding)) {
         webHook(web, WEB_HOOK_NOT_FOUND);
         if (!web->finalized) {
@@ -1313,19 +1431,29 @@ static int getFile(Web *web, char *path, size_t pathSize)
         webError(web, 404, "Cannot open document");
         return R_ERR_CANT_OPEN;
     }
-    rc = sendFile(web, fd, &info, encoding);
+    entry = 0;
+    if (cache && S_ISREG(info.st_mode)) {
+        entry = addCachedFile(cache, key, path, fd, &info, encoding);
+    }
+    if (!entry) {
+        memset(&local, 0, sizeof(local));
+        setFileEntry(&local, &info, encoding);
+        entry = &local;
+    }
+    rc = sendFile(web, fd, entry);
     close(fd);
+    if (entry != &local) {
+        releaseCachedFile(entry);
+    }
     return rc;
 }
 
-static int sendFile(Web *web, int fd, FileInfo *info, cchar *encoding)
+/*
+    Send the file response. The entry may be cached so the header values are used without copying.
+ */
+static int sendFile(Web *web, int fd, WebFileEntry *entry)
 {
-    char etag[24];
-    int  rc;
-
-    //  Generate unquoted ETag for faster comparison
-    sitosbuf(etag, sizeof(etag), (int64) ((uint64) info->st_ino ^ (uint64) info->st_size ^ (uint64) info->st_mtime),
-             10);
+    int rc;
 
     /*
         Check conditional request headers (If-None-Match, If-Modified-Since)
@@ -1333,31 +1461,31 @@ static int sendFile(Web *web, int fd, FileInfo *info, cchar *encoding)
         Per RFC 7232, this check happens before processing ranges
      */
     rc = 0;
-    if (webContentNotModified(web, etag, info->st_mtime)) {
+    if (webContentNotModified(web, entry->etag, entry->mtime)) {
         web->txLen = 0;
         web->status = 304;
         webAddHeaderStaticString(web, "Accept-Ranges", "bytes");
-        webAddHeaderDynamicString(web, "Last-Modified", webHttpDate(info->st_mtime));
-        webAddHeader(web, "ETag", "\"%s\"", etag);
+        webAddHeaderStaticString(web, "Last-Modified", entry->modified);
+        webAddHeaderStaticString(web, "ETag", entry->etagHeader);
 
-    } else if (pickRanges(web, info, etag) < 0) {
+    } else if (pickRanges(web, entry) < 0) {
         webError(web, 416, "Requested range not satisfiable");
 
     } else {
         //  Always send Last-Modified and ETag headers
-        if (info->st_mtime > 0) {
-            webAddHeaderDynamicString(web, "Last-Modified", webHttpDate(info->st_mtime));
+        if (entry->mtime > 0) {
+            webAddHeaderStaticString(web, "Last-Modified", entry->modified);
         }
-        webAddHeader(web, "ETag", "\"%s\"", etag);
+        webAddHeaderStaticString(web, "ETag", entry->etagHeader);
         webAddHeaderStaticString(web, "Accept-Ranges", "bytes");
 
         //  Add compression headers if serving compressed file
-        if (encoding) {
-            webAddHeaderStaticString(web, "Content-Encoding", encoding);
+        if (entry->encoding) {
+            webAddHeaderStaticString(web, "Content-Encoding", entry->encoding);
             webAddHeaderStaticString(web, "Vary", "Origin, Accept-Encoding");
         }
         if (!web->head) {
-            rc = sendFileContent(web, fd, info);
+            rc = sendFileContent(web, fd, entry);
         }
     }
     webFinalize(web);
@@ -1494,12 +1622,12 @@ PUBLIC ssize webSendFile(Web *web, int fd, Offset offset, ssize len)
     if (len <= 0) {
         return 0;
     }
-    if (!web->wroteHeaders && webWriteHeaders(web) < 0) {
-        return R_ERR_CANT_WRITE;
-    }
 #if ME_HTTP_SENDFILE
     //  Use zero-copy sendfile for non-TLS HTTP connections
     if (!rIsSocketSecure(web->sock)) {
+        if (!web->wroteHeaders && webWriteHeaders(web) < 0) {
+            return R_ERR_CANT_WRITE;
+        }
         written = rSendFile(web->sock, fd, offset, (size_t) len);
         if (written < 0 || written < len) {
             return webNetError(web, "Cannot send file");
@@ -1578,7 +1706,7 @@ static int fixRanges(Web *web, int64 fileSize)
     Process and validate range requests
     Returns 0 on success, error code on failure
  */
-static int pickRanges(Web *web, FileInfo *info, cchar *etag)
+static int pickRanges(Web *web, WebFileEntry *entry)
 {
     WebRange *range;
     bool     rangeValid;
@@ -1586,7 +1714,7 @@ static int pickRanges(Web *web, FileInfo *info, cchar *etag)
     if (!web->ranges) {
         //  Default case: no ranges requested - serve full file
         web->status = 200;
-        web->txLen = info->st_size;
+        web->txLen = entry->size;
         return 0;
     }
     /*
@@ -1598,22 +1726,22 @@ static int pickRanges(Web *web, FileInfo *info, cchar *etag)
         rangeValid = false;
         if (web->ifMatch) {
             //  If-Range with ETag - check if it matches current ETag
-            rangeValid = smatch(web->ifMatch, etag);
+            rangeValid = smatch(web->ifMatch, entry->etag);
         } else if (web->since > 0) {
             //  If-Range with date - check if resource hasn't been modified since
-            rangeValid = (info->st_mtime <= web->since);
+            rangeValid = (entry->mtime <= web->since);
         }
         //  If condition doesn't match, ignore ranges and serve full content
         if (!rangeValid) {
             web->ranges = NULL;
             web->status = 200;
-            web->txLen = info->st_size;
+            web->txLen = entry->size;
             return 0;
         }
     }
     //  Validate and fix ranges based on file size
-    if (fixRanges(web, info->st_size) < 0) {
-        webAddHeader(web, "Content-Range", "bytes */%lld", (int64) info->st_size);
+    if (fixRanges(web, entry->size) < 0) {
+        webAddHeader(web, "Content-Range", "bytes */%lld", (int64) entry->size);
         return R_ERR_BAD_REQUEST;
     }
     web->status = 206;
@@ -1629,7 +1757,7 @@ static int pickRanges(Web *web, FileInfo *info, cchar *etag)
         //  Single range - set Content-Range header
         range = web->ranges;
         webAddHeader(web, "Content-Range", "bytes %lld-%lld/%lld", web->ranges->start, range->end - 1,
-                     (int64) info->st_size);
+                     (int64) entry->size);
         web->txLen = range->len;
     }
     return 0;
@@ -1649,7 +1777,7 @@ static void writeRangeHeader(Web *web, WebRange *range, int64 fileSize)
     Send file content (ranges or full file)
     Returns 0 on success, error code on failure
  */
-static int sendFileContent(Web *web, int fd, FileInfo *info)
+static int sendFileContent(Web *web, int fd, WebFileEntry *entry)
 {
     WebRange *range;
 
@@ -1658,9 +1786,9 @@ static int sendFileContent(Web *web, int fd, FileInfo *info)
         for (range = web->ranges; range; range = range->next) {
             if (web->ranges->next != NULL) {
                 //  Multipart - write range header
-                writeRangeHeader(web, range, info->st_size);
+                writeRangeHeader(web, range, entry->size);
             }
-            if (webSendFile(web, fd, range->start, range->len) < 0) {
+            if (sendFileData(web, fd, entry, range->start, range->len) < 0) {
                 return R_ERR_CANT_WRITE;
             }
         }
@@ -1672,13 +1800,24 @@ static int sendFileContent(Web *web, int fd, FileInfo *info)
         }
     } else {
         //  Send entire file
-        if (web->txLen > 0 && webSendFile(web, fd, 0, web->txLen) < 0) {
+        if (web->txLen > 0 && sendFileData(web, fd, entry, 0, web->txLen) < 0) {
             return R_ERR_CANT_WRITE;
         }
     }
     return 0;
 }
 
+/*
+    Send file data from the cached contents if available, otherwise from the file
+ */
+static ssize sendFileData(Web *web, int fd, WebFileEntry *entry, Offset offset, ssize len)
+{
+    if (entry->data) {
+        return webWrite(web, &entry->data[offset], (size_t) len);
+    }
+    return webSendFile(web, fd, offset, len);
+}
+
 /********************************** Compression *********************************/
 /*
     Parse Accept-Encoding header and determine preferred compression
@@ -1690,7 +1829,7 @@ static cchar *getEncoding(Web *web)
     cchar *acceptEncoding;
     bool  supportsBr, supportsGzip;
 
-    if ((acceptEncoding = webGetHeader(web, "Accept-Encoding")) == 0) {
+    if ((acceptEncoding = webGetHeaderId(web, WEB_HDR_ACCEPT_ENCODING)) == 0) {
         return NULL;
     }
     /*
@@ -1760,6 +1899,479 @@ static bool pickFile(Web *web, char path[ME_MAX_FNAME], FileInfo *info, cchar **
     return web->exists;
 }
 
+/********************************** File Cache **********************************/
+/*
+    Create the static file cache if enabled by web.fileCache.enable
+ */
+PUBLIC void webInitFileCache(WebHost *host)
+{
+    WebFileCache *cache;
+    int64        lifespan;
+
+    if (!jsonGetBool(host->config, 0, "web.fileCache.enable", 0)) {
+        return;
+    }
+    cache = rAllocType(WebFileCache);
+    cache->entries = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    cache->maxFiles = max(svaluei(jsonGet(host->config, 0, "web.fileCache.files", "256")), 1);
+    cache->maxSize = (size_t) svalue(jsonGet(host->config, 0, "web.fileCache.size", "64K"));
+    cache->maxMemory = (size_t) svalue(jsonGet(host->config, 0, "web.fileCache.memory", "2MB"));
+    lifespan = svalue(jsonGet(host->config, 0, "web.fileCache.lifespan", "1sec"));
+    cache->lifespan = min(lifespan, MAXINT / TPS) * TPS;
+    host->fileCache = cache;
+}
+
+PUBLIC void webFreeFileCache(WebHost *host)
+{
+    RName *np;
+
+    if (!host->fileCache) {
+        return;
+    }
+    for (ITERATE_NAMES(host->fileCache->entries, np)) {
+        freeCachedFile(np->value);
+    }
+    rFreeHash(host->fileCache->entries);
+    rFree(host->fileCache);
+    host->fileCache = 0;
+}
+
+PUBLIC void webFlushFileCache(WebHost *host)
+{
+    RName *np;
+
+    if (!host || !host->fileCache) {
+        return;
+    }
+    for (ITERATE_NAMES(host->fileCache->entries, np)) {
+        removeCachedFile(host->fileCache, np->value);
+    }
+}
+
+/*
+    Lookup a cached file. If the entry has expired, check the file has not been modified or removed.
+    Returned entries must be released via releaseCachedFile.
+ */
+static WebFileEntry *lookupCachedFile(WebFileCache *cache, cchar *key)
+{
+    WebFileEntry *entry;
+    FileInfo     info;
+    Ticks        now;
+
+    if ((entry = rLookupName(cache->entries, key)) == 0) {
+        return 0;
+    }
+    now = rGetTicks();
+    if (now >= entry->expires) {
+        if (stat(entry->path, &info) < 0 || (uint64) info.st_ino != entry->inode || info.st_size != entry->size ||
+            info.st_mtime != entry->mtime) {
+            removeCachedFile(cache, entry);
+            return 0;
+        }
+        entry->expires = now + cache->lifespan;
+    }
+    entry->lastUsed = now;
+    entry->inuse++;
+    return entry;
+}
+
+/*
+    Add a file to the cache. The file contents are read and cached if smaller than the cache size limit.
+    Least recently used entries are evicted to make room. Returns the entry or NULL if it cannot be cached.
+ */
+static WebFileEntry *addCachedFile(WebFileCache *cache, cchar *key, cchar *path, int fd, FileInfo *info,
+                                   cchar *encoding)
+{
+    WebFileEntry *entry;
+    size_t       size;
+    int          tag;
+
+    if ((entry = rLookupName(cache->entries, key)) != 0) {
+        //  Replace a stale entry
+        removeCachedFile(cache, entry);
+    }
+    size = (size_t) info->st_size;
+    while (rGetHashLength(cache->entries) >= cache->maxFiles ||
+           (size <= cache->maxSize && cache->memory + size > cache->maxMemory)) {
+        if (!evictCachedFile(cache)) {
+            break;
+        }
+    }
+    if (rGetHashLength(cache->entries) >= cache->maxFiles) {
+        return 0;
+    }
+    tag = rSetMemTag(R_MEM_WEB);
+    entry = rAllocType(WebFileEntry);
+    entry->key = sclone(key);
+    entry->path = sclone(path);
+    setFileEntry(entry, info, encoding);
+
+    if (size <= cache->maxSize && cache->memory + size <= cache->maxMemory) {
+        entry->data = rAlloc(size + 1);
+        if (read(fd, entry->data, size) == (ssize) size) {
+            cache->memory += size;
+        } else {
+            //  Serve from the file instead
+            rFree(entry->data);
+            entry->data = 0;
+            lseek(fd, 0, SEEK_SET);
+        }
+    }
+    entry->lastUsed = rGetTicks();
+    entry->expires = entry->lastUsed + cache->lifespan;
+    entry->inuse = 1;
+    rAddName(cache->entries, entry->key, entry, 0);
+    rSetMemTag(tag);
+    return entry;
+}
+
+/*
+    Evict the least recently used entry that is not in use. Returns false if there is no such entry.
+ */
+static bool evictCachedFile(WebFileCache *cache)
+{
+    WebFileEntry *entry, *oldest;
+    RName        *np;
+
+    oldest = 0;
+    for (ITERATE_NAMES(cache->entries, np)) {
+        entry = np->value;
+        if (!entry->inuse && (!oldest || entry->lastUsed < oldest->lastUsed)) {
+            oldest = entry;
+        }
+    }
+    if (!oldest) {
+        return 0;
+    }
+    removeCachedFile(cache, oldest);
+    return 1;
+}
+
+/*
+    Remove an entry from the cache. Entries in use are freed when released.
+ */
+static void removeCachedFile(WebFileCache *cache, WebFileEntry *entry)
+{
+    rRemoveName(cache->entries, entry->key);
+    if (entry->data) {
+        cache->memory -= (size_t) entry->size;
+    }
+    if (entry->inuse) {
+        entry->removed = 1;
+    } else {
+        freeCachedFile(entry);
+    }
+}
+
+static void releaseCachedFile(WebFileEntry *entry)
+{
+    if (--entry->inuse == 0 && entry->removed) {
+        freeCachedFile(entry);
+    }
+}
+
+static void freeCachedFile(WebFileEntry *entry)
+{
+    rFree(entry->key);
+    rFree(entry->path);
+    rFree(entry->data);
+    rFree(entry);
+}
+
+/*
+    Set the entry metadata and format the validator header values
+ */
+static void setFileEntry(WebFileEntry *entry, FileInfo *info, cchar *encoding)
+{
+    entry->encoding = encoding;
+    entry->size = (int64) info->st_size;
+    entry->mtime = info->st_mtime;
+    entry->inode = (uint64) info->st_ino;
+
+    //  Generate unquoted ETag for faster comparison
+    sitosbuf(entry->etag, sizeof(entry->etag),
+             (int64) ((uint64) info->st_ino ^ (uint64) info->st_size ^ (uint64) info->st_mtime), 10);
+    sfmtbuf(entry->etagHeader, sizeof(entry->etagHeader), "\"%s\"", entry->etag);
+    webFormatHttpDate(entry->modified, sizeof(entry->modified), info->st_mtime);
+}
+
+#if ME_WEB_ARCHIVE
+/************************************ Archive *********************************/
+
+PUBLIC int webMountArchive(WebHost *host, cchar *path, cchar *root)
+{
+    WebArchive *archive;
+    int        rc, tag;
+
+    if (!host || !path) {
+        return R_ERR_BAD_ARGS;
+    }
+    webFreeArchive(host);
+
+    tag = rSetMemTag(R_MEM_WEB);
+    archive = rAllocType(WebArchive);
+    archive->path = sclone(path);
+    archive->entries = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    host->archive = archive;
+    rc = loadArchive(archive);
+    rSetMemTag(tag);
+
+    if (rc < 0) {
+        rError("web", "Cannot open archive %s", path);
+        webFreeArchive(host);
+        return R_ERR_CANT_OPEN;
+    }
+    if ((rc = indexArchive(archive, root)) < 0) {
+        rError("web", "Cannot mount archive %s, bad zip format", path);
+        webFreeArchive(host);
+        return rc;
+    }
+    rInfo("web", "Mounted archive %s with %d documents", path, rGetHashLength(archive->entries));
+    return 0;
+}
+
+PUBLIC void webFreeArchive(WebHost *host)
+{
+    WebArchive   *archive;
+    WebFileEntry *entry;
+    RName        *np;
+
+    if ((archive = host->archive) == 0) {
+        return;
+    }
+    for (ITERATE_NAMES(archive->entries, np)) {
+        entry = np->value;
+        rFree(entry->key);
+        rFree(entry);
+    }
+    rFreeHash(archive->entries);
+#if ME_UNIX_LIKE
+    if (archive->mapped) {
+        munmap(archive->data, archive->size);
+        archive->data = 0;
+    }
+#endif
+    rFree(archive->data);
+    rFree(archive->path);
+    rFree(archive);
+    host->archive = 0;
+}
+
+/*
+    Map the archive into memory. Read the archive if memory mapping is not supported.
+ */
+static int loadArchive(WebArchive *archive)
+{
+#if ME_UNIX_LIKE
+    FileInfo info;
+    void     *data;
+    int      fd;
+
+    if ((fd = open(archive->path, O_RDONLY | O_BINARY, 0)) < 0) {
+        return R_ERR_CANT_OPEN;
+    }
+    data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) {
+        return R_ERR_CANT_READ;
+    }
+    archive->data = data;
+    archive->size = (size_t) info.st_size;
+    archive->mapped = 1;
+#else
+    if ((archive->data = rReadFile(archive->path, &archive->size)) == 0) {
+        return R_ERR_CANT_READ;
+    }
+#endif
+    return 0;
+}
+
+/*
+    Index the zip central directory. Only stored (uncompressed) entries under the root directory are indexed.
+    Each entry is added under its request path with validators from the archive index.
+ */
+static int indexArchive(WebArchive *archive, cchar *root)
+{
+    WebFileEntry *entry;
+    cuchar       *data, *end, *cp, *local;
+    size_t       count, offset, cdOffset, cdSize, nameLen, extraLen, commentLen, rootLen, dataOffset, size, i;
+    uint         crc;
+    char         name[ME_MAX_FNAME];
+
+    data = (cuchar*) archive->data;
+    if (archive->size < ZIP_END_SIZE) {
+        return R_ERR_BAD_FORMAT;
+    }
+    /*
+        Find the end of central directory record. It is followed by an optional comment of up to 64K.
+     */
+    for (cp = &data[archive->size - ZIP_END_SIZE]; cp >= data; cp--) {
+        if (zipUint32(cp) == ZIP_END_SIG) {
+            break;
+        }
+        if ((size_t) (&data[archive->size - ZIP_END_SIZE] - cp) >= ZIP_MAX_COMMENT) {
+            return R_ERR_BAD_FORMAT;
+        }
+    }
+    if (cp < data) {
+        return R_ERR_BAD_FORMAT;
+    }
+    count = zipUint16(&cp[10]);
+    cdSize = zipUint32(&cp[12]);
+    cdOffset = zipUint32(&cp[16]);
+    end = cp;
+    if (cdOffset > (size_t) (end - data) || cdSize > (size_t) (end - data) - cdOffset) {
+        //  Includes Zip64 archives which are not supported
+        return R_ERR_BAD_FORMAT;
+    }
+    if (root) {
+        while (*root == '/') {
+            root++;
+        }
+    }
+    rootLen = slen(root);
+    if (rootLen > 0 && root[rootLen - 1] == '/') {
+        rootLen--;
+    }
+    cp = &data[cdOffset];
+    end = &data[cdOffset + cdSize];
+
+    for (i = 0; i < count; i++, cp += ZIP_CENTRAL_SIZE + nameLen + extraLen + commentLen) {
+        if ((size_t) (end - cp) < ZIP_CENTRAL_SIZE || zipUint32(cp) != ZIP_CENTRAL_SIG) {
+            return R_ERR_BAD_FORMAT;
+        }
+        nameLen = zipUint16(&cp[28]);
+        extraLen = zipUint16(&cp[30]);
+        commentLen = zipUint16(&cp[32]);
+        if ((size_t) (end - cp) < ZIP_CENTRAL_SIZE + nameLen + extraLen + commentLen) {
+            return R_ERR_BAD_FORMAT;
+        }
+        //  Select entries under the root directory. Skip directories, encrypted and compressed entries.
+        if (nameLen == 0 || nameLen >= sizeof(name) - 1 || cp[ZIP_CENTRAL_SIZE + nameLen - 1] == '/' ||
+            (zipUint16(&cp[8]) & 0x1) || zipUint16(&cp[10]) != 0) {
+            continue;
+        }
+        //  Names are not null terminated. The request path is the name less the root directory.
+        if (rootLen > 0) {
+            if (nameLen <= rootLen + 1 || memcmp(&cp[ZIP_CENTRAL_SIZE], root, rootLen) != 0 ||
+                cp[ZIP_CENTRAL_SIZE + rootLen] != '/') {
+                continue;
+            }
+            memcpy(name, &cp[ZIP_CENTRAL_SIZE + rootLen], nameLen - rootLen);
+            name[nameLen - rootLen] = '\0';
+        } else {
+            name[0] = '/';
+            memcpy(&name[1], &cp[ZIP_CENTRAL_SIZE], nameLen);
+            name[nameLen + 1] = '\0';
+        }
+        /*
+            The data follows the local header whose name and extra field lengths may differ from the central directory
+         */
+        crc = zipUint32(&cp[16]);
+        size = zipUint32(&cp[20]);
+        offset = zipUint32(&cp[42]);
+        local = &data[offset];
+        if (offset > cdOffset || cdOffset - offset < ZIP_LOCAL_SIZE || zipUint32(local) != ZIP_LOCAL_SIG) {
+            return R_ERR_BAD_FORMAT;
+        }
+        dataOffset = offset + ZIP_LOCAL_SIZE + zipUint16(&local[26]) + zipUint16(&local[28]);
+        if (dataOffset > cdOffset || size > cdOffset - dataOffset || size != zipUint32(&cp[24])) {
+            return R_ERR_BAD_FORMAT;
+        }
+        if (rLookupName(archive->entries, name)) {
+            continue;
+        }
+        entry = rAllocType(WebFileEntry);
+        entry->key = sclone(name);
+        entry->data = &archive->data[dataOffset];
+        entry->size = (int64) size;
+        entry->mtime = zipTime(zipUint16(&cp[14]), zipUint16(&cp[12]));
+
+        //  The CRC and size identify the content so the ETag is stable when the archive is rebuilt
+        sfmtbuf(entry->etag, sizeof(entry->etag), "%x-%x", crc, (uint) size);
+        sfmtbuf(entry->etagHeader, sizeof(entry->etagHeader), "\"%s\"", entry->etag);
+        webFormatHttpDate(entry->modified, sizeof(entry->modified), entry->mtime);
+        rAddName(archive->entries, entry->key, entry, 0);
+    }
+    return 0;
+}
+
+/*
+    Select the archive entry for the request path. Mirrors pickFile: directory requests use the index document
+    and pre-compressed variants are preferred if the route is compressed and the client supports the encoding.
+    Returns NULL if the document is not in the archive or if redirected to the directory.
+ */
+static WebFileEntry *pickArchiveFile(Web *web, cchar **encoding)
+{
+    WebArchive   *archive;
+    WebFileEntry *entry;
+    size_t       len;
+    char         name[ME_MAX_FNAME];
+
+    archive = web->host->archive;
+    entry = 0;
+    *encoding = NULL;
+
+    scopy(name, sizeof(name), web->path);
+    if (sends(name, "/")) {
+        sncat(name, sizeof(name), web->host->index);
+    }
+    len = slen(name);
+
+    if (web->route->compressed && (*encoding = getEncoding(web)) != 0) {
+        sncat(name, sizeof(name), smatch(*encoding, "br") ? ".br" : ".gz");
+        entry = rLookupName(archive->entries, name);
+        name[len] = '\0';
+    }
+    if (!entry) {
+        *encoding = NULL;
+        if ((entry = rLookupName(archive->entries, name)) == 0) {
+            //  External redirect if the path is an archive directory with an index
+            sfmtbuf(name, sizeof(name), "%s/%s", web->path, web->host->index);
+            if (!sends(web->path, "/") && rLookupName(archive->entries, name)) {
+                redirectToDir(web);
+            }
+            return 0;
+        }
+    }
+    if (sends(web->path, "/")) {
+        web->ext = strrchr(web->host->index, '.');
+    }
+    return entry;
+}
+
+/*
+    Convert a zip MS-DOS local date and time
+ */
+static time_t zipTime(uint date, uint time)
+{
+    struct tm tm;
+
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = (int) (date >> 9) + 80;
+    tm.tm_mon = (int) ((date >> 5) & 0xF) - 1;
+    tm.tm_mday = (int) (date & 0x1F);
+    tm.tm_hour = (int) (time >> 11);
+    tm.tm_min = (int) ((time >> 5) & 0x3F);
+    tm.tm_sec = (int) (time & 0x1F) * 2;
+    tm.tm_isdst = -1;
+    return mktime(&tm);
+}
+
+static uint zipUint16(cuchar *p)
+{
+    return (uint) p[0] | ((uint) p[1] << 8);
+}
+
+static uint zipUint32(cuchar *p)
+{
+    return (uint) p[0] | ((uint) p[1] << 8) | ((uint) p[2] << 16) | ((uint) p[3] << 24);
+}
+#endif /* ME_WEB_ARCHIVE */
+
 /*
     Copyright (c) Embedthis Software. All Rights Reserved.
     This is proprietary software and requires a commercial license from the author.
@@ -1778,11 +2390,35 @@ static bool pickFile(Web *web, char path[ME_MAX_FNAME], FileInfo *info, cchar **
 
 
 
+/************************************ Locals ***********************************/
+
+/*
+    Radix tree node for route matching. Each node holds a fragment of the route match patterns and the
+    children that continue it. The exact and prefix fields are indexes into host->routes of the first
+    route whose pattern ends at this node, or -1.
+ */
+typedef struct WebRouteNode {
+    char *fragment;                     /* Pattern fragment matched by this node */
+    size_t len;                         /* Length of the fragment */
+    int exact;                          /* First exact route ending here */
+    int prefix;                         /* First prefix route ending here */
+    int numChildren;                    /* Count of children */
+    struct WebRouteNode **children;     /* Child nodes. Each starts with a different character */
+} WebRouteNode;
+
+/*
+    Standard methods in WEB_METHOD_* bit order
+ */
+static cchar *methodNames[] = { "DELETE", "GET", "HEAD", "OPTIONS", "POST", "PUT", "TRACE", 0 };
+
 /************************************ Forwards *********************************/
 
+static void addRoute(WebHost *host, WebRoute *route);
 static WebListen *allocListen(WebHost *host, cchar *endpoint);
+static WebRouteNode *allocRouteNode(cchar *fragment, size_t len);
 static RHash *createMethodsHash(cchar *list);
 static void freeListen(WebListen *listen);
+static void freeRouteNode(WebRouteNode *node);
 static int getTimeout(WebHost *host, cchar *field, cchar *defaultValue);
 static void initMethods(WebHost *host);
 static void initRedirects(WebHost *host);
@@ -1790,6 +2426,11 @@ static void initRoutes(WebHost *host);
 static void loadMimeTypes(WebHost *host);
 static void loadAuth(WebHost *host);
 static void parseCacheControl(WebRoute *route, Json *json, int id);
+static void splitRouteNode(WebRouteNode *node, size_t offset);
+#if ME_UNIX_LIKE
+static int startWorkers(WebHost *host);
+static void stopWorkers(WebHost *host);
+#endif
 static cchar *uploadDir(void);
 
 /************************************* Code ***********************************/
@@ -1829,7 +2470,7 @@ PUBLIC WebHost *webAllocHost(Json *config, int flags)
     host->flags = flags;
     host->actions = rAllocList(0, 0);
     host->listeners = rAllocList(0, 0);
-    host->sessions = rAllocHash(0, 0);
+    host->sessions = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE | R_HASH_INCREMENTAL);
     host->webs = rAllocList(0, 0);
     host->connSequence = 0;
 
@@ -1899,6 +2540,13 @@ PUBLIC WebHost *webAllocHost(Json *config, int flags)
     initMethods(host);
     initRoutes(host);
     initRedirects(host);
+    webInitFileCache(host);
+#if ME_WEB_ARCHIVE
+    if ((path = jsonGet(host->config, 0, "web.archive.path", 0)) != 0) {
+        //  Continue to serve from the documents directory if the archive cannot be mounted
+        webMountArchive(host, path, jsonGet(host->config, 0, "web.archive.root", 0));
+    }
+#endif
     loadMimeTypes(host);
     loadAuth(host);
     webInitSessions(host);
@@ -1940,6 +2588,11 @@ PUBLIC void webFreeHost(WebHost *host)
         rFree(route);
     }
     rFreeList(host->routes);
+    freeRouteNode(host->routeTree);
+    webFreeFileCache(host);
+#if ME_WEB_ARCHIVE
+    webFreeArchive(host);
+#endif
 
     for (ITERATE_ITEMS(host->actions, action, next)) {
         rFree(action->match);
@@ -1985,6 +2638,7 @@ PUBLIC void webFreeHost(WebHost *host)
         jsonFree(host->signatures);
         host->signatures = 0;
     }
+    rFree(host->workerPids);
     rFree(host->docs);
     rFree(host->ip);
     rFree(host);
@@ -2000,6 +2654,11 @@ PUBLIC int webStartHost(WebHost *host)
     if (!host || !host->listeners) return 0;
     json = host->config;
 
+#if ME_UNIX_LIKE
+    if (startWorkers(host) < 0) {
+        return R_ERR_CANT_CREATE;
+    }
+#endif
     for (ITERATE_JSON_KEY(json, 0, "web.listen", np, id)) {
         endpoint = jsonGet(json, id, 0, 0);
         if ((listen = allocListen(host, endpoint)) == 0) {
@@ -2024,7 +2683,82 @@ PUBLIC void webStopHost(WebHost *host)
     for (ITERATE_ITEMS(host->webs, web, next)) {
         rCloseSocket(web->sock);
     }
+#if ME_UNIX_LIKE
+    stopWorkers(host);
+#endif
+}
+
+#if ME_UNIX_LIKE
+/*
+    Fork worker processes to share the listening endpoints. Each worker runs its own event loop and inherits
+    a copy of the host configuration, routes, users and sessions. The parent continues as the first worker.
+ */
+static int startWorkers(WebHost *host)
+{
+    cchar *value;
+    int   count, i, pid;
+
+    if (host->worker || host->workerPids) {
+        return 0;
+    }
+    value = jsonGet(host->config, 0, "web.workers", 0);
+    if (smatch(value, "auto")) {
+        count = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    } else {
+        count = value ? (int) stoi(value) : 1;
+    }
+    host->workers = max(min(count, WEB_MAX_WORKERS), 1);
+    host->clientAffinity = !smatch(jsonGet(host->config, 0, "web.workerAffinity", "client"), "connection");
+    if (host->workers <= 1) {
+        return 0;
+    }
+    if ((host->workerPids = rAlloc(sizeof(int) * (size_t) host->workers)) == 0) {
+        return R_ERR_MEMORY;
+    }
+    memset(host->workerPids, 0, sizeof(int) * (size_t) host->workers);
+
+    for (i = 1; i < host->workers; i++) {
+        if ((pid = rForkWorker()) < 0) {
+            return R_ERR_CANT_CREATE;
+        }
+        if (pid == 0) {
+            //  Worker. The pid list belongs to the parent.
+            rFree(host->workerPids);
+            host->workerPids = 0;
+            host->worker = 1;
+            return 0;
+        }
+        host->workerPids[i] = pid;
+    }
+    rInfo("web", "Started %d worker processes, %s affinity", host->workers,
+          host->clientAffinity ? "client" : "connection");
+    return 0;
+}
+
+/*
+    Terminate and reap the worker processes. Workers stop gracefully on SIGTERM.
+ */
+static void stopWorkers(WebHost *host)
+{
+    int i, status;
+
+    if (!host->workerPids) {
+        return;
+    }
+    for (i = 1; i < host->workers; i++) {
+        if (host->workerPids[i] > 0) {
+            kill(host->workerPids[i], SIGTERM);
+        }
+    }
+    for (i = 1; i < host->workers; i++) {
+        if (host->workerPids[i] > 0) {
+            waitpid(host->workerPids[i], &status, 0);
+        }
+    }
+    rFree(host->workerPids);
+    host->workerPids = 0;
 }
+#endif
 
 /*
     Create the listening endpoint and start listening for requests
@@ -2075,6 +2809,9 @@ static WebListen *allocListen(WebHost *host, cchar *endpoint)
 
     listen->sock = sock = rAllocSocket();
     listen->port = port;
+    if (host->workers > 1) {
+        rSetSocketReusePort(sock, host->clientAffinity ? host->workers : 0);
+    }
 
 #if ME_COM_SSL
     if (smatch(scheme, "https")) {
@@ -2308,6 +3045,7 @@ static void initRoutes(WebHost *host)
     char     *methods;
 
     host->routes = rAllocList(0, 0);
+    host->routeTree = allocRouteNode("", 0);
     json = host->config;
     routes = jsonGetNode(json, 0, "web.routes");
 
@@ -2317,7 +3055,7 @@ static void initRoutes(WebHost *host)
         rp->handler = "file";
         rp->methods = host->methods;
         rp->validate = 0;
-        rAddItem(host->routes, rp);
+        addRoute(host, rp);
 
     } else {
         for (ITERATE_JSON(json, routes, route, id)) {
@@ -2362,9 +3100,148 @@ static void initRoutes(WebHost *host)
             } else {
                 rp->methods = host->methods;
             }
-            rAddItem(host->routes, rp);
+            addRoute(host, rp);
+        }
+    }
+}
+
+/*
+    Append a route to the host routes and compile its pattern into the route tree
+ */
+static void addRoute(WebHost *host, WebRoute *route)
+{
+    WebRouteNode *node, *child;
+    RName        *np;
+    cchar        *match;
+    size_t       common;
+    int          i, index;
+
+    for (ITERATE_NAMES(route->methods, np)) {
+        for (i = 0; methodNames[i]; i++) {
+            if (smatch(np->name, methodNames[i])) {
+                route->methodMask |= (uint) (1 << i);
+            }
+        }
+    }
+    index = rAddItem(host->routes, route);
+    node = host->routeTree;
+    match = route->match ? route->match : "";
+
+    while (*match) {
+        for (i = 0, child = 0; i < node->numChildren; i++) {
+            if (node->children[i]->fragment[0] == *match) {
+                child = node->children[i];
+                break;
+            }
+        }
+        if (!child) {
+            child = allocRouteNode(match, slen(match));
+            node->children = rRealloc(node->children, sizeof(WebRouteNode*) * (size_t) (node->numChildren + 1));
+            node->children[node->numChildren++] = child;
+            node = child;
+            break;
+        }
+        for (common = 0; common < child->len && match[common] == child->fragment[common]; common++) {
+        }
+        if (common < child->len) {
+            splitRouteNode(child, common);
+        }
+        match += common;
+        node = child;
+    }
+    //  Earlier routes take precedence
+    if (route->exact) {
+        if (node->exact < 0) {
+            node->exact = index;
+        }
+    } else if (node->prefix < 0) {
+        node->prefix = index;
+    }
+}
+
+static WebRouteNode *allocRouteNode(cchar *fragment, size_t len)
+{
+    WebRouteNode *node;
+
+    node = rAllocType(WebRouteNode);
+    node->fragment = snclone(fragment, len);
+    node->len = len;
+    node->exact = -1;
+    node->prefix = -1;
+    return node;
+}
+
+/*
+    Split a node so its fragment ends at "offset". The remainder moves to a new child node.
+ */
+static void splitRouteNode(WebRouteNode *node, size_t offset)
+{
+    WebRouteNode *tail;
+
+    tail = allocRouteNode(&node->fragment[offset], node->len - offset);
+    tail->exact = node->exact;
+    tail->prefix = node->prefix;
+    tail->children = node->children;
+    tail->numChildren = node->numChildren;
+
+    node->fragment[offset] = '\0';
+    node->len = offset;
+    node->exact = -1;
+    node->prefix = -1;
+    node->children = rAlloc(sizeof(WebRouteNode*));
+    node->children[0] = tail;
+    node->numChildren = 1;
+}
+
+static void freeRouteNode(WebRouteNode *node)
+{
+    int i;
+
+    if (node) {
+        for (i = 0; i < node->numChildren; i++) {
+            freeRouteNode(node->children[i]);
+        }
+        rFree(node->children);
+        rFree(node->fragment);
+        rFree(node);
+    }
+}
+
+/*
+    Find the first route that matches the path. This walks the route tree once and selects the earliest route
+    among the prefix routes passed on the way and the exact route at the end of the path.
+ */
+PUBLIC WebRoute *webMatchRoute(WebHost *host, cchar *path)
+{
+    WebRouteNode *node, *child;
+    cchar        *cp;
+    int          best, i;
+
+    if (!host || !host->routeTree || !path) {
+        return 0;
+    }
+    node = host->routeTree;
+    best = node->prefix;
+
+    for (cp = path; *cp; cp += child->len) {
+        for (i = 0, child = 0; i < node->numChildren; i++) {
+            if (node->children[i]->fragment[0] == *cp) {
+                child = node->children[i];
+                break;
+            }
+        }
+        if (!child || strncmp(cp, child->fragment, child->len) != 0) {
+            break;
         }
+        node = child;
+        if (node->prefix >= 0 && (best < 0 || node->prefix < best)) {
+            best = node->prefix;
+        }
+    }
+    if (*cp == '\0' && node->exact >= 0 && (best < 0 || node->exact < best)) {
+        best = node->exact;
     }
+    return best >= 0 ? rGetItem(host->routes, best) : 0;
 }
 
 static void initRedirects(WebHost *host)
@@ -2543,16 +3420,65 @@ static cchar validHeaderChars[128] = {
     ['+'] = 1, ['-'] = 1, ['.'] = 1, ['^'] = 1, ['_'] = 1, ['`'] = 1, ['|'] = 1, ['~'] = 1
 };
 
+/*
+    Names of the well-known request headers in WEB_HDR_* order
+ */
+static cchar *headerNames[WEB_HDR_MAX] = {
+    "Accept", "Accept-Encoding", "Authorization", "Connection", "Content-Disposition", "Content-Length",
+    "Content-Type", "Cookie", "Host", "If-Match", "If-Modified-Since", "If-None-Match", "If-Range",
+    "If-Unmodified-Since", "Last-Event-ID", "Origin", "Range", "Referer", "Sec-WebSocket-Key",
+    "Sec-WebSocket-Protocol", "Sec-WebSocket-Version", "Transfer-Encoding", "Upgrade", "User-Agent",
+    "X-XSRF-TOKEN",
+};
+
+/*
+    Perfect hash of the well-known header names. Maps the hash to the WEB_HDR_* value plus one. Zero is not
+    a well-known header. See getHeaderId for the hash function. Regenerate if the headers change.
+ */
+static const uchar headerSlots[64] = {
+    [0] = WEB_HDR_HOST + 1,
+    [1] = WEB_HDR_IF_UNMODIFIED_SINCE + 1,
+    [2] = WEB_HDR_SEC_WEBSOCKET_VERSION + 1,
+    [3] = WEB_HDR_ACCEPT + 1,
+    [4] = WEB_HDR_RANGE + 1,
+    [8] = WEB_HDR_AUTHORIZATION + 1,
+    [10] = WEB_HDR_IF_RANGE + 1,
+    [12] = WEB_HDR_TRANSFER_ENCODING + 1,
+    [15] = WEB_HDR_REFERER + 1,
+    [17] = WEB_HDR_UPGRADE + 1,
+    [24] = WEB_HDR_CONTENT_TYPE + 1,
+    [25] = WEB_HDR_IF_MATCH + 1,
+    [26] = WEB_HDR_XSRF_TOKEN + 1,
+    [33] = WEB_HDR_LAST_EVENT_ID + 1,
+    [37] = WEB_HDR_SEC_WEBSOCKET_KEY + 1,
+    [40] = WEB_HDR_CONTENT_DISPOSITION + 1,
+    [43] = WEB_HDR_USER_AGENT + 1,
+    [47] = WEB_HDR_ACCEPT_ENCODING + 1,
+    [49] = WEB_HDR_CONTENT_LENGTH + 1,
+    [50] = WEB_HDR_IF_NONE_MATCH + 1,
+    [51] = WEB_HDR_ORIGIN + 1,
+    [55] = WEB_HDR_IF_MODIFIED_SINCE + 1,
+    [58] = WEB_HDR_COOKIE + 1,
+    [59] = WEB_HDR_CONNECTION + 1,
+    [61] = WEB_HDR_SEC_WEBSOCKET_PROTOCOL + 1,
+};
 
 /*
     Default buffer size for rx HTTP headers
  */
 #define WEB_HTTP_HEADER_SIZE 1024
 
+static char   dateCache[32];    /* Cached Date header value */
+static time_t dateCacheTime;    /* Time of the cached Date header */
+
 /************************************ Forwards *********************************/
 
 static bool authenticateRequest(Web *web);
+static void freeStreamHeaders(Web *web);
 static void freeWebFields(Web *web, bool keepAlive);
+static RArena *getArena(Web *web);
+static cchar *getDate(void);
+static int getHeaderId(cchar *key, size_t len);
 static int handleRequest(Web *web);
 static bool matchFrom(Web *web, cchar *from);
 static int parseHeaders(Web *web, size_t headerSize);
@@ -2562,6 +3488,7 @@ static bool parseRangeHeader(Web *web, char *header);
 static int processBody(Web *web);
 static void processOptions(Web *web);
 static void processQuery(Web *web);
+static void processRequest(Web *web);
 static int redirectRequest(Web *web);
 static void resetWeb(Web *web);
 static bool routeRequest(Web *web);
@@ -2583,6 +3510,7 @@ PUBLIC int webAlloc(WebListen *listen, RSocket *sock)
 {
     Web     *web;
     WebHost *host;
+    int     tag;
 
     assert(!rIsMain());
 
@@ -2597,7 +3525,9 @@ PUBLIC int webAlloc(WebListen *listen, RSocket *sock)
         rFreeSocket(sock);
         return R_ERR_TOO_MANY;
     }
+    tag = rSetMemTag(R_MEM_WEB);
     if ((web = rAllocType(Web)) == 0) {
+        rSetMemTag(tag);
         rFreeSocket(sock);
         return R_ERR_MEMORY;
     }
@@ -2616,6 +3546,8 @@ PUBLIC int webAlloc(WebListen *listen, RSocket *sock)
     web->signature = -1;
     web->status = 200;
     web->txHeaders = rAllocHash(16, R_DYNAMIC_VALUE);
+    web->arena = rAllocArena(ME_WEB_ARENA);
+    rSetMemTag(tag);
 
     rAddItem(host->webs, web);
 
@@ -2646,20 +3578,12 @@ PUBLIC void webFree(Web *web)
 
 /*
     Free range request resources
-    Used by both freeWebFields and action handlers to clean up ranges
+    Used by both freeWebFields and action handlers to clean up ranges. The ranges are allocated in the request arena.
  */
 PUBLIC void webFreeRanges(Web *web)
 {
-    WebRange *range, *next;
-
-    if (web->ranges) {
-        for (range = web->ranges; range; range = next) {
-            next = range->next;
-            rFree(range);
-        }
-        web->ranges = NULL;
-        web->currentRange = NULL;
-    }
+    web->ranges = NULL;
+    web->currentRange = NULL;
     rFree(web->rangeBoundary);
     web->rangeBoundary = NULL;
     rFree(web->rmime);
@@ -2677,6 +3601,7 @@ static void freeWebFields(Web *web, bool keepAlive)
     Ticks     connectionStarted;
     RBuf      *rx, *rxHeaders, *body, *buffer;
     RList     *etags;
+    RArena    *arena;
     int64     conn, count;
     int       close;
 
@@ -2695,19 +3620,20 @@ static void freeWebFields(Web *web, bool keepAlive)
         body = web->body;
         buffer = web->buffer;
         etags = web->etags;
+        arena = web->arena;
     }
 
-    //  Free request-specific string resources
-    rFree(web->cookie);
-    rFree(web->error);
+    /*
+        Free request-specific string resources. The cookie, error, ifMatch, auth header fields, ranges and
+        arena headers are released with the arena.
+     */
     rFree(web->path);
     rFree(web->redirect);
     rFree(web->securityToken);
     rFreeHash(web->txHeaders);
+    rFreeHash(web->rxHeaderHash);
 
 #if ME_WEB_HTTP_AUTH
-    rFree(web->authType);
-    rFree(web->authDetails);
     rFree(web->username);
     rFree(web->password);
 #if ME_WEB_AUTH_DIGEST
@@ -2727,7 +3653,6 @@ static void freeWebFields(Web *web, bool keepAlive)
     jsonFree(web->vars);
     webFreeUpload(web);
     webFreeRanges(web);
-    rFree(web->ifMatch);
 
 #if ME_COM_WEBSOCK
     if (web->webSocket) {
@@ -2749,12 +3674,14 @@ static void freeWebFields(Web *web, bool keepAlive)
         if (etags) {
             rClearList(etags);
         }
+        rResetArena(arena);
     } else {
         //  Full cleanup - free buffers and list
         rFreeBuf(web->rxHeaders);
         rFreeBuf(web->body);
         rFreeBuf(web->buffer);
         rFreeList(web->etags);
+        rFreeArena(web->arena);
     }
 
     //  Fast zero of entire structure
@@ -2773,6 +3700,7 @@ static void freeWebFields(Web *web, bool keepAlive)
         web->body = body;
         web->buffer = buffer;
         web->etags = etags;
+        web->arena = arena;
         //  Recreate txHeaders (simpler than clearing sparse hash)
         web->txHeaders = rAllocHash(16, R_DYNAMIC_VALUE);
     }
@@ -2815,6 +3743,73 @@ PUBLIC void webClose(Web *web)
     }
 }
 
+/*
+    Get the request arena. The arena is normally allocated with the connection.
+ */
+static RArena *getArena(Web *web)
+{
+    if (!web->arena) {
+        web->arena = rAllocArena(ME_WEB_ARENA);
+    }
+    return web->arena;
+}
+
+PUBLIC void *webAllocMem(Web *web, size_t size)
+{
+    return rArenaAlloc(getArena(web), size);
+}
+
+PUBLIC char *webClone(Web *web, cchar *str)
+{
+    return rArenaClone(getArena(web), str);
+}
+
+PUBLIC char *webFmt(Web *web, cchar *fmt, ...)
+{
+    va_list ap;
+    char    *result;
+
+    va_start(ap, fmt);
+    result = rArenaFmtv(getArena(web), fmt, ap);
+    va_end(ap);
+    return result;
+}
+
+/*
+    Release the response headers once they are written for a WebSocket or SSE response. These requests can run
+    for the life of the connection and the headers, ranges and etags are no longer needed. The request arena
+    is retained until the request completes as the handler may still be using arena memory.
+ */
+static void freeStreamHeaders(Web *web)
+{
+    if (!(web->upgraded || web->eventStream)) {
+        return;
+    }
+    webFreeRanges(web);
+    if (web->etags) {
+        rClearList(web->etags);
+    }
+    rFreeHash(web->txHeaders);
+    web->txHeaders = rAllocHash(16, R_DYNAMIC_VALUE);
+}
+
+/*
+    Return the Date header value. This is formatted at most once per second.
+ */
+static cchar *getDate(void)
+{
+    time_t now;
+
+    now = time(0);
+    if (now != dateCacheTime || !dateCache[0]) {
+        if (!webFormatHttpDate(dateCache, sizeof(dateCache), now)) {
+            dateCache[0] = '\0';
+        }
+        dateCacheTime = now;
+    }
+    return dateCache;
+}
+
 /*
     Process request(s) on a socket with available data.
     Called directly on connection from webAlloc and as RWait handler
@@ -2827,6 +3822,16 @@ PUBLIC void webClose(Web *web)
     @param mask I/O event mask (R_READABLE | R_WRITABLE | R_TIMEOUT)
  */
 static void webProcessRequest(Web *web)
+{
+    int tag;
+
+    //  Charge connection and request memory to the web tag. Yielding fibers save and restore their tag.
+    tag = rSetMemTag(R_MEM_WEB);
+    processRequest(web);
+    rSetMemTag(tag);
+}
+
+static void processRequest(Web *web)
 {
     WebHost *host;
     int     mask;
@@ -2920,9 +3925,11 @@ static void webSetupKeepAliveWait(Web *web)
  */
 static int serveRequest(Web *web)
 {
-    char *cp;
-    ssize size;
+    char   *cp;
+    ssize  size;
     size_t len;
+    uint64 span;
+    int    rc;
 
     web->started = rGetTicks();
 
@@ -2959,17 +3966,23 @@ static int serveRequest(Web *web)
     web->count++;
     web->headerSize = size;
 
+    //  The span starts once the headers are received so keep-alive idle time is excluded
+    span = rSpanBegin("web", "request");
+    rc = 0;
     if (parseHeaders(web, (size_t) size) < 0) {
-        return R_ERR_BAD_REQUEST;
-    }
-    webAddStandardHeaders(web);
-    webHook(web, WEB_HOOK_START);
+        rc = R_ERR_BAD_REQUEST;
+    } else {
+        webAddStandardHeaders(web);
+        webHook(web, WEB_HOOK_START);
 
-    if (handleRequest(web) < 0) {
-        return R_ERR_CANT_COMPLETE;
+        if (handleRequest(web) < 0) {
+            rc = R_ERR_CANT_COMPLETE;
+        } else {
+            webHook(web, WEB_HOOK_END);
+        }
     }
-    webHook(web, WEB_HOOK_END);
-    return 0;
+    rSpanEnd(span);
+    return rc;
 }
 
 /*
@@ -2981,6 +3994,9 @@ static int handleRequest(Web *web)
 {
     WebRoute *route;
     cchar *handler;
+    uint64 span;
+    bool routed;
+    int rc;
 
     if (web->error) {
         return 0;
@@ -2989,7 +4005,10 @@ static int handleRequest(Web *web)
         //  Protocol and site level redirections handled
         return 0;
     }
-    if (!routeRequest(web)) {
+    span = rSpanBegin("web", "route");
+    routed = routeRequest(web);
+    rSpanEnd(span);
+    if (!routed) {
         return 0;
     }
     route = web->route;
@@ -3047,10 +4066,16 @@ static int handleRequest(Web *web)
         Run standard handlers: action and file
      */
     if (handler[0] == 'a' && smatch(handler, "action")) {
-        return webActionHandler(web);
+        span = rSpanBegin("web", "action");
+        rc = webActionHandler(web);
+        rSpanEnd(span);
+        return rc;
 
     } else if (handler[0] == 'f' && smatch(handler, "file")) {
-        return webFileHandler(web);
+        span = rSpanBegin("web", "file");
+        rc = webFileHandler(web);
+        rSpanEnd(span);
+        return rc;
     }
     return webError(web, 404, "No handler to process request");
 }
@@ -3139,49 +4164,47 @@ static int webActionHandler(Web *web)
 static bool routeRequest(Web *web)
 {
     WebRoute *route;
-    char *path;
-    bool match;
-    int next;
+    size_t len;
+    bool allowed;
 
-    for (ITERATE_ITEMS(web->host->routes, route, next)) {
-        if (route->exact) {
-            match = smatch(web->path, route->match);
-        } else {
-            match = sstarts(web->path, route->match);
-        }
-        if (match) {
-            if (!rLookupName(route->methods, web->method)) {
-                webError(web, 405, "Unsupported method.");
-                return 0;
-            }
-            web->route = route;
-            if (route->redirect) {
-                webRedirect(web, 302, route->redirect);
+    if ((route = webMatchRoute(web->host, web->path)) == 0) {
+        rInfo("web", "Cannot find route to serve request %s", web->path);
+        webHook(web, WEB_HOOK_NOT_FOUND);
 
-            } else if (route->role && !smatch(route->role, "public") && !web->options) {
-                if (!authenticateRequest(web)) {
-                    return 0;
-                }
-                if (!webCan(web, route->role)) {
-                    webError(web, 403, "Access Denied. User has insufficient privilege.");
-                    return 0;
-                }
-            }
-            if (route->trim && sstarts(web->path, route->trim)) {
-                path = sclone(&web->path[slen(route->trim)]);
-                rFree(web->path);
-                web->path = path;
-            }
-            return 1;
+        if (!web->error) {
+            webWriteResponseString(web, 404, "No matching route");
         }
+        return 0;
     }
-    rInfo("web", "Cannot find route to serve request %s", web->path);
-    webHook(web, WEB_HOOK_NOT_FOUND);
+    //  Standard methods are checked via the method bits. Other methods are looked up by name.
+    if (web->methodMask) {
+        allowed = (route->methodMask & web->methodMask) != 0;
+    } else {
+        allowed = rLookupName(route->methods, web->method) != 0;
+    }
+    if (!allowed) {
+        webError(web, 405, "Unsupported method.");
+        return 0;
+    }
+    web->route = route;
+    if (route->redirect) {
+        webRedirect(web, 302, route->redirect);
 
-    if (!web->error) {
-        webWriteResponseString(web, 404, "No matching route");
+    } else if (route->role && !smatch(route->role, "public") && !web->options) {
+        if (!authenticateRequest(web)) {
+            return 0;
+        }
+        if (!webCan(web, route->role)) {
+            webError(web, 403, "Access Denied. User has insufficient privilege.");
+            return 0;
+        }
     }
-    return 0;
+    if (route->trim && sstarts(web->path, route->trim)) {
+        //  Trim the prefix in-place
+        len = slen(route->trim);
+        memmove(web->path, &web->path[len], slen(&web->path[len]) + 1);
+    }
+    return 1;
 }
 
 static bool authenticateRequest(Web *web)
@@ -3276,8 +4299,8 @@ static bool parseEtags(Web *web, cchar *value)
         return 1;
     }
 
-    //  Parse comma-separated ETags
-    copy = sclone(value);
+    //  Parse comma-separated ETags. The list references the copy so it must persist for the request.
+    copy = webClone(web, value);
 
     for (tok = stok(copy, ",", (char**) &value); tok; tok = stok(NULL, ",", (char**) &value)) {
         tok = strim(tok, " \t", R_TRIM_BOTH);
@@ -3291,11 +4314,9 @@ static bool parseEtags(Web *web, cchar *value)
         } else {
             //  Malformed ETag - clear but keep list for reuse
             rClearList(web->etags);
-            rFree(copy);
             return 0;
         }
     }
-    rFree(copy);
     return rGetListLength(web->etags) > 0;
 }
 
@@ -3376,10 +4397,13 @@ static bool parseRangeHeader(Web *web, char *header)
             }
             len = end - start;
         }
-        range = rAllocType(WebRange);
+        if ((range = webAllocMem(web, sizeof(WebRange))) == 0) {
+            return 0;
+        }
         range->start = start;
         range->end = end;
         range->len = len;
+        range->next = NULL;
         //  Add to linked list
         if (last == NULL) {
             web->ranges = range;
@@ -3529,39 +4553,46 @@ static int parseMethod(Web *web, cchar *method)
     case 'D':
         if (strcmp(method, "DELETE") == 0) {
             web->del = 1;
+            web->methodMask = WEB_METHOD_DELETE;
         }
         break;
 
     case 'G':
         if (strcmp(method, "GET") == 0) {
             web->get = 1;
+            web->methodMask = WEB_METHOD_GET;
         }
         break;
 
     case 'H':
         if (strcmp(method, "HEAD") == 0) {
             web->head = 1;
+            web->methodMask = WEB_METHOD_HEAD;
         }
         break;
 
     case 'O':
         if (strcmp(method, "OPTIONS") == 0) {
             web->options = 1;
+            web->methodMask = WEB_METHOD_OPTIONS;
         }
         break;
 
     case 'P':
         if (strcmp(method, "POST") == 0) {
             web->post = 1;
+            web->methodMask = WEB_METHOD_POST;
 
         } else if (strcmp(method, "PUT") == 0) {
             web->put = 1;
+            web->methodMask = WEB_METHOD_PUT;
         }
         break;
 
     case 'T':
         if (strcmp(method, "TRACE") == 0) {
             web->trace = 1;
+            web->methodMask = WEB_METHOD_TRACE;
         }
         break;
     }
@@ -3575,10 +4606,16 @@ static int parseMethod(Web *web, cchar *method)
 PUBLIC bool webParseHeadersBlock(Web *web, char *headers, size_t headersSize, bool upload)
 {
     cchar *end;
-    char c, *cp, *endKey, *key, *prior, *t, *value;
+    char *cp, *endKey, *key, *t, *value;
     uchar uc;
     bool hasCL = 0, hasTE = 0;
+    int id;
 
+    if (!upload && web->rxHeaderHash) {
+        //  Discard any lookups made before the headers were parsed
+        rFreeHash(web->rxHeaderHash);
+        web->rxHeaderHash = 0;
+    }
     if (headers && *headers) {
         end = &headers[headersSize];
 
@@ -3633,129 +4670,146 @@ PUBLIC bool webParseHeadersBlock(Web *web, char *headers, size_t headersSize, bo
                     return 0;
                 }
             }
-            c = tolower(*key);
+            id = getHeaderId(key, (size_t) (endKey - key));
 
-            if (upload && c != 'c' && (
-                    !scaselessmatch(key, "content-disposition") &&
-                    !scaselessmatch(key, "content-type"))) {
-                webNetError(web, "Bad upload headers");
-                return 0;
+            if (upload) {
+                if (id != WEB_HDR_CONTENT_DISPOSITION && id != WEB_HDR_CONTENT_TYPE) {
+                    //  Ignore other part content headers such as Content-Transfer-Encoding
+                    if (sncaselesscmp(key, "content-", 8) == 0) {
+                        continue;
+                    }
+                    webNetError(web, "Bad upload headers");
+                    return 0;
+                }
+            } else if (id >= 0 && !web->rxHeaderIndex[id]) {
+                //  Index the first occurrence to match webGetHeader
+                web->rxHeaderIndex[id] = value;
             }
+            switch (id) {
 #if ME_WEB_HTTP_AUTH
-            if (c == 'a' && scaselessmatch(key, "authorization")) {
+            case WEB_HDR_AUTHORIZATION: {
                 //  Parse Authorization header: "Basic xxx" or "Digest xxx"
                 char *authType = value;
                 char *sp = strchr(value, ' ');
                 if (sp) {
                     *sp++ = '\0';
-                    web->authType = sclone(authType);
-                    web->authDetails = sclone(sp);
+                    web->authType = webClone(web, authType);
+                    web->authDetails = webClone(web, sp);
                 }
-            } else
+                break;
+            }
 #endif
-            if (c == 'c') {
-                if (scaselessmatch(key, "content-disposition")) {
-                    web->contentDisposition = value;
-
-                } else if (scaselessmatch(key, "content-type")) {
-                    web->contentType = value;
-                    if (scontains(value, "multipart/form-data")) {
-                        if (webInitUpload(web) < 0) {
-                            return 0;
-                        }
-
-                    } else if (smatch(value, "application/x-www-form-urlencoded")) {
-                        web->formBody = 1;
-
-                    } else if (smatch(value, "application/json")) {
-                        web->jsonBody = 1;
-                    }
+            case WEB_HDR_CONTENT_DISPOSITION:
+                web->contentDisposition = value;
+                break;
 
-                } else if (scaselessmatch(key, "connection")) {
-                    if (scaselessmatch(value, "close")) {
-                        web->close = 1;
-                    }
-                } else if (scaselessmatch(key, "content-length")) {
-                    hasCL = 1;
-                    web->rxLen = web->rxRemaining = stoi(value);
-                    if (web->rxLen < 0) {
-                        webError(web, -400, "Bad Content-Length");
+            case WEB_HDR_CONTENT_TYPE:
+                web->contentType = value;
+                if (scontains(value, "multipart/form-data")) {
+                    if (webInitUpload(web) < 0) {
                         return 0;
                     }
 
-                } else if (scaselessmatch(key, "cookie")) {
-                    if (web->cookie) {
-                        prior = web->cookie;
-                        web->cookie = sjoin(prior, "; ", value, NULL);
-                        rFree(prior);
-                    } else {
-                        web->cookie = sclone(value);
-                    }
+                } else if (smatch(value, "application/x-www-form-urlencoded")) {
+                    web->formBody = 1;
+
+                } else if (smatch(value, "application/json")) {
+                    web->jsonBody = 1;
                 }
+                break;
 
-            } else if (c == 'i') {
-                if (scaselessmatch(key, "if-match")) {
-                    if (!parseEtags(web, value)) {
-                        webError(web, 400, "Invalid If-Match header");
-                        return 0;
-                    }
-                    web->ifMatchPresent = 1;
+            case WEB_HDR_CONNECTION:
+                if (scaselessmatch(value, "close")) {
+                    web->close = 1;
+                }
+                break;
 
-                } else if (scaselessmatch(key, "if-modified-since")) {
-                    web->since = rParseHttpDate(value);
-                    if (web->since > 0) {
-                        web->ifModified = 1;
-                    }
+            case WEB_HDR_CONTENT_LENGTH:
+                hasCL = 1;
+                web->rxLen = web->rxRemaining = stoi(value);
+                if (web->rxLen < 0) {
+                    webError(web, -400, "Bad Content-Length");
+                    return 0;
+                }
+                break;
 
-                } else if (scaselessmatch(key, "if-none-match")) {
-                    if (!parseEtags(web, value)) {
-                        webError(web, 400, "Invalid If-None-Match header");
-                        return 0;
-                    }
-                    web->ifNoneMatch = 1;
-
-                } else if (scaselessmatch(key, "if-range")) {
-                    //  Can be either an ETag or a date - strip quotes for faster comparison
-                    if (*value == '"') {
-                        web->ifMatch = sclone(strim((char*) value, "\"", R_TRIM_BOTH));
-                    } else if (*value == 'W' && value[1] == '/' && value[2] == '"') {
-                        //  Weak ETag: strip W/ prefix and quotes
-                        web->ifMatch = sclone(strim((char*) value + 2, "\"", R_TRIM_BOTH));
-                    } else {
-                        //  Date format - parse it into web->since (will be used for conditional range)
-                        web->since = rParseHttpDate(value);
-                    }
-                    web->ifRange = 1;
+            case WEB_HDR_COOKIE:
+                if (web->cookie) {
+                    web->cookie = webFmt(web, "%s; %s", web->cookie, value);
+                } else {
+                    web->cookie = webClone(web, value);
+                }
+                break;
 
-                } else if (scaselessmatch(key, "if-unmodified-since")) {
-                    web->unmodifiedSince = rParseHttpDate(value);
-                    if (web->unmodifiedSince > 0) {
-                        web->ifUnmodified = 1;
-                    }
+            case WEB_HDR_IF_MATCH:
+                if (!parseEtags(web, value)) {
+                    webError(web, 400, "Invalid If-Match header");
+                    return 0;
+                }
+                web->ifMatchPresent = 1;
+                break;
+
+            case WEB_HDR_IF_MODIFIED_SINCE:
+                web->since = rParseHttpDate(value);
+                if (web->since > 0) {
+                    web->ifModified = 1;
+                }
+                break;
+
+            case WEB_HDR_IF_NONE_MATCH:
+                if (!parseEtags(web, value)) {
+                    webError(web, 400, "Invalid If-None-Match header");
+                    return 0;
+                }
+                web->ifNoneMatch = 1;
+                break;
+
+            case WEB_HDR_IF_RANGE:
+                //  Can be either an ETag or a date - strip quotes for faster comparison
+                if (*value == '"') {
+                    web->ifMatch = webClone(web, strim((char*) value, "\"", R_TRIM_BOTH));
+                } else if (*value == 'W' && value[1] == '/' && value[2] == '"') {
+                    //  Weak ETag: strip W/ prefix and quotes
+                    web->ifMatch = webClone(web, strim((char*) value + 2, "\"", R_TRIM_BOTH));
+                } else {
+                    //  Date format - parse it into web->since (will be used for conditional range)
+                    web->since = rParseHttpDate(value);
+                }
+                web->ifRange = 1;
+                break;
+
+            case WEB_HDR_IF_UNMODIFIED_SINCE:
+                web->unmodifiedSince = rParseHttpDate(value);
+                if (web->unmodifiedSince > 0) {
+                    web->ifUnmodified = 1;
                 }
+                break;
 
-            } else if (c == 'l' && scaselessmatch(key, "last-event-id")) {
+            case WEB_HDR_LAST_EVENT_ID:
                 web->lastEventId = stoi(value);
+                break;
 
-            } else if (c == 'o' && scaselessmatch(key, "origin")) {
+            case WEB_HDR_ORIGIN:
                 web->origin = value;
+                break;
 
-            } else if (c == 'r' && scaselessmatch(key, "range")) {
-                value = sclone(value);
-                if (!parseRangeHeader(web, value)) {
-                    rFree(value);
+            case WEB_HDR_RANGE:
+                if (!parseRangeHeader(web, webClone(web, value))) {
                     webError(web, 400, "Invalid Range header");
                     return 0;
                 }
-                rFree(value);
+                break;
 
-            } else if (c == 't' && scaselessmatch(key, "transfer-encoding")) {
+            case WEB_HDR_TRANSFER_ENCODING:
                 if (scaselessmatch(value, "chunked")) {
                     hasTE = 1;
                     web->chunked = WEB_CHUNK_START;
                 }
-            } else if (c == 'u' && scaselessmatch(key, "upgrade")) {
+                break;
+
+            case WEB_HDR_UPGRADE:
                 web->upgrade = value;
+                break;
             }
         }
     }
@@ -3781,30 +4835,67 @@ PUBLIC bool webParseHeadersBlock(Web *web, char *headers, size_t headersSize, bo
 }
 
 /*
-    Headers have been tokenized with a null replacing the ":" and "\r\n"
+    Map a header name to its WEB_HDR_* value. Returns -1 if not a well-known header.
+    The hash is computed from the length and the lower case first and last characters.
+ */
+static int getHeaderId(cchar *key, size_t len)
+{
+    int id;
+
+    if (len == 0) {
+        return -1;
+    }
+    id = headerSlots[((len + (uchar) (key[len - 1] | 0x20)) * 5 + (uchar) (key[0] | 0x20)) & 63] - 1;
+    if (id < 0 || !scaselessmatch(key, headerNames[id])) {
+        return -1;
+    }
+    return id;
+}
+
+/*
+    Headers have been tokenized with a null replacing the ":" and "\r\n".
+    Well-known headers are indexed when parsed. Other headers are hashed on the first lookup of such a header.
  */
 PUBLIC cchar *webGetHeader(Web *web, cchar *name)
 {
-    cchar *cp, *end, *start;
-    cchar *value;
+    cchar *cp, *end, *key, *value;
+    int   id;
 
-    start = rGetBufStart(web->rxHeaders);
-    end = rGetBufEnd(web->rxHeaders);
-    value = 0;
+    if (!name) {
+        return 0;
+    }
+    if ((id = getHeaderId(name, slen(name))) >= 0) {
+        return web->rxHeaderIndex[id];
+    }
+    if (!web->rxHeaderHash) {
+        web->rxHeaderHash = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE | R_HASH_CASELESS);
+        end = rGetBufEnd(web->rxHeaders);
 
-    for (cp = start; cp < end; cp++) {
-        if (scaselessmatch(cp, name)) {
-            cp += slen(name) + 1;
+        for (cp = rGetBufStart(web->rxHeaders); cp < end; ) {
+            key = cp;
+            cp += slen(cp) + 1;
+            if (cp >= end) {
+                break;
+            }
             while (isWhite(*cp)) cp++;
             value = cp;
-            break;
-        }
-        cp += slen(cp) + 1;
-        if (cp < end && *cp) {
-            cp += slen(cp) + 1;
+            //  Skip the value and the nulls that replaced trailing white space and the "\r\n"
+            for (cp += slen(cp); cp < end && *cp == '\0'; cp++) {
+            }
+            if (getHeaderId(key, slen(key)) < 0 && !rLookupName(web->rxHeaderHash, key)) {
+                rAddName(web->rxHeaderHash, key, (void*) value, 0);
+            }
         }
     }
-    return value;
+    return rLookupName(web->rxHeaderHash, name);
+}
+
+PUBLIC cchar *webGetHeaderId(Web *web, int id)
+{
+    if (id < 0 || id >= WEB_HDR_MAX) {
+        return 0;
+    }
+    return web->rxHeaderIndex[id];
 }
 
 PUBLIC bool webGetNextHeader(Web *web, cchar **pkey, cchar **pvalue)
@@ -4069,11 +5160,12 @@ PUBLIC void webSetCacheControlHeaders(Web *web)
 
 static char *findPatternFrom(RBuf *buf, cchar *pattern, size_t patLen, size_t fromOffset);
 static bool isprintable(cchar *s, size_t len);
+static RBuf *formatHeaders(Web *web);
+static size_t getChunkDivider(Web *web, char *chunk, size_t chunkSize, size_t size);
 static ssize consumeChunkStart(Web *web, size_t desiredSize);
 static int consumeChunkData(Web *web, ssize nbytes);
 static ssize readSocketBuffer(Web *web, size_t desiredSize);
 static ssize readSocketBlock(Web *web, size_t desiredSize);
-static int writeChunkDivider(Web *web, size_t bufsize);
 
 /************************************* Code ***********************************/
 /*
@@ -4447,15 +5539,10 @@ PUBLIC int webConsumeInput(Web *web)
  */
 PUBLIC ssize webWriteHeaders(Web *web)
 {
-    WebHost *host;
-    Ticks   remaining;
-    RName   *header;
-    RBuf    *buf;
-    cchar   *connection, *protocol;
-    ssize   nbytes;
-    int     status;
+    RIOVec iov[1];
+    RBuf   *buf;
+    ssize  nbytes;
 
-    host = web->host;
     if (web->wroteHeaders) {
         rError("web", "Headers already created");
         return 0;
@@ -4465,6 +5552,34 @@ PUBLIC ssize webWriteHeaders(Web *web)
     }
     web->writingHeaders = 1;
 
+    buf = formatHeaders(web);
+    iov[0].iov_base = rGetBufStart(buf);
+    iov[0].iov_len = rGetBufLength(buf);
+    nbytes = rWriteSocketv(web->sock, iov, 1, web->deadline);
+    rFreeBuf(buf);
+    if (nbytes < 0) {
+        return R_ERR_CANT_WRITE;
+    }
+    webUpdateDeadline(web);
+    web->writingHeaders = 0;
+    web->wroteHeaders = 1;
+    freeStreamHeaders(web);
+    return nbytes;
+}
+
+/*
+    Create the response line and headers. The caller must free the returned buffer.
+ */
+static RBuf *formatHeaders(Web *web)
+{
+    WebHost *host;
+    Ticks   remaining;
+    RName   *header;
+    RBuf    *buf;
+    cchar   *connection, *protocol;
+    int     status;
+
+    host = web->host;
     status = web->status;
     if (status == 0) {
         status = 500;
@@ -4475,7 +5590,7 @@ PUBLIC ssize webWriteHeaders(Web *web)
     if (web->count >= host->maxRequests) {
         web->close = 1;
     }
-    webAddHeaderDynamicString(web, "Date", webHttpDate(time(0)));
+    webAddHeaderStaticString(web, "Date", getDate());
 
     if (web->upgrade) {
         connection = "Upgrade";
@@ -4550,14 +5665,7 @@ PUBLIC ssize webWriteHeaders(Web *web)
         //  Delay adding if using transfer encoding. This optimization eliminates a write per chunk.
         rPutStringToBuf(buf, "\r\n");
     }
-    if ((nbytes = webWrite(web, rGetBufStart(buf), rGetBufLength(buf))) < 0) {
-        rFreeBuf(buf);
-        return R_ERR_CANT_WRITE;
-    }
-    rFreeBuf(buf);
-    web->writingHeaders = 0;
-    web->wroteHeaders = 1;
-    return nbytes;
+    return buf;
 }
 
 /*
@@ -4587,9 +5695,9 @@ PUBLIC void webAddHeader(Web *web, cchar *key, cchar *fmt, ...)
     va_list ap;
 
     va_start(ap, fmt);
-    value = sfmtv(fmt, ap);
+    value = rArenaFmtv(getArena(web), fmt, ap);
     va_end(ap);
-    webAddHeaderDynamicString(web, key, value);
+    webAddHeaderStaticString(web, key, value);
 }
 
 PUBLIC void webAddHeaderDynamicString(Web *web, cchar *key, char *value)
@@ -4641,7 +5749,12 @@ PUBLIC void webAddAccessControlHeader(Web *web)
  */
 PUBLIC ssize webWrite(Web *web, cvoid *buf, size_t bufsize)
 {
-    ssize written;
+    RIOVec iov[3];
+    RBuf   *headers;
+    char   chunk[24];
+    size_t chunkLen;
+    ssize  written;
+    int    count;
 
     if (web->finalized) {
         return 0;
@@ -4651,7 +5764,7 @@ PUBLIC ssize webWrite(Web *web, cvoid *buf, size_t bufsize)
     } else if (bufsize == 0 || bufsize >= MAXINT) {
         bufsize = slen(buf);
     }
-    if (web->buffer && !web->writingHeaders) {
+    if (web->buffer) {
         if (buf) {
             rPutBlockToBuf(web->buffer, buf, bufsize);
             return (ssize) bufsize;
@@ -4660,41 +5773,58 @@ PUBLIC ssize webWrite(Web *web, cvoid *buf, size_t bufsize)
         bufsize = rGetBufLength(web->buffer);
         webSetContentLength(web, bufsize);
     }
-    if (!web->wroteHeaders && webWriteHeaders(web) < 0) {
-        //  Already closed
-        return R_ERR_CANT_WRITE;
+    /*
+        Gather the headers (if not yet written), the chunk divider and the body into one write
+     */
+    count = 0;
+    headers = 0;
+    if (!web->wroteHeaders) {
+        if (web->writingHeaders) {
+            return 0;
+        }
+        headers = formatHeaders(web);
+        iov[count].iov_base = rGetBufStart(headers);
+        iov[count++].iov_len = rGetBufLength(headers);
     }
-    if (web->head && !web->writingHeaders && bufsize > 0) {
+    if (web->head && bufsize > 0) {
         // Non-finalizing head requests remit no body
-        webUpdateDeadline(web);
-        return 0;
-    }
-    if (writeChunkDivider(web, bufsize) < 0) {
-        //  Already closed
+        bufsize = 0;
+        chunkLen = 0;
+    } else {
+        chunkLen = getChunkDivider(web, chunk, sizeof(chunk), bufsize);
+        iov[count].iov_base = chunk;
+        iov[count++].iov_len = chunkLen;
+        iov[count].iov_base = (void*) buf;
+        iov[count++].iov_len = bufsize;
+    }
+    written = rWriteSocketv(web->sock, iov, count, web->deadline);
+    rFreeBuf(headers);
+    if (written < 0) {
+        if (chunkLen > 0) {
+            webNetError(web, "Cannot write to socket");
+        }
         return R_ERR_CANT_WRITE;
     }
+    web->wroteHeaders = 1;
+
     if (bufsize > 0) {
-        if ((written = rWriteSocket(web->sock, buf, bufsize, web->deadline)) < 0) {
-            return R_ERR_CANT_WRITE;
-        }
-        if (web->wroteHeaders && web->host->flags & WEB_SHOW_RESP_BODY) {
-            if (isprintable(buf, (size_t) written)) {
+        if (web->host->flags & WEB_SHOW_RESP_BODY) {
+            if (isprintable(buf, bufsize)) {
                 if (web->moreBody) {
-                    write(rGetLogFile(), (char*) buf, (uint) written);
+                    write(rGetLogFile(), (char*) buf, (uint) bufsize);
                 } else {
-                    rLog("raw", "web", "Response Body >>>>\n\n%*s", (int) written, (char*) buf);
+                    rLog("raw", "web", "Response Body >>>>\n\n%*s", (int) bufsize, (char*) buf);
                     web->moreBody = 1;
                 }
             }
         }
-        if (web->wroteHeaders) {
-            web->txRemaining -= written;
-        }
-    } else {
-        written = 0;
+        web->txRemaining -= (ssize) bufsize;
     }
     webUpdateDeadline(web);
-    return written;
+    if (headers) {
+        freeStreamHeaders(web);
+    }
+    return (ssize) bufsize;
 }
 
 /*
@@ -4745,24 +5875,20 @@ PUBLIC ssize webWriteJson(Web *web, const Json *json)
 }
 
 /*
-    Write a transfer-chunk encoded divider if required
+    Format a transfer-chunk encoded divider if required. Headers must be written or being written with the
+    divider. Returns the length of the divider or zero if not required.
  */
-static int writeChunkDivider(Web *web, size_t size)
+static size_t getChunkDivider(Web *web, char *chunk, size_t chunkSize, size_t size)
 {
-    char chunk[24];
-
-    if (web->txLen >= 0 || !web->wroteHeaders || web->upgraded) {
+    if (web->txLen >= 0 || web->upgraded) {
         return 0;
     }
     if (size == 0) {
-        scopy(chunk, sizeof(chunk), "\r\n0\r\n\r\n");
+        scopy(chunk, chunkSize, "\r\n0\r\n\r\n");
     } else {
-        sfmtbuf(chunk, sizeof(chunk), "\r\n%zx\r\n", size);
-    }
-    if (rWriteSocket(web->sock, chunk, slen(chunk), web->deadline) < 0) {
-        return webNetError(web, "Cannot write to socket");
+        sfmtbuf(chunk, chunkSize, "\r\n%zx\r\n", size);
     }
-    return 0;
+    return slen(chunk);
 }
 
 /*
@@ -4809,12 +5935,10 @@ PUBLIC ssize webWriteResponseString(Web *web, int status, cchar *msg)
 
     webAddHeaderStaticString(web, "Content-Type", "text/plain");
 
-    if (webWriteHeaders(web) < 0) {
+    //  The headers are written with the message body
+    if (web->status != 204 && !web->head && web->txLen > 0 && webWrite(web, msg, (size_t) web->txLen) < 0) {
         rc = R_ERR_CANT_WRITE;
     } else {
-        if (web->status != 204 && !web->head && web->txLen > 0) {
-            (void) webWrite(web, msg, (size_t) web->txLen);
-        }
         rc = webFinalize(web);
     }
     if (status != 200 && status != 201 && status != 204 && status != 301 && status != 302 && status != 401) {
@@ -4861,10 +5985,9 @@ PUBLIC ssize webWriteEvent(Web *web, int64 id, cchar *name, cchar *fmt, ...)
     va_end(ap);
 
     if (!web->wroteHeaders) {
+        //  The headers are written with the first event
         webAddHeaderStaticString(web, "Content-Type", "text/event-stream");
-        if (webWriteHeaders(web) < 0) {
-            return R_ERR_CANT_WRITE;
-        }
+        web->eventStream = 1;
     }
     nbytes = webWriteFmt(web, "id: %ld\nevent: %s\ndata: %s\n\n", id, name, buf);
     rFree(buf);
@@ -4999,7 +6122,7 @@ PUBLIC int webError(Web *web, int status, cchar *fmt, ...)
 
     if (!web->error) {
         va_start(args, fmt);
-        web->error = sfmtv(fmt, args);
+        web->error = rArenaFmtv(getArena(web), fmt, args);
         va_end(args);
     }
     webWriteResponseString(web, status, NULL);
@@ -5017,7 +6140,7 @@ PUBLIC int webNetError(Web *web, cchar *fmt, ...)
 
     va_start(args, fmt);
     if (!web->error && fmt) {
-        web->error = sfmtv(fmt, args);
+        web->error = rArenaFmtv(getArena(web), fmt, args);
         rTrace("web", "%s", web->error);
     }
     web->status = 550;
@@ -5593,7 +6716,7 @@ static int selectProtocol(Web *web, cchar *protocol)
     int       count;
 
     ws = web->webSocket;
-    protocols = sclone(webGetHeader(web, "sec-websocket-protocol"));
+    protocols = sclone(webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_PROTOCOL));
     if (protocols && *protocols) {
         // Just select the first matching protocol
         count = 0;
@@ -5629,13 +6752,13 @@ static int addHeaders(Web *web)
 
     assert(web);
 
-    version = (int) stoi(webGetHeader(web, "sec-websocket-version"));
+    version = (int) stoi(webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_VERSION));
     if (version < WS_VERSION) {
         webAddHeader(web, "Sec-WebSocket-Version", "%d", WS_VERSION);
         webError(web, 400, "Unsupported Sec-WebSocket-Version");
         return R_ERR_BAD_ARGS;
     }
-    if ((key = webGetHeader(web, "sec-websocket-key")) == 0) {
+    if ((key = webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_KEY)) == 0) {
         webError(web, 400, "Bad Sec-WebSocket-Key");
         return R_ERR_BAD_ARGS;
     }
@@ -5858,6 +6981,21 @@ static void eventAction(Web *web)
     webFinalize(web);
 }
 
+/*
+    SSE test of the request arena. The response headers are released once written with the first event,
+    while arena memory remains valid until the request completes.
+ */
+static void arenaEventAction(Web *web)
+{
+    char *msg;
+
+    msg = webFmt(web, "Arena %d", 42);
+    webAddHeader(web, "X-Padding", "%0*d", (int) ME_WEB_ARENA * 2, 0);
+    webWriteEvent(web, 0, "test", "%s", msg);
+    webWriteEvent(web, 0, "arena", "%s %d", msg, (int) rGetHashLength(web->txHeaders));
+    webFinalize(web);
+}
+
 static void formAction(Web *web)
 {
     char *name, *address;
@@ -6167,6 +7305,7 @@ PUBLIC void webTestInit(WebHost *host, cchar *prefix)
     rInfo("test", "Built with development web/test.c for testing -- not for production (DO NOT DISTRIBUTE)");
 
     webAddAction(host, SFMT(url, "%s/event", prefix), eventAction, NULL);
+    webAddAction(host, SFMT(url, "%s/arena", prefix), arenaEventAction, NULL);
     webAddAction(host, SFMT(url, "%s/form", prefix), formAction, NULL);
     webAddAction(host, SFMT(url, "%s/bulk", prefix), bulkOutput, NULL);
     webAddAction(host, SFMT(url, "%s/error", prefix), errorAction, NULL);
@@ -6187,6 +7326,10 @@ PUBLIC void webTestInit(WebHost *host, cchar *prefix)
     webAddAction(host, SFMT(url, "%s/sig", prefix), sigAction, NULL);
     webAddAction(host, SFMT(url, "%s/buffer", prefix), bufferAction, NULL);
     webAddAction(host, SFMT(url, "%s/recurse", prefix), recurseAction, NULL);
+    webAddAction(host, SFMT(url, "%s/stats", prefix), webEventStatsAction, NULL);
+#if ME_R_SPAN
+    webAddAction(host, SFMT(url, "%s/spans", prefix), webSpansAction, NULL);
+#endif
 #if ME_WEB_FIBER_BLOCKS
     webAddAction(host, SFMT(url, "%s/crash/null", prefix), crashNullAction, NULL);
     webAddAction(host, SFMT(url, "%s/crash/divide", prefix), crashDivideAction, NULL);
@@ -6670,10 +7813,22 @@ PUBLIC cchar *webGetStatusMsg(int status)
     Caller must free
  */
 PUBLIC char *webHttpDate(time_t when)
+{
+    char buf[32];
+
+    if (!webFormatHttpDate(buf, sizeof(buf), when)) {
+        return 0;
+    }
+    return sclone(buf);
+}
+
+PUBLIC char *webFormatHttpDate(char *buf, size_t bufsize, time_t when)
 {
     struct tm tm;
-    char      buf[32];
 
+    if (!buf || bufsize == 0) {
+        return 0;
+    }
 #if ME_WIN_LIKE
     if (gmtime_s(&tm, &when) != 0) {
         return 0;
@@ -6684,10 +7839,10 @@ PUBLIC char *webHttpDate(time_t when)
     }
 #endif
     buf[0] = '\0';
-    if (strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm) == 0) {
+    if (strftime(buf, bufsize, "%a, %d %b %Y %H:%M:%S GMT", &tm) == 0) {
         return 0;
     }
-    return sclone(buf);
+    return buf;
 }
 
 PUBLIC cchar *webGetDocs(WebHost *host)
@@ -7154,6 +8309,100 @@ PUBLIC cchar *webGetQueryVar(Web *web, cchar *name, cchar *defaultValue)
     return jsonGet(web->qvars, 0, name, defaultValue);
 }
 
+#if R_USE_EVENT
+static void putHistogram(RBuf *buf, cchar *name, const REventHistogram *hist)
+{
+    int i;
+
+    rPutToBuf(buf, "\"%s\":{\"count\":%lld,\"avg\":%lld,\"max\":%lld,\"p50\":%lld,\"p90\":%lld,\"p99\":%lld,"
+              "\"buckets\":[", name, (int64) hist->count, (int64) (hist->count ? hist->total / hist->count : 0),
+              (int64) hist->max, (int64) rGetEventPercentile(hist, 50), (int64) rGetEventPercentile(hist, 90),
+              (int64) rGetEventPercentile(hist, 99));
+    for (i = 0; i < R_EVENT_BUCKETS; i++) {
+        rPutToBuf(buf, i ? ",%lld" : "%lld", (int64) hist->buckets[i]);
+    }
+    rPutStringToBuf(buf, "]}");
+}
+
+/*
+    Render fiber pool and stack statistics including the recommended stack limits
+ */
+static void putFiberStats(RBuf *buf)
+{
+    size_t initial, limit, adviceInitial, adviceMax;
+    int    active, pooled;
+#if ME_FIBER_STACK_TUNE
+    RFiberStackClass classes[ME_FIBER_STACK_CLASSES], *cp;
+    int              i, count;
+#endif
+
+    rGetFiberStats(&active, NULL, &pooled, NULL, NULL, NULL, NULL);
+    rGetFiberStackLimits(&initial, &limit, NULL, NULL);
+    rGetFiberStackAdvice(&adviceInitial, &adviceMax);
+    rPutToBuf(buf, "\"fibers\":{\"active\":%d,\"pooled\":%d,\"stack\":%lld,\"stackMax\":%lld,"
+              "\"advice\":{\"stack\":%lld,\"stackMax\":%lld},\"procs\":[", active, pooled, (int64) initial,
+              (int64) limit, (int64) adviceInitial, (int64) adviceMax);
+#if ME_FIBER_STACK_TUNE
+    count = rGetFiberStackProfile(classes, ME_FIBER_STACK_CLASSES);
+    for (i = 0; i < count; i++) {
+        cp = &classes[i];
+        rPutToBuf(buf, "%s{\"proc\":\"%p\",\"runs\":%lld,\"samples\":%lld,\"grows\":%lld,\"peak\":%lld,"
+                  "\"size\":%lld}", i ? "," : "", cp->proc, (int64) cp->runs, (int64) cp->samples,
+                  (int64) cp->grows, (int64) cp->peak, (int64) cp->size);
+    }
+#endif
+    rPutStringToBuf(buf, "]}");
+}
+
+/*
+    Action to render the event loop health statistics as JSON. Times are in microseconds.
+    Fiber stack sizes are in bytes. Install via: webAddAction(host, "/api/stats", webEventStatsAction, "admin");
+ */
+PUBLIC void webEventStatsAction(Web *web)
+{
+    REventStats stats;
+    RBuf        *buf;
+
+    rGetEventStats(&stats);
+    buf = rAllocBuf(1024);
+    rPutToBuf(buf, "{\"enabled\":%s,\"iterations\":%lld,\"dispatched\":%lld,\"queued\":%d,\"maxDue\":%d,"
+              "\"slow\":%lld,\"slowThreshold\":%lld,", stats.enabled ? "true" : "false", (int64) stats.iterations,
+              (int64) stats.dispatched, stats.queued, stats.maxDue, (int64) stats.slow, (int64) stats.slowThreshold);
+    putHistogram(buf, "loop", &stats.loop);
+    rPutCharToBuf(buf, ',');
+    putHistogram(buf, "lag", &stats.lag);
+    rPutCharToBuf(buf, ',');
+    putHistogram(buf, "slice", &stats.slice);
+    rPutCharToBuf(buf, ',');
+    putFiberStats(buf);
+    rPutCharToBuf(buf, '}');
+
+    webAddHeaderStaticString(web, "Content-Type", "application/json");
+    webAddHeaderStaticString(web, "Cache-Control", "no-store");
+    webWrite(web, rBufToString(buf), rGetBufLength(buf));
+    webFinalize(web);
+    rFreeBuf(buf);
+}
+#endif
+
+#if ME_R_SPAN
+/*
+    Respond with the recorded trace spans as Chrome trace-event JSON.
+    Install via: webAddAction(host, "/api/spans", webSpansAction, "admin");
+ */
+PUBLIC void webSpansAction(Web *web)
+{
+    char *spans;
+
+    spans = rGetSpans();
+    webAddHeaderStaticString(web, "Content-Type", "application/json");
+    webAddHeaderStaticString(web, "Cache-Control", "no-store");
+    webWrite(web, spans, slen(spans));
+    webFinalize(web);
+    rFree(spans);
+}
+#endif
+
 /*
     Copyright (c) Embedthis Software. All Rights Reserved.
     This is proprietary software and requires a commercial license from the author.
@@ -91,7 +91,7 @@ PUBLIC int ioInitSync(void)
      */
     nextSeq = rand();
     ioto->syncDue = MAXINT64;
-    ioto->syncHash = rAllocHash(0, 0);
+    ioto->syncHash = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE | R_HASH_INCREMENTAL);
     ioto->maxSyncSize = svaluei(jsonGet(ioto->config, 0, "database.maxSyncSize", "1k"));
     if ((lastSync = dbGetField(ioto->db, "SyncState", "lastSync", NULL, DB_PARAMS())) != NULL) {
         ioto->lastSync = sclone(lastSync);
@@ -12,6 +12,12 @@
 
 static cchar *trace;        /* General log trace */
 static cchar *exitEvent;    /* Exit event */
+#if ME_R_PROFILE
+static cchar *cpuProfile;   /* CPU profile output file */
+#endif
+#if ME_R_SPAN
+static cchar *spanPath;     /* Trace span output file */
+#endif
 
 /*
     Default trace filters
@@ -41,6 +47,9 @@ static void showUsage(int line)
             "    --background              # Daemonize and run in the background\n"
             "    --cloud ID                # Cloud ID for self-claiming\n"
             "    --config dir              # Set the directory for config files and ioto.json5\n"
+#if ME_R_PROFILE
+            "    --cpuprofile path         # Sample CPU use and save folded stacks to path on exit\n"
+#endif
             "    --debug                   # Emit debug tracing\n"
             "    --exit event|seconds      # Exit on event or after 'seconds'\n"
             "    --gen                     # Generate a UID \n"
@@ -53,6 +62,9 @@ static void showUsage(int line)
             "    --quiet                   # Run in quiet mode with minimal output\n"
             "    --reset                   # Reset state to factory defaults\n"
             "    --show [HBhb]             # Show request headers/body (HB) and response headers/body (hb).\n"
+#if ME_R_SPAN
+            "    --spans path              # Record trace spans and save to path on exit\n"
+#endif
             "    --state dir               # Set the state directory\n"
             "    --sync up|down|both       # Force a database sync with the cloud\n"
             "    --test suite              # Run Unit test suite in the Unit app (see test.json5)\n"
@@ -106,6 +118,14 @@ PUBLIC int main(int argc, char **argv, char **envp)
             }
             ioto->cmdConfigDir = sclone(argv[++argind]);
 
+#if ME_R_PROFILE
+        } else if (smatch(argp, "--cpuprofile")) {
+            if (argind + 1 >= argc) {
+                usage();
+            }
+            cpuProfile = argv[++argind];
+#endif
+
         } else if (smatch(argp, "--debug") || smatch(argp, "-d")) {
             trace = TRACE_DEBUG_FILTER;
             show = "hH";
@@ -174,6 +194,14 @@ PUBLIC int main(int argc, char **argv, char **envp)
                 show = argv[++argind];
             }
 
+#if ME_R_SPAN
+        } else if (smatch(argp, "--spans")) {
+            if (argind + 1 >= argc) {
+                usage();
+            }
+            spanPath = argv[++argind];
+#endif
+
         } else if (smatch(argp, "--state")) {
             //  Set an alternate state directory
                 if (argind + 1 >= argc) {
@@ -280,12 +308,41 @@ PUBLIC int main(int argc, char **argv, char **envp)
     if (background) {
         rDaemonize();
     }
+#endif
+#if ME_R_PROFILE
+    //  Start after daemonizing as interval timers are not inherited by the child
+    if (cpuProfile && rStartProfile(0, 0) < 0) {
+        rError("app", "Cannot start CPU profiler");
+        exit(1);
+    }
+#endif
+#if ME_R_SPAN
+    if (spanPath && rStartSpans(0, spanPath) < 0) {
+        rError("app", "Cannot start trace spans");
+        exit(1);
+    }
 #endif
     /*
         Service events until instructed to stop. Handles restarts.
      */
     ioRun(ioStart);
 
+#if ME_R_PROFILE
+    if (cpuProfile) {
+        rStopProfile();
+        if (rWriteProfile(cpuProfile, 0) < 0) {
+            rError("app", "Cannot write CPU profile to %s", cpuProfile);
+        }
+    }
+#endif
+#if ME_R_SPAN
+    if (spanPath) {
+        rStopSpans();
+        if (rWriteSpans(spanPath) < 0) {
+            rError("app", "Cannot write trace spans to %s", spanPath);
+        }
+    }
+#endif
     rTerm();
     return 0;
 }
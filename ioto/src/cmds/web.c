@@ -41,6 +41,7 @@ static bool    background;          /* Run as background daemon process */
 static char    *homeDir;            /* Working directory to change to on startup */
 static char    *configPath;         /* Custom path to web.json5 config file */
 static char    *profile;            /* Execution profile (dev, prod) for config selection */
+static cchar   *workers;            /* Worker process count override (count or "auto") */
 
 /*********************************** Forwards *********************************/
 
@@ -70,7 +71,8 @@ static int usage(void)
              "    --timeouts               # Disable timeouts for debugging\n"
              "    --trace file[:type:from] # Trace to file (stdout:all:all)\n"
              "    --verbose                # Verbose operation. Alias for --show Hhb plus module trace.\n"
-             "    --version                # Output version information\n\n");
+             "    --version                # Output version information\n"
+             "    --workers count|auto     # Serve with multiple worker processes\n\n");
     return R_ERR_BAD_ARGS;
 }
 
@@ -87,6 +89,7 @@ int main(int argc, char **argv)
     homeDir = 0;
     configPath = 0;
     profile = 0;
+    workers = 0;
 
     //  Parse command-line arguments
     for (argind = 1; argind < argc; argind++) {
@@ -166,6 +169,12 @@ int main(int argc, char **argv)
             rPrintf("%s\n", ME_VERSION);
             exit(0);
 
+        } else if (smatch(argp, "--workers") || smatch(argp, "-w")) {
+            if (argind + 1 >= argc) {
+                return usage();
+            }
+            workers = argv[++argind];
+
         } else {
             return usage();
         }
@@ -212,6 +221,7 @@ static void start(void)
 {
     cchar  *path;
     size_t stackInitial, stackMax, stackGrow, stackReset;
+    Ticks  slow;
     int    maxFibers, poolMin, poolMax;
 
     //  Load configuration from file or use defaults
@@ -243,11 +253,15 @@ static void start(void)
     stackGrow = (size_t) svalue(jsonGet(config, 0, "limits.fiberStackGrow", "0"));
     stackReset = (size_t) svalue(jsonGet(config, 0, "limits.fiberStackReset", "0"));
     rSetFiberStackLimits(stackInitial, stackMax, stackGrow, stackReset);
+    rSetFiberStackTuning(jsonGetBool(config, 0, "limits.fiberStackTune", 1));
 
     //  Override listen endpoints if specified on command line
     if (endpoint) {
         jsonSetJsonFmt(config, 0, "web", "{listen: ['%s']}", endpoint);
     }
+    if (workers) {
+        jsonSetString(config, 0, "web.workers", workers);
+    }
 
     //  Configure logging based on config or command-line trace
     setLog(config);
@@ -272,6 +286,21 @@ static void start(void)
     webTestInit(host, "/test");
 #endif
 
+    //  Event loop health statistics and slow handler detection (msec)
+    slow = jsonGetNum(config, 0, "limits.slowHandler", 0);
+    path = jsonGet(config, 0, "web.stats", 0);
+    if (path || slow > 0) {
+        rSetEventStats(1, slow);
+    }
+    if (path) {
+        webAddAction(host, path, webEventStatsAction, jsonGet(config, 0, "web.statsRole", "admin"));
+    }
+#if ME_R_SPAN
+    if ((path = jsonGet(config, 0, "web.spans", 0)) != 0) {
+        webAddAction(host, path, webSpansAction, jsonGet(config, 0, "web.spansRole", "admin"));
+    }
+#endif
+
     //  Start listening and accepting connections
     if (webStartHost(host) < 0) {
         rError("web", "Cannot start host");
@@ -64,6 +64,10 @@ PUBLIC int ioInitConfig(void)
     stackGrow = (size_t) svalue(jsonGet(json, 0, "limits.fiberStackGrow", "0"));
     stackReset = (size_t) svalue(jsonGet(json, 0, "limits.fiberStackReset", "0"));
     rSetFiberStackLimits(stackInitial, stackMax, stackGrow, stackReset);
+    rSetFiberStackTuning(jsonGetBool(json, 0, "limits.fiberStackTune", 1));
+
+    //  Periodic per-subsystem memory report via rMetrics. Requires ME_R_MEM_TAGS.
+    rSetMemReport(svalue(jsonGet(json, 0, "limits.memoryReport", "0")) * TPS);
 
 #if SERVICES_CLOUD
     if (ioto->cmdAccount) {
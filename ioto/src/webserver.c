@@ -18,7 +18,8 @@ static int parseShow(cchar *arg);
 PUBLIC int ioInitWeb(void)
 {
     WebHost *webHost;
-    cchar   *webShow;
+    Ticks   slow;
+    cchar   *url, *webShow, *workers;
     char    *path;
 
     webInit();
@@ -36,23 +37,43 @@ PUBLIC int ioInitWeb(void)
 
     webShow = ioto->cmdWebShow ? ioto->cmdWebShow : jsonGet(ioto->config, 0, "log.show", "");
 
+    /*
+        Worker processes fork the entire process. Inside the agent that would duplicate the database journal,
+        MQTT connection, cron and sync timers, so workers are only supported by the standalone web command.
+     */
+    workers = jsonGet(ioto->config, 0, "web.workers", 0);
+    if (workers && !smatch(workers, "1")) {
+        rError("web", "The web.workers setting is not supported when running inside the agent");
+        return R_ERR_BAD_ARGS;
+    }
     if ((webHost = webAllocHost(ioto->config, parseShow(webShow))) == 0) {
         return R_ERR_CANT_INITIALIZE;
     }
 #if SERVICES_DATABASE
-    {
-        cchar *url;
-        if ((url = jsonGet(ioto->config, 0, "web.auth.login", 0)) != 0) {
-            webAddAction(webHost, url, webLoginUser, NULL);
-        }
-        if ((url = jsonGet(ioto->config, 0, "web.auth.logout", 0)) != 0) {
-            webAddAction(webHost, url, webLogoutUser, NULL);
-        }
+    if ((url = jsonGet(ioto->config, 0, "web.auth.login", 0)) != 0) {
+        webAddAction(webHost, url, webLoginUser, NULL);
+    }
+    if ((url = jsonGet(ioto->config, 0, "web.auth.logout", 0)) != 0) {
+        webAddAction(webHost, url, webLogoutUser, NULL);
     }
 #endif
 #if ESP32 || FREERTOS
     webSetHostDefaultIP(webHost, rGetIP());
 #endif
+    //  Event loop health statistics and slow handler detection (msec)
+    slow = jsonGetNum(ioto->config, 0, "limits.slowHandler", 0);
+    url = jsonGet(ioto->config, 0, "web.stats", 0);
+    if (url || slow > 0) {
+        rSetEventStats(1, slow);
+    }
+    if (url) {
+        webAddAction(webHost, url, webEventStatsAction, jsonGet(ioto->config, 0, "web.statsRole", "admin"));
+    }
+#if ME_R_SPAN
+    if ((url = jsonGet(ioto->config, 0, "web.spans", 0)) != 0) {
+        webAddAction(webHost, url, webSpansAction, jsonGet(ioto->config, 0, "web.spansRole", "admin"));
+    }
+#endif
 
     if (webStartHost(webHost) < 0) {
         webFreeHost(webHost);
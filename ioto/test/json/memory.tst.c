@@ -44,6 +44,32 @@ static void jsonMemoryTest()
     jsonFree(clone);
 }
 
+static void jsonInternTest()
+{
+    Json     *a, *b;
+    JsonNode *na, *nb;
+
+    // Cloned property names are interned and shared between objects
+    a = jsonClone(parse("{temperature: 21, humidity: 40}"), 0);
+    b = jsonClone(a, 0);
+    na = jsonGetNode(a, 0, "temperature");
+    nb = jsonGetNode(b, 0, "temperature");
+    ttrue(na && nb);
+    ttrue(na->name == nb->name);
+    ttrue(na->name == rLookupIntern("temperature"));
+    ttrue(!na->allocatedName);
+
+    // Names set via jsonSet are interned too
+    jsonSet(a, 0, "pressure", "1013", 0);
+    jsonSet(b, 0, "pressure", "1020", 0);
+    ttrue(jsonGetNode(a, 0, "pressure")->name == jsonGetNode(b, 0, "pressure")->name);
+    checkValue(a, "pressure", "1013");
+    checkValue(b, "pressure", "1020");
+
+    jsonFree(a);
+    jsonFree(b);
+}
+
 static void jsonLockTest()
 {
     Json    *obj;
@@ -110,6 +136,7 @@ int main(void)
 {
     rInit(0, 0);
     jsonMemoryTest();
+    jsonInternTest();
     jsonLockTest();
     jsonUserFlagsTest();
     rTerm();
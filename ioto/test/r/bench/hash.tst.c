@@ -0,0 +1,361 @@
+/*
+    hash.tst.c - RHash microbenchmarks
+
+    Compares the open-addressing RHash with the previous chained hash design for 16 to 1M keys.
+    The chained hash is reproduced here as a reference. Run manually via "tm bench".
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define MIN_OPS 2000000                 /* Minimum operations per measurement */
+
+/*
+    Reference chained hash. Names are chained through an index array and hash codes are not stored.
+ */
+typedef struct ChainName {
+    char *name;
+    void *value;
+    int next;
+    int used;
+} ChainName;
+
+typedef struct ChainHash {
+    int *buckets;
+    ChainName *names;
+    uint numBuckets;
+    uint size;
+    uint length;
+    int free;
+} ChainHash;
+
+static size_t chainSizes[] = {
+    19, 29, 59, 79, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 0
+};
+
+static char **keys;
+static char **missing;
+
+/************************************ Code ************************************/
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#else
+    return (double) rGetTicks() * 1e6;
+#endif
+}
+
+static void chainGrowNames(ChainHash *hash, size_t size)
+{
+    size_t i;
+
+    if (size < 16) {
+        size = 16;
+    }
+    hash->names = rRealloc(hash->names, size * sizeof(ChainName));
+    memset(&hash->names[hash->size], 0, (size - hash->size) * sizeof(ChainName));
+    for (i = hash->size; i < size; i++) {
+        hash->names[i].next = hash->free;
+        hash->free = (int) i;
+    }
+    hash->size = (uint) size;
+}
+
+static void chainGrowBuckets(ChainHash *hash, size_t size)
+{
+    ChainName *np;
+    size_t    i;
+    uint      bindex;
+
+    for (i = 0; chainSizes[i]; i++) {
+        if (size < chainSizes[i]) {
+            break;
+        }
+    }
+    size = chainSizes[i] ? chainSizes[i] : chainSizes[i - 1];
+    if (hash->numBuckets >= size) {
+        return;
+    }
+    rFree(hash->buckets);
+    hash->buckets = rAlloc(size * sizeof(int));
+    hash->numBuckets = (uint) size;
+    for (i = 0; i < size; i++) {
+        hash->buckets[i] = -1;
+    }
+    for (i = 0; i < hash->size; i++) {
+        np = &hash->names[i];
+        if (np->used) {
+            bindex = shash(np->name, slen(np->name)) % (uint) size;
+            np->next = hash->buckets[bindex];
+            hash->buckets[bindex] = (int) i;
+        }
+    }
+}
+
+static ChainHash *chainAlloc(void)
+{
+    ChainHash *hash;
+
+    hash = rAllocType(ChainHash);
+    hash->free = -1;
+    return hash;
+}
+
+static void chainFree(ChainHash *hash)
+{
+    rFree(hash->buckets);
+    rFree(hash->names);
+    rFree(hash);
+}
+
+static int chainLookup(ChainHash *hash, cchar *name, int *bucket, int *prior)
+{
+    ChainName *np;
+    int       bindex, kindex;
+
+    if (hash->numBuckets == 0) {
+        return -1;
+    }
+    bindex = (int) (shash(name, slen(name)) % hash->numBuckets);
+    if (bucket) {
+        *bucket = bindex;
+    }
+    if (prior) {
+        *prior = -1;
+    }
+    for (kindex = hash->buckets[bindex]; kindex >= 0; kindex = np->next) {
+        np = &hash->names[kindex];
+        if (strcmp(np->name, name) == 0) {
+            return kindex;
+        }
+        if (prior) {
+            *prior = kindex;
+        }
+    }
+    return -1;
+}
+
+static void chainAdd(ChainHash *hash, char *name, void *value)
+{
+    ChainName *np;
+    int       bindex, kindex;
+
+    if (hash->length >= hash->numBuckets) {
+        chainGrowBuckets(hash, hash->length + 1);
+    }
+    if ((kindex = chainLookup(hash, name, &bindex, 0)) < 0) {
+        if (hash->free < 0) {
+            chainGrowNames(hash, hash->size * 3 / 2);
+        }
+        kindex = hash->free;
+        np = &hash->names[kindex];
+        hash->free = np->next;
+        np->next = hash->buckets[bindex];
+        hash->buckets[bindex] = kindex;
+        hash->length++;
+    }
+    np = &hash->names[kindex];
+    np->name = name;
+    np->value = value;
+    np->used = 1;
+}
+
+static void *chainGet(ChainHash *hash, cchar *name)
+{
+    int kindex;
+
+    if ((kindex = chainLookup(hash, name, 0, 0)) < 0) {
+        return 0;
+    }
+    return hash->names[kindex].value;
+}
+
+static void chainRemove(ChainHash *hash, cchar *name)
+{
+    ChainName *np;
+    int       bindex, kindex, prior;
+
+    if ((kindex = chainLookup(hash, name, &bindex, &prior)) < 0) {
+        return;
+    }
+    np = &hash->names[kindex];
+    if (prior >= 0) {
+        hash->names[prior].next = np->next;
+    } else {
+        hash->buckets[bindex] = np->next;
+    }
+    np->used = 0;
+    np->next = hash->free;
+    hash->free = kindex;
+    hash->length--;
+}
+
+/*
+    Time inserting, hit and miss lookups and removal of count keys. Results are in nanoseconds per operation.
+ */
+typedef struct Result {
+    double insert;
+    double hit;
+    double miss;
+    double remove;
+} Result;
+
+static int repeatCount(int count)
+{
+    return max(1, MIN_OPS / count);
+}
+
+static Result benchRHash(int count)
+{
+    Result r;
+    RHash  *hash;
+    double start;
+    int    i, rep, reps;
+    ssize  sum;
+
+    reps = repeatCount(count);
+    sum = 0;
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        hash = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+        for (i = 0; i < count; i++) {
+            rAddName(hash, keys[i], (void*) (ssize) (i + 1), 0);
+        }
+        if (rep < reps - 1) {
+            rFreeHash(hash);
+        }
+    }
+    r.insert = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        for (i = 0; i < count; i++) {
+            sum += (ssize) rLookupName(hash, keys[i]);
+        }
+    }
+    r.hit = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        for (i = 0; i < count; i++) {
+            sum += (ssize) rLookupName(hash, missing[i]);
+        }
+    }
+    r.miss = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (i = 0; i < count; i++) {
+        rRemoveName(hash, keys[i]);
+    }
+    r.remove = (now() - start) / count;
+
+    teqi(rGetHashLength(hash), 0);
+    ttrue(sum == (ssize) reps * ((ssize) count * (count + 1) / 2));
+    rFreeHash(hash);
+    return r;
+}
+
+static Result benchChain(int count)
+{
+    Result    r;
+    ChainHash *hash;
+    double    start;
+    int       i, rep, reps;
+    ssize     sum;
+
+    reps = repeatCount(count);
+    sum = 0;
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        hash = chainAlloc();
+        for (i = 0; i < count; i++) {
+            chainAdd(hash, keys[i], (void*) (ssize) (i + 1));
+        }
+        if (rep < reps - 1) {
+            chainFree(hash);
+        }
+    }
+    r.insert = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        for (i = 0; i < count; i++) {
+            sum += (ssize) chainGet(hash, keys[i]);
+        }
+    }
+    r.hit = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (rep = 0; rep < reps; rep++) {
+        for (i = 0; i < count; i++) {
+            sum += (ssize) chainGet(hash, missing[i]);
+        }
+    }
+    r.miss = (now() - start) / ((double) reps * count);
+
+    start = now();
+    for (i = 0; i < count; i++) {
+        chainRemove(hash, keys[i]);
+    }
+    r.remove = (now() - start) / count;
+
+    teqi(hash->length, 0);
+    ttrue(sum == (ssize) reps * ((ssize) count * (count + 1) / 2));
+    chainFree(hash);
+    return r;
+}
+
+static void benchHash(void)
+{
+    Result rh, ch;
+    int    count, i, max;
+
+    max = 1024 * 1024;
+    keys = rAlloc(sizeof(char*) * (size_t) max);
+    missing = rAlloc(sizeof(char*) * (size_t) max);
+    for (i = 0; i < max; i++) {
+        keys[i] = sfmt("/api/v1/resource/%d/name", i);
+        missing[i] = sfmt("/api/v1/missing/%d/name", i);
+    }
+    printf("\nRHash microbenchmark (ns/op): open-addressing vs chained\n\n");
+    printf("%8s  %-8s %9s %9s %9s %9s\n", "keys", "table", "insert", "hit", "miss", "remove");
+    for (count = 16; count <= max; count *= 4) {
+        ch = benchChain(count);
+        rh = benchRHash(count);
+        printf("%8d  %-8s %9.1f %9.1f %9.1f %9.1f\n", count, "chained", ch.insert, ch.hit, ch.miss, ch.remove);
+        printf("%8s  %-8s %9.1f %9.1f %9.1f %9.1f\n", "", "rhash", rh.insert, rh.hit, rh.miss, rh.remove);
+    }
+    printf("\n");
+    for (i = 0; i < max; i++) {
+        rFree(keys[i]);
+        rFree(missing[i]);
+    }
+    rFree(keys);
+    rFree(missing);
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    benchHash();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
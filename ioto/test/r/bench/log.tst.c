@@ -0,0 +1,137 @@
+/*
+    log.tst.c - Logging microbenchmarks
+
+    Measures the per-line cost of formatting and emitting log messages with the default and syslog
+    formats, and the cost of filtered (disabled) log statements. Output is written to /dev/null.
+    Run manually via "tm bench".
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define LOG_LINES 1000000               /* Lines per measurement */
+
+/************************************ Code ************************************/
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#else
+    return (double) rGetTicks() * 1e6;
+#endif
+}
+
+/*
+    Time rFormatLog for a format in nanoseconds per line
+ */
+static double timeFormat(cchar *format)
+{
+    RBuf   *buf;
+    double start;
+    int    i;
+
+    buf = rAllocBuf(ME_MAX_LOG_LINE);
+    rSetLogFormat(format, 1);
+    start = now();
+    for (i = 0; i < LOG_LINES; i++) {
+        rFormatLog(buf, "trace", "bench", "GET /api/status HTTP/1.1 200");
+    }
+    rFreeBuf(buf);
+    return (now() - start) / LOG_LINES;
+}
+
+/*
+    Time rLog with formatting arguments in nanoseconds per line
+ */
+static double timeEmit(cchar *format)
+{
+    double start;
+    int    i;
+
+    rSetLogFormat(format, 1);
+    start = now();
+    for (i = 0; i < LOG_LINES; i++) {
+        rTrace("bench", "Request %d from %s, status %d", i, "192.168.1.10", 200);
+    }
+    return (now() - start) / LOG_LINES;
+}
+
+static void benchLog(void)
+{
+    cchar *formats[] = { R_LOG_FORMAT, R_LOG_SYSLOG, NULL };
+    int   i;
+
+    rSetLog("/dev/null:raw,error,info,trace:all", 0, 1);
+    printf("\nLog microbenchmark (ns/line)\n\n");
+    printf("%-28s %10s %10s\n", "format", "rFormatLog", "rTrace");
+    for (i = 0; formats[i]; i++) {
+        printf("%-28s %10.1f %10.1f\n", formats[i], timeFormat(formats[i]), timeEmit(formats[i]));
+    }
+    printf("\n");
+}
+
+/*
+    Time disabled log statements in nanoseconds per call
+ */
+static void benchFilter(void)
+{
+    double start, elapsed;
+    cchar  *source;
+    int    i, count;
+
+    rSetLog("/dev/null:error:all,!web", 0, 1);
+    printf("Log filter microbenchmark (ns/call)\n\n");
+
+    count = 0;
+    start = now();
+    for (i = 0; i < LOG_LINES * 10; i++) {
+        count += rEmitLog("trace", "bench");
+    }
+    elapsed = now() - start;
+    teqi(count, 0);
+    printf("%-36s %8.2f\n", "rEmitLog(trace, bench)", elapsed / (LOG_LINES * 10));
+
+    start = now();
+    for (i = 0; i < LOG_LINES * 10; i++) {
+        rTrace("bench", "Request %d from %s", i, "192.168.1.10");
+    }
+    printf("%-36s %8.2f\n", "rTrace disabled type", (now() - start) / (LOG_LINES * 10));
+
+    start = now();
+    for (i = 0; i < LOG_LINES * 10; i++) {
+        rError("web", "Request %d from %s", i, "192.168.1.10");
+    }
+    printf("%-36s %8.2f\n", "rError disabled source", (now() - start) / (LOG_LINES * 10));
+
+    //  A variable source is not cached per call site
+    source = rGetAppName() ? "bench" : "other";
+    start = now();
+    for (i = 0; i < LOG_LINES * 10; i++) {
+        rTrace(source, "Request %d from %s", i, "192.168.1.10");
+    }
+    printf("%-36s %8.2f\n\n", "rTrace disabled, variable source", (now() - start) / (LOG_LINES * 10));
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    benchLog();
+    benchFilter();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
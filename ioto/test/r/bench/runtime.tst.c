@@ -0,0 +1,838 @@
+/*
+    runtime.tst.c - Runtime primitive microbenchmarks with baseline comparison
+
+    Measures throughput and latency percentiles for RHash, rbtree, RBuf, formatting, events, fibers and the
+    string routines. Each benchmark runs for a share of the total duration set via "tm --duration SECS".
+    Latencies are per-operation averages of each timed sample batch.
+
+    Results are saved to "latest.json" (or $TESTME_REPORT.json). If "baseline.json" exists (or $BENCH_BASELINE),
+    the results are compared and a benchmark fails if its median latency grows by more than BENCH_THRESHOLD
+    percent (or $BENCH_THRESHOLD). The median is used as it is robust to scheduling noise. To accept the
+    current results as the baseline:
+
+        cp latest.json baseline.json
+
+    Baselines are only compared for the same platform and build profile. Run manually via "tm bench".
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+#include    "json.h"
+
+/*********************************** Locals ***********************************/
+
+#define BENCH_DURATION    (20 * TPS)    /* Default total duration */
+#define BENCH_MIN_SAMPLES 10            /* Minimum samples per benchmark */
+#define BENCH_MAX_SAMPLES 10000         /* Maximum samples per benchmark */
+#define BENCH_THRESHOLD   20            /* Median latency regression threshold (percent) */
+#define BATCH             1000          /* Operations per sample for constant time operations */
+#define FIBER_BATCH       100           /* Operations per sample for fiber operations */
+#define MAX_KEYS          (64 * 1024)
+
+struct Bench;
+typedef void (*BenchProc)(struct Bench *bp);
+
+typedef struct Bench {
+    cchar *group;                       /* Benchmark group */
+    cchar *name;                        /* Benchmark name within the group */
+    BenchProc proc;                     /* Run one sample */
+    int size;                           /* Working set size */
+    double start;                       /* Start of the current sample (nsec) */
+    double elapsed;                     /* Total timed nsec */
+    int64 ops;                          /* Total timed operations */
+    double *samples;                    /* Nsec per operation for each sample */
+    int count;                          /* Number of samples */
+    double opsPerSec;
+    double p50;
+    double p95;
+    double p99;
+} Bench;
+
+typedef struct Item {
+    cchar *key;
+} Item;
+
+static char  **keys;
+static Item  *items;
+static int   fired;
+
+static void benchHashInsert(Bench *bp);
+static void benchHashLookup(Bench *bp);
+static void benchHashRemove(Bench *bp);
+static void benchRbInsert(Bench *bp);
+static void benchRbLookup(Bench *bp);
+static void benchRbWalk(Bench *bp);
+static void benchBufPut(Bench *bp);
+static void benchBufGrow(Bench *bp);
+static void benchBufCompact(Bench *bp);
+static void benchFmtInt(Bench *bp);
+static void benchFmtFloat(Bench *bp);
+static void benchFmtShortest(Bench *bp);
+static void benchFmtString(Bench *bp);
+static void benchPutInt(Bench *bp);
+static void benchPutDouble(Bench *bp);
+static void benchSfmt(Bench *bp);
+static void benchEventCancel(Bench *bp);
+static void benchEventFire(Bench *bp);
+static void benchFiberSpawn(Bench *bp);
+static void benchFiberSwitch(Bench *bp);
+static void benchSclone(Bench *bp);
+static void benchSmatch(Bench *bp);
+static void benchScontains(Bench *bp);
+static void benchStok(Bench *bp);
+static void benchSreplace(Bench *bp);
+static void benchSjoin(Bench *bp);
+static void benchStoi(Bench *bp);
+
+static Bench benches[] = {
+    { "hash", "insert-16", benchHashInsert, 16 },
+    { "hash", "insert-1K", benchHashInsert, 1024 },
+    { "hash", "insert-64K", benchHashInsert, MAX_KEYS },
+    { "hash", "lookup-16", benchHashLookup, 16 },
+    { "hash", "lookup-1K", benchHashLookup, 1024 },
+    { "hash", "lookup-64K", benchHashLookup, MAX_KEYS },
+    { "hash", "remove-16", benchHashRemove, 16 },
+    { "hash", "remove-1K", benchHashRemove, 1024 },
+    { "hash", "remove-64K", benchHashRemove, MAX_KEYS },
+    { "rb", "insert-1K", benchRbInsert, 1024 },
+    { "rb", "insert-64K", benchRbInsert, MAX_KEYS },
+    { "rb", "lookup-1K", benchRbLookup, 1024 },
+    { "rb", "lookup-64K", benchRbLookup, MAX_KEYS },
+    { "rb", "walk-64K", benchRbWalk, MAX_KEYS },
+    { "buf", "put", benchBufPut, BATCH },
+    { "buf", "grow", benchBufGrow, BATCH },
+    { "buf", "compact", benchBufCompact, BATCH },
+    { "fmt", "int", benchFmtInt, BATCH },
+    { "fmt", "float", benchFmtFloat, BATCH },
+    { "fmt", "shortest", benchFmtShortest, BATCH },
+    { "fmt", "string", benchFmtString, BATCH },
+    { "fmt", "sfmt", benchSfmt, BATCH },
+    { "fmt", "put-int", benchPutInt, BATCH },
+    { "fmt", "put-double", benchPutDouble, BATCH },
+    { "event", "schedule-cancel", benchEventCancel, BATCH },
+    { "event", "fire", benchEventFire, FIBER_BATCH },
+    { "fiber", "spawn", benchFiberSpawn, FIBER_BATCH },
+    { "fiber", "switch", benchFiberSwitch, BATCH },
+    { "string", "sclone", benchSclone, BATCH },
+    { "string", "smatch", benchSmatch, BATCH },
+    { "string", "scontains", benchScontains, BATCH },
+    { "string", "stok", benchStok, BATCH },
+    { "string", "sreplace", benchSreplace, BATCH },
+    { "string", "sjoin", benchSjoin, BATCH },
+    { "string", "stoi", benchStoi, BATCH },
+};
+
+#define NUM_BENCHES ((int) (sizeof(benches) / sizeof(benches[0])))
+
+static cchar *TEXT = "GET /api/v1/device/status?verbose=1 HTTP/1.1\r\nHost: localhost\r\nAccept: application/json\r\n"
+                     "User-Agent: ioto-bench/1.0\r\nConnection: keep-alive\r\nContent-Type: application/json\r\n";
+
+/************************************ Code ************************************/
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#else
+    return (double) rGetTicks() * 1e6;
+#endif
+}
+
+static void startTimer(Bench *bp)
+{
+    bp->start = now();
+}
+
+static void stopTimer(Bench *bp, int64 ops)
+{
+    double elapsed;
+
+    elapsed = now() - bp->start;
+    bp->elapsed += elapsed;
+    bp->ops += ops;
+    if (bp->count < BENCH_MAX_SAMPLES) {
+        bp->samples[bp->count++] = elapsed / (double) ops;
+    }
+}
+
+/*
+    Hash benchmarks. Lookup and remove tables are built outside the timed region.
+ */
+static RHash *buildHash(int size)
+{
+    RHash *hash;
+    int   i;
+
+    hash = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    for (i = 0; i < size; i++) {
+        rAddName(hash, keys[i], keys[i], 0);
+    }
+    return hash;
+}
+
+static void benchHashInsert(Bench *bp)
+{
+    RHash *hash;
+    int   i;
+
+    hash = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rAddName(hash, keys[i], keys[i], 0);
+    }
+    stopTimer(bp, bp->size);
+    rFreeHash(hash);
+}
+
+static void benchHashLookup(Bench *bp)
+{
+    RHash *hash;
+    int   i, rep, reps, found;
+
+    hash = buildHash(bp->size);
+    reps = max(1, BATCH * 10 / bp->size);
+    found = 0;
+    startTimer(bp);
+    for (rep = 0; rep < reps; rep++) {
+        for (i = 0; i < bp->size; i++) {
+            found += rLookupName(hash, keys[i]) != 0;
+        }
+    }
+    stopTimer(bp, (int64) reps * bp->size);
+    teqi(found, reps * bp->size);
+    rFreeHash(hash);
+}
+
+static void benchHashRemove(Bench *bp)
+{
+    RHash *hash;
+    int   i;
+
+    hash = buildHash(bp->size);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rRemoveName(hash, keys[i]);
+    }
+    stopTimer(bp, bp->size);
+    teqi(rGetHashLength(hash), 0);
+    rFreeHash(hash);
+}
+
+/*
+    Red/black tree benchmarks
+ */
+static int compareItems(cvoid *n1, cvoid *n2, cvoid *ctx)
+{
+    return strcmp(((Item*) n1)->key, ((Item*) n2)->key);
+}
+
+static RbTree *buildTree(int size)
+{
+    RbTree *rbt;
+    int    i;
+
+    rbt = rbAlloc(0, compareItems, NULL, NULL);
+    for (i = 0; i < size; i++) {
+        rbInsert(rbt, &items[i]);
+    }
+    return rbt;
+}
+
+static void benchRbInsert(Bench *bp)
+{
+    RbTree *rbt;
+    int    i;
+
+    rbt = rbAlloc(0, compareItems, NULL, NULL);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rbInsert(rbt, &items[i]);
+    }
+    stopTimer(bp, bp->size);
+    rbFree(rbt);
+}
+
+static void benchRbLookup(Bench *bp)
+{
+    RbTree *rbt;
+    int    i, found;
+
+    rbt = buildTree(bp->size);
+    found = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        found += rbLookup(rbt, &items[i], NULL) != 0;
+    }
+    stopTimer(bp, bp->size);
+    teqi(found, bp->size);
+    rbFree(rbt);
+}
+
+static void benchRbWalk(Bench *bp)
+{
+    RbTree *rbt;
+    RbNode *node;
+    int    count;
+
+    rbt = buildTree(bp->size);
+    count = 0;
+    startTimer(bp);
+    for (ITERATE_TREE(rbt, node)) {
+        count++;
+    }
+    stopTimer(bp, bp->size);
+    teqi(count, bp->size);
+    rbFree(rbt);
+}
+
+/*
+    Buffer benchmarks. Each operation puts a 64 byte block.
+ */
+static void benchBufPut(Bench *bp)
+{
+    RBuf *buf;
+    int  i;
+
+    buf = rAllocBuf((size_t) bp->size * 64 + 1);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rPutBlockToBuf(buf, TEXT, 64);
+    }
+    stopTimer(bp, bp->size);
+    teqz(rGetBufLength(buf), (size_t) bp->size * 64);
+    rFreeBuf(buf);
+}
+
+static void benchBufGrow(Bench *bp)
+{
+    RBuf *buf;
+    int  i;
+
+    buf = rAllocBuf(16);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rPutBlockToBuf(buf, TEXT, 64);
+    }
+    stopTimer(bp, bp->size);
+    teqz(rGetBufLength(buf), (size_t) bp->size * 64);
+    rFreeBuf(buf);
+}
+
+static void benchBufCompact(Bench *bp)
+{
+    RBuf *buf;
+    int  i;
+
+    buf = rAllocBuf(4096);
+    rPutBlockToBuf(buf, TEXT, 64);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rPutBlockToBuf(buf, TEXT, 64);
+        rAdjustBufStart(buf, 64);
+        rCompactBuf(buf);
+    }
+    stopTimer(bp, bp->size);
+    teqz(rGetBufLength(buf), 64);
+    rFreeBuf(buf);
+}
+
+/*
+    Formatting benchmarks
+ */
+static void benchFmtInt(Bench *bp)
+{
+    char  buf[64];
+    int64 len;
+    int   i;
+
+    len = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        len += rSnprintf(buf, sizeof(buf), "%d", i * 7919);
+    }
+    stopTimer(bp, bp->size);
+    ttrue(len > 0);
+}
+
+static void benchFmtFloat(Bench *bp)
+{
+    char  buf[64];
+    int64 len;
+    int   i;
+
+    len = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        len += rSnprintf(buf, sizeof(buf), "%.3f", (double) i * 1.618);
+    }
+    stopTimer(bp, bp->size);
+    ttrue(len > 0);
+}
+
+static void benchFmtShortest(Bench *bp)
+{
+    char  buf[64];
+    int64 len;
+    int   i;
+
+    len = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        len += rSnprintf(buf, sizeof(buf), "%g", (double) i / 7.0);
+    }
+    stopTimer(bp, bp->size);
+    ttrue(len > 0);
+}
+
+static void benchFmtString(Bench *bp)
+{
+    char  buf[128];
+    int64 len;
+    int   i;
+
+    len = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        len += rSnprintf(buf, sizeof(buf), "%s: %s", "Content-Type", "application/json");
+    }
+    stopTimer(bp, bp->size);
+    ttrue(len > 0);
+}
+
+static void benchSfmt(Bench *bp)
+{
+    char *str;
+    int  i;
+
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        str = sfmt("%s/%d?q=%.2f", "/api/v1/device", i, (double) i / 3.0);
+        rFree(str);
+    }
+    stopTimer(bp, bp->size);
+}
+
+/*
+    Append numbers to a buffer without parsing a format. Compare with fmt/int and fmt/shortest.
+ */
+static void benchPutInt(Bench *bp)
+{
+    RBuf *buf;
+    int  i;
+
+    buf = rAllocBuf(bp->size * 12);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rPutIntToBuf(buf, i * 7919);
+    }
+    stopTimer(bp, bp->size);
+    ttrue(rGetBufLength(buf) > 0);
+    rFreeBuf(buf);
+}
+
+static void benchPutDouble(Bench *bp)
+{
+    RBuf *buf;
+    int  i;
+
+    buf = rAllocBuf(bp->size * 24);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rPutDoubleToBuf(buf, (double) i / 7.0);
+    }
+    stopTimer(bp, bp->size);
+    ttrue(rGetBufLength(buf) > 0);
+    rFreeBuf(buf);
+}
+
+/*
+    Event benchmarks
+ */
+static void eventProc(void *data)
+{
+    fired++;
+}
+
+static void benchEventCancel(Bench *bp)
+{
+    REvent id;
+    int    i;
+
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        id = rStartEvent(eventProc, NULL, 60 * TPS);
+        rStopEvent(id);
+    }
+    stopTimer(bp, bp->size);
+}
+
+/*
+    Time scheduling and running events. Each event runs on a fiber.
+ */
+static void benchEventFire(Bench *bp)
+{
+    int i;
+
+    fired = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rStartEvent(eventProc, NULL, 0);
+    }
+    while (fired < bp->size) {
+        rRunEvents();
+    }
+    stopTimer(bp, bp->size);
+}
+
+/*
+    Fiber benchmarks
+ */
+static void fiberProc(void *data)
+{
+    fired++;
+}
+
+static void switchProc(void *data)
+{
+    while (rYieldFiber(0) == 0) {
+    }
+}
+
+/*
+    Time allocating a fiber and running it to completion
+ */
+static void benchFiberSpawn(Bench *bp)
+{
+    int i;
+
+    fired = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rResumeFiber(rAllocFiber("bench", fiberProc, NULL), 0);
+    }
+    stopTimer(bp, bp->size);
+    teqi(fired, bp->size);
+}
+
+/*
+    Time a resume and yield round trip
+ */
+static void benchFiberSwitch(Bench *bp)
+{
+    RFiber *fiber;
+    int    i;
+
+    fiber = rAllocFiber("bench", switchProc, NULL);
+    rResumeFiber(fiber, 0);
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rResumeFiber(fiber, 0);
+    }
+    stopTimer(bp, bp->size);
+    rResumeFiber(fiber, (void*) 1);
+}
+
+/*
+    String benchmarks
+ */
+static void benchSclone(Bench *bp)
+{
+    int i;
+
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rFree(sclone(keys[i]));
+    }
+    stopTimer(bp, bp->size);
+}
+
+static void benchSmatch(Bench *bp)
+{
+    int i, count;
+
+    count = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        count += smatch(keys[i], keys[i + 1]);
+    }
+    stopTimer(bp, bp->size);
+    teqi(count, 0);
+}
+
+static void benchScontains(Bench *bp)
+{
+    int i, count;
+
+    count = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        count += scontains(TEXT, "Content-Type") != 0;
+    }
+    stopTimer(bp, bp->size);
+    teqi(count, bp->size);
+}
+
+static void benchStok(Bench *bp)
+{
+    char copy[256], *tok, *last;
+    int  i, count;
+
+    count = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        scopy(copy, sizeof(copy), "alpha, beta, gamma, delta, epsilon, zeta, eta, theta");
+        for (tok = stok(copy, ", ", &last); tok; tok = stok(NULL, ", ", &last)) {
+            count++;
+        }
+    }
+    stopTimer(bp, bp->size);
+    teqi(count, bp->size * 8);
+}
+
+static void benchSreplace(Bench *bp)
+{
+    int i;
+
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rFree(sreplace(TEXT, "\r\n", "\n"));
+    }
+    stopTimer(bp, bp->size);
+}
+
+static void benchSjoin(Bench *bp)
+{
+    int i;
+
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        rFree(sjoin("/api/v1/", keys[i], "/status", NULL));
+    }
+    stopTimer(bp, bp->size);
+}
+
+static void benchStoi(Bench *bp)
+{
+    int64 sum;
+    int   i;
+
+    sum = 0;
+    startTimer(bp);
+    for (i = 0; i < bp->size; i++) {
+        sum += stoi("1234567890");
+    }
+    stopTimer(bp, bp->size);
+    teqz(sum, (int64) bp->size * 1234567890);
+}
+
+/*
+    Run a benchmark for its share of the duration and compute the statistics
+ */
+static int compareSamples(cvoid *p1, cvoid *p2, void *ctx)
+{
+    double d1, d2;
+
+    d1 = *(double*) p1;
+    d2 = *(double*) p2;
+    return d1 < d2 ? -1 : (d1 > d2 ? 1 : 0);
+}
+
+static double percentile(Bench *bp, int pc)
+{
+    int index;
+
+    index = (bp->count * pc + 99) / 100 - 1;
+    return bp->samples[max(0, min(index, bp->count - 1))];
+}
+
+static void runBench(Bench *bp, Ticks duration)
+{
+    Ticks deadline;
+
+    bp->samples = rAlloc(sizeof(double) * BENCH_MAX_SAMPLES);
+    deadline = rGetTicks() + duration;
+
+    //  Warm caches, pools and the fiber stack advice before measuring
+    bp->proc(bp);
+    bp->count = 0;
+    bp->ops = 0;
+    bp->elapsed = 0;
+
+    do {
+        bp->proc(bp);
+    } while (bp->count < BENCH_MIN_SAMPLES || (rGetTicks() < deadline && bp->count < BENCH_MAX_SAMPLES));
+
+    rSort(bp->samples, bp->count, sizeof(double), compareSamples, NULL);
+    bp->opsPerSec = bp->elapsed > 0 ? (double) bp->ops * 1e9 / bp->elapsed : 0;
+    bp->p50 = percentile(bp, 50);
+    bp->p95 = percentile(bp, 95);
+    bp->p99 = percentile(bp, 99);
+    rFree(bp->samples);
+    bp->samples = 0;
+}
+
+static cchar *getProfile(void)
+{
+#if ME_DEBUG
+    return "debug";
+#else
+    return "release";
+#endif
+}
+
+static cchar *getPlatform(void)
+{
+    cchar *platform;
+
+    if ((platform = getenv("PLATFORM")) != 0) {
+        return platform;
+    }
+#if MACOSX
+    return "macosx";
+#elif LINUX
+    return "linux";
+#elif WINDOWS
+    return "windows";
+#else
+    return "unknown";
+#endif
+}
+
+static void saveResults(cchar *path)
+{
+    Json  *json;
+    Bench *bp;
+    char  key[80];
+    int   i;
+
+    json = jsonAlloc();
+    jsonSetString(json, 0, "platform", getPlatform());
+    jsonSetString(json, 0, "profile", getProfile());
+    jsonSetDate(json, 0, "timestamp", rGetTime());
+    for (i = 0; i < NUM_BENCHES; i++) {
+        bp = &benches[i];
+        sfmtbuf(key, sizeof(key), "results.%s.%s", bp->group, bp->name);
+        jsonSetJsonFmt(json, 0, key, "{opsPerSec: %.0f, p50: %.2f, p95: %.2f, p99: %.2f, samples: %d}",
+                       bp->opsPerSec, bp->p50, bp->p95, bp->p99, bp->count);
+    }
+    teqi(jsonSave(json, 0, NULL, path, 0644, JSON_JSON | JSON_MULTILINE), 0);
+    jsonFree(json);
+    tinfo("Results saved to %s", path);
+}
+
+/*
+    Fail benchmarks whose median latency regressed beyond the threshold
+ */
+static void compareBaseline(cchar *path, int threshold)
+{
+    Json   *baseline;
+    Bench  *bp;
+    char   key[80], *errorMsg;
+    double base, change;
+    int    i, regressions;
+
+    if (!rFileExists(path)) {
+        tinfo("No baseline at %s. To set: cp latest.json %s", path, path);
+        return;
+    }
+    if ((baseline = jsonParseFile(path, &errorMsg, 0)) == 0) {
+        tfail("Cannot parse baseline %s: %s", path, errorMsg);
+        rFree(errorMsg);
+        return;
+    }
+    if (!smatch(jsonGet(baseline, 0, "platform", 0), getPlatform()) ||
+        !smatch(jsonGet(baseline, 0, "profile", 0), getProfile())) {
+        tinfo("Baseline %s is for a different platform or profile, skipping comparison", path);
+        jsonFree(baseline);
+        return;
+    }
+    printf("\nComparison with %s (threshold %d%%)\n\n", path, threshold);
+    printf("%-8s %-16s %12s %12s %9s\n", "group", "benchmark", "base p50 ns", "p50 ns", "change");
+    regressions = 0;
+    for (i = 0; i < NUM_BENCHES; i++) {
+        bp = &benches[i];
+        sfmtbuf(key, sizeof(key), "results.%s.%s.p50", bp->group, bp->name);
+        if ((base = jsonGetDouble(baseline, 0, key, 0)) <= 0) {
+            continue;
+        }
+        change = (bp->p50 - base) * 100 / base;
+        printf("%-8s %-16s %12.1f %12.1f %+8.1f%%%s\n", bp->group, bp->name, base, bp->p50, change,
+               change > threshold ? "  REGRESSED" : "");
+        if (change > threshold) {
+            regressions++;
+        }
+        ttrue(change <= threshold, "%s/%s regressed %.1f%% (p50 %.1f vs %.1f nsec)",
+              bp->group, bp->name, change, bp->p50, base);
+    }
+    printf("\n");
+    tinfo("%d regressions", regressions);
+    jsonFree(baseline);
+}
+
+static void benchRuntime(void)
+{
+    Bench *bp;
+    Ticks duration;
+    cchar *env;
+    char  *path;
+    int   i, threshold;
+
+    duration = BENCH_DURATION;
+    if ((env = getenv("TESTME_DURATION")) != 0 && atoi(env) > 0) {
+        duration = atoi(env) * TPS;
+    }
+    threshold = BENCH_THRESHOLD;
+    if ((env = getenv("BENCH_THRESHOLD")) != 0 && atoi(env) > 0) {
+        threshold = atoi(env);
+    }
+    keys = rAlloc(sizeof(char*) * (MAX_KEYS + 1));
+    items = rAlloc(sizeof(Item) * MAX_KEYS);
+    for (i = 0; i <= MAX_KEYS; i++) {
+        keys[i] = sfmt("/api/v1/resource/%d/name", i);
+        if (i < MAX_KEYS) {
+            items[i].key = keys[i];
+        }
+    }
+    printf("\nRuntime microbenchmarks (%s, %lld secs)\n\n", getProfile(), (int64) (duration / TPS));
+    printf("%-8s %-16s %14s %10s %10s %10s %8s\n", "group", "benchmark", "ops/sec", "p50 ns", "p95 ns", "p99 ns",
+           "samples");
+    for (i = 0; i < NUM_BENCHES; i++) {
+        bp = &benches[i];
+        runBench(bp, max(duration / NUM_BENCHES, 1));
+        printf("%-8s %-16s %14.0f %10.1f %10.1f %10.1f %8d\n", bp->group, bp->name, bp->opsPerSec,
+               bp->p50, bp->p95, bp->p99, bp->count);
+    }
+    env = getenv("TESTME_REPORT");
+    path = sfmt("%s.json", env && *env ? env : "latest");
+    saveResults(path);
+    rFree(path);
+
+    env = getenv("BENCH_BASELINE");
+    compareBaseline(env && *env ? env : "baseline.json", threshold);
+
+    for (i = 0; i <= MAX_KEYS; i++) {
+        rFree(keys[i]);
+    }
+    rFree(keys);
+    rFree(items);
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    benchRuntime();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
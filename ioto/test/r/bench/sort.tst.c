@@ -0,0 +1,251 @@
+/*
+    sort.tst.c - rSort and rSortList microbenchmarks
+
+    Compares rSort with the previous first-element pivot quicksort and the C library qsort on sorted,
+    reversed, random and duplicate-heavy input. The previous quicksort is reproduced here as a reference
+    and is skipped where it would go quadratic. Run manually via "tm bench".
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define MIN_ITEMS   1000000             /* Minimum items sorted per measurement */
+#define REF_LIMIT   20000               /* Largest sorted input for the reference quicksort */
+
+static cchar *patterns[] = { "sorted", "reversed", "random", "dups", NULL };
+
+/************************************ Code ************************************/
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#else
+    return (double) rGetTicks() * 1e6;
+#endif
+}
+
+static int compareInt(cvoid *p1, cvoid *p2, void *ctx)
+{
+    int a = *(int*) p1, b = *(int*) p2;
+
+    return (a > b) - (a < b);
+}
+
+static int compareQsort(cvoid *p1, cvoid *p2)
+{
+    return compareInt(p1, p2, 0);
+}
+
+static int compareString(cvoid *p1, cvoid *p2, void *ctx)
+{
+    return strcmp(*(char**) p1, *(char**) p2);
+}
+
+/*
+    Reference: the previous rSort quicksort
+ */
+static void refSwap(char *a, char *b, int width)
+{
+    char tmp;
+
+    if (a == b) {
+        return;
+    }
+    while (width--) {
+        tmp = *a;
+        *a++ = *b;
+        *b++ = tmp;
+    }
+}
+
+static void refSort(void *base, int nelt, int esize, RSortProc cmp, void *ctx)
+{
+    char *array, *pivot, *left, *right, *end;
+
+    if (nelt < 2 || esize <= 0) {
+        return;
+    }
+    array = base;
+    end = array + (nelt * esize);
+    left = array;
+    right = array + ((nelt - 1) * esize);
+    pivot = array;
+
+    while (left < right) {
+        while (left < end && cmp(left, pivot, ctx) <= 0) {
+            left += esize;
+        }
+        while (right > array && cmp(right, pivot, ctx) > 0) {
+            right -= esize;
+        }
+        if (left < right) {
+            refSwap(left, right, esize);
+        }
+    }
+    refSwap(pivot, right, esize);
+    refSort(array, (int) ((right - array) / esize), esize, cmp, ctx);
+    refSort(left, nelt - (int) ((left - array) / esize), esize, cmp, ctx);
+}
+
+static void fill(int *values, int n, int pattern)
+{
+    int i;
+
+    srand(42);
+    for (i = 0; i < n; i++) {
+        switch (pattern) {
+        case 0:
+            values[i] = i;
+            break;
+        case 1:
+            values[i] = n - i;
+            break;
+        case 2:
+            values[i] = rand();
+            break;
+        default:
+            values[i] = rand() % 16;
+            break;
+        }
+    }
+}
+
+/*
+    Time sorting n integers with the given engine (0: reference, 1: rSort, 2: qsort) in nanoseconds per item
+ */
+static double timeSort(int engine, int n, int pattern, int *values, int *work)
+{
+    double start, elapsed;
+    int    i, rep, reps;
+
+    reps = max(1, MIN_ITEMS / n);
+    fill(values, n, pattern);
+    elapsed = 0;
+    for (rep = 0; rep < reps; rep++) {
+        memcpy(work, values, sizeof(int) * (size_t) n);
+        start = now();
+        if (engine == 0) {
+            refSort(work, n, sizeof(int), compareInt, 0);
+        } else if (engine == 1) {
+            rSort(work, n, sizeof(int), compareInt, 0);
+        } else {
+            qsort(work, (size_t) n, sizeof(int), compareQsort);
+        }
+        elapsed += now() - start;
+    }
+    for (i = 1; i < n; i++) {
+        if (work[i - 1] > work[i]) {
+            break;
+        }
+    }
+    teqi(i, n);
+    return elapsed / ((double) reps * n);
+}
+
+static void benchIntegers(void)
+{
+    cchar *pattern;
+    int   *values, *work, n, p;
+    char  ref[32];
+
+    printf("\nrSort microbenchmark (ns/item): 4-byte integers\n\n");
+    printf("%8s  %-9s %10s %10s %10s\n", "items", "input", "previous", "rSort", "qsort");
+    for (n = 1000; n <= 1000000; n *= 10) {
+        values = rAlloc(sizeof(int) * (size_t) n);
+        work = rAlloc(sizeof(int) * (size_t) n);
+        for (p = 0; (pattern = patterns[p]) != 0; p++) {
+            if (p < 2 && n > REF_LIMIT) {
+                scopy(ref, sizeof(ref), "-");
+            } else {
+                SFMT(ref, "%.1f", timeSort(0, n, p, values, work));
+            }
+            printf("%8d  %-9s %10s %10.1f %10.1f\n", n, pattern, ref,
+                   timeSort(1, n, p, values, work), timeSort(2, n, p, values, work));
+        }
+        rFree(values);
+        rFree(work);
+    }
+}
+
+/*
+    Compare the rSortList radix path with a comparison sort of the same strings
+ */
+static void benchStrings(void)
+{
+    RList  *list;
+    char   **keys, **sorted;
+    double start, radix, compare;
+    int    i, n, p;
+
+    printf("\nrSortList microbenchmark (ns/item): strings\n\n");
+    printf("%8s  %-9s %10s %10s\n", "items", "input", "compare", "radix");
+    for (n = 1000; n <= 1000000; n *= 10) {
+        keys = rAlloc(sizeof(char*) * (size_t) n);
+        sorted = rAlloc(sizeof(char*) * (size_t) n);
+        list = rAllocList(n, 0);
+        for (p = 0; patterns[p]; p++) {
+            srand(42);
+            for (i = 0; i < n; i++) {
+                if (p == 0) {
+                    keys[i] = sfmt("/var/lib/ioto/items/%08d", i);
+                } else if (p == 1) {
+                    keys[i] = sfmt("/var/lib/ioto/items/%08d", n - i);
+                } else if (p == 2) {
+                    keys[i] = sfmt("/var/lib/ioto/items/%08d", rand());
+                } else {
+                    keys[i] = sfmt("/var/lib/ioto/items/%d", rand() % 16);
+                }
+            }
+            memcpy(sorted, keys, sizeof(char*) * (size_t) n);
+            start = now();
+            rSort(sorted, n, sizeof(char*), compareString, 0);
+            compare = (now() - start) / n;
+
+            rClearList(list);
+            for (i = 0; i < n; i++) {
+                rAddItem(list, keys[i]);
+            }
+            start = now();
+            rSortList(list, NULL, NULL);
+            radix = (now() - start) / n;
+            for (i = 0; i < n; i++) {
+                if (!smatch(rGetItem(list, i), sorted[i])) {
+                    break;
+                }
+            }
+            teqi(i, n);
+            printf("%8d  %-9s %10.1f %10.1f\n", n, patterns[p], compare, radix);
+            for (i = 0; i < n; i++) {
+                rFree(keys[i]);
+            }
+        }
+        rFreeList(list);
+        rFree(sorted);
+        rFree(keys);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    benchIntegers();
+    benchStrings();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
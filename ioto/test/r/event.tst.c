@@ -15,6 +15,17 @@
 
 static int eventCount = 0;
 
+#define ORDER_COUNT 2000                /* Number of events to schedule for ordering tests */
+#define ORDER_DELAYS 7                  /* Number of distinct delays */
+
+#define BENCH_THREADS 4                 /* Foreign threads posting events in the contention benchmark */
+#define BENCH_EVENTS 25000              /* Events posted by each foreign thread */
+
+static int orderSeen[ORDER_COUNT];
+static int orderRun[ORDER_COUNT];
+static int orderRunCount = 0;
+static int benchCount = 0;
+
 /************************************ Code ************************************/
 
 static void eventProc(cchar *signal)
@@ -64,6 +75,64 @@ static void stopEvent(void)
 }
 
 
+static void orderProc(void *arg)
+{
+    int index;
+
+    index = (int) (ssize) arg;
+    orderSeen[index]++;
+    orderRun[orderRunCount++] = index;
+}
+
+
+//  Test that many queued events run in due order, events due at the same time run FIFO and stopped events never run
+static void orderEvents(void)
+{
+    REvent ids[ORDER_COUNT];
+    int    i, j, delay, prior[ORDER_DELAYS];
+
+    memset(orderSeen, 0, sizeof(orderSeen));
+    orderRunCount = 0;
+
+    for (i = 0; i < ORDER_COUNT; i++) {
+        ids[i] = rAllocEvent(NULL, orderProc, (void*) (ssize) i, (i % ORDER_DELAYS) * 5, R_EVENT_FAST);
+        tneqz(ids[i], 0);
+    }
+    for (i = 0; i < ORDER_COUNT; i++) {
+        ttrue(rLookupEvent(ids[i]));
+    }
+    //  Stop every third event
+    for (i = 0; i < ORDER_COUNT; i += 3) {
+        teqi(rStopEvent(ids[i]), 0);
+        tfalse(rLookupEvent(ids[i]));
+        teqi(rStopEvent(ids[i]), R_ERR_CANT_FIND);
+    }
+    //  Run the last event immediately
+    teqi(rRunEvent(ids[ORDER_COUNT - 1]), 0);
+
+    rSleep(ORDER_DELAYS * 5 + 50);
+
+    for (i = 0; i < ORDER_COUNT; i++) {
+        teqi(orderSeen[i], (i % 3) ? 1 : 0);
+        tfalse(rLookupEvent(ids[i]));
+    }
+    teqi(orderRunCount, ORDER_COUNT - (ORDER_COUNT + 2) / 3);
+
+    //  Events with the same delay must run in order of scheduling
+    for (j = 0; j < ORDER_DELAYS; j++) {
+        prior[j] = -1;
+    }
+    for (i = 0; i < orderRunCount; i++) {
+        if (orderRun[i] == ORDER_COUNT - 1) {
+            continue;
+        }
+        delay = orderRun[i] % ORDER_DELAYS;
+        ttrue(orderRun[i] > prior[delay]);
+        prior[delay] = orderRun[i];
+    }
+}
+
+
 static cchar *spawnMain(void)
 {
     //  Runs on an outside thread. WARNING: cannot call most runtime APIs
@@ -118,12 +187,158 @@ static void outsideEvent(void)
 }
 
 
+#if ME_UNIX_LIKE
+static int inboxRan = 0;
+static int inboxResults[4];
+
+static void inboxProc(void *arg)
+{
+    inboxRan++;
+}
+
+
+/*
+    Runs on an outside thread while the main thread is blocked, so posted events remain in the inbox
+ */
+static void *inboxThread(void *arg)
+{
+    REvent id;
+
+    id = rStartEvent(inboxProc, 0, 0);
+    inboxResults[0] = rLookupEvent(id);
+    inboxResults[1] = rStopEvent(id);
+    inboxResults[2] = rLookupEvent(id);
+    inboxResults[3] = rStopEvent(id);
+    return 0;
+}
+
+
+static void inboxEvent(void)
+{
+    pthread_t thread;
+
+    inboxRan = 0;
+    if (pthread_create(&thread, NULL, inboxThread, NULL) != 0) {
+        tfail();
+        return;
+    }
+    pthread_join(thread, NULL);
+    ttrue(inboxResults[0]);
+    teqi(inboxResults[1], 0);
+    tfalse(inboxResults[2]);
+    teqi(inboxResults[3], R_ERR_CANT_FIND);
+
+    //  The stopped event is discarded when the inbox is drained and must not run
+    rSleep(20);
+    teqi(inboxRan, 0);
+}
+#endif
+
+
+static void benchProc(void *arg)
+{
+    if (++benchCount == BENCH_THREADS * BENCH_EVENTS) {
+        rSignalSync("bench-signal", "done");
+    }
+}
+
+
+//  Runs on an outside thread. Post events as fast as possible.
+static void benchThread(void *arg)
+{
+    int i;
+
+    for (i = 0; i < BENCH_EVENTS; i++) {
+        rAllocEvent(NULL, benchProc, 0, 0, R_EVENT_FAST);
+    }
+}
+
+
+/*
+    Contention benchmark. Foreign threads post events concurrently while the main loop drains them.
+ */
+static void contentionBenchmark(void)
+{
+    cchar *result;
+    Ticks start, elapsed;
+    int   i;
+
+    benchCount = 0;
+    rWatch("bench-signal", (RWatchProc) rResumeFiber, rGetFiber());
+    start = rGetTicks();
+    for (i = 0; i < BENCH_THREADS; i++) {
+        if (rCreateThread("bench", benchThread, 0) < 0) {
+            tfail();
+            return;
+        }
+    }
+    result = rYieldFiber(0);
+    elapsed = rGetTicks() - start;
+    rWatchOff("bench-signal", (RWatchProc) rResumeFiber, rGetFiber());
+
+    tmatch(result, "done");
+    teqi(benchCount, BENCH_THREADS * BENCH_EVENTS);
+    tinfo("Posted %d events from %d threads in %lld msec (%.0f events/sec)", benchCount, BENCH_THREADS,
+          (long long) elapsed, benchCount * 1000.0 / (double) (elapsed ? elapsed : 1));
+}
+
+
+static void slowProc(void *arg)
+{
+    Ticks start;
+
+    //  Busy wait without yielding
+    start = rGetTicks();
+    while (rGetElapsedTicks(start) < 20) {
+    }
+}
+
+//  Event loop health statistics
+static void eventStats(void)
+{
+    REventStats stats;
+
+    rSetEventStats(1, 10);
+    rStartFastEvent(slowProc, 0, 0);
+    rStartEvent(slowProc, 0, 0);
+    rSleep(50);
+
+    rGetEventStats(&stats);
+    ttrue(stats.enabled);
+    teqi(stats.slowThreshold, 10);
+    ttrue(stats.dispatched >= 3);
+    ttrue(stats.iterations >= stats.loop.count);
+    ttrue(stats.loop.count > 0);
+    ttrue(stats.lag.count >= 3);
+    ttrue(stats.maxDue >= 1);
+    ttrue(stats.slow >= 2);
+    ttrue(stats.slice.max >= 19000);
+    ttrue(rGetEventPercentile(&stats.slice, 100) == stats.slice.max);
+    ttrue(rGetEventPercentile(&stats.slice, 50) <= stats.slice.max);
+    ttrue(stats.loop.max >= 19000);
+
+    rSetEventStats(0, 0);
+    rResetEventStats();
+    rGetEventStats(&stats);
+    tfalse(stats.enabled);
+    teqz(stats.loop.count, 0);
+    teqz(stats.slice.count, 0);
+    teqz(rGetEventPercentile(&stats.slice, 99), 0);
+}
+
+
 static void fiberMain()
 {
     startEvent();
     stopEvent();
+    orderEvents();
     spawnThread();
     outsideEvent();
+#if ME_UNIX_LIKE
+    inboxEvent();
+#endif
+    contentionBenchmark();
+    eventStats();
     rStop();
 }
 
@@ -0,0 +1,129 @@
+/*
+    fiber.tst.c - Unit tests for fiber stack tuning
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define DEEP_STACK (40 * 1024)          /* Stack used by deepProc */
+#define RUNS       40                   /* Fibers to run per proc */
+
+/************************************ Code ************************************/
+
+static void deepProc(int *count)
+{
+    volatile char buf[DEEP_STACK];
+    size_t        i;
+
+    for (i = 0; i < sizeof(buf); i += 256) {
+        buf[i] = 1;
+    }
+    (*count)++;
+}
+
+static void shallowProc(int *count)
+{
+    (*count)++;
+}
+
+/*
+    Resuming from the main fiber runs each fiber to completion
+ */
+static void runFibers(RFiberProc proc, int runs)
+{
+    RFiber *fiber;
+    int    count, i;
+
+    count = 0;
+    for (i = 0; i < runs; i++) {
+        fiber = rAllocFiber("test", proc, &count);
+        tnotnull(fiber);
+        rResumeFiber(fiber, 0);
+    }
+    teqi(count, runs);
+}
+
+#if ME_FIBER_STACK_TUNE
+static RFiberStackClass *findClass(RFiberStackClass *classes, int count, RFiberProc proc)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (classes[i].proc == (void*) proc) {
+            return &classes[i];
+        }
+    }
+    return NULL;
+}
+#endif
+
+static void stackTuning()
+{
+#if ME_FIBER_STACK_TUNE
+    RFiberStackClass classes[ME_FIBER_STACK_CLASSES], *deep, *shallow;
+    size_t           initial, limit;
+    uint64           grows;
+    int              count;
+
+    runFibers((RFiberProc) deepProc, RUNS);
+    runFibers((RFiberProc) shallowProc, RUNS);
+
+    count = rGetFiberStackProfile(classes, ME_FIBER_STACK_CLASSES);
+    deep = findClass(classes, count, (RFiberProc) deepProc);
+    shallow = findClass(classes, count, (RFiberProc) shallowProc);
+    tnotnull(deep);
+    tnotnull(shallow);
+    if (!deep || !shallow) {
+        return;
+    }
+    teqz(deep->runs, RUNS);
+    ttrue(deep->samples > 0);
+    ttrue(deep->peak >= DEEP_STACK);
+    ttrue(deep->size >= deep->peak);
+
+    //  Shallow fibers get a smaller stack than the default
+    ttrue(shallow->samples > 0);
+    ttrue(shallow->peak < deep->peak);
+    ttrue(shallow->size < deep->size);
+    ttrue(shallow->size <= rGetFiberStackSize());
+
+    //  Once tuned, deep fibers no longer grow their stack through guard page faults
+    grows = deep->grows;
+    ttrue(grows > 0);
+    runFibers((RFiberProc) deepProc, RUNS);
+    count = rGetFiberStackProfile(classes, ME_FIBER_STACK_CLASSES);
+    deep = findClass(classes, count, (RFiberProc) deepProc);
+    teqz(deep->grows, grows);
+
+    //  Advice covers the deep fibers
+    rGetFiberStackAdvice(&initial, &limit);
+    ttrue(initial >= ME_FIBER_TUNED_MIN_STACK);
+    ttrue(limit >= deep->peak * 2);
+
+    ttrue(rSetFiberStackTuning(0));
+    runFibers((RFiberProc) deepProc, RUNS);
+    tfalse(rSetFiberStackTuning(1));
+#else
+    runFibers((RFiberProc) deepProc, RUNS);
+    tfalse(rSetFiberStackTuning(1));
+#endif
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    stackTuning();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
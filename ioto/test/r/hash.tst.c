@@ -12,6 +12,7 @@
 /*********************************** Locals ***********************************/
 
 #define HASH_COUNT 256                 /* Number of items to enter */
+#define GROW_COUNT 100000              /* Number of items for incremental resize tests */
 
 /************************************ Code ************************************/
 
@@ -172,6 +173,217 @@ static void iterateHash()
 }
 
 
+/*
+    Churn the table with removals and re-insertions so deleted slots are reused and purged
+ */
+static void churnHash()
+{
+    RHash *table;
+    char  name[32];
+    int   i, round;
+
+    table = rAllocHash(0, R_TEMPORAL_NAME | R_STATIC_VALUE);
+
+    for (round = 0; round < 20; round++) {
+        for (i = 0; i < 1000; i++) {
+            rAddName(table, SFMT(name, "key-%d-%d", round, i), (void*) (ssize) (i + 1), 0);
+        }
+        teqi(rGetHashLength(table), 1000);
+        for (i = 0; i < 1000; i++) {
+            ttrue(rLookupName(table, SFMT(name, "key-%d-%d", round, i)) == (void*) (ssize) (i + 1));
+            teqi(rRemoveName(table, name), 0);
+        }
+        teqi(rGetHashLength(table), 0);
+        tnull(rLookupName(table, SFMT(name, "key-%d-%d", round, 0)));
+    }
+    teqi(rRemoveName(table, "missing"), R_ERR_CANT_FIND);
+
+    //  Update in place keeps one entry
+    rAddName(table, "name", "one", 0);
+    rAddName(table, "name", "two", 0);
+    teqi(rGetHashLength(table), 1);
+    tmatch(rLookupName(table, "name"), "two");
+    rFreeHash(table);
+}
+
+static void duplicateAndCaseless()
+{
+    RHash *table;
+    RName *np;
+    int   count;
+
+    table = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    rAddDuplicateName(table, "Set-Cookie", "a", 0);
+    rAddDuplicateName(table, "Set-Cookie", "b", 0);
+    teqi(rGetHashLength(table), 2);
+    count = 0;
+    for (ITERATE_NAMES(table, np)) {
+        tmatch(np->name, "Set-Cookie");
+        count++;
+    }
+    teqi(count, 2);
+    teqi(rRemoveName(table, "Set-Cookie"), 0);
+    teqi(rGetHashLength(table), 1);
+    tnotnull(rLookupName(table, "Set-Cookie"));
+    rFreeHash(table);
+
+    table = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE | R_HASH_CASELESS);
+    rAddName(table, "Content-Type", "text/plain", 0);
+    tmatch(rLookupName(table, "content-type"), "text/plain");
+    tmatch(rLookupName(table, "CONTENT-TYPE"), "text/plain");
+    tnull(rLookupName(table, "content-length"));
+    rFreeHash(table);
+}
+
+/*
+    Lookups, updates and removals must see all names while an incremental resize is in progress
+ */
+static void incrementalHash()
+{
+    RHash *table;
+    RName *np;
+    char  name[32];
+    int   i, count;
+
+    table = rAllocHash(0, R_TEMPORAL_NAME | R_STATIC_VALUE | R_HASH_INCREMENTAL);
+    for (i = 0; i < GROW_COUNT; i++) {
+        rAddName(table, SFMT(name, "key-%d", i), (void*) (ssize) (i + 1), 0);
+        ttrue(rLookupName(table, name) == (void*) (ssize) (i + 1));
+        ttrue(rLookupName(table, "key-0") == (void*) 1);
+        if (i % 7 == 0 && i > 0) {
+            //  Remove a prior name which may still be in the old table
+            teqi(rRemoveName(table, SFMT(name, "key-%d", i / 2)), 0);
+            tnull(rLookupName(table, name));
+        }
+    }
+    count = 0;
+    for (ITERATE_NAMES(table, np)) {
+        count++;
+    }
+    teqi(count, rGetHashLength(table));
+    for (i = 0; i < GROW_COUNT; i++) {
+        np = rLookupNameEntry(table, SFMT(name, "key-%d", i));
+        if (np) {
+            ttrue(np->value == (void*) (ssize) (i + 1));
+            //  Update in place
+            rAddName(table, name, (void*) (ssize) (i + 2), 0);
+            ttrue(rLookupName(table, name) == (void*) (ssize) (i + 2));
+        }
+    }
+    teqi(count, rGetHashLength(table));
+    rFreeHash(table);
+}
+
+static void internStrings()
+{
+    RHash *table;
+    cchar *atom, *other;
+    char  name[256];
+
+    atom = rIntern("content-type");
+    tnotnull(atom);
+    tmatch(atom, "content-type");
+    SFMT(name, "content-%s", "type");
+    ttrue(rIntern(name) == atom);
+    ttrue(rInternBlock("content-type: text/plain", 12) == atom);
+    ttrue(rLookupIntern("content-type") == atom);
+    teqi(rGetInternHash(atom), shash("content-type", 12));
+
+    other = rIntern("Content-Type");
+    tnotnull(other);
+    ttrue(other != atom);
+    tnull(rLookupIntern("not-interned"));
+    tnull(rIntern(NULL));
+
+    //  Over-long strings are not interned
+    memset(name, 'x', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    tnull(rIntern(name));
+
+    //  Atoms can be used as static names and match lookups by value or by pointer
+    table = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE);
+    rAddName(table, atom, "text/plain", 0);
+    tmatch(rLookupName(table, atom), "text/plain");
+    tmatch(rLookupName(table, "content-type"), "text/plain");
+    tnull(rLookupName(table, other));
+    rFreeHash(table);
+}
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec / 1e3;
+#else
+    return (double) rGetTicks() * 1e3;
+#endif
+}
+
+static int compareDouble(cvoid *a, cvoid *b)
+{
+    double x = *(double*) a, y = *(double*) b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+    Measure per-insert latency in microseconds while the table grows. Returns the worst latency of the
+    inserts that resized the table. Growth of the names array is common to both modes and is excluded.
+ */
+static double measureGrowth(int flags, cchar *label)
+{
+    RHash  *table;
+    char   name[32], **names;
+    double *times, start, elapsed, resize;
+    uint   capacity;
+    int    i;
+
+    names = rAlloc(sizeof(char*) * GROW_COUNT);
+    times = rAlloc(sizeof(double) * GROW_COUNT);
+    for (i = 0; i < GROW_COUNT; i++) {
+        names[i] = sclone(SFMT(name, "session-%d", i));
+    }
+    table = rAllocHash(0, R_STATIC_NAME | R_STATIC_VALUE | flags);
+    resize = 0;
+    for (i = 0; i < GROW_COUNT; i++) {
+        capacity = table->capacity;
+        start = now();
+        rAddName(table, names[i], names[i], 0);
+        elapsed = now() - start;
+        times[i] = elapsed;
+        if (capacity && table->capacity != capacity && elapsed > resize) {
+            resize = elapsed;
+        }
+    }
+    teqi(rGetHashLength(table), GROW_COUNT);
+    rFreeHash(table);
+
+    qsort(times, GROW_COUNT, sizeof(double), compareDouble);
+    tinfo("%s insert latency usec: p50 %.2f, p99 %.2f, p99.9 %.2f, max %.1f, resize %.1f", label,
+          times[GROW_COUNT / 2], times[GROW_COUNT * 99 / 100], times[GROW_COUNT * 999 / 1000],
+          times[GROW_COUNT - 1], resize);
+    for (i = 0; i < GROW_COUNT; i++) {
+        rFree(names[i]);
+    }
+    rFree(names);
+    rFree(times);
+    return resize;
+}
+
+/*
+    Tail latency under growth. An incremental resize must not stall like a full rebuild of the table.
+ */
+static void growthLatency()
+{
+    double full, incremental;
+
+    full = measureGrowth(0, "Full rehash");
+    incremental = measureGrowth(R_HASH_INCREMENTAL, "Incremental");
+    ttrue(incremental < full);
+}
+
 int main(void)
 {
     rInit(0, 0);
@@ -180,6 +392,11 @@ int main(void)
     inserAndRemoveHash();
     hashScale();
     iterateHash();
+    churnHash();
+    duplicateAndCaseless();
+    incrementalHash();
+    growthLatency();
+    internStrings();
     rTerm();
     return 0;
 }
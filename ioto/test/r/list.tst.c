@@ -744,6 +744,161 @@ static void testSortList()
     rFreeList(lp);
 }
 
+typedef struct Record {
+    int64 key;
+    int64 seq;
+    void *data;
+} Record;
+
+static int64 comparisons;
+
+static int compareInt(cvoid *p1, cvoid *p2, void *ctx)
+{
+    int a = *(int*) p1, b = *(int*) p2;
+
+    comparisons++;
+    return (a > b) - (a < b);
+}
+
+static int compareRecord(cvoid *p1, cvoid *p2, void *ctx)
+{
+    int64 a = ((Record*) p1)->key, b = ((Record*) p2)->key;
+
+    return (a > b) - (a < b);
+}
+
+static int compareString(cvoid *p1, cvoid *p2, void *ctx)
+{
+    return strcmp(*(char**) p1, *(char**) p2);
+}
+
+static int patternValue(int pattern, int i, int n)
+{
+    switch (pattern) {
+    case 0:
+        return i;                               // Sorted
+    case 1:
+        return n - i;                           // Reversed
+    case 2:
+        return rand();                          // Random
+    case 3:
+        return rand() % 4;                      // Few unique
+    case 4:
+        return i < n / 2 ? i : n - i;           // Organ pipe
+    case 5:
+        return i % 100;                         // Sawtooth
+    default:
+        return 7;                               // All equal
+    }
+}
+
+/*
+    Sort inputs that defeat a simple quicksort. Sorted input must not go quadratic.
+ */
+static void testSortPatterns()
+{
+    Record *records;
+    int    *values, i, n, pattern;
+    int64  sum, check;
+
+    n = 20000;
+    values = rAlloc(sizeof(int) * (size_t) n);
+    records = rAlloc(sizeof(Record) * (size_t) n);
+
+    for (pattern = 0; pattern < 7; pattern++) {
+        sum = check = 0;
+        for (i = 0; i < n; i++) {
+            values[i] = patternValue(pattern, i, n);
+            sum += values[i];
+        }
+        comparisons = 0;
+        rSort(values, n, sizeof(int), compareInt, 0);
+        for (i = 0; i < n; i++) {
+            check += values[i];
+            if (i > 0 && values[i - 1] > values[i]) {
+                break;
+            }
+        }
+        teqi(i, n);
+        ttrue(check == sum);
+        //  n log2 n is about 300K comparisons
+        ttrue(comparisons < (int64) n * 30);
+
+        for (i = 0; i < n; i++) {
+            records[i].key = patternValue(pattern, i, n);
+            records[i].seq = i;
+            records[i].data = &records[i];
+        }
+        rSort(records, n, sizeof(Record), compareRecord, 0);
+        for (i = 1; i < n; i++) {
+            if (records[i - 1].key > records[i].key) {
+                break;
+            }
+        }
+        teqi(i, n);
+    }
+    rFree(values);
+    rFree(records);
+}
+
+/*
+    Large string lists are radix sorted and must match the comparison sort
+ */
+static void testSortStrings()
+{
+    RList *lp;
+    char  **expect, *s;
+    int   i, n, next;
+
+    n = 5000;
+    lp = rAllocList(0, R_DYNAMIC_VALUE);
+    expect = rAlloc(sizeof(char*) * (size_t) n);
+    for (i = 0; i < n; i++) {
+        switch (i % 4) {
+        case 0:
+            s = sfmt("/var/lib/ioto/shared/prefix/%d", rand() % 1000);
+            break;
+        case 1:
+            s = sfmt("%x", rand());
+            break;
+        case 2:
+            s = sclone(i % 8 ? "duplicate" : "");
+            break;
+        default:
+            s = sfmt("/var/lib/ioto/%c%d", 'a' + rand() % 26, rand());
+            break;
+        }
+        rAddItem(lp, s);
+        expect[i] = s;
+    }
+    rSort(expect, n, sizeof(char*), compareString, 0);
+    rSortList(lp, NULL, NULL);
+    teqi(rGetListLength(lp), n);
+    for (ITERATE_ITEMS(lp, s, next)) {
+        if (!smatch(s, expect[next])) {
+            break;
+        }
+    }
+    teqi(next, n);
+
+    //  Already sorted and reversed input
+    rSortList(lp, NULL, NULL);
+    for (i = 0; i < n / 2; i++) {
+        s = lp->items[i];
+        lp->items[i] = lp->items[n - i - 1];
+        lp->items[n - i - 1] = s;
+    }
+    rSortList(lp, NULL, NULL);
+    for (ITERATE_ITEMS(lp, s, next)) {
+        if (!smatch(s, expect[next])) {
+            break;
+        }
+    }
+    teqi(next, n);
+    rFree(expect);
+    rFreeList(lp);
+}
+
 static void testEdgeCases()
 {
     RList *lp;
@@ -834,6 +989,8 @@ int main(void)
     testListToString();
     testStackOperations();
     testSortList();
+    testSortPatterns();
+    testSortStrings();
     testStringOperations();
     testEdgeCases();
     testAddNullItem();
@@ -0,0 +1,282 @@
+/*
+    log.tst.c - Unit tests for logging
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define LOG_LINES 20000                 /* Number of lines to log */
+#define FORMAT_ITEMS 100                /* More log format items than can be compiled */
+
+/************************************ Code ************************************/
+
+static int countLines(cchar *path, int *sequence)
+{
+    char   *data, *cp, *end;
+    size_t len;
+    int    count, expect;
+
+    data = rReadFile(path, &len);
+    tnotnull(data);
+    count = 0;
+    expect = 0;
+    for (cp = data; cp && *cp; cp = end ? end + 1 : 0) {
+        end = strchr(cp, '\n');
+        if ((cp = strstr(cp, "line ")) != 0 && (!end || cp < end)) {
+            //  Lines must be written in order
+            if (atoi(&cp[5]) < expect) {
+                *sequence = 0;
+            }
+            expect = atoi(&cp[5]);
+            count++;
+        }
+    }
+    rFree(data);
+    return count;
+}
+
+static void syncLog()
+{
+    char path[ME_MAX_FNAME], *temp;
+    int  i, ordered;
+
+    temp = rGetTempFile("data", "temp-log");
+    teqi(rSetLog(SFMT(path, "%s:all:all", temp), "%M", 1), 0);
+    for (i = 0; i < 100; i++) {
+        rInfo("test", "line %d", i);
+    }
+    //  No-op when not async
+    rFlushLog();
+    ordered = 1;
+    teqi(countLines(temp, &ordered), 100);
+    ttrue(ordered);
+    unlink(temp);
+    rFree(temp);
+}
+
+static void formatLog()
+{
+    RBuf *buf;
+    char host[256], format[FORMAT_ITEMS * 3 + 1], num[32], *expect;
+    int  i, pid, status;
+
+    buf = rAllocBuf(0);
+    gethostname(host, sizeof(host));
+    host[sizeof(host) - 1] = '\0';
+
+    rSetLogFormat("%A [%P] %T %S %H: %M", 1);
+    rFormatLog(buf, "info", "test", "hello");
+    expect = sfmt("%s [%d] info test %s: hello\n", rGetAppName(), getpid(), host);
+    tmatch(rBufToString(buf), expect);
+    rFree(expect);
+
+    //  Unknown tokens lose the "%" and a trailing "%" is ignored
+    rSetLogFormat("%F%%|%M%", 1);
+    rFormatLog(buf, "info", "test", "line\n");
+    tmatch(rBufToString(buf), "F%|line\n");
+
+    rSetLogFormat("%M", 1);
+    rFormatLog(buf, "info", "test", "");
+    tmatch(rBufToString(buf), "");
+    rFormatLog(buf, "raw", "test", "raw text");
+    tmatch(rBufToString(buf), "raw text");
+
+    //  Dates are "Mon DD HH:MM:SS"
+    rSetLogFormat("%D|%M", 1);
+    rFormatLog(buf, "info", "test", "dated");
+    teqz(slen(rBufToString(buf)), 15 + 7);
+    tmatch(&rBufToString(buf)[15], "|dated\n");
+
+#if ME_UNIX_LIKE
+    //  Forked processes render their own process ID
+    rSetLogFormat("%P|%M", 1);
+    if ((pid = fork()) == 0) {
+        rFormatLog(buf, "info", "test", "child");
+        _exit(smatch(rBufToString(buf), SFMT(num, "%d|child\n", getpid())) ? 0 : 1);
+    }
+    ttrue(pid > 0);
+    ttrue(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+#endif
+
+    //  Formats with too many items are rejected in favor of the default format
+    for (i = 0; i < FORMAT_ITEMS; i++) {
+        format[i * 3] = '%';
+        format[i * 3 + 1] = 'T';
+        format[i * 3 + 2] = ' ';
+    }
+    format[i * 3] = '\0';
+    rSetLogFormat(format, 1);
+    rFormatLog(buf, "info", "test", "message");
+    expect = sfmt("%s: message\n", rGetAppName());
+    tmatch(rBufToString(buf), expect);
+    rFree(expect);
+
+    rSetLogFormat(R_LOG_FORMAT, 1);
+    rFreeBuf(buf);
+}
+
+static int logCount;
+
+static void countHandler(cchar *type, cchar *source, cchar *msg)
+{
+    logCount++;
+}
+
+static void emitSite(int i)
+{
+    rTrace("site", "trace %d", i);
+}
+
+/*
+    Call sites cache filter decisions. Changing the filter must invalidate the cache.
+ */
+static void filterLog()
+{
+    RLogHandler prior;
+    cchar       *source;
+    int         i;
+
+    prior = rSetLogHandler(countHandler);
+    rSetLogFilter("error,info", "all", 1);
+    logCount = 0;
+    for (i = 0; i < 10; i++) {
+        emitSite(i);
+    }
+    teqi(logCount, 0);
+
+    rSetLogFilter("error,info,trace", "all,!other", 1);
+    for (i = 0; i < 10; i++) {
+        emitSite(i);
+    }
+    teqi(logCount, 10);
+
+    rSetLogFilter("error,info,trace", "all,!site", 1);
+    emitSite(0);
+    teqi(logCount, 10);
+
+    //  Variable sources are checked on every call
+    logCount = 0;
+    for (i = 0; i < 10; i++) {
+        source = (i & 1) ? "site" : "other";
+        rTrace(source, "trace %d", i);
+    }
+    teqi(logCount, 5);
+    ttrue(rEmitLog("trace", "other"));
+    tfalse(rEmitLog("trace", "site"));
+
+    rSetLogHandler(prior);
+    rSetLogFilter("error,info", "all,!mbedtls", 1);
+}
+
+static void asyncLog()
+{
+    char path[ME_MAX_FNAME], *temp;
+    int  i, ordered;
+
+    temp = rGetTempFile("data", "temp-log");
+    teqi(rSetLog(SFMT(path, "%s:async=block:all:all", temp), "%M", 1), 0);
+#if ME_UNIX_LIKE && R_USE_THREAD
+    for (i = 0; i < LOG_LINES; i++) {
+        rInfo("test", "line %d", i);
+    }
+    //  Blocking policy keeps every message
+    rFlushLog();
+    teqz(rGetLogDropped(), 0);
+    ordered = 1;
+    teqi(countLines(temp, &ordered), LOG_LINES);
+    ttrue(ordered);
+
+    //  Drop policy never blocks, but every message is either written or counted
+    teqi(rSetLogAsync(1, R_LOG_DROP), 0);
+    for (i = 0; i < LOG_LINES; i++) {
+        rInfo("test", "line %d", LOG_LINES + i);
+    }
+    rFlushLog();
+    ordered = 1;
+    teqi(countLines(temp, &ordered) + (int) rGetLogDropped(), LOG_LINES * 2);
+    ttrue(ordered);
+
+    //  Switching the log path drains the ring to the prior log
+    rInfo("test", "line %d", LOG_LINES * 2);
+    teqi(rSetLogPath("stdout", 1), 0);
+    ordered = 1;
+    teqi(countLines(temp, &ordered) + (int) rGetLogDropped(), LOG_LINES * 2 + 1);
+    ttrue(ordered);
+    teqi(rSetLogAsync(0, -1), 0);
+#else
+    teqi(rSetLogAsync(1, R_LOG_DROP), R_ERR_BAD_STATE);
+#endif
+    unlink(temp);
+    rFree(temp);
+}
+
+/*
+    A forked worker must restart the async writer or its messages are never written
+ */
+static void forkLog()
+{
+#if ME_UNIX_LIKE && R_USE_THREAD
+    char path[ME_MAX_FNAME], *temp;
+    int  i, ordered, pid, status, waited;
+
+    temp = rGetTempFile("data", "temp-log");
+    teqi(rSetLog(SFMT(path, "%s:all:all", temp), "%M", 1), 0);
+    teqi(rSetLogAsync(1, R_LOG_BLOCK), 0);
+
+    //  Setting the log without async must not disable async logging
+    teqi(rSetLog(SFMT(path, "%s:all:all", temp), "%M", 1), 0);
+
+    if ((pid = rForkWorker()) == 0) {
+        //  More than the ring holds so the block policy waits for the writer
+        for (i = 0; i < LOG_LINES; i++) {
+            rInfo("test", "line %d", i);
+        }
+        rFlushLog();
+        //  Exit handlers drain the ring
+        rInfo("test", "line %d", LOG_LINES);
+        exit(0);
+    }
+    ttrue(pid > 0);
+    status = -1;
+    for (waited = 0; waited < 100 && waitpid(pid, &status, WNOHANG) == 0; waited++) {
+        rSleep(100);
+    }
+    if (waited >= 100) {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        tfail("Forked worker did not complete logging");
+    } else {
+        ttrue(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    ordered = 1;
+    teqi(countLines(temp, &ordered), LOG_LINES + 1);
+    ttrue(ordered);
+    teqi(rSetLogAsync(0, -1), 0);
+    teqi(rSetLogPath("stdout", 1), 0);
+    unlink(temp);
+    rFree(temp);
+#endif
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    formatLog();
+    filterLog();
+    syncLog();
+    asyncLog();
+    forkLog();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
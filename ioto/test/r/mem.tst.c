@@ -267,6 +267,238 @@ static void testMemcpy()
     teqi(memcmp(binDest, binSrc, 50), 0);
 }
 
+#define POOL_OBJECTS 1000
+
+typedef struct PoolObj {
+    int64 id;
+    char data[40];
+} PoolObj;
+
+static void          *poolObjects[POOL_OBJECTS];
+static volatile bool poolThreadDone;
+
+static void poolThread(RPool *pool)
+{
+    int i;
+
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        rFreeToPool(pool, poolObjects[i]);
+    }
+    poolThreadDone = 1;
+}
+
+/*
+    Allocate and free objects on a foreign thread. These are allocated via malloc and join the pool when merged.
+ */
+static void poolForeignThread(RPool *pool)
+{
+    void **list;
+    int  i;
+
+    list = rAlloc(sizeof(void*) * POOL_OBJECTS * 5);
+    for (i = 0; i < POOL_OBJECTS * 5; i++) {
+        list[i] = rAllocFromPool(pool);
+    }
+    for (i = 0; i < POOL_OBJECTS * 5; i++) {
+        rFreeToPool(pool, list[i]);
+    }
+    rFree(list);
+    poolThreadDone = 1;
+}
+
+static RPoolStats *getPoolStats(RMemStats *stats, size_t size)
+{
+    int i;
+
+    rGetMemStats(stats);
+    for (i = 0; i < stats->pools; i++) {
+        if (stats->stats[i].size == R_ALLOC_ALIGN(size, R_POOL_ALIGN)) {
+            return &stats->stats[i];
+        }
+    }
+    return 0;
+}
+
+static void testPools()
+{
+    RMemStats stats;
+    RPool     *pool, *large;
+    PoolObj   *obj;
+    int       i, j, inUse;
+
+    //  Pools are shared by size class
+    pool = rAllocPool(sizeof(PoolObj));
+    tnotnull(pool);
+    ttrue(rAllocPool(sizeof(PoolObj) - 1) == pool);
+    ttrue(rAllocPool(sizeof(PoolObj) + R_POOL_ALIGN) != pool);
+
+    rGetMemStats(&stats);
+    inUse = 0;
+    for (i = 0; i < stats.pools; i++) {
+        if (stats.stats[i].size == R_ALLOC_ALIGN(sizeof(PoolObj), R_POOL_ALIGN)) {
+            inUse = (int) stats.stats[i].inUse;
+        }
+    }
+
+    //  Objects are zeroed and distinct
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        obj = rAllocFromPool(pool);
+        tnotnull(obj);
+        for (j = 0; j < (int) sizeof(PoolObj); j++) {
+            if (((char*) obj)[j] != 0) {
+                break;
+            }
+        }
+        teqi(j, (int) sizeof(PoolObj));
+        memset(obj, 0x77, sizeof(PoolObj));
+        obj->id = i;
+        poolObjects[i] = obj;
+    }
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        teqz(((PoolObj*) poolObjects[i])->id, i);
+    }
+#if ME_MEM_POOL
+    rGetMemStats(&stats);
+    ttrue(stats.pools > 0);
+    ttrue(stats.poolBytes >= POOL_OBJECTS * sizeof(PoolObj));
+    ttrue(stats.poolUsed >= POOL_OBJECTS * sizeof(PoolObj));
+    for (i = 0; i < stats.pools; i++) {
+        if (stats.stats[i].size == R_ALLOC_ALIGN(sizeof(PoolObj), R_POOL_ALIGN)) {
+            teqz(stats.stats[i].inUse, inUse + POOL_OBJECTS);
+        }
+    }
+#endif
+
+    //  Freed objects are recycled
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        rFreeToPool(pool, poolObjects[i]);
+    }
+    rFreeToPool(pool, NULL);
+    obj = rAllocFromPool(pool);
+#if ME_MEM_POOL
+    ttrue(obj == poolObjects[POOL_OBJECTS - 1]);
+#endif
+    teqz(obj->id, 0);
+    rFreeToPool(pool, obj);
+
+    //  Objects freed by a foreign thread are reclaimed by the main thread
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        poolObjects[i] = rAllocFromPool(pool);
+    }
+    poolThreadDone = 0;
+    ttrue(rCreateThread("pool", poolThread, pool) == 0);
+    for (i = 0; i < 5000 && !poolThreadDone; i++) {
+        rSleep(1);
+    }
+    ttrue(poolThreadDone);
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        poolObjects[i] = rAllocFromPool(pool);
+    }
+#if ME_MEM_POOL
+    rGetMemStats(&stats);
+    for (i = 0; i < stats.pools; i++) {
+        if (stats.stats[i].size == R_ALLOC_ALIGN(sizeof(PoolObj), R_POOL_ALIGN)) {
+            teqz(stats.stats[i].inUse, inUse + POOL_OBJECTS);
+        }
+    }
+#endif
+    for (i = 0; i < POOL_OBJECTS; i++) {
+        rFreeToPool(pool, poolObjects[i]);
+    }
+
+    //  Objects too large for slabs use malloc
+    large = rAllocPool(ME_MEM_POOL_MAX + 1);
+    tnotnull(large);
+    obj = rAllocFromPool(large);
+    tnotnull(obj);
+    rFreeToPool(large, obj);
+}
+
+/*
+    Objects from foreign threads beyond the slab capacity are released rather than retained
+ */
+static void testPoolBound()
+{
+#if ME_MEM_POOL
+    RMemStats  stats;
+    RPoolStats *sp;
+    RPool      *pool;
+    void       **list;
+    int64      count, i, slabObjects;
+
+    pool = rAllocPool(sizeof(PoolObj));
+    poolThreadDone = 0;
+    ttrue(rCreateThread("pool", poolForeignThread, pool) == 0);
+    for (i = 0; i < 5000 && !poolThreadDone; i++) {
+        rSleep(1);
+    }
+    ttrue(poolThreadDone);
+
+    //  Drain the free list so the remote objects are merged, then return everything
+    sp = getPoolStats(&stats, sizeof(PoolObj));
+    count = sp->objects - sp->inUse + 1;
+    list = rAlloc(sizeof(void*) * (size_t) count);
+    for (i = 0; i < count; i++) {
+        list[i] = rAllocFromPool(pool);
+    }
+    for (i = 0; i < count; i++) {
+        rFreeToPool(pool, list[i]);
+    }
+    rFree(list);
+
+    sp = getPoolStats(&stats, sizeof(PoolObj));
+    slabObjects = sp->slabs * (int64) (ME_MEM_POOL_SLAB / sp->size);
+    ttrue(sp->objects <= slabObjects * 2);
+#endif
+}
+
+static void testArena()
+{
+    RArena *arena;
+    char   buf[32], *first, *str, *big, *cp;
+    int    i;
+
+    arena = rAllocArena(1024);
+    tnotnull(arena);
+    teqz(rGetArenaUsed(arena), 0);
+
+    //  Allocations are aligned and distinct
+    first = rArenaAlloc(arena, 1);
+    tnotnull(first);
+    cp = rArenaAlloc(arena, 3);
+    ttrue(cp > first);
+    ttrue(((size_t) cp % sizeof(void*)) == 0);
+
+    str = rArenaClone(arena, "hello");
+    tmatch(str, "hello");
+    tmatch(rArenaClone(arena, NULL), "");
+
+    str = rArenaFmt(arena, "%s-%d", "value", 42);
+    tmatch(str, "value-42");
+
+    //  Overflow into new blocks and dedicated large blocks
+    for (i = 0; i < 200; i++) {
+        str = rArenaFmt(arena, "item-%d", i);
+        tmatch(str, SFMT(buf, "item-%d", i));
+    }
+    big = rArenaAlloc(arena, 10000);
+    tnotnull(big);
+    memset(big, 'x', 10000);
+    str = rArenaFmt(arena, "%s", "after-big");
+    tmatch(str, "after-big");
+    str = rArenaFmt(arena, "%2000s", "wide");
+    teqz(slen(str), 2000);
+    ttrue(rGetArenaUsed(arena) > 12000);
+
+    //  Reset reuses the first block
+    rResetArena(arena);
+    teqz(rGetArenaUsed(arena), 0);
+    ttrue(rArenaAlloc(arena, 1) == first);
+
+    rFreeArena(arena);
+    rFreeArena(NULL);
+}
+
 static int    memHandlerCalled = 0;
 static int    lastCause = 0;
 static size_t lastSize = 0;
@@ -357,6 +589,9 @@ int main(void)
     testMemcpy();
     testMemHandlerAndExceptions();
     testEdgeCases();
+    testPools();
+    testPoolBound();
+    testArena();
     rTerm();
     return 0;
 }
@@ -0,0 +1,126 @@
+/*
+    memtag.tst.c - Unit tests for per-subsystem memory accounting
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define TEST_TAG  (R_MEM_APP)
+#define TEST_SIZE 1000
+
+/************************************ Code ************************************/
+
+#if ME_R_MEM_TAGS
+static void childProc(void *data)
+{
+    //  Fibers inherit the tag of their creator
+    *(int*) data = rGetMemTag();
+    rSetMemTag(R_MEM_APP + 1);
+    rYieldFiber(0);
+    *(int*) data = rGetMemTag();
+}
+#endif
+
+static void memTags()
+{
+#if ME_R_MEM_TAGS
+    int prior;
+
+    teqi(rGetMemTag(), R_MEM_OTHER);
+    prior = rSetMemTag(TEST_TAG);
+    teqi(prior, R_MEM_OTHER);
+    teqi(rGetMemTag(), TEST_TAG);
+
+    //  Invalid tags are ignored
+    teqi(rSetMemTag(R_MEM_TAGS), TEST_TAG);
+    teqi(rSetMemTag(-1), TEST_TAG);
+    teqi(rGetMemTag(), TEST_TAG);
+
+    teqi(rSetMemTag(prior), TEST_TAG);
+    teqi(rGetMemTag(), R_MEM_OTHER);
+
+    teqi(rSetMemTagName(TEST_TAG, "test"), 0);
+    teqi(rSetMemTagName(R_MEM_TAGS, "bad"), R_ERR_BAD_ARGS);
+#endif
+}
+
+static void memSnapshot()
+{
+#if ME_R_MEM_TAGS
+    RMemSnapshot before, after, diff;
+    char         *mem;
+    int          prior;
+
+    rGetMemSnapshot(&before);
+    tmatch(before.tags[R_MEM_WEB].name, "web");
+    tmatch(before.tags[TEST_TAG].name, "test");
+
+    prior = rSetMemTag(TEST_TAG);
+    mem = rAlloc(TEST_SIZE);
+    rSetMemTag(prior);
+
+    rGetMemSnapshot(&after);
+    rDiffMemSnapshot(&diff, &before, &after);
+    teqz(diff.tags[TEST_TAG].bytes, TEST_SIZE);
+    teqz(diff.tags[TEST_TAG].blocks, 1);
+    teqz(diff.tags[TEST_TAG].allocs, 1);
+    ttrue(diff.tags[TEST_TAG].peak >= TEST_SIZE);
+
+    //  Resized blocks keep their tag even when resized under another tag
+    mem = rRealloc(mem, TEST_SIZE * 2);
+    rGetMemSnapshot(&after);
+    rDiffMemSnapshot(&diff, &before, &after);
+    teqz(diff.tags[TEST_TAG].bytes, TEST_SIZE * 2);
+    teqz(diff.tags[TEST_TAG].blocks, 1);
+
+    rFree(mem);
+    rGetMemSnapshot(&after);
+    rDiffMemSnapshot(&diff, &before, &after);
+    teqz(diff.tags[TEST_TAG].bytes, 0);
+    teqz(diff.tags[TEST_TAG].blocks, 0);
+    teqz(diff.tags[TEST_TAG].allocs, 1);
+    ttrue(diff.tags[TEST_TAG].peak >= TEST_SIZE * 2);
+#endif
+}
+
+static void memFiber()
+{
+#if ME_R_MEM_TAGS
+    RFiber *fiber;
+    int    prior, tag;
+
+    prior = rSetMemTag(TEST_TAG);
+    fiber = rAllocFiber("child", childProc, &tag);
+    tnotnull(fiber);
+    rResumeFiber(fiber, 0);
+    teqi(tag, TEST_TAG);
+
+    //  The fiber tag is saved and restored across switches
+    teqi(rGetMemTag(), TEST_TAG);
+    rResumeFiber(fiber, 0);
+    teqi(tag, R_MEM_APP + 1);
+    teqi(rGetMemTag(), TEST_TAG);
+    rSetMemTag(prior);
+#endif
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    memTags();
+    memSnapshot();
+    memFiber();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
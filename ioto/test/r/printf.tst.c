@@ -358,6 +358,101 @@ static void regress()
     tmatch(buf, "20, after");
 }
 
+static void shortest()
+{
+    RBuf   *rb;
+    char   buf[256], *str;
+    double values[] = { 0.1, 0.3, 1.0 / 3.0, 2.0 / 3.0, 1e-7, 5e-324, 1.7976931348623157e308, 123456.789, 9007199254740993.0 };
+    int    i;
+
+    //  Without a precision, %g emits the shortest digits that read back as the same double
+    sfmtbuf(buf, sizeof(buf), "%g", 0.1 + 0.2);
+    tmatch(buf, "0.30000000000000004");
+
+    sfmtbuf(buf, sizeof(buf), "%g", 1e-7);
+    tmatch(buf, "1e-07");
+
+    sfmtbuf(buf, sizeof(buf), "%G", 1.5e300);
+    tmatch(buf, "1.5E+300");
+
+    sfmtbuf(buf, sizeof(buf), "%g", 0.0);
+    tmatch(buf, "0");
+
+    sfmtbuf(buf, sizeof(buf), "%g", -0.0);
+    tmatch(buf, "-0");
+
+    sfmtbuf(buf, sizeof(buf), "%.3g", 1.5);
+    tmatch(buf, "1.500");
+
+    for (i = 0; i < (int) (sizeof(values) / sizeof(double)); i++) {
+        str = sftosbuf(buf, sizeof(buf), values[i]);
+        tnotnull(str);
+        ttrue(strtod(str, NULL) == values[i]);
+        ttrue(strtod(sfmtbuf(buf, sizeof(buf), "%g", -values[i]), NULL) == -values[i]);
+    }
+    tnull(sftosbuf(buf, 4, 0.125));
+    tmatch(sftosbuf(buf, 6, 0.125), "0.125");
+
+    sfmtbuf(buf, sizeof(buf), "%f|%e|%5g", NAN, -INFINITY, INFINITY);
+    tmatch(buf, "nan|-inf|  inf");
+
+    //  Rounding carries into a new leading digit
+    sfmtbuf(buf, sizeof(buf), "%.2f", 99.999);
+    tmatch(buf, "100.00");
+
+    //  Exact ties round half to even
+    sfmtbuf(buf, sizeof(buf), "%.0f %.0f %.0f %.1f %.1f", 0.5, 1.5, 2.5, 0.25, 0.375);
+    tmatch(buf, "0 2 2 0.2 0.4");
+
+    sfmtbuf(buf, sizeof(buf), "%.0e %.1e", 2.5, 1.25e10);
+    tmatch(buf, "2e+00 1.2e+10");
+
+    //  Explicit precisions round the exact binary value, not the shortest digits
+    sfmtbuf(buf, sizeof(buf), "%.2f", 0x1.ecd38a3d70a3dp+14);
+    tmatch(buf, "31540.88");
+
+    sfmtbuf(buf, sizeof(buf), "%.1f", 0x1.cbb8333333333p+14);
+    tmatch(buf, "29422.0");
+
+    sfmtbuf(buf, sizeof(buf), "%12.4e", 130645.0);
+    tmatch(buf, "  1.3064e+05");
+
+    sfmtbuf(buf, sizeof(buf), "%.20f", 0.1);
+    tmatch(buf, "0.10000000000000000555");
+
+    sfmtbuf(buf, sizeof(buf), "%.17e", 5e-324);
+    tmatch(buf, "4.94065645841246544e-324");
+
+    sfmtbuf(buf, sizeof(buf), "%.2f", -0.001);
+    tmatch(buf, "-0.00");
+
+    sfmtbuf(buf, sizeof(buf), "%.3f", 1e20);
+    tmatch(buf, "100000000000000000000.000");
+
+    sfmtbuf(buf, sizeof(buf), "%.20f", 0.5);
+    tmatch(buf, "0.50000000000000000000");
+
+    sfmtbuf(buf, sizeof(buf), "%.3f", 1e-10);
+    tmatch(buf, "0.000");
+
+    //  Width applies to the whole number
+    sfmtbuf(buf, sizeof(buf), "[%-8.2f|%08.3f|%+g|%10.2e]", 2.5, -1.5, 3.0, 12345.0);
+    tmatch(buf, "[2.50    |-001.500|+3|  1.23e+04]");
+
+    rb = rAllocBuf(0);
+    rPutIntToBuf(rb, 0);
+    rPutCharToBuf(rb, ' ');
+    rPutIntToBuf(rb, INT64_MIN);
+    rPutCharToBuf(rb, ' ');
+    rPutIntToBuf(rb, INT64_MAX);
+    rPutCharToBuf(rb, ' ');
+    rPutDoubleToBuf(rb, 0.1 + 0.2);
+    rPutCharToBuf(rb, ' ');
+    rPutDoubleToBuf(rb, 2.5e-5);
+    tmatch(rBufToString(rb), "0 -9223372036854775808 9223372036854775807 0.30000000000000004 2.5e-05");
+    rFreeBuf(rb);
+}
+
 int main(void)
 {
     rInit(0, 0);
@@ -373,6 +468,7 @@ int main(void)
     overflow();
     extra();
     regress();
+    shortest();
     rTerm();
     return 0;
 }
@@ -0,0 +1,141 @@
+/*
+    profile.tst.c - Unit tests for the sampling profiler
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define SPIN_MSEC 300                   /* CPU time to consume per spin */
+
+/************************************ Code ************************************/
+
+static void spin(Ticks msec)
+{
+    Ticks          deadline;
+    volatile int64 sum;
+
+    deadline = rGetTicks() + msec;
+    for (sum = 0; rGetTicks() < deadline; sum++) {
+    }
+}
+
+static void spinProc(void *data)
+{
+    spin(SPIN_MSEC);
+}
+
+#if ME_R_PROFILE
+static int countSamples(cchar *profile, cchar *prefix)
+{
+    char *copy, *line, *tok, *count;
+    int  total;
+
+    total = 0;
+    copy = sclone(profile);
+    for (line = stok(copy, "\n", &tok); line; line = stok(NULL, "\n", &tok)) {
+        count = strrchr(line, ' ');
+        ttrue(count != NULL);
+        if (count && sstarts(line, prefix)) {
+            total += atoi(count + 1);
+        }
+    }
+    rFree(copy);
+    return total;
+}
+#endif
+
+static void profileCpu()
+{
+#if ME_R_PROFILE
+    RFiber *fiber;
+    char   *profile, *path;
+    int64  samples, dropped;
+    int    fiberSamples, mainSamples;
+
+    teqi(rStartProfile(1000, 0), 0);
+    teqi(rStartProfile(1000, 0), R_ERR_BAD_STATE);
+
+    spin(SPIN_MSEC);
+    fiber = rAllocFiber("spin", spinProc, NULL);
+    tnotnull(fiber);
+    rResumeFiber(fiber, 0);
+    rStopProfile();
+
+    rGetProfileStats(&samples, &dropped);
+    ttrue(samples > 0);
+    teqz(dropped, 0);
+
+    //  Folded stacks are attributed to the main fiber or the fiber entry proc
+    profile = rGetProfile(0);
+    tnotnull(profile);
+    mainSamples = countSamples(profile, "main;");
+    fiberSamples = countSamples(profile, "fiber:");
+    teqz(mainSamples + fiberSamples, samples);
+    ttrue(mainSamples > 0);
+    ttrue(fiberSamples > 0);
+    rFree(profile);
+
+    //  A full buffer drops samples
+    teqi(rStartProfile(1000, 4), 0);
+    spin(SPIN_MSEC / 3);
+    rStopProfile();
+    rGetProfileStats(&samples, &dropped);
+    teqz(samples, 4);
+    ttrue(dropped > 0);
+
+    path = rGetTempFile("data", "profile");
+    teqi(rWriteProfile(path, R_PROFILE_RAW), 0);
+    profile = rReadFile(path, NULL);
+    tnotnull(profile);
+    teqi(countSamples(profile, ""), 4);
+    rFree(profile);
+    unlink(path);
+    rFree(path);
+#endif
+}
+
+/*
+    Samples are retained and sampling resumes when the runtime is restarted
+ */
+static void profileRestart()
+{
+#if ME_R_PROFILE
+    int64 before, samples, dropped;
+
+    teqi(rStartProfile(1000, 0), 0);
+    spin(SPIN_MSEC / 3);
+    rGetProfileStats(&before, &dropped);
+    ttrue(before > 0);
+
+    rSetState(R_RESTART);
+    rTerm();
+    rInit(0, 0);
+
+    rGetProfileStats(&samples, &dropped);
+    ttrue(samples >= before);
+    spin(SPIN_MSEC / 3);
+    rStopProfile();
+    rGetProfileStats(&samples, &dropped);
+    ttrue(samples > before);
+#endif
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    profileCpu();
+    profileRestart();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
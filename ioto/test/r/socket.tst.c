@@ -19,6 +19,7 @@ typedef struct TestSocket {
     RSocket *client;                         /* Client socket */
     RBuf *buf;                               /* Input buffer */
     ssize written;                           /* Size of data written */
+    RBuf *expect;                            /* Expected data if verifying content */
     int port;                                /* Server port */
     Ticks deadline;                          /* Timeout deadline */
 } TestSocket;
@@ -173,6 +174,77 @@ static void clientServer(cchar *host)
 }
 
 
+/*
+    Write sets of small and large blocks with rWriteSocketv. The large blocks force partial writes.
+ */
+static void clientServerVectored()
+{
+    RSocket *sp;
+    RIOVec  iov[4];
+    char    *large, prefix[32];
+    ssize   nbytes;
+    size_t  largeSize;
+    int     i, rc;
+
+    ts->listen = openServer(ts, "127.0.0.1");
+    tnotnull(ts->listen);
+    if (ts->listen == 0) {
+        return;
+    }
+    sp = rAllocSocket();
+    tnotnull(sp);
+
+    ts->fiber = rGetFiber();
+    ts->buf = rAllocBuf(0);
+    ts->expect = rAllocBuf(0);
+    ts->written = 0;
+
+    rc = rConnectSocket(sp, "127.0.0.1", ts->port, ts->deadline);
+    ttrue(rc >= 0);
+
+    teqz(rWriteSocketv(sp, NULL, 1, ts->deadline), R_ERR_BAD_ARGS);
+    teqz(rWriteSocketv(sp, iov, ME_R_IOV_MAX + 1, ts->deadline), R_ERR_BAD_ARGS);
+
+    largeSize = 256 * 1024;
+    large = rAlloc(largeSize);
+    for (i = 0; i < (int) largeSize; i++) {
+        large[i] = (char) ('a' + i % 26);
+    }
+    for (i = 0; i < 20; i++) {
+        sfmtbuf(prefix, sizeof(prefix), "block %d\r\n", i);
+        iov[0].iov_base = prefix;
+        iov[0].iov_len = slen(prefix);
+        iov[1].iov_base = "";
+        iov[1].iov_len = 0;
+        iov[2].iov_base = "\r\n";
+        iov[2].iov_len = 2;
+        iov[3].iov_base = large;
+        iov[3].iov_len = (i & 1) ? largeSize : (size_t) i;
+        nbytes = rWriteSocketv(sp, iov, 4, ts->deadline);
+        teqz(nbytes, slen(prefix) + 2 + iov[3].iov_len);
+        if (nbytes < 0) {
+            break;
+        }
+        rPutStringToBuf(ts->expect, prefix);
+        rPutStringToBuf(ts->expect, "\r\n");
+        rPutBlockToBuf(ts->expect, large, iov[3].iov_len);
+        ts->written += nbytes;
+    }
+    rFree(large);
+    rFreeSocket(sp);
+
+    //  Wait for read side to resume when read is complete
+    rYieldFiber(0);
+
+    rFreeSocket(ts->listen);
+    ts->listen = 0;
+    rFreeBuf(ts->buf);
+    ts->buf = 0;
+    rFreeBuf(ts->expect);
+    ts->expect = 0;
+}
+
+
 static void acceptFn(TestSocket *tp, RSocket *sp)
 {
     ssize nbytes;
@@ -186,6 +258,9 @@ static void acceptFn(TestSocket *tp, RSocket *sp)
     } while (nbytes > 0);
 
     teqz(rGetBufLength(tp->buf), tp->written);
+    if (tp->expect) {
+        ttrue(smatch(rBufToString(tp->buf), rBufToString(tp->expect)));
+    }
     rResumeFiber(tp->fiber, 0);
 }
 
@@ -240,6 +315,7 @@ static void fiberMain(void *arg)
 #if !WIN
     clientServerIPv4();
     clientServerIPv6();
+    clientServerVectored();
 #endif
 #if ME_COM_SSL && UNUSED
     clientSslv4();
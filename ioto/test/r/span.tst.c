@@ -0,0 +1,165 @@
+/*
+    span.tst.c - Unit tests for trace spans
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "r.h"
+
+/*********************************** Locals ***********************************/
+
+#define RING_SIZE 8
+
+/************************************ Code ************************************/
+
+#if ME_R_SPAN
+static int countEvents(cchar *trace)
+{
+    cchar *cp;
+    int   count;
+
+    count = 0;
+    for (cp = trace; (cp = scontains(cp, "\"ph\":\"X\"")) != 0; cp++) {
+        count++;
+    }
+    return count;
+}
+
+static bool hasParent(cchar *trace, uint64 id, uint64 parent)
+{
+    char match[80];
+
+    sfmtbuf(match, sizeof(match), "\"id\":%lld,\"parent\":%lld}", (int64) id, (int64) parent);
+    return scontains(trace, match) != 0;
+}
+
+static void childProc(uint64 *ids)
+{
+    ids[0] = rSpanBegin("test", "child");
+    ids[1] = rSpanBegin("test", "grandchild");
+    rSpanEnd(ids[1]);
+    rSpanEnd(ids[0]);
+}
+#endif
+
+static void spanNesting()
+{
+#if ME_R_SPAN
+    RFiber *fiber;
+    uint64 ids[2], inner, outer;
+    char   *trace;
+
+    //  Spans are not recorded until started
+    teqz(rSpanBegin("test", "idle"), 0);
+    rSpanEnd(0);
+
+    teqi(rStartSpans(0, NULL), 0);
+    outer = rSpanBegin("test", "outer");
+    inner = rSpanBegin("test", "inner");
+    ttrue(outer > 0);
+    ttrue(inner > outer);
+    teqz(rGetFiber()->span, inner);
+
+    //  Spans in another fiber do not nest under the spans of the main fiber
+    fiber = rAllocFiber("child", (RFiberProc) childProc, ids);
+    tnotnull(fiber);
+    rResumeFiber(fiber, 0);
+    teqz(rGetFiber()->span, inner);
+
+    rSpanEnd(inner);
+    teqz(rGetFiber()->span, outer);
+    rSpanEnd(outer);
+    teqz(rGetFiber()->span, 0);
+    rStopSpans();
+
+    trace = rGetSpans();
+    tnotnull(trace);
+    ttrue(sstarts(trace, "{\"traceEvents\":["));
+    ttrue(scontains(trace, "\"args\":{\"name\":\"main\"}") != 0);
+    teqi(countEvents(trace), 4);
+    ttrue(hasParent(trace, outer, 0));
+    ttrue(hasParent(trace, inner, outer));
+    ttrue(hasParent(trace, ids[0], 0));
+    ttrue(hasParent(trace, ids[1], ids[0]));
+    rFree(trace);
+#endif
+}
+
+static void spanRing()
+{
+#if ME_R_SPAN
+    uint64 first, span;
+    char   *path, *trace;
+    int    i;
+
+    path = rGetTempFile("data", "spans");
+    teqi(rStartSpans(RING_SIZE, path), 0);
+
+    //  Open spans do not appear in the trace
+    first = rSpanBegin("test", "open");
+    trace = rGetSpans();
+    teqi(countEvents(trace), 0);
+    rFree(trace);
+
+    //  The ring keeps only the most recent spans
+    for (i = 0; i < RING_SIZE * 2; i++) {
+        span = rSpanBegin("test", "loop");
+        rSpanEnd(span);
+    }
+    //  Ending an overwritten span is ignored
+    rSpanEnd(first);
+    teqz(rGetFiber()->span, 0);
+
+    teqi(rWriteSpans(NULL), 0);
+    trace = rReadFile(path, NULL);
+    tnotnull(trace);
+    teqi(countEvents(trace), RING_SIZE);
+    rFree(trace);
+
+    rStopSpans();
+    teqz(rSpanBegin("test", "stopped"), 0);
+    unlink(path);
+    rFree(path);
+#endif
+}
+
+/*
+    Spans are retained when the runtime is restarted
+ */
+static void spanRestart()
+{
+#if ME_R_SPAN
+    char *trace;
+
+    teqi(rStartSpans(RING_SIZE, NULL), 0);
+    rSpanEnd(rSpanBegin("test", "before"));
+
+    rSetState(R_RESTART);
+    rTerm();
+    rInit(0, 0);
+
+    rSpanEnd(rSpanBegin("test", "after"));
+    trace = rGetSpans();
+    teqi(countEvents(trace), 2);
+    rFree(trace);
+    rStopSpans();
+#endif
+}
+
+int main(void)
+{
+    rInit(0, 0);
+    spanNesting();
+    spanRing();
+    spanRestart();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
@@ -84,6 +84,7 @@ static char *HTTPS;
 #define SAMPLE_INTERVAL 50                 // Sample memory every N iterations
 #define MAX_SAMPLES 100                    // Maximum memory samples to collect
 #define LEAK_THRESHOLD 1.15                // 15% memory growth threshold (allows for runtime variance)
+#define LEAK_TAG_SLACK 1024                // Live bytes a memory tag may retain per test class
 
 // Runtime iterations (set from TESTME_ITERATIONS or defaults)
 static int SOAK_ITERATIONS = DEFAULT_SOAK_ITERATIONS;
@@ -113,6 +114,22 @@ static size_t getCurrentMemoryUsage()
     return 0;
 }
 
+#if ME_R_MEM_TAGS
+/*
+    Check the live heap charged to a memory tag did not grow over a test class
+ */
+static void checkMemTag(cchar *name, RMemSnapshot *diff, int tag)
+{
+    RMemTagStats *sp;
+
+    sp = &diff->tags[tag];
+    tinfo("  %s: %s tag %+lld bytes, %+lld blocks, %lld allocs",
+          name, sp->name, sp->bytes, sp->blocks, sp->allocs);
+    ttrue(sp->blocks <= 0 && sp->bytes <= LEAK_TAG_SLACK,
+          "%s: %s tag retained %lld bytes in %lld blocks", name, sp->name, sp->bytes, sp->blocks);
+}
+#endif
+
 /*
     Run basic GET requests
  */
@@ -365,6 +382,9 @@ static void fiberMain(void *data)
         size_t startMem, soakMem, baselineMem, testStartMem, testEndMem, endMem;
         Ticks startTime, endTime;
         int i;
+#if ME_R_MEM_TAGS
+        RMemSnapshot before, after;
+#endif
 
         tinfo("=== URL Module Memory Leak Test Suite (Client API Only) ===");
         tinfo("This test runs multiple request types to detect memory leaks in the URL client");
@@ -410,8 +430,18 @@ static void fiberMain(void *data)
         for (i = 0; i < numTests; i++) {
             testStartMem = getCurrentMemoryUsage();
             tinfo("Running: %s (%d iterations)...", tests[i].name, TEST_ITERATIONS);
+#if ME_R_MEM_TAGS
+            rGetMemSnapshot(&before);
+#endif
             tests[i].fn(HTTP, TEST_ITERATIONS);
             testEndMem = getCurrentMemoryUsage();
+#if ME_R_MEM_TAGS
+            //  Per-tag accounting is exact, so the URL client and its JSON must not retain memory
+            rGetMemSnapshot(&after);
+            rDiffMemSnapshot(&after, &before, &after);
+            checkMemTag(tests[i].name, &after, R_MEM_URL);
+            checkMemTag(tests[i].name, &after, R_MEM_JSON);
+#endif
 
             double classGrowth = (double)testEndMem / (double)testStartMem;
             double classGrowthPercent = (classGrowth - 1.0) * 100.0;
@@ -0,0 +1,185 @@
+/*
+    archive.tst.c - Unit tests for serving documents from a packed archive
+
+    The test web.json5 mounts archive.zip with the "pack" directory as the document root. The archive contains
+    stored documents under pack/archive, pre-compressed variants of app.js, a deflated entry that is not served
+    and an entry outside the root directory.
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "test.h"
+
+/*********************************** Locals ***********************************/
+
+static char *HTTP;
+static char *HTTPS;
+
+/************************************ Code ************************************/
+
+static void testMount()
+{
+    WebHost *host;
+    Json    *config;
+
+    config = jsonParse("{ web: { documents: './site' } }", 0);
+    host = webAllocHost(config, 0);
+    ttrue(host);
+
+    teqi(webMountArchive(host, "missing.zip", NULL), R_ERR_CANT_OPEN);
+    tnull(host->archive);
+    teqi(webMountArchive(host, "web.json5", NULL), R_ERR_BAD_FORMAT);
+    tnull(host->archive);
+    teqi(webMountArchive(host, "archive.zip", "pack"), 0);
+    tnotnull(host->archive);
+
+    //  Remounting replaces the archive
+    teqi(webMountArchive(host, "archive.zip", NULL), 0);
+    tnotnull(host->archive);
+    webFreeHost(host);
+}
+
+static void testGet()
+{
+    Url  *up;
+    char url[128], *etag, *headers;
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/index.html", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "<html><body>Archive index</body></html>\n");
+    tcontains(urlGetHeader(up, "Content-Type"), "text/html");
+    tnotnull(urlGetHeader(up, "Last-Modified"));
+
+    //  The ETag is derived from the CRC and size in the archive index
+    etag = sclone(urlGetHeader(up, "ETag"));
+    tmatch(etag, "\"ada17548-28\"");
+
+    headers = sfmt("If-None-Match: %s\r\n", etag);
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/index.html", HTTP), NULL, 0, headers);
+    teqi(status, 304);
+    rFree(headers);
+    rFree(etag);
+
+    status = urlFetch(up, "HEAD", SFMT(url, "%s/archive/index.html", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetHeader(up, "Content-Length"), "40");
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/range.txt", HTTP), NULL, 0, "Range: bytes=10-19\r\n");
+    teqi(status, 206);
+    tmatch(urlGetResponse(up), "0123456789");
+    tmatch(urlGetHeader(up, "Content-Range"), "bytes 10-19/100");
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/index.html", HTTPS), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "<html><body>Archive index</body></html>\n");
+    urlFree(up);
+}
+
+static void testIndex()
+{
+    Url  *up;
+    char url[128];
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "<html><body>Archive index</body></html>\n");
+    tcontains(urlGetHeader(up, "Content-Type"), "text/html");
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/sub/", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "<html><body>Archive sub index</body></html>\n");
+
+    //  Archive directories without a trailing slash are redirected
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/sub", HTTP), NULL, 0, NULL);
+    teqi(status, 301);
+    tcontains(urlGetHeader(up, "Location"), "/archive/sub/");
+    urlFree(up);
+}
+
+static void testEncodings()
+{
+    Url  *up;
+    char url[128];
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/app.js", HTTP), NULL, 0, "Accept-Encoding: br, gzip\r\n");
+    teqi(status, 200);
+    tmatch(urlGetHeader(up, "Content-Encoding"), "br");
+    tmatch(urlGetHeader(up, "Content-Length"), "54");
+    tcontains(urlGetHeader(up, "Vary"), "Accept-Encoding");
+    tcontains(urlGetHeader(up, "Content-Type"), "javascript");
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/app.js", HTTP), NULL, 0, "Accept-Encoding: gzip\r\n");
+    teqi(status, 200);
+    tmatch(urlGetHeader(up, "Content-Encoding"), "gzip");
+    tmatch(urlGetHeader(up, "Content-Length"), "76");
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/app.js", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tnull(urlGetHeader(up, "Content-Encoding"));
+    tmatch(urlGetHeader(up, "Content-Length"), "49");
+
+    //  Variants are also served directly without a content encoding
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/app.js.gz", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tnull(urlGetHeader(up, "Content-Encoding"));
+    urlFree(up);
+}
+
+static void testFallback()
+{
+    Url  *up;
+    char url[128];
+    int  status;
+
+    up = urlAlloc(0);
+
+    //  Documents not in the archive are served from the documents directory
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/disk.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "Disk document outside the archive\n");
+
+    //  Compressed entries and entries outside the archive root are not served
+    status = urlFetch(up, "GET", SFMT(url, "%s/archive/deflated.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 404);
+    status = urlFetch(up, "GET", SFMT(url, "%s/other/outside.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 404);
+    status = urlFetch(up, "GET", SFMT(url, "%s/outside.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 404);
+    urlFree(up);
+}
+
+static void fiberMain(void *arg)
+{
+    webInit();
+    testMount();
+    if (setup(&HTTP, &HTTPS)) {
+        testGet();
+        testIndex();
+        testEncodings();
+        testFallback();
+    }
+    webTerm();
+    rFree(HTTP);
+    rFree(HTTPS);
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
@@ -890,6 +890,8 @@ static void saveMarkdownResults(cchar *version, cchar *timestamp, cchar *platfor
             categoryLabel = "**Mixed Workload**";
         } else if (scmp(groupNode->name, "throughput") == 0) {
             categoryLabel = "**Throughput**";
+        } else if (scmp(groupNode->name, "scaling") == 0) {
+            categoryLabel = "**Worker Scaling**";
         } else if (scmp(groupNode->name, "single_thread") == 0) {
             categoryLabel = "**Single Thread**";
         } else if (scmp(groupNode->name, "uploads") == 0) {
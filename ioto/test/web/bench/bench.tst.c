@@ -19,13 +19,17 @@
 #define URL_TIMEOUT_MS   10000   // 10 second timeout to prevent hangs
 
 #define NUM_SOAK_GROUPS  9
-#define NUM_BENCH_GROUPS 12
+#define NUM_BENCH_GROUPS 13
+
+// Worker scaling benchmark: private server port and maximum number of worker configurations
+#define SCALING_PORT     4270
+#define SCALING_MAX_RUNS 8
 
 /*
     List of all benchmark classes in run order
  */
 static cchar *benchClasses[] = {
-    "throughput", "static", "https", "raw_http", "raw_https",
+    "throughput", "scaling", "static", "https", "raw_http", "raw_https",
     "websockets", "put", "upload", "auth", "actions", "mixed", "connections",
     NULL
 };
@@ -57,6 +61,7 @@ static void benchMixed(Ticks duration);
 static void benchWebSockets(Ticks duration);
 static void benchConnections(Ticks duration, cchar *host, int port, bool useTls, bool useSession, int resultIndex);
 static void testWrk(void);
+static void testScaling(void);
 static void fiberMain(void *data);
 static cchar *initBench(void);
 static void runSoakTest(cchar *classes[], int numClasses, Ticks duration);
@@ -206,6 +211,12 @@ static bool runBenchClass(cchar *testClass, Ticks duration)
         if (!bctx->soak) {
             testWrk();
         }
+
+    } else if (smatch(testClass, "scaling")) {
+        // scaling launches its own servers and uses wrk, only run when recording
+        if (!bctx->soak) {
+            testScaling();
+        }
     }
     return !bctx->fatal;
 }
@@ -1293,6 +1304,138 @@ static void testWrk(void)
     rFree(host);
 }
 
+#if ME_UNIX_LIKE
+/*
+    Start a private web server with the given number of worker processes.
+    Returns the server PID or zero on failure.
+ */
+static int startScalingServer(int workers)
+{
+    Json    *config;
+    RSocket *sp;
+    char    cmd[256], path[64], pidPath[64], *pidText;
+    int     i, pid, rc;
+
+    if ((config = jsonParseFile("web.json5", NULL, 0)) == 0) {
+        tinfo("Warning: Cannot read web.json5");
+        return 0;
+    }
+    // Distribute each connection independently. Client affinity would send all local connections to one worker.
+    jsonSetJsonFmt(config, 0, "web.listen", "['http://localhost:%d']", SCALING_PORT);
+    jsonSetNumber(config, 0, "web.workers", workers);
+    jsonSetString(config, 0, "web.workerAffinity", "connection");
+    jsonSetString(config, 0, "log.path", "scaling.log");
+
+    SFMT(path, "scaling-%d.json5", getpid());
+    SFMT(pidPath, "scaling-%d.pid", getpid());
+    rc = jsonSave(config, 0, 0, path, 0644, JSON_HUMAN);
+    jsonFree(config);
+    if (rc < 0) {
+        tinfo("Warning: Cannot write %s", path);
+        return 0;
+    }
+    SFMT(cmd, "web --config %s >/dev/null 2>&1 & echo $! > %s", path, pidPath);
+    if (system(cmd) != 0 || (pidText = rReadFile(pidPath, NULL)) == 0) {
+        tinfo("Warning: Cannot start web with %d workers", workers);
+        unlink(path);
+        return 0;
+    }
+    pid = atoi(pidText);
+    rFree(pidText);
+    unlink(pidPath);
+
+    // Wait for the server to accept connections
+    for (i = 0; i < 50; i++) {
+        sp = rAllocSocket();
+        rc = rConnectSocket(sp, "localhost", SCALING_PORT, rGetTicks() + TPS);
+        rFreeSocket(sp);
+        if (rc == 0) {
+            break;
+        }
+        rSleep(100);
+    }
+    unlink(path);
+    if (rc != 0) {
+        tinfo("Warning: Web with %d workers did not start", workers);
+        kill(pid, SIGTERM);
+        return 0;
+    }
+    return pid;
+}
+
+/*
+    Stop a private web server and wait for it and its workers to exit
+ */
+static void stopScalingServer(int pid)
+{
+    kill(pid, SIGTERM);
+    for (int i = 0; i < 100 && kill(pid, 0) == 0; i++) {
+        rSleep(100);
+    }
+}
+#endif
+
+/*
+   Test: Benchmark multi-core scaling with web worker processes
+   Runs a private server with 1, 2, 4 ... N workers (N = CPU cores) and measures each with wrk.
+   Reports requests/sec and the speedup relative to a single worker.
+ */
+static void testScaling(void)
+{
+#if ME_UNIX_LIKE
+    BenchResult *results[SCALING_MAX_RUNS];
+    char        name[32];
+    double      base;
+    int         cores, count, durationSecs, pid, workers;
+
+    tinfo("=== Benchmarking worker scaling (SO_REUSEPORT) ===");
+
+    if (system("command -v wrk >/dev/null 2>&1") != 0) {
+        tinfo("SKIP: wrk not installed - install from https://github.com/wg/wrk");
+        return;
+    }
+    cores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    durationSecs = (int) (getBenchDuration() / 1000);
+    if (durationSecs < 5) {
+        durationSecs = 5;
+    }
+    count = 0;
+    base = 0;
+    for (workers = 1; count < SCALING_MAX_RUNS; workers *= 2) {
+        if (workers > cores) {
+            // Always finish with one worker per core
+            if (workers / 2 >= cores) break;
+            workers = cores;
+        }
+        if ((pid = startScalingServer(workers)) == 0) {
+            break;
+        }
+        SFMT(name, "workers_%d", workers);
+        results[count] = runWrkInner("localhost", SCALING_PORT, max(cores, 2), 64, durationSecs, name);
+        stopScalingServer(pid);
+        waitForTimeWaits(0, 0);
+        if (!results[count]) {
+            break;
+        }
+        if (count == 0) {
+            base = results[count]->requestsPerSec;
+        }
+        printBenchResult(results[count]);
+        tinfo("Workers %d: %.0f req/sec, %.2fx speedup", workers, results[count]->requestsPerSec,
+              base > 0 ? results[count]->requestsPerSec / base : 0);
+        count++;
+    }
+    if (count > 0) {
+        saveBenchGroup("scaling", results, count);
+    }
+    for (int i = 0; i < count; i++) {
+        freeBenchResult(results[i]);
+    }
+#else
+    tinfo("SKIP: worker scaling requires a Unix-like system");
+#endif
+}
+
 /*
     Check if a test class name is valid
  */
@@ -1372,7 +1515,7 @@ static cchar *initBench(void)
         if (!isValidBenchClass(testClass)) {
             tinfo("Error: Invalid TESTME_CLASS='%s'", testClass);
             tinfo(
-                "Valid values: static, https, raw_http, raw_https, put, upload, auth, actions, mixed, websockets, connections, throughput");
+                "Valid values: static, https, raw_http, raw_https, put, upload, auth, actions, mixed, websockets, connections, throughput, scaling");
             bctx->fatal = true;
             return NULL;
         }
@@ -0,0 +1,205 @@
+/*
+    file-cache.tst.c - Unit tests for the static file cache
+
+    The shared test web server runs without a file cache so the uncached file handler keeps its coverage.
+    This test starts its own host from web.json5 on separate endpoints with web.fileCache enabled and a
+    lifespan of one second.
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "test.h"
+
+/*********************************** Locals ***********************************/
+
+#define CACHE_FILE   "site/upload/cache-test.txt"
+#define CACHE_CONFIG "{ enable: true, files: 256, size: '64K', memory: '2MB', lifespan: '1sec' }"
+
+static cchar   *HTTP = "http://localhost:4250";
+static cchar   *HTTPS = "https://localhost:4251";
+static Json    *config;
+static WebHost *host;
+
+/************************************ Code ************************************/
+
+static bool startHost()
+{
+    if ((config = jsonParseFile("web.json5", NULL, 0)) == 0) {
+        tfail("Cannot parse web.json5");
+        return 0;
+    }
+    jsonSetJsonFmt(config, 0, "web.fileCache", "%s", CACHE_CONFIG);
+    jsonSetJsonFmt(config, 0, "web.listen", "['%s', '%s']", HTTP, HTTPS);
+
+    if ((host = webAllocHost(config, 0)) == 0) {
+        tfail("Cannot allocate host");
+        return 0;
+    }
+    tnotnull(host->fileCache);
+    if (webStartHost(host) < 0) {
+        tfail("Cannot start host");
+        return 0;
+    }
+    return 1;
+}
+
+static void stopHost()
+{
+    if (host) {
+        webStopHost(host);
+        webFreeHost(host);
+    }
+    jsonFree(config);
+}
+
+static void testCachedContent()
+{
+    Url  *up;
+    char url[128], *etag, *headers;
+    int  status;
+
+    up = urlAlloc(0);
+
+    //  Create the file via the server so the server can later update it
+    status = urlFetch(up, "PUT", SFMT(url, "%s/upload/cache-test.txt", HTTP), "cached content", 14, NULL);
+    ttrue(status == 201 || status == 204);
+
+    //  First request reads the file, the second is served from the cache
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "cached content");
+    etag = sclone(urlGetHeader(up, "ETag"));
+    tnotnull(etag);
+    tnotnull(urlGetHeader(up, "Last-Modified"));
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "cached content");
+    tmatch(urlGetHeader(up, "ETag"), etag);
+
+    //  Ranges and conditional requests use the cached content and validators
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, "Range: bytes=7-13\r\n");
+    teqi(status, 206);
+    tmatch(urlGetResponse(up), "content");
+
+    headers = sfmt("If-None-Match: %s\r\n", etag);
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, headers);
+    teqi(status, 304);
+    rFree(headers);
+
+    //  TLS responses are written from the cached content
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTPS), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "cached content");
+
+    rFree(etag);
+    urlFree(up);
+}
+
+static void testModified()
+{
+    Url  *up;
+    char url[128], *etag;
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    etag = sclone(urlGetHeader(up, "ETag"));
+
+    //  Changes made outside the server are seen once the cache lifespan expires
+    ttrue(rWriteFile(CACHE_FILE, "modified content", 16, 0644) == 16);
+    rSleep(1500);
+
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "modified content");
+    tfalse(smatch(urlGetHeader(up, "ETag"), etag));
+
+    rFree(etag);
+    urlFree(up);
+}
+
+static void testPutDelete()
+{
+    Url  *up;
+    char url[128];
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+
+    //  PUT and DELETE discard cached files immediately
+    status = urlFetch(up, "PUT", SFMT(url, "%s/upload/cache-test.txt", HTTP), "put content", 11, NULL);
+    ttrue(status == 201 || status == 204);
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetResponse(up), "put content");
+
+    status = urlFetch(up, "DELETE", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 204);
+    status = urlFetch(up, "GET", SFMT(url, "%s/upload/cache-test.txt", HTTP), NULL, 0, NULL);
+    teqi(status, 404);
+    urlFree(up);
+}
+
+static void testEncodings()
+{
+    Url  *up;
+    char url[128];
+    int  i, status;
+
+    up = urlAlloc(0);
+
+    //  Each preferred encoding is cached separately
+    for (i = 0; i < 2; i++) {
+        status = urlFetch(up, "GET", SFMT(url, "%s/compressed/app.js", HTTP), NULL, 0, "Accept-Encoding: br\r\n");
+        teqi(status, 200);
+        tmatch(urlGetHeader(up, "Content-Encoding"), "br");
+
+        status = urlFetch(up, "GET", SFMT(url, "%s/compressed/app.js", HTTP), NULL, 0, "Accept-Encoding: gzip\r\n");
+        teqi(status, 200);
+        tmatch(urlGetHeader(up, "Content-Encoding"), "gzip");
+
+        status = urlFetch(up, "GET", SFMT(url, "%s/compressed/app.js", HTTP), NULL, 0, NULL);
+        teqi(status, 200);
+        tnull(urlGetHeader(up, "Content-Encoding"));
+    }
+    //  Directory index
+    for (i = 0; i < 2; i++) {
+        status = urlFetch(up, "GET", SFMT(url, "%s/", HTTP), NULL, 0, NULL);
+        teqi(status, 200);
+        tcontains(urlGetHeader(up, "Content-Type"), "text/html");
+    }
+    urlFree(up);
+}
+
+static void fiberMain(void *arg)
+{
+    webInit();
+    if (setup(NULL, NULL) && startHost()) {
+        testCachedContent();
+        testModified();
+        testPutDelete();
+        testEncodings();
+    }
+    stopHost();
+    unlink(CACHE_FILE);
+    webTerm();
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
@@ -0,0 +1,196 @@
+/*
+    headers-index.tst.c - Unit tests for the request header index
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "test.h"
+
+/************************************ Code ************************************/
+
+static Web *parse(WebHost *host, cchar *headers)
+{
+    Web *web;
+
+    web = rAllocType(Web);
+    web->host = host;
+    web->rxLen = -1;
+    web->rxHeaders = rAllocBuf(0);
+    rPutStringToBuf(web->rxHeaders, headers);
+    rAddNullToBuf(web->rxHeaders);
+    ttrue(webParseHeadersBlock(web, web->rxHeaders->start, rGetBufLength(web->rxHeaders), 0));
+    return web;
+}
+
+static void freeWeb(Web *web)
+{
+    rFreeHash(web->rxHeaderHash);
+    rFreeList(web->etags);
+    rFreeArena(web->arena);
+    rFreeBuf(web->rxHeaders);
+    rFree(web);
+}
+
+static void testLookup(WebHost *host)
+{
+    Web *web;
+
+    web = parse(host,
+                "Host: example.com\r\n"
+                "accept-encoding:  gzip, br\r\n"
+                "X-Custom: one\r\n"
+                "x-custom: two\r\n"
+                "Empty:\r\n"
+                "Cookie: a=1\r\n"
+                "COOKIE: b=2\r\n"
+                "X-Last: last\r\n");
+
+    //  Well-known headers by id and by name in any case
+    tmatch(webGetHeaderId(web, WEB_HDR_HOST), "example.com");
+    tmatch(webGetHeader(web, "HOST"), "example.com");
+    tmatch(webGetHeaderId(web, WEB_HDR_ACCEPT_ENCODING), "gzip, br");
+    tmatch(webGetHeader(web, "Accept-Encoding"), "gzip, br");
+    tnull(webGetHeaderId(web, WEB_HDR_RANGE));
+    tnull(webGetHeaderId(web, -1));
+    tnull(webGetHeaderId(web, WEB_HDR_MAX));
+
+    //  Repeated headers return the first value but are all processed
+    tmatch(webGetHeaderId(web, WEB_HDR_COOKIE), "a=1");
+    tmatch(web->cookie, "a=1; b=2");
+
+    //  Other headers
+    tmatch(webGetHeader(web, "x-custom"), "one");
+    tmatch(webGetHeader(web, "X-CUSTOM"), "one");
+    tmatch(webGetHeader(web, "Empty"), "");
+    tmatch(webGetHeader(web, "X-Last"), "last");
+    tnull(webGetHeader(web, "Missing"));
+    tnull(webGetHeader(web, "Hos"));
+    tnull(webGetHeader(web, ""));
+    freeWeb(web);
+}
+
+static void testWellKnown(WebHost *host)
+{
+    Web *web;
+
+    web = parse(host,
+                "Accept: text/html\r\n"
+                "Accept-Encoding: gzip\r\n"
+                "Authorization: Basic dGVzdA==\r\n"
+                "Connection: keep-alive\r\n"
+                "Content-Length: 0\r\n"
+                "Content-Type: text/plain\r\n"
+                "Host: localhost\r\n"
+                "If-Match: \"abc\"\r\n"
+                "If-Modified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+                "If-None-Match: \"abc\"\r\n"
+                "If-Range: \"abc\"\r\n"
+                "If-Unmodified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+                "Last-Event-ID: 42\r\n"
+                "Origin: http://localhost\r\n"
+                "Range: bytes=0-1\r\n"
+                "Referer: http://localhost/\r\n"
+                "Sec-WebSocket-Key: key\r\n"
+                "Sec-WebSocket-Protocol: chat\r\n"
+                "Sec-WebSocket-Version: 13\r\n"
+                "Transfer-Encoding: identity\r\n"
+                "Upgrade: websocket\r\n"
+                "User-Agent: testme\r\n"
+                "X-XSRF-TOKEN: token\r\n");
+
+    tmatch(webGetHeaderId(web, WEB_HDR_ACCEPT), "text/html");
+    tmatch(webGetHeaderId(web, WEB_HDR_CONNECTION), "keep-alive");
+    tmatch(webGetHeaderId(web, WEB_HDR_CONTENT_LENGTH), "0");
+    tmatch(webGetHeaderId(web, WEB_HDR_CONTENT_TYPE), "text/plain");
+    tmatch(webGetHeaderId(web, WEB_HDR_IF_MATCH), "\"abc\"");
+    tmatch(webGetHeaderId(web, WEB_HDR_IF_MODIFIED_SINCE), "Sun, 06 Nov 1994 08:49:37 GMT");
+    tmatch(webGetHeaderId(web, WEB_HDR_IF_NONE_MATCH), "\"abc\"");
+    tmatch(webGetHeaderId(web, WEB_HDR_IF_UNMODIFIED_SINCE), "Sun, 06 Nov 1994 08:49:37 GMT");
+    tmatch(webGetHeaderId(web, WEB_HDR_LAST_EVENT_ID), "42");
+    tmatch(webGetHeaderId(web, WEB_HDR_ORIGIN), "http://localhost");
+    tmatch(webGetHeaderId(web, WEB_HDR_RANGE), "bytes=0-1");
+    tmatch(webGetHeaderId(web, WEB_HDR_REFERER), "http://localhost/");
+    tmatch(webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_KEY), "key");
+    tmatch(webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_PROTOCOL), "chat");
+    tmatch(webGetHeaderId(web, WEB_HDR_SEC_WEBSOCKET_VERSION), "13");
+    tmatch(webGetHeaderId(web, WEB_HDR_TRANSFER_ENCODING), "identity");
+    tmatch(webGetHeaderId(web, WEB_HDR_UPGRADE), "websocket");
+    tmatch(webGetHeaderId(web, WEB_HDR_USER_AGENT), "testme");
+    tmatch(webGetHeaderId(web, WEB_HDR_XSRF_TOKEN), "token");
+    tmatch(webGetHeader(web, WEB_XSRF_HEADER), "token");
+
+    //  Parsed fields are still set
+    teqi(web->lastEventId, 42);
+    ttrue(web->ifModified);
+    ttrue(web->ifUnmodified);
+    ttrue(web->ifRange);
+    tmatch(web->upgrade, "websocket");
+    tmatch(web->contentType, "text/plain");
+
+    //  Other headers are not confused with the well-known headers
+    tnull(webGetHeader(web, "X-Other"));
+    freeWeb(web);
+}
+
+/*
+    Upload part headers permit Content-Disposition and Content-Type. Other content headers are ignored.
+ */
+static void testUploadHeaders(WebHost *host)
+{
+    Web *web;
+
+    web = rAllocType(Web);
+    web->host = host;
+    web->rxLen = -1;
+    web->rxHeaders = rAllocBuf(0);
+    rPutStringToBuf(web->rxHeaders,
+                    "Content-Disposition: form-data; name=\"file\"; filename=\"data.txt\"\r\n"
+                    "Content-Type: text/plain\r\n"
+                    "Content-Transfer-Encoding: binary\r\n");
+    rAddNullToBuf(web->rxHeaders);
+    ttrue(webParseHeadersBlock(web, web->rxHeaders->start, rGetBufLength(web->rxHeaders), 1));
+    tmatch(web->contentDisposition, "form-data; name=\"file\"; filename=\"data.txt\"");
+    tmatch(web->contentType, "text/plain");
+
+    //  Part headers are not indexed as request headers
+    tnull(webGetHeaderId(web, WEB_HDR_CONTENT_TYPE));
+
+    rFlushBuf(web->rxHeaders);
+    rPutStringToBuf(web->rxHeaders, "X-Other: value\r\n");
+    rAddNullToBuf(web->rxHeaders);
+    tfalse(webParseHeadersBlock(web, web->rxHeaders->start, rGetBufLength(web->rxHeaders), 1));
+    tmatch(web->error, "Bad upload headers");
+    freeWeb(web);
+}
+
+static void fiberMain(void *data)
+{
+    WebHost *host;
+    Json    *config;
+
+    webInit();
+    config = jsonParse("{ web: { documents: './site' } }", 0);
+    host = webAllocHost(config, 0);
+    ttrue(host);
+    testLookup(host);
+    testWellKnown(host);
+    testUploadHeaders(host);
+    webFreeHost(host);
+    webTerm();
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
@@ -0,0 +1,173 @@
+/*
+    route.tst.c - Route matching microbenchmark
+
+    Compares the route tree used by webMatchRoute with the previous linear scan of the route list for
+    10, 100 and 1000 routes. The requested paths match routes at the end of the list which is the worst
+    case for the linear scan. Run manually via "tm route".
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "testme.h"
+#include    "web.h"
+
+/*********************************** Locals ***********************************/
+
+#define MIN_OPS 2000000                 /* Minimum operations per measurement */
+
+/************************************ Code ************************************/
+
+static double now(void)
+{
+#if ME_UNIX_LIKE
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#else
+    return (double) rGetTicks() * 1e6;
+#endif
+}
+
+/*
+    Create a host with half exact API routes and half static prefix routes
+ */
+static WebHost *allocHost(int count)
+{
+    WebHost *host;
+    Json    *config;
+    RBuf    *buf;
+    int     i;
+
+    buf = rAllocBuf(0);
+    rPutStringToBuf(buf, "{ web: { documents: './site', routes: [");
+    for (i = 0; i < count; i++) {
+        if (i & 1) {
+            rPutToBuf(buf, "{ match: '/static/s%d/' },", i);
+        } else {
+            rPutToBuf(buf, "{ match: '/api/v1/r%d', methods: ['GET', 'POST'] },", i);
+        }
+    }
+    rPutStringToBuf(buf, "] } }");
+    config = jsonParse(rBufToString(buf), 0);
+    rFreeBuf(buf);
+    ttrue(config);
+    host = webAllocHost(config, 0);
+    ttrue(host);
+    return host;
+}
+
+/*
+    The previous routeRequest matching: test every route in order then lookup the method
+ */
+static WebRoute *linearMatch(WebHost *host, cchar *path, cchar *method)
+{
+    WebRoute *route;
+    int      next;
+
+    for (ITERATE_ITEMS(host->routes, route, next)) {
+        if (route->exact) {
+            if (smatch(path, route->match)) {
+                break;
+            }
+        } else if (sstarts(path, route->match)) {
+            break;
+        }
+    }
+    if (!route || !rLookupName(route->methods, method)) {
+        return 0;
+    }
+    return route;
+}
+
+static WebRoute *treeMatch(WebHost *host, cchar *path, uint method)
+{
+    WebRoute *route;
+
+    if ((route = webMatchRoute(host, path)) == 0 || !(route->methodMask & method)) {
+        return 0;
+    }
+    return route;
+}
+
+static double timeLinear(WebHost *host, cchar *path, WebRoute *expect)
+{
+    double start;
+    int    i, reps;
+
+    reps = MIN_OPS / max(rGetListLength(host->routes) / 10, 1);
+    start = now();
+    for (i = 0; i < reps; i++) {
+        if (linearMatch(host, path, "GET") != expect) {
+            tfail("Linear match failed for %s", path);
+            break;
+        }
+    }
+    return (now() - start) / reps;
+}
+
+static double timeTree(WebHost *host, cchar *path, WebRoute *expect)
+{
+    double start;
+    int    i;
+
+    start = now();
+    for (i = 0; i < MIN_OPS; i++) {
+        if (treeMatch(host, path, WEB_METHOD_GET) != expect) {
+            tfail("Tree match failed for %s", path);
+            break;
+        }
+    }
+    return (now() - start) / MIN_OPS;
+}
+
+static void benchRoutes(void)
+{
+    WebHost  *host;
+    WebRoute *expect;
+    char     exact[80], prefix[80], *paths[3];
+    int      count, i;
+
+    printf("\nRoute matching microbenchmark (ns/op): linear scan vs route tree\n\n");
+    printf("%6s  %-24s %9s %9s\n", "routes", "path", "linear", "tree");
+    for (count = 10; count <= 1000; count *= 10) {
+        host = allocHost(count);
+        sfmtbuf(exact, sizeof(exact), "/api/v1/r%d", count - 2);
+        sfmtbuf(prefix, sizeof(prefix), "/static/s%d/app.css", count - 1);
+        paths[0] = exact;
+        paths[1] = prefix;
+        paths[2] = "/missing/path";
+        for (i = 0; i < 3; i++) {
+            expect = linearMatch(host, paths[i], "GET");
+            ttrue(expect == treeMatch(host, paths[i], WEB_METHOD_GET));
+            ttrue(i == 2 ? expect == 0 : expect == rGetItem(host->routes, count - 2 + i));
+            printf("%6d  %-24s %9.1f %9.1f\n", count, paths[i], timeLinear(host, paths[i], expect),
+                   timeTree(host, paths[i], expect));
+        }
+        webFreeHost(host);
+    }
+    printf("\n");
+}
+
+static void fiberMain(void *data)
+{
+    webInit();
+    benchRoutes();
+    webTerm();
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
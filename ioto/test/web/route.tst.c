@@ -0,0 +1,151 @@
+/*
+    route.tst.c - Unit tests for route matching
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "test.h"
+
+/************************************ Code ************************************/
+
+static WebHost *allocHost(cchar *routes)
+{
+    WebHost *host;
+    Json    *config;
+    char    *text;
+
+    text = sfmt("{ web: { documents: './site', routes: %s } }", routes);
+    config = jsonParse(text, 0);
+    rFree(text);
+    ttrue(config);
+    host = webAllocHost(config, 0);
+    ttrue(host);
+    return host;
+}
+
+static cchar *matchRoute(WebHost *host, cchar *path)
+{
+    WebRoute *route;
+
+    route = webMatchRoute(host, path);
+    return route ? route->match : "none";
+}
+
+static void testMatching()
+{
+    WebHost *host;
+
+    host = allocHost("["
+                     "{ match: '/api/login' },"
+                     "{ match: '/api/' },"
+                     "{ match: '/api/public/' },"
+                     "{ match: '/' },"
+                     "{ match: '/app' },"
+                     "{ match: '/apple/' },"
+                     "{ match: '/static/' },"
+                     "]");
+
+    //  Exact routes must match the whole path
+    tmatch(matchRoute(host, "/api/login"), "/api/login");
+    tmatch(matchRoute(host, "/app"), "/app");
+    tmatch(matchRoute(host, "/"), "/");
+    tmatch(matchRoute(host, "/ap"), "none");
+    tmatch(matchRoute(host, "/apps"), "none");
+    tmatch(matchRoute(host, "/index.html"), "none");
+
+    //  Prefix routes match any path with the prefix
+    tmatch(matchRoute(host, "/api/"), "/api/");
+    tmatch(matchRoute(host, "/api/login/more"), "/api/");
+    tmatch(matchRoute(host, "/apple/pie"), "/apple/");
+    tmatch(matchRoute(host, "/static/css/app.css"), "/static/");
+
+    //  The first matching route wins even if a later route is longer
+    tmatch(matchRoute(host, "/api/public/doc"), "/api/");
+
+    tnull(webMatchRoute(host, NULL));
+    webFreeHost(host);
+}
+
+static void testPrecedence()
+{
+    WebHost *host;
+
+    //  An earlier exact route wins over a later prefix route and vice versa
+    host = allocHost("["
+                     "{ match: '/a/b' },"
+                     "{ match: '/a/' },"
+                     "{ match: '/c/' },"
+                     "{ match: '/c/d' },"
+                     "{ match: '/a/b' },"
+                     "{ match: '' },"
+                     "]");
+    tmatch(matchRoute(host, "/a/b"), "/a/b");
+    ttrue(webMatchRoute(host, "/a/b") == rGetItem(host->routes, 0));
+    tmatch(matchRoute(host, "/a/c"), "/a/");
+    tmatch(matchRoute(host, "/c/d"), "/c/");
+
+    //  An empty match is a prefix of every path
+    tmatch(matchRoute(host, "/other"), "");
+    tmatch(matchRoute(host, ""), "");
+    webFreeHost(host);
+}
+
+static void testMethods()
+{
+    WebHost  *host;
+    WebRoute *route;
+
+    host = allocHost("["
+                     "{ match: '/upload/', methods: ['GET', 'PUT', 'PROPFIND'] },"
+                     "{ match: '/' },"
+                     "]");
+    route = webMatchRoute(host, "/upload/file.txt");
+    ttrue(route);
+    teqi(route->methodMask, WEB_METHOD_GET | WEB_METHOD_PUT);
+    tnotnull(rLookupName(route->methods, "PROPFIND"));
+
+    //  Routes without methods use the host methods
+    route = webMatchRoute(host, "/");
+    ttrue(route);
+    teqi(route->methodMask, WEB_METHOD_GET | WEB_METHOD_POST);
+    webFreeHost(host);
+}
+
+static void testDefaultRoute()
+{
+    WebHost *host;
+    Json    *config;
+
+    config = jsonParse("{ web: { documents: './site' } }", 0);
+    host = webAllocHost(config, 0);
+    ttrue(host);
+    tmatch(matchRoute(host, "/anything"), "");
+    tmatch(matchRoute(host, "/"), "");
+    webFreeHost(host);
+}
+
+static void fiberMain(void *data)
+{
+    webInit();
+    testMatching();
+    testPrecedence();
+    testMethods();
+    testDefaultRoute();
+    webTerm();
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+    return 0;
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
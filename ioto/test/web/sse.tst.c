@@ -11,6 +11,7 @@
     - Event type verification
     - Data content verification
     - Connection completion
+    - Response header release once written, with request arena memory retained
 
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
@@ -208,6 +209,42 @@ static void testResponseHeaders(void)
     urlFree(up);
 }
 
+/*
+    Test the response headers are released once written while arena memory stays valid. The /test/arena
+    endpoint formats a message in the arena, adds a header that spans several arena blocks, then reports the
+    message and the count of response headers after the first event.
+ */
+static void testArena(void)
+{
+    SseTestData testData;
+    Url         *up;
+    char        url[128];
+    int         rc;
+
+    memset(&testData, 0, sizeof(testData));
+    testData.expectedEvents = 2;
+
+    up = urlAlloc(0);
+    rc = urlStart(up, "GET", SFMT(url, "%s/test/arena", HTTP));
+    teqi(rc, 0);
+    rc = urlWriteHeaders(up, NULL);
+    teqi(rc, 0);
+    rc = urlFinalize(up);
+    teqi(rc, 0);
+    teqi(urlGetStatus(up), 200);
+    teqz(slen(urlGetHeader(up, "X-Padding")), 2 * 2048);
+
+    rc = urlSseRun(up, lowLevelCallback, &testData, up->rx, rGetTicks() + 30 * TPS);
+    teqi(rc, 0);
+    ttrue(testData.verified);
+    tmatch(testData.lastEvent, "arena");
+    tmatch(testData.lastData, "Arena 42 0");
+
+    rFree(testData.lastEvent);
+    rFree(testData.lastData);
+    urlFree(up);
+}
+
 static void fiberMain(void *data)
 {
     if (setup(&HTTP, &HTTPS)) {
@@ -215,6 +252,7 @@ static void fiberMain(void *data)
         testLowLevelApi();
         testHttpsEvents();
         testResponseHeaders();
+        testArena();
     }
     rFree(HTTP);
     rFree(HTTPS);
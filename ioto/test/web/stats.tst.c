@@ -0,0 +1,96 @@
+/*
+    stats.tst.c - Unit tests for the event loop statistics and trace span actions
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "test.h"
+
+/*********************************** Locals ***********************************/
+
+static char *HTTP;
+
+/************************************ Code ************************************/
+
+static void getStats()
+{
+    Url   *up;
+    Json  *json;
+    char  url[128];
+    int   status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/test/stats", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetHeader(up, "Content-Type"), "application/json");
+
+    json = urlGetJsonResponse(up);
+    tnotnull(json);
+    if (json) {
+        //  Enabled via limits.slowHandler in web.json5
+        ttrue(jsonGetBool(json, 0, "enabled", 0));
+        teqi(jsonGetInt(json, 0, "slowThreshold", 0), 1000);
+        ttrue(jsonGetNum(json, 0, "iterations", 0) > 0);
+        ttrue(jsonGetNum(json, 0, "dispatched", 0) > 0);
+        ttrue(jsonGetNum(json, 0, "slice.count", 0) > 0);
+        tnotnull(jsonGet(json, 0, "loop.p99", 0));
+        tnotnull(jsonGet(json, 0, "lag.max", 0));
+        tnotnull(jsonGet(json, 0, "slice.buckets[19]", 0));
+        tnull(jsonGet(json, 0, "slice.buckets[20]", 0));
+
+        //  Fiber stack profile and recommended limits
+        ttrue(jsonGetNum(json, 0, "fibers.stack", 0) > 0);
+        ttrue(jsonGetNum(json, 0, "fibers.advice.stack", 0) > 0);
+        ttrue(jsonGetNum(json, 0, "fibers.advice.stackMax", 0) >= jsonGetNum(json, 0, "fibers.advice.stack", 0));
+        tnotnull(jsonGet(json, 0, "fibers.procs", 0));
+        jsonFree(json);
+    }
+    urlFree(up);
+}
+
+static void getSpans()
+{
+#if ME_R_SPAN
+    Url  *up;
+    Json *json;
+    char url[128];
+    int  status;
+
+    up = urlAlloc(0);
+    status = urlFetch(up, "GET", SFMT(url, "%s/test/spans", HTTP), NULL, 0, NULL);
+    teqi(status, 200);
+    tmatch(urlGetHeader(up, "Content-Type"), "application/json");
+
+    json = urlGetJsonResponse(up);
+    tnotnull(json);
+    if (json) {
+        tnotnull(jsonGet(json, 0, "traceEvents", 0));
+        jsonFree(json);
+    }
+    urlFree(up);
+#endif
+}
+
+static void fiberMain(void *data)
+{
+    if (setup(&HTTP, NULL)) {
+        getStats();
+        getSpans();
+    }
+    rFree(HTTP);
+    rStop();
+}
+
+int main(void)
+{
+    rInit(fiberMain, 0);
+    rServiceEvents();
+    rTerm();
+}
+
+/*
+    Copyright (c) Embedthis Software. All Rights Reserved.
+    This is proprietary software and requires a commercial license from the author.
+ */
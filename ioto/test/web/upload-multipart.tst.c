@@ -14,6 +14,7 @@
     - Filename parsing from Content-Disposition
     - Multipart boundary handling
     - Content-Type in multipart sections
+    - Other content headers in multipart sections (Content-Transfer-Encoding)
     - Empty file uploads
     - Large form data with files
 
@@ -444,6 +445,39 @@ static void testContentTypeVariations(void)
     urlFree(up);
 }
 
+/*
+    Some clients send Content-Transfer-Encoding in part headers. Other content part headers are ignored.
+ */
+static void testTransferEncodingHeader(void)
+{
+    Url  *up;
+    char url[128], headers[256], *boundary, body[1024], filepath[256];
+    int  status, pid;
+
+    up = urlAlloc(0);
+    pid = getpid();
+    boundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+    SFMT(body,
+         "--%s\r\n"
+         "Content-Disposition: form-data; name=\"file\"; filename=\"encoded-%d.txt\"\r\n"
+         "Content-Type: text/plain\r\n"
+         "Content-Transfer-Encoding: binary\r\n"
+         "\r\n"
+         "Encoded file content\r\n"
+         "--%s--\r\n",
+         boundary, pid, boundary);
+    SFMT(headers, "Content-Type: multipart/form-data; boundary=%s\r\n", boundary);
+
+    status = urlFetch(up, "POST", SFMT(url, "%s/test/upload/", HTTP), body, slen(body), headers);
+    teqi(status, 200);
+
+    SFMT(filepath, "tmp/encoded-%d.txt", pid);
+    ttrue(rFileExists(filepath));
+    unlink(filepath);
+    urlFree(up);
+}
+
 static void fiberMain(void *data)
 {
     if (setup(&HTTP, &HTTPS)) {
@@ -457,6 +491,7 @@ static void fiberMain(void *data)
         testMissingFilename();
         testInvalidBoundary();
         testContentTypeVariations();
+        testTransferEncodingHeader();
     }
     rFree(HTTP);
     rFree(HTTPS);